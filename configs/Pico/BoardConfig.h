@@ -41,6 +41,14 @@
 #define PIN_SLIDER_SOCD_ONE    -1         // SOCD Slider Pin One
 #define PIN_SLIDER_SOCD_TWO    -1         // SOCD Slider Pin Two
 
+// This is the remap layer section.
+// `REMAP_LAYER_1` and `REMAP_LAYER_2` define layers that change what some of the pins above map to.
+// The `Next Remap Layer` hotkey cycles through the default mapping and the layers, the selected layer is not saved.
+// Each entry is a pin and the buttons it maps to on that layer, `0` disables the pin.
+// The D-pad is mapped with `GAMEPAD_MASK_DU`, `GAMEPAD_MASK_DD`, `GAMEPAD_MASK_DL` and `GAMEPAD_MASK_DR`.
+// EG. swapping B1 and B3 and turning L2 into the Home button:
+// #define REMAP_LAYER_1 { { PIN_BUTTON_B1, GAMEPAD_MASK_B3 }, { PIN_BUTTON_B3, GAMEPAD_MASK_B1 }, { PIN_BUTTON_L2, GAMEPAD_MASK_A1 } }
+
 // This is the SOCD section.
 // SOCD stands for `simultaneous opposing cardinal directions`.
 // There are three options for `DEFAULT_SOCD_MODE` currently:
@@ -189,6 +197,7 @@
 #define I2C_ANALOG1219_BLOCK i2c0
 #define I2C_ANALOG1219_SPEED 400000
 #define I2C_ANALOG1219_ADDRESS 0x40
+#define I2C_ANALOG1219_DRDY_PIN -1
 
 // Reverse Button section
 #define REVERSE_LED_PIN -1
@@ -40,6 +40,16 @@
 #define PIN_SLIDER_SOCD_ONE    -1         // SOCD Slider Pin One
 #define PIN_SLIDER_SOCD_TWO    -1         // SOCD Slider Pin Two
 
+// This is the button matrix section.
+// A matrix wires the buttons in rows and columns so that more buttons fit than there are free GPIO pins,
+// 5 rows and 5 columns read 25 buttons on 10 pins. Each button connects one row to one column, no diodes needed.
+// When `BUTTON_MATRIX_ROW_PINS` is defined the `PIN_*` button settings above become key numbers instead of GPIO pins:
+// a key number is `row * columns + column`, counted from 0 in the order the pins are listed below.
+// Up to 8 rows, 8 columns and 30 keys are supported. When three buttons on the corners of a rectangle are held,
+// the fourth can't be told apart from them and the affected buttons keep their previous state until it clears.
+// #define BUTTON_MATRIX_ROW_PINS { 2, 3, 4, 5, 6 }
+// #define BUTTON_MATRIX_COLUMN_PINS { 7, 8, 9, 10, 11 }
+
 
 // This is the SOCD section.
 // SOCD stands for `simultaneous opposing cardinal directions`.
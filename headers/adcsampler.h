@@ -0,0 +1,65 @@
+#ifndef ADCSAMPLER_H_
+#define ADCSAMPLER_H_
+
+#include <cstdint>
+
+// Total conversions per second, shared by all channels in round robin
+#ifndef ADC_SAMPLER_RATE
+#define ADC_SAMPLER_RATE 100000
+#endif
+
+// Samples per channel averaged into each value, a power of two
+#ifndef ADC_SAMPLER_OVERSAMPLING
+#define ADC_SAMPLER_OVERSAMPLING 16
+#endif
+
+// IIR filter weight of a new value is 1 / (1 << ADC_SAMPLER_FILTER_SHIFT), 0 disables the filter
+#ifndef ADC_SAMPLER_FILTER_SHIFT
+#define ADC_SAMPLER_FILTER_SHIFT 2
+#endif
+
+#define ADC_SAMPLER_BUFFER_SIZE 256 // Samples in the DMA ring, a power of two
+#define ADC_SAMPLER_INPUTS 5        // GPIO 26-29 and the temperature sensor
+
+// Shared ADC service. The ADC converts every registered pin in round robin free-running mode and DMA
+// writes the samples into a ring buffer, so reading a value never waits for a conversion.
+class AdcSampler {
+public:
+	AdcSampler(AdcSampler const&) = delete;
+	void operator=(AdcSampler const&) = delete;
+	static AdcSampler& getInstance() {
+		static AdcSampler instance;
+		return instance;
+	}
+
+	// Configures an ADC pin (GPIO 26-29) for sampling, must be called before start()
+	bool addPin(uint8_t pin);
+	// Starts the free-running conversions, called once all add-ons are set up
+	void start();
+	// Decimates and filters the latest samples of every pin, called once per frame
+	void update();
+	// Returns the latest filtered value of a pin scaled to 16 bits
+	uint16_t getValue(uint8_t pin) const;
+
+private:
+	AdcSampler() {}
+
+	struct Channel {
+		uint32_t filtered; // 16-bit value with 8 fractional bits
+		uint16_t value;
+	};
+
+	void updateBlocking();
+	void filter(uint8_t input, uint16_t value);
+
+	uint8_t inputMask = 0;
+	uint8_t slotCount = 0;                    // Inputs sampled in round robin, including padding
+	uint8_t slotInputs[4] = {};               // Input converted in each round robin slot
+	int dataChannel = -1;
+	int controlChannel = -1;
+	bool running = false;
+	bool primed = false;
+	Channel channels[ADC_SAMPLER_INPUTS] = {};
+};
+
+#endif
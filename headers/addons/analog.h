@@ -7,6 +7,8 @@
 
 #include "BoardConfig.h"
 
+#include "analogconditioner.h"
+
 #ifndef ANALOG_INPUT_ENABLED
 #define ANALOG_INPUT_ENABLED 0
 #endif
@@ -19,6 +21,18 @@
 #define ANALOG_ADC_VRY    -1
 #endif
 
+#ifndef ANALOG_DEADZONE_MODE
+#define ANALOG_DEADZONE_MODE ANALOG_DEADZONE_AXIAL
+#endif
+
+#ifndef ANALOG_DEADZONE_SIZE
+#define ANALOG_DEADZONE_SIZE 10 // Percent of the stick radius
+#endif
+
+#ifndef ANALOG_CURVE
+#define ANALOG_CURVE ANALOG_CURVE_LINEAR
+#endif
+
 // Analog Module Name
 #define AnalogName "Analog"
 
@@ -32,6 +46,7 @@ public:
 private:
 	uint8_t analogAdcPinX;
 	uint8_t analogAdcPinY;
+	AnalogConditioner conditioner;
 };
 
 #endif  // _Analog_H_
\ No newline at end of file
@@ -55,17 +55,13 @@ public:
 private:
     void debounce();
     uint8_t gpadToBinary(DpadMode, GamepadState);
-    void SOCDDualClean(SOCDMode);
     uint8_t SOCDCombine(SOCDMode, uint8_t);
-    uint8_t SOCDGamepadClean(uint8_t, bool isLastWin);
     void OverrideGamepad(Gamepad *, DpadMode, uint8_t);
     const SOCDMode getSOCDMode(GamepadOptions&);
     uint8_t dDebState;          // Debounce State (stored)
     uint8_t dualState;          // Dual Directional State
-    DpadDirection lastGPUD; // Gamepad Last Up-Down
-	DpadDirection lastGPLR; // Gamepad Last Left-Right
-    DpadDirection lastDualUD; // Dual Last Up-Down
-    DpadDirection lastDualLR; // Gamepad Last Left-Right
+    GamepadSOCDCleaner gamepadCleaner; // Gamepad direction history
+    GamepadSOCDCleaner dualCleaner;    // Dual direction history
     uint32_t dpadTime[4];
     uint8_t pinDualDirDown;
     uint8_t pinDualDirUp;
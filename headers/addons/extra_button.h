@@ -16,7 +16,7 @@ public:
 	virtual bool available();
 	virtual void setup();       // ExtraButton Setup
 	virtual void process() {}     // ExtraButton Process
-	virtual void preprocess();
+	virtual void preprocess() {}
 	virtual std::string name() { return ExtraButtonName; }
 private:
 	uint32_t extraButtonMap;
@@ -7,6 +7,8 @@
 
 #include "GamepadEnums.h"
 
+#include "analogconditioner.h"
+
 #ifndef I2C_ANALOG1219_ENABLED
 #define I2C_ANALOG1219_ENABLED 0
 #endif
@@ -31,11 +33,16 @@
 #define I2C_ANALOG1219_ADDRESS 0x40
 #endif
 
+// Without a DRDY pin the conversions are fetched on a timer
+#ifndef I2C_ANALOG1219_DRDY_PIN
+#define I2C_ANALOG1219_DRDY_PIN -1
+#endif
+
 // Analog Module Name
 #define I2CAnalog1219Name "I2CAnalog"
 
 typedef struct {
-	float A[4];
+	uint16_t A[4]; // 16-bit readings, 0 to VREF
 } ADS_PINS;
 
 class I2CAnalog1219Input : public GPAddon {
@@ -48,6 +55,7 @@ public:
 private:
     ADS1219 * ads;
 	ADS_PINS pins;
+	AnalogConditioner conditioner;
 	int channelHop;
 	uint32_t uIntervalMS;       // ADS1219 Interval
 	uint32_t nextTimer;         // Turbo Timer
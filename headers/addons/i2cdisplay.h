@@ -13,6 +13,7 @@
 #include "gpaddon.h"
 #include "gamepad.h"
 #include "storagemanager.h"
+#include "usb_driver.h"
 
 #ifndef HAS_I2C_DISPLAY
 #define HAS_I2C_DISPLAY -1
@@ -82,6 +83,7 @@ private:
 	void drawWasdBox(int startX, int startY, int buttonRadius, int buttonPadding);
 	void drawArcadeStick(int startX, int startY, int buttonRadius, int buttonPadding);
 	void drawStatusBar(Gamepad*);
+	void drawUsbStats(const UsbReportStats*);
 	void drawText(int startX, int startY, std::string text);
 	void initMenu(char**);
 	//Adding my stuff here, remember to sort before PR
@@ -99,7 +101,8 @@ private:
 	void drawSticklessButtons(int startX, int startY, int buttonRadius, int buttonPadding);
 	void drawWasdButtons(int startX, int startY, int buttonRadius, int buttonPadding);
 	void drawArcadeButtons(int startX, int startY, int buttonRadius, int buttonPadding);
-	void drawSplashScreen(int splashMode, uint8_t* splashChoice, int splashSpeed);
+	void drawSplashScreen(int splashMode, const SplashImage& splashImage, int splashSpeed);
+	void drawSplashImage(const SplashImage& splashImage, int mils);
 	void drawDancepadA(int startX, int startY, int buttonSize, int buttonPadding);
 	void drawDancepadB(int startX, int startY, int buttonSize, int buttonPadding);
 	void drawTwinStickA(int startX, int startY, int buttonSize, int buttonPadding);
@@ -135,7 +138,8 @@ private:
 	enum DisplayMode {
 		CONFIG_INSTRUCTION,
 		BUTTONS,
-		SPLASH
+		SPLASH,
+		USB_STATS
 	};
 
 	DisplayMode getDisplayMode();
@@ -28,7 +28,7 @@ public:
 	virtual void process();     // JSlider process
     virtual std::string name() { return JSliderName; }
 private:
-    DpadMode read();
+    DpadMode read(const GpioSnapshot &);
     void debounce();
     DpadMode dpadState;           // Saved locally for debounce
     DpadMode dDebState;          // Debounce JSlider State
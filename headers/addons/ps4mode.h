@@ -3,11 +3,17 @@
 
 #include "gpaddon.h"
 #include "storagemanager.h"
+#include "ps4signer.h"
 
 #ifndef PS4MODE_ADDON_ENABLED
 #define PS4MODE_ADDON_ENABLED 0
 #endif
 
+// Time core1 may spend signing per loop iteration in microseconds
+#ifndef PS4_SIGNING_BUDGET_US
+#define PS4_SIGNING_BUDGET_US 1000
+#endif
+
 // Turbo Module Name
 #define PS4ModeName "PS4Mode"
 
@@ -19,9 +25,10 @@ public:
 	virtual void process();     // TURBO Setting of buttons (Enable/Disable)
     virtual std::string name() { return PS4ModeName; }
 private:
-	struct mbedtls_rsa_context rsa_context;
-    uint8_t hashed_nonce[32];
-    PS4Options ps4Options;
+    PS4Signer signer;
+    uint32_t signingStarted;
+    uint32_t signingCpuTime;
+    uint32_t signingGeneration; // PS4Data::nonceGeneration of the nonce being signed
 };
 
 #endif  // PS4MODE_H_
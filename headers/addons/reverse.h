@@ -24,20 +24,13 @@ public:
 	virtual void process();     // Reverse process
     virtual std::string name() { return ReverseName; }
 private:
-    void update();
-    uint8_t input(uint8_t valueMask, uint16_t buttonMask, uint16_t buttonMaskReverse, uint8_t action, bool invertAxis);
+    void reverse(GamepadRemapper & remapper, const GamepadButtonMapping * mapping, uint32_t reverseTarget, uint8_t action);
 
 	bool state;
 
 	uint8_t pinLED;
 
-	GamepadButtonMapping *mapDpadUp;
-	GamepadButtonMapping *mapDpadDown;
-	GamepadButtonMapping *mapDpadLeft;
-	GamepadButtonMapping *mapDpadRight;
-
-	bool invertXAxis;
-	bool invertYAxis;
+	uint8_t layer;
 
     // 0 - Ignore, 1 - Enabled, 2 - Neutral
     uint8_t actionUp;
@@ -40,7 +40,7 @@ public:
 	virtual void process();     // SliderSOCD process
     virtual std::string name() { return SliderSOCDName; }
 private:
-    SOCDMode read();
+    SOCDMode read(const GpioSnapshot &);
     void debounce();
     SOCDMode socdState;           // Saved locally for debounce
     SOCDMode dDebState;          // Debounce SliderSOCD State
@@ -98,7 +98,7 @@ public:
 	virtual void process();     // TURBO Setting of buttons (Enable/Disable)
     virtual std::string name() { return TurboName; }
 private:
-    void read(const AddonOptions&);                // Read TURBO Buttons and Dials
+    void read(const AddonOptions&, const GpioSnapshot&);                // Read TURBO Buttons and Dials
     void debounce();            // TURBO Button Debouncer
     void updateTurboShotCount(uint8_t turboShotCount);
     bool bDebState;             // Debounce TURBO Button State
@@ -115,7 +115,6 @@ private:
     uint32_t chargeState;       // Turbo Charge Button States
     bool bTurboFlicker;         // Turbo Enable Buttons Toggle OFF Flag ??
     uint32_t nextTimer;         // Turbo Timer
-    uint8_t adcShmupDial;       // Turbo ADC Dial Input
     uint16_t dialValue;         // Turbo Dial Value (Raw)
     uint16_t incrementValue;    // Turbo Dial Increment Value
     uint8_t turboDialIncrements;    // Turbo Increments based on max/min
@@ -8,10 +8,14 @@
 #include "gpaddon.h"
 #include "gamepad.h"
 #include "storagemanager.h"
+#include "analogconditioner.h"
 #include "WiiExtension.h"
 
 // WiiExtension Module Name
 #define WiiExtensionName "WiiExtension"
+#define WiiExtensionPollerName "WiiExtensionPoller"
+
+#define WII_AXIS_CENTER 0x8000 // Raw stick center, see AnalogConditioner::defaultCalibration
 
 #ifndef WII_EXTENSION_ENABLED
 #define WII_EXTENSION_ENABLED 0
@@ -37,49 +41,63 @@
 #define WII_EXTENSION_I2C_SPEED 400000
 #endif
 
-class WiiExtensionInput : public GPAddon {
+// Time between detection attempts while no extension answers
+#ifndef WII_EXTENSION_RETRY_MS
+#define WII_EXTENSION_RETRY_MS 100
+#endif
+
+// Decoded controller state, published by the core1 poller and merged into the gamepad on core0
+struct WiiExtensionSnapshot {
+    int8_t extensionType = WII_EXTENSION_NONE;
+    uint32_t buttons = 0;
+    uint8_t dpad = 0;
+
+    // Raw stick positions, conditioned when copied to the gamepad
+    uint16_t leftX = WII_AXIS_CENTER;
+    uint16_t leftY = WII_AXIS_CENTER;
+    uint16_t rightX = WII_AXIS_CENTER;
+    uint16_t rightY = WII_AXIS_CENTER;
+
+    uint16_t triggerLeft  = 0;
+    uint16_t triggerRight = 0;
+
+    // Diagnostics
+    uint32_t polls = 0;
+    uint32_t timeouts = 0;
+    uint32_t reconnects = 0;
+};
+
+// Talks to the extension on core1, so a slow or flaky controller never stalls the gamepad loop
+class WiiExtensionPoller : public GPAddon {
 public:
 	virtual bool available();
-	virtual void setup();       // WiiExtension Setup
-	virtual void process();     // WiiExtension Process
+	virtual void setup();       // WiiExtension I2C Setup
+	virtual void process();     // WiiExtension Poll
 	virtual void preprocess() {}
-	virtual std::string name() { return WiiExtensionName; }
+	virtual std::string name() { return WiiExtensionPollerName; }
+
+    // Copies the latest published snapshot, false until the poller has published one
+    static bool readSnapshot(WiiExtensionSnapshot& copy);
 private:
     WiiExtension * wii;
-    uint32_t uIntervalMS;
     uint32_t nextTimer;
+    WiiExtensionSnapshot snapshot;
 
-    bool buttonC = false;
-    bool buttonZ = false;
-
-    bool buttonA = false;
-    bool buttonB = false;
-    bool buttonX = false;
-    bool buttonY = false;
-    bool buttonL = false;
-    bool buttonZL = false;
-    bool buttonR = false;
-    bool buttonZR = false;
-
-    bool buttonSelect = false;
-    bool buttonStart = false;
-    bool buttonHome = false;
-
-    bool dpadUp     = false;
-    bool dpadDown   = false;
-    bool dpadLeft   = false;
-    bool dpadRight  = false;
-
-    uint16_t triggerLeft  = 0;
-    uint16_t triggerRight = 0;
-    uint16_t whammyBar    = 0;
-
-    uint16_t leftX = 0;
-    uint16_t leftY = 0;
-    uint16_t rightX = 0;
-    uint16_t rightY = 0;
+    void decode();
+    static void publishSnapshot(const WiiExtensionSnapshot& latest);
+    static uint16_t scaleAxis(uint16_t value, uint16_t max, bool invert);
+};
 
-    uint16_t map(uint16_t x, uint16_t in_min, uint16_t in_max, uint16_t out_min, uint16_t out_max);
+class WiiExtensionInput : public GPAddon {
+public:
+	virtual bool available();
+	virtual void setup();       // WiiExtension Setup
+	virtual void process();     // WiiExtension Process
+	virtual void preprocess() {}
+	virtual std::string name() { return WiiExtensionName; }
+private:
+    WiiExtensionSnapshot snapshot;
+    AnalogConditioner conditioner;
 };
 
 #endif  // _WIIExtensionAddon_H
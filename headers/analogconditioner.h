@@ -0,0 +1,50 @@
+#ifndef ANALOGCONDITIONER_H_
+#define ANALOGCONDITIONER_H_
+
+#include <cstdint>
+
+#include "enums.h"
+
+#define ANALOG_CURVE_SEGMENTS 32 // Linear segments of the response curve lookup table
+
+// Raw readings of one axis at its limits and at rest, in 16-bit input units
+struct AnalogAxisCalibration {
+	uint16_t min;
+	uint16_t center;
+	uint16_t max;
+};
+
+struct AnalogStickCalibration {
+	AnalogAxisCalibration x;
+	AnalogAxisCalibration y;
+};
+
+// Turns raw stick readings into GamepadState joystick values: calibration, deadzone and response curve,
+// all in integer math so it stays cheap on a core without an FPU
+class AnalogConditioner {
+public:
+	AnalogConditioner();
+
+	// An axis whose limits are not ordered around its center falls back to the full input range
+	void setCalibration(const AnalogStickCalibration& calibration);
+	// Deadzone size is a percentage of the stick radius
+	void setDeadzone(AnalogDeadzoneMode mode, uint8_t percent);
+	void setCurve(AnalogCurve curve);
+
+	// Conditions a raw 16-bit stick position, outputs range from GAMEPAD_JOYSTICK_MIN to GAMEPAD_JOYSTICK_MAX
+	void process(uint16_t rawX, uint16_t rawY, uint16_t& outX, uint16_t& outY) const;
+
+	static const AnalogStickCalibration defaultCalibration;
+
+private:
+	int32_t normalize(uint16_t raw, const AnalogAxisCalibration& calibration) const;
+	int32_t applyCurve(int32_t value) const;
+
+	AnalogStickCalibration calibration;
+	AnalogDeadzoneMode deadzoneMode;
+	int32_t deadzone;
+	bool linear;
+	uint16_t curve[ANALOG_CURVE_SEGMENTS + 1];
+};
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef BUTTONMATRIX_H_
+#define BUTTONMATRIX_H_
+
+#include <cstdint>
+
+#include "pico/time.h"
+
+// Time between two scans of the whole matrix in microseconds
+#ifndef BUTTON_MATRIX_SCAN_US
+#define BUTTON_MATRIX_SCAN_US 200
+#endif
+
+// Time a driven row is given before its columns are read, covers the pull-ups recharging the columns
+// the previous row pulled low
+#ifndef BUTTON_MATRIX_SETTLE_US
+#define BUTTON_MATRIX_SETTLE_US 5
+#endif
+
+#define BUTTON_MATRIX_MAX_ROWS 8
+#define BUTTON_MATRIX_MAX_COLUMNS 8
+#define BUTTON_MATRIX_MAX_KEYS 30 // Key numbers share the range of GPIO numbers in the button mappings
+
+// Scans a row/column button matrix without diodes from a chain of timer alarms. Rows are driven low one at a
+// time and columns read through their pull-ups, keys are numbered row * columns + column. Each alarm reads
+// the row driven by the previous one and drives the next, so the settle time passes between two alarms
+// instead of inside the interrupt.
+class ButtonMatrix {
+public:
+	ButtonMatrix(ButtonMatrix const&) = delete;
+	void operator=(ButtonMatrix const&) = delete;
+	static ButtonMatrix& getInstance() {
+		static ButtonMatrix instance;
+		return instance;
+	}
+
+	// Configures the pins, scans once so the keys are valid right away and starts the alarms
+	bool setup(const uint8_t * rowPins, uint8_t rows, const uint8_t * columnPins, uint8_t columns);
+	// Pressed keys as a bitmask of key numbers
+	uint32_t getKeys() const { return keys; }
+	// GPIOs taken by the matrix rows and columns
+	uint32_t getPinMask() const { return pinMask; }
+	// Times a key combination became ambiguous and the affected keys held their previous state
+	uint32_t getGhostCount() const { return ghostCount; }
+
+private:
+	ButtonMatrix() {}
+
+	static int64_t scanCallback(alarm_id_t id, void * user_data);
+	// Advances the scan by one row, returns the time until the next step as the alarm pool expects it
+	int64_t scanStep();
+	void publish();
+
+	uint8_t rowPins[BUTTON_MATRIX_MAX_ROWS] = {};
+	uint8_t columnPins[BUTTON_MATRIX_MAX_COLUMNS] = {};
+	uint8_t rows = 0;
+	uint8_t columns = 0;
+	uint32_t pinMask = 0;
+	uint8_t rowColumns[BUTTON_MATRIX_MAX_ROWS] = {}; // Pressed columns of each row in the running scan
+	uint8_t scanRow = 0;                             // Row being driven, rows between two scans
+	uint32_t ambiguousKeys = 0;
+	volatile uint32_t keys = 0;
+	volatile uint32_t ghostCount = 0;
+	alarm_id_t scanAlarm = 0;
+};
+
+#endif
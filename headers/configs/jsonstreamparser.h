@@ -0,0 +1,71 @@
+#ifndef _JSONSTREAMPARSER_H_
+#define _JSONSTREAMPARSER_H_
+
+#include <ArduinoJson.h>
+
+#include <cstddef>
+#include <string>
+
+// Incremental JSON parser that builds a document from input arriving in arbitrary chunks, so HTTP POST
+// bodies can be parsed straight from the received pbufs without buffering the raw text first.
+// Strings are copied into the document, the input chunks do not need to stay around.
+class JsonStreamParser
+{
+public:
+	static const uint8_t MAX_DEPTH = ARDUINOJSON_DEFAULT_NESTING_LIMIT;
+
+	// Starts parsing a new value into doc, which is cleared
+	void reset(JsonDocument* doc);
+
+	// Consumes the next chunk, returns false once the input is malformed or the document is full
+	bool parse(const char* data, size_t length);
+
+	// Returns true if the input held exactly one complete value
+	bool finish();
+
+private:
+	enum class State : uint8_t
+	{
+		VALUE,       // Expecting a value
+		FIRST_VALUE, // Expecting a value or ']' right after '['
+		FIRST_KEY,   // Expecting a key or '}' right after '{'
+		KEY,         // Expecting a key
+		COLON,
+		STRING,
+		NUMBER,
+		LITERAL,
+		AFTER_VALUE, // Expecting ',' or the end of the current container
+		DONE,
+		ERROR,
+	};
+
+	struct Frame
+	{
+		JsonObject object;
+		JsonArray array;
+	};
+
+	bool parseChar(char c);
+	bool parseEscape(char c);
+	bool beginContainer(bool isObject);
+	bool endContainer();
+	bool endValue();
+	bool endString();
+	bool endNumber();
+	bool endLiteral();
+	template <typename T> bool store(const T& value);
+
+	JsonDocument* doc = nullptr;
+	State state = State::ERROR;
+	Frame stack[MAX_DEPTH];
+	uint8_t depth = 0;
+
+	std::string key;
+	std::string text;       // String, number or literal being read
+	bool stringIsKey = false;
+	uint8_t escape = 0;     // 1 after a backslash, 2-5 while reading \uXXXX digits
+	uint16_t codePoint = 0;
+	uint16_t highSurrogate = 0;
+};
+
+#endif
@@ -64,6 +64,22 @@ typedef enum
 	INPUT_TEST
 } OnBoardLedMode;
 
+typedef enum
+{
+	ANALOG_DEADZONE_NONE,
+	ANALOG_DEADZONE_AXIAL,         // Each axis snaps to center on its own
+	ANALOG_DEADZONE_RADIAL,        // The stick snaps to center inside a circle
+	ANALOG_DEADZONE_SCALED_RADIAL, // Radial, with the remaining travel scaled back to the full range
+} AnalogDeadzoneMode;
+
+typedef enum
+{
+	ANALOG_CURVE_LINEAR,
+	ANALOG_CURVE_QUADRATIC,
+	ANALOG_CURVE_CUBIC,
+	ANALOG_CURVE_SQUARE_ROOT,
+} AnalogCurve;
+
 typedef enum
 {
 	CONFIG_TYPE_WEB = 0,
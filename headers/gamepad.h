@@ -5,6 +5,8 @@
 #include <string.h>
 
 #include "gamepad/GamepadDebouncer.h"
+#include "gamepad/GamepadRemapper.h"
+#include "gamepad/GamepadSOCDCleaner.h"
 #include "gamepad/GamepadOptions.h"
 #include "gamepad/GamepadState.h"
 #include "gamepad/GamepadStorage.h"
@@ -54,6 +56,21 @@ struct GamepadButtonMapping
 	bool isAssigned() const { return pin != 0xff; }
 };
 
+/**
+ * @brief GPIO levels sampled once per frame by Gamepad::read, so every input add-on sees the same frame.
+ * Bits are inverted from the pin levels since inputs use pullups: a set bit is a pressed input.
+ */
+struct GpioSnapshot
+{
+	uint32_t pressed {0};
+	uint32_t keys {0};      // Inputs the button mappings refer to: the pressed pins, or the keys of a button matrix
+	uint64_t timestamp {0}; // getMicro() when the pins were sampled
+	uint32_t firstEdge {0}; // time_us_32() of the oldest input change picked up by this sample
+	uint16_t edges {0};     // Input changes picked up by this sample, only tracked while the InputScanner runs
+
+	inline bool isPressed(uint8_t pin) const { return pin < NUM_BANK0_GPIOS && (pressed & (1 << pin)); }
+};
+
 #define GAMEPAD_DIGITAL_INPUT_COUNT 18 // Total number of buttons, including D-pad
 
 class Gamepad {
@@ -69,6 +86,8 @@ public:
 	void setup();
 	void process();
 	void read();
+	// Maps a recorded snapshot instead of sampling the inputs, used to replay input traces
+	void read(const GpioSnapshot& snapshot);
 	void save();
 	void debounce();
 	
@@ -89,13 +108,18 @@ public:
 	 */
 	bool hasRightAnalogStick {false};
 
-	void *getReport();
+	/**
+	 * @brief Report for the current input mode with every field the encoders never touch already set.
+	 * Report buffers must be seeded with it once, after that the encoders only write the fields that change.
+	 */
+	const void *getDefaultReport();
 	uint16_t getReportSize();
-	HIDReport *getHIDReport();
-	SwitchReport *getSwitchReport();
-	XInputReport *getXInputReport();
-	KeyboardReport *getKeyboardReport();
-	PS4Report *getPS4Report();
+	void *getReport(void *report);
+	HIDReport *getHIDReport(HIDReport *report);
+	SwitchReport *getSwitchReport(SwitchReport *report);
+	XInputReport *getXInputReport(XInputReport *report);
+	KeyboardReport *getKeyboardReport(KeyboardReport *report);
+	PS4Report *getPS4Report(PS4Report *report);
 
 	/**
 	 * @brief Check for a button press. Used by `pressed[Button]` helper methods.
@@ -130,6 +154,8 @@ public:
 	inline bool __attribute__((always_inline)) pressedF1()    { return pressedButton(f1Mask); }
 	inline bool __attribute__((always_inline)) pressedF2()    { return pressedButton(f2Mask); }
 	GamepadDebouncer debouncer;
+	GamepadSOCDCleaner socdCleaner;
+	GamepadRemapper remapper;
 	GamepadStorage *mpgStorage;
 	const uint8_t debounceMS;
 	uint16_t f1Mask;
@@ -137,6 +163,7 @@ public:
 	GamepadOptions options;
 	GamepadState rawState;
 	GamepadState state;
+	GpioSnapshot gpio;
 	GamepadButtonMapping *mapDpadUp;
 	GamepadButtonMapping *mapDpadDown;
 	GamepadButtonMapping *mapDpadLeft;
@@ -157,6 +184,20 @@ public:
 	GamepadButtonMapping *mapButtonA2;
 	GamepadButtonMapping **gamepadMappings;
 
+	/**
+	 * @brief Remap source of a GPIO pin, for add-ons that map their own pins through the remapper.
+	 * With a button matrix the keys take the low sources and the pins follow them.
+	 */
+	inline uint8_t getRemapSource(uint8_t pin) const {
+		if (pin >= NUM_BANK0_GPIOS)
+			return REMAP_NO_SOURCE;
+#ifdef BUTTON_MATRIX_ROW_PINS
+		return pin + 32;
+#else
+		return pin;
+#endif
+	}
+
 	inline static const SOCDMode resolveSOCDMode(const GamepadOptions& options) {
 		 return ((options.socdMode == SOCD_MODE_BYPASS) && 
 		         (options.inputMode == INPUT_MODE_HID || options.inputMode == INPUT_MODE_SWITCH || options.inputMode == INPUT_MODE_PS4)) ?
@@ -164,8 +205,10 @@ public:
 	};
 
 private:
-	void releaseAllKeys(void);
-	void pressKey(uint8_t code);
+	void compileMappings();
+	void mapInputs();
+	void releaseAllKeys(KeyboardReport *report);
+	void pressKey(KeyboardReport *report, uint8_t code);
 	uint8_t getModifier(uint8_t code);
 
 	GamepadHotkeyEntry hotkeyF1Up;
@@ -62,5 +62,6 @@ typedef enum
 	HOTKEY_INVERT_X_AXIS,
 	HOTKEY_INVERT_Y_AXIS,
 	HOTKEY_SOCD_FIRST_INPUT,
-	HOTKEY_SOCD_BYPASS
+	HOTKEY_SOCD_BYPASS,
+	HOTKEY_NEXT_REMAP_LAYER
 } GamepadHotkey;
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <stdint.h>
+#include "GamepadState.h"
+
+#define REMAP_SOURCE_COUNT 64 // Input bits a rule can read from
+#define REMAP_NIBBLE_COUNT (REMAP_SOURCE_COUNT / 4)
+#define REMAP_MAX_LAYERS 4    // Including the base layer
+#define REMAP_BASE_LAYER 0
+#define REMAP_NO_LAYER 0xFF
+#define REMAP_NO_SOURCE 0xFF
+
+struct GamepadRemapRule
+{
+	uint8_t source;
+	uint32_t target;
+};
+
+/**
+ * @brief Maps input bits to gamepad outputs through a set of rules and layers.
+ *
+ * A rule maps one source bit, such as a pin, to a target mask that holds the buttons in bits 0-15 and the
+ * D-pad as GAMEPAD_MASK_DU..GAMEPAD_MASK_DR. The base layer holds the rules of the button mappings, every
+ * other layer overrides some of its sources. A layer is active while its trigger source is held, layers
+ * without a trigger are selected with selectLayer and stay active until another one is selected. Trigger
+ * layers stack on the selected layer, the sources they don't override keep the mapping of the selected layer.
+ *
+ * Each layer is compiled into bit-sliced tables: one table per group of four sources, indexed by the
+ * pressed sources of the group, holding the OR of their targets. Mapping all inputs is one lookup per group
+ * that has rules, however many rules there are.
+ */
+class GamepadRemapper
+{
+	public:
+		GamepadRemapper() { reset(); }
+
+		/**
+		 * @brief Map input bits through the active layer.
+		 *
+		 * @param sources The pressed input bits.
+		 * @return uint32_t The OR of the targets of every pressed source.
+		 */
+		uint32_t apply(uint64_t sources);
+
+		/**
+		 * @brief Add a target to a source of the base layer, layers that don't override the source map it too.
+		 */
+		void addRule(uint8_t source, uint32_t target);
+
+		/**
+		 * @brief Map a source to a target while the layer is active, a target of 0 disables the source.
+		 */
+		void setOverride(uint8_t layer, uint8_t source, uint32_t target);
+
+		/**
+		 * @brief Add a layer on top of the base layer.
+		 *
+		 * @param trigger The source that activates the layer while held, or REMAP_NO_SOURCE for a selectable layer.
+		 * @return uint8_t The new layer, or REMAP_NO_LAYER when all layers are taken.
+		 */
+		uint8_t addLayer(uint8_t trigger = REMAP_NO_SOURCE);
+
+		void selectLayer(uint8_t layer);
+
+		/**
+		 * @brief Select the next layer without a trigger, wrapping around to the base layer.
+		 */
+		void nextLayer();
+
+		/**
+		 * @brief Remove every rule and layer.
+		 */
+		void reset();
+
+		uint8_t getActiveLayer() const { return activeLayer; }
+		uint8_t getSelectedLayer() const { return selectedLayer; }
+
+	private:
+		uint32_t target(uint8_t layer, uint8_t source) const; // Override of the layer or the base rule
+		void compile(uint8_t nibble);
+		void compileAll();
+
+		uint32_t rules[REMAP_SOURCE_COUNT] {};
+		uint32_t overrides[REMAP_MAX_LAYERS][REMAP_SOURCE_COUNT] {};
+		uint64_t overridden[REMAP_MAX_LAYERS] {};        // Sources each layer overrides
+		uint32_t tables[REMAP_MAX_LAYERS][REMAP_NIBBLE_COUNT][16] {};
+		uint8_t nibbles[REMAP_NIBBLE_COUNT] {};          // Groups with at least one rule in any layer
+		uint8_t nibbleCount {0};
+		uint8_t triggers[REMAP_MAX_LAYERS] {};
+		uint64_t triggerMask {0};                        // Trigger sources of all layers
+		uint8_t layerCount {1};
+		uint8_t selectedLayer {REMAP_BASE_LAYER};
+		uint8_t activeLayer {REMAP_BASE_LAYER};
+};
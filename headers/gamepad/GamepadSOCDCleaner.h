@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stdint.h>
+#include "GamepadState.h"
+
+/**
+ * @brief SOCD cleaning for one set of directional inputs.
+ *
+ * Each cleaner keeps the direction history of its own inputs, so separate inputs such as the gamepad D-pad
+ * and the Dual Directional pins don't see each other's presses. Every mode is compiled into a transition table
+ * indexed by the history and the raw D-pad, cleaning a D-pad is a single lookup.
+ */
+class GamepadSOCDCleaner
+{
+	public:
+		/**
+		 * @brief Run SOCD cleaning against a D-pad value.
+		 *
+		 * @param mode The SOCD cleaning mode.
+		 * @param dpad The GamepadState.dpad value.
+		 * @return uint8_t The clean D-pad value.
+		 */
+		uint8_t clean(SOCDMode mode, uint8_t dpad);
+
+		void reset() { history = 0; }
+
+	private:
+		uint8_t history {0}; // Last Up-Down direction in bits 0-1, last Left-Right direction in bits 2-3
+};
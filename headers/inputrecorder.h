@@ -0,0 +1,122 @@
+#ifndef INPUTRECORDER_H_
+#define INPUTRECORDER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "gamepad.h"
+
+// Input changes kept in the trace, the oldest are overwritten once it is full
+#ifndef INPUT_RECORDER_ENTRIES
+#define INPUT_RECORDER_ENTRIES 512
+#endif
+
+#define INPUT_TRACE_MAGIC 0x52545047 // "GPTR"
+#define INPUT_TRACE_VERSION 1
+
+/* Input trace file, as downloaded from and uploaded to web config (little endian)
+ *
+ *   InputTraceHeader
+ *   count x InputTraceEntry, oldest first
+ *
+ * An entry is written whenever the sampled inputs or the final gamepad state of a frame changed.
+ */
+struct __attribute__((packed)) InputTraceHeader
+{
+	uint32_t magic;
+	uint16_t version;
+	uint16_t entrySize;
+	uint32_t count;
+	uint32_t dropped; // Entries overwritten before the oldest one in the file
+};
+
+struct __attribute__((packed)) InputTraceEntry
+{
+	uint32_t time;    // Low 32 bits of getMicro() when the inputs were sampled
+	uint32_t pressed; // GpioSnapshot::pressed
+	uint32_t keys;    // GpioSnapshot::keys
+	uint16_t buttons; // Final GamepadState after the add-ons
+	uint16_t aux;
+	uint8_t dpad;
+	uint8_t lt;
+	uint8_t rt;
+	uint8_t reserved;
+	uint16_t lx;
+	uint16_t ly;
+	uint16_t rx;
+	uint16_t ry;
+};
+
+static_assert(sizeof(InputTraceEntry) == 28, "The trace file layout must not change without a version bump");
+
+#define INPUT_TRACE_MAX_SIZE (sizeof(InputTraceHeader) + INPUT_RECORDER_ENTRIES * sizeof(InputTraceEntry))
+
+// Outcome of the latest replay, only the digital outputs are compared since analog inputs are not in the trace
+struct InputReplayResult
+{
+	uint32_t frames;         // Entries fed through the pipeline
+	uint32_t mismatches;     // Frames whose buttons, dpad or aux differ from the recording
+	uint32_t firstMismatch;  // Entry index of the first mismatch
+	uint16_t expectedButtons;
+	uint16_t actualButtons;
+	uint8_t expectedDpad;
+	uint8_t actualDpad;
+	uint16_t expectedAux;
+	uint16_t actualAux;
+	uint32_t pipelineTime;   // Microseconds spent in the pipeline over all frames
+	uint32_t pipelineMax;    // Longest single frame in microseconds
+};
+
+// Records the inputs and final state of every frame that changed into RAM that survives a reboot, so the
+// trace of a gamepad session can be downloaded from web config afterwards. An uploaded trace is replayed
+// on the next gamepad boot: its inputs are fed through read, debounce, SOCD and the input add-ons on the
+// recorded clock and every frame is compared against the recorded state.
+class InputRecorder {
+public:
+	InputRecorder(InputRecorder const&) = delete;
+	void operator=(InputRecorder const&) = delete;
+	static InputRecorder& getInstance() {
+		static InputRecorder instance;
+		return instance;
+	}
+
+	// Called on gamepad boots before the add-ons are set up. Starts a pending replay or a new recording.
+	void begin();
+	// Set before core1 starts and cleared by core0, so core1 can check it
+	bool isReplaying() const { return replaying; }
+	// Only valid on core0, which owns the replay
+	uint64_t getReplayTime() const { return replayTime; }
+
+	// Loads the next recorded frame into the gamepad in place of Gamepad::read
+	void replay(Gamepad* gamepad);
+	// Records the frame when recording, compares it against the trace when replaying. A finished replay
+	// reboots into web config mode.
+	void capture(const GpioSnapshot& gpio, const GamepadState& state);
+
+	// Writes the trace file into buffer, returns its length or 0 if there is nothing recorded
+	size_t exportTrace(uint8_t* buffer, size_t size) const;
+	// Stores an uploaded trace to be replayed on the next gamepad boot
+	bool importTrace(const uint8_t* data, size_t length);
+
+	uint32_t getEntryCount() const;
+	// Oldest entries overwritten since the recording started, a replay of a trace that lost its start
+	// begins with add-on and debouncer history that differs from the recording
+	uint32_t getDroppedCount() const;
+	// Result of the replay of the trace in memory, nullptr if it was recorded instead
+	const InputReplayResult* getReplayResult() const;
+
+private:
+	InputRecorder() {}
+
+	void finishReplay();
+
+	volatile bool replaying = false;
+	bool recording = false;
+	uint64_t replayTime = 0;
+	uint32_t replayIndex = 0;
+	uint32_t frameStart = 0;
+	GpioSnapshot lastGpio;
+	GamepadState lastState;
+};
+
+#endif
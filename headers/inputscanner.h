@@ -0,0 +1,55 @@
+#ifndef INPUTSCANNER_H_
+#define INPUTSCANNER_H_
+
+#include <cstdint>
+
+// Samples taken per second across all scanned pins
+#ifndef INPUT_SCANNER_SAMPLE_RATE
+#define INPUT_SCANNER_SAMPLE_RATE 1000000
+#endif
+
+#define INPUT_SCANNER_RING_SIZE 256 // Edges buffered between two drains, a power of two
+
+// Button scanning service. A PIO state machine samples the input pins continuously and pushes their
+// levels only when they change, DMA stores every change with the time it arrived in a ring buffer.
+// Reading the inputs drains the ring instead of touching the pins.
+class InputScanner {
+public:
+	InputScanner(InputScanner const&) = delete;
+	void operator=(InputScanner const&) = delete;
+	static InputScanner& getInstance() {
+		static InputScanner instance;
+		return instance;
+	}
+
+	// Scans every GPIO configured as an input apart from the excluded ones, called once all add-ons have set up their pins.
+	// Stays stopped when an output or peripheral pin sits between the inputs or no PIO state machine is free,
+	// and stops for good if a pin between the inputs starts toggling later on.
+	bool start(uint32_t excludedPins = 0);
+	bool isRunning() const { return running; }
+	// True when an edge arrived that has not been drained yet
+	bool hasPendingEdges() const;
+	// Consumes the buffered edges and returns the latest pin levels, like gpio_get_all()
+	uint32_t drain();
+
+	uint32_t getFirstEdgeTime() const { return firstEdgeTime; } // time_us_32() of the oldest edge the last drain picked up
+	uint16_t getDrainedEdges() const { return drainedEdges; }   // Input changes the last drain picked up
+
+private:
+	InputScanner() {}
+
+	void stop();
+	uint32_t getWriteIndex() const;
+
+	bool running = false;
+	uint32_t pinMask = 0;
+	uint32_t levels = 0;
+	uint32_t readIndex = 0;
+	uint32_t firstEdgeTime = 0;
+	uint16_t drainedEdges = 0;
+	bool synced = false;             // The sync push that follows start() has been drained
+	int levelChannel = -1;
+	int timeChannel = -1;
+};
+
+#endif
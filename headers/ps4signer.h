@@ -0,0 +1,84 @@
+#ifndef PS4SIGNER_H_
+#define PS4SIGNER_H_
+
+#include <cstdint>
+
+#include "storagemanager.h"
+
+// RSASSA-PSS (SHA-256) signing of the PS4 authentication nonce, split into small resumable steps.
+//
+// The private key operation runs as two CRT exponentiations with 1024 bit Montgomery arithmetic.
+// All constants that only depend on the key (R^2 mod p/q and the Montgomery inverses) are computed
+// once in setup, and every call to step() performs about one Montgomery multiplication so the caller
+// can bound how long a single loop iteration is stalled.
+class PS4Signer {
+public:
+	static const uint16_t PRIME_LIMBS = 32;
+	static const uint16_t SIGNATURE_SIZE = 256;
+	static const uint16_t HASH_SIZE = 32;
+	static const uint16_t SALT_SIZE = HASH_SIZE;
+
+	enum class State : uint8_t {
+		IDLE,
+		ENCODE,
+		REDUCE,
+		TABLE_P,
+		EXP_P,
+		TABLE_Q,
+		EXP_Q,
+		COMBINE,
+		DONE,
+	};
+
+	void setup(const PS4Options& options);
+	// Hashes the nonce and queues the signature, salt must hold SALT_SIZE random bytes
+	void start(const uint8_t* nonce, uint16_t nonceSize, const uint8_t* salt);
+	void reset() { state = State::IDLE; }
+	// Performs the next unit of work, returns true once the signature is ready
+	bool step();
+
+	State getState() const { return state; }
+	bool isBusy() const { return state != State::IDLE && state != State::DONE; }
+	const uint8_t* getSignature() const { return signature; }
+
+private:
+	struct Modulus {
+		uint32_t m[PRIME_LIMBS];
+		uint32_t rr[PRIME_LIMBS]; // R^2 mod m, R = 2^(32 * PRIME_LIMBS)
+		uint32_t mInv;            // -m^-1 mod 2^32
+	};
+
+	struct Exponentiation {
+		const Modulus* modulus;
+		const uint32_t* exponent;
+		uint32_t* value; // Base on entry, result once done
+		int16_t window;
+		uint8_t operation;
+		uint8_t tableIndex;
+	};
+
+	void beginExponentiation(const Modulus& modulus, const uint32_t* exponent, uint32_t* value);
+	bool buildTable();
+	bool exponentiate();
+	void combine();
+
+	State state = State::IDLE;
+
+	Modulus p;
+	Modulus q;
+	uint32_t dp[PRIME_LIMBS];
+	uint32_t dq[PRIME_LIMBS];
+	uint32_t qInvMont[PRIME_LIMBS]; // q^-1 mod p in Montgomery form
+
+	uint8_t hash[HASH_SIZE];
+	uint8_t salt[SALT_SIZE];
+	uint8_t signature[SIGNATURE_SIZE]; // Holds the encoded message until the private key operation replaces it
+
+	uint32_t mp[PRIME_LIMBS];
+	uint32_t mq[PRIME_LIMBS];
+	uint32_t accumulator[PRIME_LIMBS];
+	uint32_t table[16][PRIME_LIMBS];
+	Exponentiation exp;
+};
+
+#endif
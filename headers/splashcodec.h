@@ -0,0 +1,45 @@
+#ifndef SPLASHCODEC_H_
+#define SPLASHCODEC_H_
+
+#include <cstdint>
+
+// Splash images are stored as a sequence of RLE compressed frames laid out in OLED page order
+// (one byte holds 8 vertical pixels, 128 columns per page, 8 pages per 128x64 frame), so that
+// frames can be decoded straight into the display back buffer.
+//
+// Every frame starts with a 3 byte header: the frame type followed by the compressed length
+// (little endian). Key frames replace the destination, delta frames are XORed onto the previous frame.
+// Raw frames are key frames stored uncompressed, for images RLE would make larger than FRAME_SIZE.
+//
+// The compressed stream is a sequence of tokens:
+//   0x00-0x7F: literal, the next (token + 1) bytes are copied
+//   0x80-0xFF: repeat, the next byte is repeated (token - 0x80 + 2) times
+namespace SplashCodec {
+    const uint16_t FRAME_WIDTH = 128;
+    const uint8_t FRAME_PAGES = 8;
+    const uint16_t FRAME_SIZE = FRAME_WIDTH * FRAME_PAGES;
+    const uint16_t FRAME_HEADER_SIZE = 3;
+
+    enum FrameType : uint8_t {
+        FRAME_KEY = 0,
+        FRAME_DELTA = 1,
+        FRAME_RAW = 2,
+    };
+
+    // A single raw frame, the largest a one frame image can get
+    const uint16_t MAX_FRAME_SIZE = FRAME_HEADER_SIZE + FRAME_SIZE;
+
+    // Decodes frames up to and including frameIndex into a page ordered buffer with the given pitch
+    // and number of pages. Returns false if the stream is malformed.
+    bool decode(const uint8_t* data, uint16_t size, uint8_t frameIndex, uint8_t* dest, uint16_t pitch, uint8_t pages);
+
+    // Returns true if the stream holds exactly frameCount well-formed frames and the first one is a key frame
+    bool validate(const uint8_t* data, uint16_t size, uint8_t frameCount);
+
+    // Encodes a row-major 128x64 bitmap (MSB is the left-most pixel, 16 bytes per row) as a single key frame,
+    // or as a raw frame if compression does not pay off. Returns the number of bytes written, or 0 if the
+    // frame does not fit into maxSize.
+    uint16_t encodeBitmap(const uint8_t* bitmap, uint8_t* out, uint16_t maxSize);
+}
+
+#endif
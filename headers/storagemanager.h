@@ -13,6 +13,7 @@
 #include "enums.h"
 #include "helper.h"
 #include "gamepad.h"
+#include "analogconditioner.h"
 
 #include "mbedtls/rsa.h"
 
@@ -22,12 +23,18 @@
 #define ANIMATION_STORAGE_INDEX 		2048 // 1024 bytes for LED animations
 #define ADDON_STORAGE_INDEX             3072 // 1024 bytes for Add-Ons
 #define PS4_STORAGE_INDEX               4096 // 2048 bytes for PS4 options
-#define SPLASH_IMAGE_STORAGE_INDEX		6144 // 1032 bytes for Display Config
+#define SPLASH_IMAGE_STORAGE_INDEX		6144 // 1036 bytes for Display Config
+
+#define SPLASH_IMAGE_DATA_SIZE			1028 // Encoded splash frames, fits one raw frame, see splashcodec.h
 
 
 #define CHECKSUM_MAGIC          0 	// Checksum CRC
 #define NOCHECKSUM_MAGIC        0xDEADBEEF // No checksum CRC
 
+#define SETTINGS_SNAPSHOT_MAGIC     0x53535047 // "GPSS"
+#define SETTINGS_SNAPSHOT_VERSION   1
+#define SETTINGS_SNAPSHOT_MAX_SIZE  (EEPROM_SIZE_BYTES + 128) // All sections plus the snapshot framing
+
 struct ButtonLayoutParams
 {
 	union {
@@ -107,6 +114,7 @@ struct AddonOptions {
 	int i2cAnalog1219Block;
 	uint32_t i2cAnalog1219Speed;
 	uint8_t i2cAnalog1219Address;
+	uint8_t i2cAnalog1219DRDYPin;
 	uint8_t pinDualDirUp;    // Pins for Dual Directional Input
 	uint8_t pinDualDirDown;
 	uint8_t pinDualDirLeft;
@@ -116,6 +124,10 @@ struct AddonOptions {
 	OnBoardLedMode onBoardLedMode;
 	uint8_t analogAdcPinX;
 	uint8_t analogAdcPinY;
+	AnalogDeadzoneMode analogDeadzoneMode;
+	uint8_t analogDeadzone; // Percent of the stick radius
+	AnalogCurve analogCurve;
+	AnalogStickCalibration analogCalibration; // Analog add-on stick, captured from web config
 	uint16_t bootselButtonMap;
 	uint8_t extraButtonPin;
 	uint32_t extraButtonMap;
@@ -165,10 +177,15 @@ struct AddonOptions {
 };
 
 struct SplashImage {
-	uint8_t data[16*64];
+	uint16_t size;       // Bytes of data in use
+	uint8_t frameCount;
+	uint8_t frameDelay;  // Time between frames in 10ms steps
+	uint8_t data[SPLASH_IMAGE_DATA_SIZE];
 	uint32_t checksum;
 };
 
+static_assert(SPLASH_IMAGE_STORAGE_INDEX + sizeof(SplashImage) <= EEPROM_SIZE_BYTES, "SplashImage exceeds the EEPROM region");
+
 struct PS4Options {
 	uint8_t serial[16];
 	uint8_t signature[256];
@@ -268,6 +285,11 @@ public:
 
 	void ResetSettings(); 				// EEPROM Reset Feature
 
+	// Binary image of every settings section, see storagemanager.cpp for the layout.
+	// An import only takes effect after a reboot.
+	size_t exportSnapshot(uint8_t* buffer, size_t size, bool includePS4);
+	bool importSnapshot(const uint8_t* data, size_t length);
+
 	void setPLEDPins(int pin1, int pin2, int pin3, int pin4) {
 		pledPins[0] = pin1;
 		pledPins[1] = pin2;
@@ -289,8 +311,10 @@ private:
 	void initBoardOptions();
 	void initPreviewBoardOptions();
 	void initAddonOptions();
+	bool migrateLegacyAddonOptions();
 	void initLEDOptions();
 	void initSplashImage();
+	bool migrateLegacySplashImage();
 	void setDefaultBoardOptions();
 	void setDefaultAddonOptions();
 	void setDefaultSplashImage();
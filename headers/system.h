@@ -14,6 +14,49 @@ namespace System {
     uint32_t getTotalHeap();
     // Returns the about of heap memory currently allocated in bytes
     uint32_t getUsedHeap();
+    // Returns the most heap memory that has been claimed from the system in bytes
+    uint32_t getPeakHeap();
+    // Returns the amount of heap memory not currently allocated in bytes
+    uint32_t getFreeHeap();
+    // Returns the size of the largest heap block that can be allocated for sure in bytes
+    uint32_t getLargestFreeHeap();
+    // Starts a new heap high-water mark at the heap memory currently allocated
+    void resetHeapHighWater();
+    // Returns the most heap memory allocated at once since the high-water mark was last reset in bytes
+    uint32_t getHeapHighWater();
+
+    // Fills the unused part of a core's stack with a known pattern so its high-water mark can be measured
+    void paintStack(uint32_t core);
+    // Returns the size of a core's stack in bytes
+    uint32_t getStackSize(uint32_t core);
+    // Returns the deepest stack use of a core since its stack was painted in bytes
+    uint32_t getStackHighWater(uint32_t core);
+
+    // Stack and heap use of a core right after it finished its setup
+    struct BootMemory {
+        uint32_t stackHighWater;
+        uint32_t usedHeap;
+    };
+    void recordBootMemory(uint32_t core);
+    const BootMemory& getBootMemory(uint32_t core);
+
+    // Heap use attributed to a subsystem
+    enum class MemoryCategory : uint8_t {
+        JSON,   // ArduinoJson documents of the web config
+        LEDS,   // LED matrix and frame buffer, also part of the NeoPico LED add-on
+        ADDONS, // Add-on objects and what they allocate during setup
+        COUNT
+    };
+
+    struct MemoryCounter {
+        uint32_t allocations; // Number of allocations tracked so far
+        uint32_t current;     // Bytes currently allocated
+        uint32_t peak;        // Most bytes allocated at once
+    };
+
+    void trackAllocation(MemoryCategory category, uint32_t bytes);
+    void trackFree(MemoryCategory category, uint32_t bytes);
+    const MemoryCounter& getMemoryCounter(MemoryCategory category);
 
     enum class BootMode : uint32_t {
         DEFAULT = 0,
@@ -2,6 +2,18 @@
 
 #include <cstring>
 
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+
+// RDATA plus three result bytes, then WREG with the next channel
+#define SCAN_READ_BYTES 3
+// Time for the scan transfers at 400kHz with some slack, added to the conversion period without DRDY
+#define SCAN_TRANSFER_US 250
+
+static ADS1219* scanInstance = nullptr;
+
+static const uint8_t scanMux[ADS1219_SCAN_CHANNELS] = { MUX_SINGLE_0, MUX_SINGLE_1, MUX_SINGLE_2, MUX_SINGLE_3 };
+
 ADS1219::ADS1219(int bWire, int sda, int scl, i2c_inst_t *picoI2C, int32_t speed, uint8_t addr) {
   bbi2c.iSDA = sda;
   bbi2c.iSCL = scl;
@@ -11,6 +23,14 @@ ADS1219::ADS1219(int bWire, int sda, int scl, i2c_inst_t *picoI2C, int32_t speed
   address = addr;
   config = 0x00;
   singleShot = true;
+  dataRate = 20;
+  scanning = false;
+  drdyPin = -1;
+  scanChannel = 0;
+  readChannel = 0;
+  readPending = false;
+  scanResync = false;
+  scanValid = 0;
 }
 
 void ADS1219::begin() {
@@ -154,6 +174,7 @@ void ADS1219::setGain(adsGain_t gain){
 }
 
 void ADS1219::setDataRate(int rate){
+	dataRate = rate;
 	config &= DATA_RATE_MASK;
 	switch (rate){
     case (20):
@@ -211,3 +232,126 @@ void ADS1219::setChannel(int channel){
   }
   writeRegister(config);
 }
+
+// Continuous conversion scan. The DRDY edge (or timer) queues the whole exchange into the I2C TX FIFO:
+// RDATA, a repeated start reading the three result bytes with a stop, then WREG selecting the next channel.
+// WREG restarts the conversion, so the next DRDY edge signals a settled result of the new channel.
+// The I2C interrupt collects the result once the three bytes arrived, core0 only copies the latest values.
+bool ADS1219::startScan(int drdyPin){
+  if (!bbi2c.bWire || scanInstance != nullptr)
+    return false;
+
+  scanInstance = this;
+  this->drdyPin = drdyPin;
+  scanChannel = 0;
+  scanValid = 0;
+  readPending = false;
+  scanResync = false;
+
+  setConversionMode(CONTINUOUS);
+  setChannel(scanChannel);
+  start();
+
+  i2c_hw_t * hw = i2c_get_hw(bbi2c.picoI2C);
+  hw->enable = 0;
+  hw->tar = address;
+  hw->rx_tl = SCAN_READ_BYTES - 1;
+  hw->intr_mask = I2C_IC_INTR_MASK_M_RX_FULL_BITS | I2C_IC_INTR_MASK_M_TX_ABRT_BITS;
+  hw->enable = 1;
+
+  const uint irq = I2C0_IRQ + i2c_hw_index(bbi2c.picoI2C);
+  irq_set_exclusive_handler(irq, i2cIRQ);
+  irq_set_enabled(irq, true);
+
+  scanning = true;
+  if (drdyPin >= 0) {
+    gpio_init(drdyPin);
+    gpio_set_dir(drdyPin, GPIO_IN);
+    gpio_pull_up(drdyPin);
+    gpio_add_raw_irq_handler(drdyPin, drdyIRQ);
+    gpio_set_irq_enabled(drdyPin, GPIO_IRQ_EDGE_FALL, true);
+    irq_set_enabled(IO_IRQ_BANK0, true);
+  } else {
+    const int64_t periodUs = 1000000 / dataRate + 1000000 / dataRate / 4 + SCAN_TRANSFER_US;
+    add_repeating_timer_us(-periodUs, scanTimerCallback, this, &scanTimer);
+  }
+
+  return true;
+}
+
+bool ADS1219::getScanResults(uint32_t results[ADS1219_SCAN_CHANNELS]){
+  for (int i = 0; i < ADS1219_SCAN_CHANNELS; i++)
+    results[i] = scanResults[i];
+  return scanValid == (1 << ADS1219_SCAN_CHANNELS) - 1;
+}
+
+// Runs in interrupt context, never waits on the bus
+void ADS1219::queueScanRead(){
+  // The previous result is still on its way, this conversion gets skipped
+  if (readPending)
+    return;
+
+  i2c_hw_t * hw = i2c_get_hw(bbi2c.picoI2C);
+  if (scanResync) {
+    // A bus error flushed the FIFO, set the multiplexer again and read from the next conversion on
+    scanResync = false;
+    hw->data_cmd = CONFIG_REGISTER_ADDRESS;
+    hw->data_cmd = ((config & MUX_MASK) | scanMux[scanChannel]) | I2C_IC_DATA_CMD_STOP_BITS;
+    return;
+  }
+
+  readChannel = scanChannel;
+  readPending = true;
+  scanChannel = (scanChannel + 1) % ADS1219_SCAN_CHANNELS;
+  config = (config & MUX_MASK) | scanMux[scanChannel];
+
+  hw->data_cmd = 0x10; // RDATA
+  hw->data_cmd = I2C_IC_DATA_CMD_RESTART_BITS | I2C_IC_DATA_CMD_CMD_BITS;
+  hw->data_cmd = I2C_IC_DATA_CMD_CMD_BITS;
+  hw->data_cmd = I2C_IC_DATA_CMD_CMD_BITS | I2C_IC_DATA_CMD_STOP_BITS;
+  hw->data_cmd = CONFIG_REGISTER_ADDRESS; // Starts a new transfer after the stop
+  hw->data_cmd = config | I2C_IC_DATA_CMD_STOP_BITS;
+}
+
+void ADS1219::scanI2CIRQ(){
+  i2c_hw_t * hw = i2c_get_hw(bbi2c.picoI2C);
+  const uint32_t status = hw->intr_stat;
+
+  if (status & I2C_IC_INTR_STAT_R_TX_ABRT_BITS) {
+    (void)hw->clr_tx_abrt;
+    while (hw->rxflr > 0)
+      (void)hw->data_cmd;
+    readPending = false;
+    scanResync = true;
+    return;
+  }
+
+  if ((status & I2C_IC_INTR_STAT_R_RX_FULL_BITS) && hw->rxflr >= SCAN_READ_BYTES) {
+    uint32_t data32 = (hw->data_cmd & 0xFF) << 16;
+    data32 |= (hw->data_cmd & 0xFF) << 8;
+    data32 |= (hw->data_cmd & 0xFF);
+    if (data32 >= 0x800000)
+      data32 = data32 - 0x1000000; // Same sign handling as readConversionResult
+    scanResults[readChannel] = data32;
+    scanValid |= 1 << readChannel;
+    readPending = false;
+  }
+}
+
+void ADS1219::drdyIRQ(){
+  if (scanInstance == nullptr || !(gpio_get_irq_event_mask(scanInstance->drdyPin) & GPIO_IRQ_EDGE_FALL))
+    return;
+
+  gpio_acknowledge_irq(scanInstance->drdyPin, GPIO_IRQ_EDGE_FALL);
+  scanInstance->queueScanRead();
+}
+
+void ADS1219::i2cIRQ(){
+  if (scanInstance != nullptr)
+    scanInstance->scanI2CIRQ();
+}
+
+bool ADS1219::scanTimerCallback(repeating_timer_t* timer){
+  static_cast<ADS1219*>(timer->user_data)->queueScanRead();
+  return true;
+}
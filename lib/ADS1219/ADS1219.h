@@ -11,6 +11,9 @@
 #define _ADS1219_H_
 
 #include <BitBang_I2C.h>
+#include "pico/time.h"
+
+#define ADS1219_SCAN_CHANNELS 4
 
 #define CONFIG_REGISTER_ADDRESS 0x40
 #define STATUS_REGISTER_ADDRESS 0x24
@@ -99,6 +102,14 @@ class ADS1219  {
 	uint8_t readRegister(adsRegister_t reg);
   	void start();
 	uint32_t readConversionResult();
+
+	// Converts the single ended channels in turn without blocking, hardware I2C only and one device at a time.
+	// Each result is fetched and the multiplexer moved on from the DRDY falling edge, or from a timer running
+	// at the data rate when drdyPin is -1. The I2C block must not be used by anything else while scanning.
+	bool startScan(int drdyPin);
+	// Copies the latest result of every channel, returns false until each channel was read once
+	bool getScanResults(uint32_t results[ADS1219_SCAN_CHANNELS]);
+	bool isScanning() { return scanning; }
   private:
 	void writeRegister(uint8_t data);
 	
@@ -108,6 +119,23 @@ class ADS1219  {
 	bool singleShot;
 	int data_ready;
 	unsigned char uc[128];
+
+	void queueScanRead();
+	void scanI2CIRQ();
+	static void drdyIRQ();
+	static void i2cIRQ();
+	static bool scanTimerCallback(repeating_timer_t* timer);
+
+	int dataRate;
+	bool scanning;
+	int drdyPin;
+	repeating_timer_t scanTimer;
+	uint8_t scanChannel;                 // Channel the multiplexer is set to
+	volatile uint8_t readChannel;        // Channel of the result being read
+	volatile bool readPending;
+	volatile bool scanResync;            // Multiplexer state unknown after a bus error
+	volatile uint8_t scanValid;          // Channels read at least once
+	volatile uint32_t scanResults[ADS1219_SCAN_CHANNELS];
 };
 
 #endif
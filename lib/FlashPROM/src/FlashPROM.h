@@ -43,6 +43,18 @@ class FlashPROM
 				memcpy(&cache[index], &value, sizeof(T));
 		}
 
+		void getBytes(uint16_t const index, uint8_t *data, uint16_t size)
+		{
+			if ((index + size) <= EEPROM_SIZE_BYTES)
+				memcpy(data, &cache[index], size);
+		}
+
+		void setBytes(uint16_t const index, const uint8_t *data, uint16_t size)
+		{
+			if ((index + size) <= EEPROM_SIZE_BYTES)
+				memcpy(&cache[index], data, size);
+		}
+
 	private:
 		static uint8_t cache[EEPROM_SIZE_BYTES];
 };
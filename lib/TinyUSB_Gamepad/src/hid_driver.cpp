@@ -14,14 +14,64 @@
 // Magic byte sequence to enable PS button on PS3
 static const uint8_t magic_init_bytes[8] = {0x21, 0x26, 0x01, 0x07, 0x00, 0x00, 0x00, 0x00};
 
+static uint8_t hid_endpoint_in = 0;
+
 bool send_hid_report(uint8_t report_id, void *report, uint8_t report_size)
 {
+	// Reports without an ID are handed to the IN endpoint as-is, tud_hid_report would copy them into the class buffer first
+	if (report_id == 0 && hid_endpoint_in != 0)
+	{
+		if (!tud_ready() || usbd_edpt_busy(0, hid_endpoint_in))
+			return false;
+
+		usbd_edpt_claim(0, hid_endpoint_in);
+		bool sent = usbd_edpt_xfer(0, hid_endpoint_in, (uint8_t *)report, report_size);
+		usbd_edpt_release(0, hid_endpoint_in);
+		return sent;
+	}
+
 	if (tud_hid_ready())
 		return tud_hid_report(report_id, report, report_size);
 
 	return false;
 }
 
+void hid_reset(uint8_t rhport)
+{
+	hid_endpoint_in = 0;
+	hidd_reset(rhport);
+}
+
+uint16_t hid_open(uint8_t rhport, tusb_desc_interface_t const *itf_descriptor, uint16_t max_length)
+{
+	uint16_t driver_length = hidd_open(rhport, itf_descriptor, max_length);
+
+	// Remember the IN endpoint so reports can be sent from our own buffers
+	uint8_t const *current_descriptor = (uint8_t const *)itf_descriptor;
+	uint8_t const *end_descriptor = current_descriptor + driver_length;
+	while (current_descriptor < end_descriptor)
+	{
+		if (tu_desc_type(current_descriptor) == TUSB_DESC_ENDPOINT)
+		{
+			tusb_desc_endpoint_t const *endpoint_descriptor = (tusb_desc_endpoint_t const *)current_descriptor;
+			if (tu_edpt_dir(endpoint_descriptor->bEndpointAddress) == TUSB_DIR_IN)
+				hid_endpoint_in = endpoint_descriptor->bEndpointAddress;
+		}
+
+		current_descriptor = tu_desc_next(current_descriptor);
+	}
+
+	return driver_length;
+}
+
+bool hid_xfer_cb(uint8_t rhport, uint8_t ep_addr, xfer_result_t result, uint32_t xferred_bytes)
+{
+	if (ep_addr == hid_endpoint_in)
+		report_transfer_complete();
+
+	return hidd_xfer_cb(rhport, ep_addr, result, xferred_bytes);
+}
+
 bool hid_control_xfer_cb(uint8_t rhport, uint8_t stage, tusb_control_request_t const * request)
 {
 	if (
@@ -44,8 +94,8 @@ const usbd_class_driver_t hid_driver = {
 	.name = "HID",
 #endif
 	.init = hidd_init,
-	.reset = hidd_reset,
-	.open = hidd_open,
+	.reset = hid_reset,
+	.open = hid_open,
 	.control_xfer_cb = hid_control_xfer_cb,
-	.xfer_cb = hidd_xfer_cb,
+	.xfer_cb = hid_xfer_cb,
 	.sof = NULL};
\ No newline at end of file
@@ -12,3 +12,6 @@
 extern const usbd_class_driver_t hid_driver;
 
 bool send_hid_report(uint8_t report_id, void *report, uint8_t report_size);
+void hid_reset(uint8_t rhport);
+uint16_t hid_open(uint8_t rhport, tusb_desc_interface_t const *itf_descriptor, uint16_t max_length);
+bool hid_xfer_cb(uint8_t rhport, uint8_t ep_addr, xfer_result_t result, uint32_t xferred_bytes);
@@ -0,0 +1,178 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#include "ps4_auth.h"
+
+#include "CRC32.h"
+
+// Alternative version
+static constexpr uint8_t output_0x03[] = {
+	0x21, 0x27, 0x04, 0xcf, 0x00, 0x2c, 0x56,
+    0x08, 0x00, 0x3d, 0x00, 0xe8, 0x03, 0x04, 0x00,
+    0xff, 0x7f, 0x0d, 0x0d, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+// Passinglink version
+/*static constexpr uint8_t output_0x03[] = {
+	0x21, 0x27, 0x4, 0x40, 0x7, 0x2c, 0x56, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+	0x0, 0x0,  0xd,  0xd, 0x0,  0x0, 0x0,  0x0,  0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+	0x0, 0x0,  0x0,  0x0, 0x0,  0x0, 0x0,  0x0,  0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0
+};*/
+
+// Nonce Page Size: 0x38 (56)
+// Response Page Size: 0x38 (56)
+static constexpr uint8_t output_0xf3[] = { 0x0, 0x38, 0x38, 0, 0, 0, 0 };
+
+static uint8_t cur_nonce_id = 1;
+static uint8_t received_nonce_pages = 0; // Bit per nonce page received for cur_nonce_id
+
+static uint8_t send_nonce_part = 0;
+
+static void reset_auth()
+{
+	PS4Data::getInstance().ps4State = PS4State::no_nonce;
+	received_nonce_pages = 0;
+	send_nonce_part = 0;
+}
+
+ssize_t get_ps4_report(uint8_t report_id, uint8_t * buf, uint16_t reqlen)
+{
+	uint8_t data[64] = {};
+	uint32_t crc32;
+	switch(report_id) {
+		// Not sure on 0x03? maybe a controller qualifier
+		case PS4AuthReport::PS4_UNKNOWN_0X03:
+			if (reqlen != sizeof(output_0x03)) {
+				return -1;
+			}
+			memcpy(buf, output_0x03, reqlen);
+			return reqlen;
+		// Use our private RSA key to sign the nonce and return chunks
+		case PS4AuthReport::PS4_GET_SIGNATURE_NONCE:
+			// We send 56 byte chunks back to the PS4, we've already calculated these
+			data[0] = 0xF1;
+			data[1] = cur_nonce_id;    // nonce_id
+			data[2] = send_nonce_part; // next_part
+			data[3] = 0;
+
+			// The response is only valid once signed, never page out a half written buffer
+			if (PS4Data::getInstance().ps4State != PS4State::signed_nonce_ready) {
+				return -1;
+			}
+
+			// 56 byte chunks
+			memcpy(&data[4], &PS4Data::getInstance().ps4_auth_buffer[send_nonce_part*PS4_AUTH_PAGE_SIZE], PS4_AUTH_PAGE_SIZE);
+
+			// calculate the CRC32 of the buffer and write it back
+			crc32 = CRC32::calculate(data, 60);
+			memcpy(&data[60], &crc32, sizeof(uint32_t));
+			memcpy(buf, &data[1], 63); // move data over to buffer
+			if ( (++send_nonce_part) == PS4_RESPONSE_PAGES ) {
+				reset_auth();
+				PS4Data::getInstance().authsent = true;
+			}
+			return 63;
+		// Are we ready to sign?
+		case PS4AuthReport::PS4_GET_SIGNING_STATE:
+      		data[0] = 0xF2;
+			data[1] = cur_nonce_id;
+			data[2] = PS4Data::getInstance().ps4State == PS4State::signed_nonce_ready ? 0 : 16; // 0 means auth is ready, 16 means we're still signing
+			memset(&data[3], 0, 9);
+			crc32 = CRC32::calculate(data, 12);
+			memcpy(&data[12], &crc32, sizeof(uint32_t));
+			memcpy(buf, &data[1], 15); // move data over to buffer
+			return 15;
+		case PS4AuthReport::PS4_RESET_AUTH: // Reset the Authentication
+			if (reqlen != sizeof(output_0xf3)) {
+				return -1;
+			}
+			memcpy(buf, output_0xf3, reqlen);
+			reset_auth();
+			return reqlen;
+		default:
+			break;
+	};
+	return -1;
+}
+
+void set_ps4_report(uint8_t report_id, uint8_t const * data, uint16_t reqlen)
+{
+	uint8_t nonce_id;
+	uint8_t nonce_page;
+	uint32_t crc32;
+	uint8_t buffer[64];
+	uint8_t nonce[56]; // max nonce data
+	uint16_t noncelen;
+	uint16_t buflen;
+
+	if (report_id == PS4AuthReport::PS4_SET_AUTH_PAYLOAD) {
+		if (reqlen != 63 ) {
+			return;
+		}
+
+		// Setup CRC32 buffer
+		buffer[0] = report_id;
+		memcpy(&buffer[1], data, reqlen);
+		buflen = reqlen + 1;
+
+		nonce_id = data[0];
+		nonce_page = data[1];
+		// data[2] is zero padding
+
+		// The CRC is not word aligned in the buffer, so it has to be copied out
+		uint32_t received_crc32;
+		memcpy(&received_crc32, &buffer[buflen-sizeof(uint32_t)], sizeof(uint32_t));
+		crc32 = CRC32::calculate(buffer, buflen-sizeof(uint32_t));
+		if ( crc32 != received_crc32 ) {
+			return; // CRC32 failed on set report
+		}
+
+		// 256 byte nonce, with 56 byte packets leaves 24 extra bytes on the last packet?
+		if ( nonce_page == PS4_NONCE_PAGES - 1 ) {
+			// Copy/append data from buffer[4:64-28] into our nonce
+			noncelen = 32; // from 4 to 64 - 24 - 4
+		} else {
+			// Copy/append data from buffer[4:64-4] into our nonce
+			noncelen = 56;
+			// from 4 to 64 - 4
+		}
+
+		memcpy(nonce, &buffer[4], noncelen);
+		save_nonce(nonce_id, nonce_page, nonce, noncelen);
+	}
+}
+
+void save_nonce(uint8_t nonce_id, uint8_t nonce_page, uint8_t * buffer, uint16_t buflen) {
+	if ( nonce_page >= PS4_NONCE_PAGES || ((size_t)nonce_page*PS4_AUTH_PAGE_SIZE + buflen) > sizeof(PS4Data::getInstance().nonce_buffer) ) {
+		reset_auth();
+		return; // page outside of the nonce buffer
+	}
+
+	if ( nonce_page == 0 ) {
+		// A new nonce restarts the exchange, including a response that was still being paged out
+		reset_auth();
+		cur_nonce_id = nonce_id;
+		PS4Data::getInstance().ps4State = PS4State::receiving_nonce;
+	} else if ( nonce_id != cur_nonce_id ) {
+		reset_auth();
+		return; // setting nonce with mismatched id
+	}
+
+	memcpy(&PS4Data::getInstance().nonce_buffer[nonce_page*PS4_AUTH_PAGE_SIZE], buffer, buflen);
+	received_nonce_pages |= (1 << nonce_page);
+
+	if ( nonce_page == PS4_NONCE_PAGES - 1 ) {
+		// Only sign once every page made it, otherwise parts of an older nonce would be signed
+		if ( received_nonce_pages == (1 << PS4_NONCE_PAGES) - 1 ) {
+			PS4Data::getInstance().nonceGeneration++;
+			PS4Data::getInstance().ps4State = PS4State::nonce_ready;
+		} else {
+			reset_auth();
+		}
+	}
+}
@@ -0,0 +1,86 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * SPDX-FileCopyrightText: Copyright (c) 2021 Jason Skuby (mytechtoybox.com)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <sys/types.h>
+
+// PS4 authentication feature reports, kept apart from the USB driver so the exchange can run on a host
+
+// The 256 byte nonce arrives in 5 pages of 56 bytes (the last one only holds 32),
+// the 1064 byte response goes back in 19 pages of 56 bytes
+#define PS4_AUTH_PAGE_SIZE 56
+#define PS4_NONCE_PAGES 5
+#define PS4_RESPONSE_PAGES 19
+
+typedef enum
+{
+	PS4_UNKNOWN_0X03         = 0x03,    // Unknown (PS4 Report 0x03)
+	PS4_SET_AUTH_PAYLOAD     = 0xF0,    // Set Auth Payload
+	PS4_GET_SIGNATURE_NONCE  = 0xF1,    // Get Signature Nonce
+	PS4_GET_SIGNING_STATE    = 0xF2,    // Get Signing State
+	PS4_RESET_AUTH           = 0xF3     // Unknown (PS4 Report 0xF3)
+} PS4AuthReport;
+
+ssize_t get_ps4_report(uint8_t report_id, uint8_t * buf, uint16_t reqlen);
+void set_ps4_report(uint8_t report_id, uint8_t const * buf, uint16_t reqlen);
+void save_nonce(uint8_t nonce_id, uint8_t nonce_page, uint8_t * data, uint16_t size);
+
+typedef enum {
+	no_nonce = 0,
+	receiving_nonce = 1,
+	nonce_ready = 2,
+	signed_nonce_ready = 3
+} PS4State;
+
+typedef struct {
+	uint32_t count;       // Nonces signed since boot
+	uint32_t lastTime;    // Time from receiving the last nonce to its signature being ready in microseconds
+	uint32_t lastCpuTime; // Part of lastTime actually spent signing in microseconds
+	uint32_t maxStall;    // Longest single loop iteration spent signing in microseconds
+} PS4SigningStats;
+
+// Storage manager for board, LED options, and thread-safe settings
+class PS4Data {
+public:
+	PS4Data(PS4Data const&) = delete;
+	void operator=(PS4Data const&)  = delete;
+	static PS4Data& getInstance() // Thread-safe storage ensures cross-thread talk
+	{
+		static PS4Data instance;
+		return instance;
+	}
+
+	PS4State ps4State;
+	bool authsent;
+	uint8_t nonce_buffer[256];
+	// Bumped whenever a complete nonce arrives, so a signature started on an older nonce is never published
+	volatile uint32_t nonceGeneration;
+
+	// Send back in 56 byte chunks:
+	//    256 byte - nonce signature
+	//    16 byte  - ps4 serial
+	//    256 byte - RSA N
+	//    256 byte - RSA E
+	//    256 byte - ps4 signature
+	//    24 byte  - zero padding
+
+	// buffer = 256 + 16 + 256 + 256 + 256 + 24
+	// == 1064 bytes (almost 1 kb)
+	uint8_t ps4_auth_buffer[1064];
+
+	PS4SigningStats signingStats;
+private:
+	PS4Data() {
+		ps4State = PS4State::no_nonce;
+		authsent = false;
+		nonceGeneration = 0;
+		memset(nonce_buffer, 0, 256);
+		memset(ps4_auth_buffer, 0, 1064);
+		memset(&signingStats, 0, sizeof(signingStats));
+	}
+};
@@ -5,6 +5,9 @@
 
 #include <stdint.h>
 
+#include "pico/platform.h"
+#include "hardware/timer.h"
+
 #include "tusb_config.h"
 #include "tusb.h"
 #include "class/hid/hid.h"
@@ -22,6 +25,28 @@ UsbMode usb_mode = USB_MODE_HID;
 InputMode input_mode = INPUT_MODE_XINPUT;
 bool usb_mounted = false;
 
+// IN reports are double buffered: the encoder writes straight into the back buffer while the front
+// buffer holds the last report handed to the endpoint, which doubles as the change detection reference.
+static uint8_t report_buffers[2][CFG_TUD_ENDPOINT0_SIZE] __attribute__((aligned(4))) = { };
+static uint8_t report_back = 0;
+static bool report_forced = true;
+
+#define REPORT_STATS_MAGIC 0x55534253 // "USBS"
+
+static UsbReportStats report_stats = { };
+static uint32_t last_transfer_complete_us = 0;
+static uint32_t last_transfer_submit_us = 0;
+static uint32_t pending_edge_us = 0;
+static bool edge_pending = false;
+
+// A report submitted this soon after the previous transfer completed kept the endpoint busy,
+// well under the 1ms minimum polling interval and a few iterations of the report loop
+#define REPORT_BUSY_SLACK_US 250
+
+// Kept in RAM that is not cleared on boot, so the counters of a gamepad session survive the reboot into web config
+static UsbReportStats __uninitialized_ram(saved_report_stats);
+static uint32_t __uninitialized_ram(saved_report_stats_magic);
+
 InputMode get_input_mode(void)
 {
 	return input_mode;
@@ -35,6 +60,7 @@ bool get_usb_mounted(void)
 void initialize_driver(InputMode mode)
 {
 	input_mode = mode;
+	report_stats.inputMode = mode;
 	if (mode == INPUT_MODE_CONFIG)
 		usb_mode = USB_MODE_NET;
 
@@ -50,14 +76,40 @@ void receive_report(uint8_t *buffer)
 	}
 }
 
-void send_report(void *report, uint16_t report_size)
+void init_report_buffers(const void *report, uint16_t report_size)
+{
+	memcpy(report_buffers[0], report, report_size);
+	memcpy(report_buffers[1], report, report_size);
+	report_back = 0;
+	report_forced = true;
+}
+
+uint8_t *get_report_buffer(void)
+{
+	return report_buffers[report_back];
+}
+
+void report_input_edges(uint32_t first_edge_us, uint16_t count)
 {
-	static uint8_t previous_report[CFG_TUD_ENDPOINT0_SIZE] = { };
+	report_stats.inputEdges += count;
+
+	// A report the endpoint was too busy for still owes the older change
+	if (!edge_pending)
+	{
+		pending_edge_us = first_edge_us;
+		edge_pending = true;
+	}
+}
 
+void send_report(void *report, uint16_t report_size)
+{
 	if (tud_suspended())
 		tud_remote_wakeup();
 
-	if (memcmp(previous_report, report, report_size) != 0)
+	report_stats.generated++;
+
+	const uint8_t *previous_report = report_buffers[report_back ^ 1];
+	if (report_forced || memcmp(previous_report, report, report_size) != 0)
 	{
 		bool sent = false;
 		switch (input_mode)
@@ -71,9 +123,78 @@ void send_report(void *report, uint16_t report_size)
 				break;
 		}
 
+		// The endpoint was idle, so the old front buffer is no longer owned by a transfer and becomes the back buffer
+		if (sent && report == report_buffers[report_back])
+		{
+			report_back ^= 1;
+			report_forced = false;
+		}
+
 		if (sent)
-			memcpy(previous_report, report, report_size);
+		{
+			report_stats.sent++;
+			last_transfer_submit_us = time_us_32();
+
+			if (edge_pending)
+			{
+				const uint32_t latency = last_transfer_submit_us - pending_edge_us;
+				report_stats.inputLatency = report_stats.inputLatency == 0
+					? latency
+					: (report_stats.inputLatency * 7 + latency) / 8;
+				if (latency > report_stats.inputLatencyMax)
+					report_stats.inputLatencyMax = latency;
+				edge_pending = false;
+			}
+		}
+		else
+		{
+			report_stats.busy++;
+		}
+	}
+	else
+	{
+		// The change did not reach the report, e.g. an unmapped pin or a bounce the debouncer held back
+		edge_pending = false;
+		report_stats.deduplicated++;
+	}
+}
+
+void report_transfer_complete(void)
+{
+	const uint32_t now = time_us_32();
+
+	// Only a transfer submitted right after the previous one completed was paced by the host,
+	// otherwise the gap also holds the time the endpoint sat idle with nothing to send
+	if (last_transfer_complete_us != 0 && last_transfer_submit_us - last_transfer_complete_us < REPORT_BUSY_SLACK_US)
+	{
+		const uint32_t interval = now - last_transfer_complete_us;
+		report_stats.pollInterval = report_stats.pollInterval == 0
+			? interval
+			: (report_stats.pollInterval * 7 + interval) / 8;
+
+		if (report_stats.pollIntervalMin == 0 || interval < report_stats.pollIntervalMin)
+			report_stats.pollIntervalMin = interval;
 	}
+
+	report_stats.completed++;
+	last_transfer_complete_us = now;
+}
+
+const UsbReportStats *get_report_stats(void)
+{
+	return &report_stats;
+}
+
+void save_report_stats(void)
+{
+	report_stats.ps4Signing = PS4Data::getInstance().signingStats;
+	saved_report_stats = report_stats;
+	saved_report_stats_magic = REPORT_STATS_MAGIC;
+}
+
+const UsbReportStats *get_saved_report_stats(void)
+{
+	return saved_report_stats_magic == REPORT_STATS_MAGIC ? &saved_report_stats : NULL;
 }
 
 /* USB Driver Callback (Required for XInput) */
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "gamepad/GamepadDescriptors.h"
+#include "ps4_driver.h"
 
 typedef enum
 {
@@ -13,9 +14,33 @@ typedef enum
 	USB_MODE_NET,
 } UsbMode;
 
+typedef struct
+{
+	uint32_t generated;       // Reports produced by the gamepad
+	uint32_t sent;            // Reports handed to the IN endpoint
+	uint32_t deduplicated;    // Reports skipped because nothing changed since the last one sent
+	uint32_t busy;            // Reports dropped because the IN endpoint was busy or not ready
+	uint32_t completed;       // IN transfers the host has picked up
+	uint32_t pollInterval;    // Smoothed host polling interval in microseconds, 0 until measured
+	uint32_t pollIntervalMin; // Shortest host polling interval seen in microseconds, 0 until measured
+	uint32_t inputEdges;      // Input changes the scanner picked up, 0 when the pins are read directly
+	uint32_t inputLatency;    // Smoothed time from an input change to the report carrying it being sent in microseconds
+	uint32_t inputLatencyMax; // Longest time from an input change to its report being sent in microseconds
+	InputMode inputMode;      // Class driver the counters were collected with
+	PS4SigningStats ps4Signing;
+} UsbReportStats;
+
 InputMode get_input_mode(void);
 bool get_usb_mounted(void);
 void initialize_driver(InputMode mode);
 void receive_report(uint8_t *buffer);
+void init_report_buffers(const void *report, uint16_t report_size);
+uint8_t *get_report_buffer(void);
 void send_report(void *report, uint16_t report_size);
+void report_transfer_complete(void);
+// Input changes from first_edge_us on are carried by the next report that is sent
+void report_input_edges(uint32_t first_edge_us, uint16_t count);
+const UsbReportStats *get_report_stats(void);
+void save_report_stats(void);
+const UsbReportStats *get_saved_report_stats(void);
 
@@ -4,6 +4,7 @@
  */
 
 #include "xinput_driver.h"
+#include "usb_driver.h"
 
 uint8_t endpoint_in = 0;
 uint8_t endpoint_out = 0;
@@ -101,6 +102,8 @@ static bool xinput_xfer_callback(uint8_t rhport, uint8_t ep_addr, xfer_result_t
 
 	if (ep_addr == endpoint_out)
 		usbd_edpt_xfer(0, endpoint_out, xinput_out_buffer, XINPUT_OUT_SIZE);
+	else if (ep_addr == endpoint_in)
+		report_transfer_complete();
 
 	return true;
 }
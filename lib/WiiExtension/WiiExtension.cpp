@@ -660,6 +660,7 @@ void WiiExtension::poll() {
             extensionType = WII_EXTENSION_NONE;
             reset();
             start();
+            if (extensionType != WII_EXTENSION_NONE) reconnects++;
         }
     } else {
         reset();
@@ -694,13 +695,15 @@ uint16_t WiiExtension::calibrate(uint16_t pos, uint16_t min, uint16_t max, uint1
 }
 
 int WiiExtension::doI2CWrite(uint8_t *pData, int iLen) {
-    int result = i2c_write_blocking(picoI2C, address, pData, iLen, false);
+    int result = i2c_write_timeout_us(picoI2C, address, pData, iLen, false, WII_EXTENSION_TIMEOUT * 1000);
+    if (result == PICO_ERROR_TIMEOUT) timeouts++;
     waitUntil_us(WII_EXTENSION_DELAY);
     return result;
 }
 
 int WiiExtension::doI2CRead(uint8_t *pData, int iLen) {
-    int result = i2c_read_blocking(picoI2C, address, pData, iLen, false);
+    int result = i2c_read_timeout_us(picoI2C, address, pData, iLen, false, WII_EXTENSION_TIMEOUT * 1000);
+    if (result == PICO_ERROR_TIMEOUT) timeouts++;
     waitUntil_us(WII_EXTENSION_DELAY);
     return result;
 }
@@ -56,6 +56,7 @@
 #define WII_EXTENSION_DELAY 300
 #endif
 
+// Longest a single I2C transfer may take in milliseconds before it is abandoned
 #ifndef WII_EXTENSION_TIMEOUT
 #define WII_EXTENSION_TIMEOUT 2
 #endif
@@ -137,6 +138,10 @@ class WiiExtension {
 
     bool isReady         = false;
 
+    // Diagnostics
+    uint32_t timeouts    = 0; // I2C transfers abandoned after WII_EXTENSION_TIMEOUT
+    uint32_t reconnects  = 0; // Extensions detected again after a failed poll
+
     // Constructor 
 	WiiExtension(int sda, int scl, i2c_inst_t *i2cCtl, int32_t speed, uint8_t addr);
 
@@ -48,9 +48,18 @@
 
 #define TCP_MSS                         (1500 /*mtu*/ - 20 /*iphdr*/ - 20 /*tcphhr*/)
 #define TCP_SND_BUF                     (2 * TCP_MSS)
+// Room for the httpd read buffer of a dynamic file plus the copy tcp_write makes of it
+#define MEM_SIZE                        (2 * TCP_SND_BUF)
 
 #define ETHARP_SUPPORT_STATIC_ENTRIES   1
 
+// Enough connections for the parallel fetches of the web configurator, idle keep-alive connections
+// are dropped when a new one does not fit
+#define MEMP_NUM_TCP_PCB                8
+#define HTTPD_USE_MEM_POOL              1
+#define MEMP_NUM_PARALLEL_HTTPD_CONNS   MEMP_NUM_TCP_PCB
+#define LWIP_HTTPD_KILL_OLD_ON_CONNECTIONS_EXCEEDED 1
+
 #define LWIP_HTTPD_CGI                  0
 #define LWIP_HTTPD_SSI                  0
 #define LWIP_HTTPD_CGI_SSI              0
@@ -58,8 +67,10 @@
 #define LWIP_HTTPD_CUSTOM_FILES         1
 #define LWIP_HTTPD_SUPPORT_POST         1
 #define LWIP_HTTPD_SUPPORT_V09          0
-#define LWIP_HTTPD_SUPPORT_11_KEEPALIVE 0 // Causes lockups with CGI requests
+#define LWIP_HTTPD_SUPPORT_11_KEEPALIVE 1 // Needs Content-Length and FS_FILE_FLAGS_HEADER_PERSISTENT on every file
 #define LWIP_HTTPD_ABORT_ON_CLOSE_MEM_ERROR 1
+#define LWIP_HTTPD_DYNAMIC_FILE_READ    1 // API responses are serialized in chunks through fs_read_custom
+#define LWIP_HTTPD_FS_ASYNC_READ        1 // Lets event streams wait for new data without closing
 
 #define LWIP_SINGLE_NETIF               1
 
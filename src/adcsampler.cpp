@@ -0,0 +1,140 @@
+#include "adcsampler.h"
+
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "pico/platform.h"
+
+#define ADC_PIN_FIRST 26
+#define ADC_PIN_LAST 29
+#define ADC_TEMPERATURE_INPUT 4
+#define ADC_MAX ((1 << 12) - 1)
+#define ADC_CLOCK_HZ 48000000
+
+static_assert((ADC_SAMPLER_OVERSAMPLING & (ADC_SAMPLER_OVERSAMPLING - 1)) == 0, "Oversampling must be a power of two");
+static_assert(ADC_SAMPLER_OVERSAMPLING * 4 <= ADC_SAMPLER_BUFFER_SIZE / 2, "Oversampling window must fit in half the ring");
+static_assert((ADC_SAMPLER_BUFFER_SIZE & (ADC_SAMPLER_BUFFER_SIZE - 1)) == 0, "Ring size must be a power of two");
+
+// DMA rings wrap on an address boundary of their own size
+static uint16_t sampleBuffer[ADC_SAMPLER_BUFFER_SIZE] __attribute__((aligned(ADC_SAMPLER_BUFFER_SIZE * sizeof(uint16_t))));
+// Reloaded into the data channel by the control channel every time the ring has been filled
+static uint32_t sampleTransferCount = ADC_SAMPLER_BUFFER_SIZE;
+
+bool AdcSampler::addPin(uint8_t pin) {
+	if (running || pin < ADC_PIN_FIRST || pin > ADC_PIN_LAST)
+		return false;
+
+	adc_gpio_init(pin);
+	inputMask |= 1 << (pin - ADC_PIN_FIRST);
+	return true;
+}
+
+void AdcSampler::start() {
+	if (running || inputMask == 0)
+		return;
+
+	// The ring only stays in step with the round robin if the number of inputs divides its size,
+	// three pins are padded with the otherwise unused temperature sensor input
+	uint8_t roundRobinMask = inputMask;
+	slotCount = 0;
+	for (uint8_t input = 0; input < ADC_SAMPLER_INPUTS; input++) {
+		if (roundRobinMask & (1 << input))
+			slotInputs[slotCount++] = input;
+	}
+	if (slotCount == 3) {
+		roundRobinMask |= 1 << ADC_TEMPERATURE_INPUT;
+		slotInputs[slotCount++] = ADC_TEMPERATURE_INPUT;
+	}
+
+	dataChannel = dma_claim_unused_channel(false);
+	controlChannel = dma_claim_unused_channel(false);
+	if (dataChannel < 0 || controlChannel < 0) {
+		// Without DMA the pins are read one conversion at a time in update()
+		if (dataChannel >= 0)
+			dma_channel_unclaim(dataChannel);
+		if (controlChannel >= 0)
+			dma_channel_unclaim(controlChannel);
+		dataChannel = controlChannel = -1;
+		running = true;
+		return;
+	}
+
+	adc_select_input(slotInputs[0]);
+	adc_set_round_robin(slotCount > 1 ? roundRobinMask : 0);
+	adc_fifo_setup(true, true, 1, false, false);
+	adc_set_clkdiv((float)ADC_CLOCK_HZ / ADC_SAMPLER_RATE - 1.0f);
+	adc_fifo_drain();
+
+	dma_channel_config dataConfig = dma_channel_get_default_config(dataChannel);
+	channel_config_set_transfer_data_size(&dataConfig, DMA_SIZE_16);
+	channel_config_set_read_increment(&dataConfig, false);
+	channel_config_set_write_increment(&dataConfig, true);
+	channel_config_set_ring(&dataConfig, true, __builtin_ctz(sizeof(sampleBuffer)));
+	channel_config_set_dreq(&dataConfig, DREQ_ADC);
+	channel_config_set_chain_to(&dataConfig, controlChannel);
+	dma_channel_configure(dataChannel, &dataConfig, sampleBuffer, &adc_hw->fifo, ADC_SAMPLER_BUFFER_SIZE, false);
+
+	dma_channel_config controlConfig = dma_channel_get_default_config(controlChannel);
+	channel_config_set_transfer_data_size(&controlConfig, DMA_SIZE_32);
+	channel_config_set_read_increment(&controlConfig, false);
+	channel_config_set_write_increment(&controlConfig, false);
+	dma_channel_configure(controlChannel, &controlConfig, &dma_hw->ch[dataChannel].al1_transfer_count_trig,
+		&sampleTransferCount, 1, false);
+
+	dma_channel_start(dataChannel);
+	adc_run(true);
+	running = true;
+
+	// Wait for the first oversampling window so the first values are not read from an empty ring
+	while (dma_channel_hw_addr(dataChannel)->transfer_count > (uint32_t)(ADC_SAMPLER_BUFFER_SIZE - ADC_SAMPLER_OVERSAMPLING * slotCount))
+		tight_loop_contents();
+}
+
+void AdcSampler::update() {
+	if (!running)
+		return;
+
+	if (dataChannel < 0) {
+		updateBlocking();
+		return;
+	}
+
+	// Only samples before the one DMA writes next are complete, the ring holds the older ones
+	const uint32_t writeIndex = (dma_channel_hw_addr(dataChannel)->write_addr - (uintptr_t)sampleBuffer) / sizeof(uint16_t);
+	uint32_t sums[4] = {};
+	for (uint32_t i = 1; i <= ADC_SAMPLER_OVERSAMPLING * slotCount; i++) {
+		const uint32_t index = (writeIndex - i) & (ADC_SAMPLER_BUFFER_SIZE - 1);
+		sums[index % slotCount] += sampleBuffer[index];
+	}
+
+	for (uint8_t slot = 0; slot < slotCount; slot++) {
+		if (inputMask & (1 << slotInputs[slot]))
+			filter(slotInputs[slot], ((uint64_t)sums[slot] * 0xFFFF) / (ADC_MAX * ADC_SAMPLER_OVERSAMPLING));
+	}
+	primed = true;
+}
+
+void AdcSampler::updateBlocking() {
+	for (uint8_t slot = 0; slot < slotCount; slot++) {
+		if (inputMask & (1 << slotInputs[slot])) {
+			adc_select_input(slotInputs[slot]);
+			filter(slotInputs[slot], (adc_read() * 0xFFFF) / ADC_MAX);
+		}
+	}
+	primed = true;
+}
+
+void AdcSampler::filter(uint8_t input, uint16_t value) {
+	Channel& channel = channels[input];
+	const uint32_t target = (uint32_t)value << 8;
+	if (!primed)
+		channel.filtered = target;
+	else
+		channel.filtered = (int32_t)channel.filtered + (((int32_t)target - (int32_t)channel.filtered) >> ADC_SAMPLER_FILTER_SHIFT);
+	channel.value = channel.filtered >> 8;
+}
+
+uint16_t AdcSampler::getValue(uint8_t pin) const {
+	if (pin < ADC_PIN_FIRST || pin > ADC_PIN_LAST)
+		return 0;
+	return channels[pin - ADC_PIN_FIRST].value;
+}
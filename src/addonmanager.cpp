@@ -1,9 +1,17 @@
 #include "addonmanager.h"
+#include "system.h"
+
+#include <malloc.h>
 
 void AddonManager::LoadAddon(GPAddon* addon, ADDON_PROCESS processAt) {
     if (addon->available()) {
         AddonBlock * block = new AddonBlock;
+        const uint32_t heapBefore = System::getUsedHeap();
 		addon->setup();
+        const uint32_t heapAfter = System::getUsedHeap();
+        // The other core may allocate at the same time during boot, so the setup share is an estimate
+        const uint32_t setupHeap = heapAfter > heapBefore ? heapAfter - heapBefore : 0;
+        System::trackAllocation(System::MemoryCategory::ADDONS, malloc_usable_size(addon) + sizeof(AddonBlock) + setupHeap);
         block->ptr = addon;
         block->process = processAt;
         addons.push_back(block);
@@ -1,11 +1,6 @@
 #include "addons/analog.h"
 #include "storagemanager.h"
-
-#include "hardware/adc.h"
-
-#define ADC_MAX ((1 << 12) - 1)
-#define ANALOG_CENTER 0.5f // 0.5f is center
-#define ANALOG_DEADZONE 0.05f // move to config (future release)
+#include "adcsampler.h"
 
 bool AnalogInput::available() {
     const AddonOptions& options = Storage::getInstance().getAddonOptions();
@@ -15,32 +10,32 @@ bool AnalogInput::available() {
 }
 
 void AnalogInput::setup() {
+    const AddonOptions& options = Storage::getInstance().getAddonOptions();
+
     // Make sure GPIO is high-impedance, no pullups etc
     if ( analogAdcPinX != (uint8_t)-1 )
-        adc_gpio_init(analogAdcPinX);
+        AdcSampler::getInstance().addPin(analogAdcPinX);
     if ( analogAdcPinY != (uint8_t)-1)
-        adc_gpio_init(analogAdcPinY);
+        AdcSampler::getInstance().addPin(analogAdcPinY);
+
+    conditioner.setCalibration(options.analogCalibration);
+    conditioner.setDeadzone(options.analogDeadzoneMode, options.analogDeadzone);
+    conditioner.setCurve(options.analogCurve);
 }
 
 void AnalogInput::process()
 {
     Gamepad * gamepad = Storage::getInstance().GetGamepad();
-    float adc_x = ANALOG_CENTER;
-    float adc_y = ANALOG_CENTER;
-    if ( analogAdcPinX != (uint8_t)-1) {
-        adc_select_input(analogAdcPinX-26); // ANALOG-X
-        adc_x = ((float)adc_read())/ADC_MAX;
-    }
-    if ( analogAdcPinY != (uint8_t)-1) {
-        adc_select_input(analogAdcPinY-26); // ANALOG-Y
-        adc_y = ((float)adc_read())/ADC_MAX;
-    }
-    if ( abs(adc_x - ANALOG_CENTER) < ANALOG_DEADZONE ) // deadzones
-        adc_x = ANALOG_CENTER;
-    if ( abs(adc_y - ANALOG_CENTER) < ANALOG_DEADZONE ) // deadzones
-        adc_y = ANALOG_CENTER;
+    const AdcSampler& adcSampler = AdcSampler::getInstance();
+    const AnalogStickCalibration& calibration = Storage::getInstance().getAddonOptions().analogCalibration;
+
+    // A missing pin reads as an axis at rest
+    uint16_t rawX = calibration.x.center;
+    uint16_t rawY = calibration.y.center;
+    if ( analogAdcPinX != (uint8_t)-1)
+        rawX = adcSampler.getValue(analogAdcPinX); // ANALOG-X
+    if ( analogAdcPinY != (uint8_t)-1)
+        rawY = adcSampler.getValue(analogAdcPinY); // ANALOG-Y
 
-    // Convert to 16-bit value
-    gamepad->state.lx = (uint16_t)(65535.0f*adc_x);
-    gamepad->state.ly = (uint16_t)(65535.0f*adc_y);
+    conditioner.process(rawX, rawY, gamepad->state.lx, gamepad->state.ly);
 }
@@ -34,11 +34,8 @@ void DualDirectionalInput::setup() {
     dDebState = 0;
     dualState = 0;
 
-    lastGPUD = DIRECTION_NONE;
-	lastGPLR = DIRECTION_NONE;
-
-    lastDualUD = DIRECTION_NONE;
-    lastDualLR = DIRECTION_NONE;
+    gamepadCleaner.reset();
+    dualCleaner.reset();
 
     uint32_t now = getMillis();
     for(int i = 0; i < 4; i++) {
@@ -66,19 +63,18 @@ void DualDirectionalInput::preprocess()
 {
     Gamepad * gamepad = Storage::getInstance().GetGamepad();
 
- 	// Need to invert since we're using pullups
     dualState = 0;
     if ( pinDualDirUp != (uint8_t)-1 ) {
-        dualState |= (!gpio_get(pinDualDirUp) ? gamepad->mapDpadUp->buttonMask : 0);
+        dualState |= (gamepad->gpio.isPressed(pinDualDirUp) ? gamepad->mapDpadUp->buttonMask : 0);
     }
     if ( pinDualDirDown != (uint8_t)-1 ) {
-        dualState |= (!gpio_get(pinDualDirDown) ? gamepad->mapDpadDown->buttonMask : 0);
+        dualState |= (gamepad->gpio.isPressed(pinDualDirDown) ? gamepad->mapDpadDown->buttonMask : 0);
     }
     if ( pinDualDirLeft != (uint8_t)-1 ) {
-        dualState |= (!gpio_get(pinDualDirLeft) ? gamepad->mapDpadLeft->buttonMask  : 0);
+        dualState |= (gamepad->gpio.isPressed(pinDualDirLeft) ? gamepad->mapDpadLeft->buttonMask  : 0);
     }
     if ( pinDualDirRight != (uint8_t)-1 ) {
-        dualState |= (!gpio_get(pinDualDirRight) ? gamepad->mapDpadRight->buttonMask : 0);
+        dualState |= (gamepad->gpio.isPressed(pinDualDirRight) ? gamepad->mapDpadRight->buttonMask : 0);
     }
 
     // Debounce our directional pins
@@ -90,18 +86,18 @@ void DualDirectionalInput::preprocess()
 
     // Combined Mode
     if ( combineMode == DUAL_COMBINE_MODE_MIXED ) {
-        SOCDDualClean(socdMode); // Clean up Dual SOCD based on the mode
+        dualState = dualCleaner.clean(socdMode, dualState); // Clean up Dual SOCD based on the mode
 
         // Second Input (Last Input Priority) needs to happen before we MPG clean
         if ( socdMode == SOCD_MODE_SECOND_INPUT_PRIORITY ||
              socdMode == SOCD_MODE_FIRST_INPUT_PRIORITY ) {
-            gamepadState = SOCDGamepadClean(gamepadState, socdMode == SOCD_MODE_SECOND_INPUT_PRIORITY) | dualState;
+            gamepadState = gamepadCleaner.clean(socdMode, gamepadState) | dualState;
         }
     }
     // None Mode (no combination, no overwrite)
     else if ( combineMode == DUAL_COMBINE_MODE_NONE ) {
         // just SOCD clean the dual inputs based on the desired mode
-        SOCDDualClean(socdMode);
+        dualState = dualCleaner.clean(socdMode, dualState);
     }
     // Gamepad Overwrite Mode
     else if ( combineMode == DUAL_COMBINE_MODE_GAMEPAD ) {
@@ -160,7 +156,7 @@ void DualDirectionalInput::process()
                 if ( socdMode == SOCD_MODE_NEUTRAL ) {
                     dualOut = SOCDCombine(socdMode, gamepadDpad);
                 } else if ( socdMode != SOCD_MODE_BYPASS ) {
-                    dualOut = SOCDGamepadClean(dualOut | gamepadDpad, socdMode == SOCD_MODE_SECOND_INPUT_PRIORITY);
+                    dualOut = gamepadCleaner.clean(socdMode, dualOut | gamepadDpad);
                 } else {
                     dualOut |= gamepadDpad;
                 }
@@ -186,49 +182,6 @@ void DualDirectionalInput::OverrideGamepad(Gamepad * gamepad, DpadMode mode, uin
     }
 }
 
-uint8_t DualDirectionalInput::SOCDGamepadClean(uint8_t gamepadState, bool isLastWin) {
-    // Gamepad SOCD Last-Win OR First-Win Clean
-    switch (gamepadState & (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN)) {
-        case (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN): // If last state was Up or Down, exclude it from our gamepad
-            if (isLastWin) gamepadState ^= (lastGPUD == DIRECTION_UP) ? GAMEPAD_MASK_UP : GAMEPAD_MASK_DOWN;
-            else gamepadState ^= (lastGPUD == DIRECTION_UP) ? GAMEPAD_MASK_DOWN : GAMEPAD_MASK_UP;
-            break;
-        case GAMEPAD_MASK_UP:
-            gamepadState |= GAMEPAD_MASK_UP;
-            lastGPUD = DIRECTION_UP;
-            break;
-        case GAMEPAD_MASK_DOWN:
-            gamepadState |= GAMEPAD_MASK_DOWN;
-            lastGPUD = DIRECTION_DOWN;
-            break;
-        default:
-            lastGPUD = DIRECTION_NONE;
-            break;
-    }
-    switch (gamepadState & (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT)) {
-        case (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT):
-            if (lastGPLR != DIRECTION_NONE)
-                if (isLastWin) gamepadState ^= (lastGPLR == DIRECTION_LEFT) ? GAMEPAD_MASK_LEFT : GAMEPAD_MASK_RIGHT;
-                else gamepadState ^= (lastGPLR == DIRECTION_LEFT) ? GAMEPAD_MASK_RIGHT : GAMEPAD_MASK_LEFT;
-            else
-                lastGPLR = DIRECTION_NONE;
-            break;
-        case GAMEPAD_MASK_LEFT:
-            gamepadState |= GAMEPAD_MASK_LEFT;
-            lastGPLR = DIRECTION_LEFT;
-            break;
-        case GAMEPAD_MASK_RIGHT:
-            gamepadState |= GAMEPAD_MASK_RIGHT;
-            lastGPLR = DIRECTION_RIGHT;
-            break;
-        default:
-            lastGPLR = DIRECTION_NONE;
-            break;
-    }
-    return gamepadState;
-}
-
-
 uint8_t DualDirectionalInput::SOCDCombine(SOCDMode mode, uint8_t gamepadState) {
     uint8_t outState = dualState | gamepadState;
 
@@ -257,61 +210,6 @@ uint8_t DualDirectionalInput::SOCDCombine(SOCDMode mode, uint8_t gamepadState) {
     return outState;
 }
 
-void DualDirectionalInput::SOCDDualClean(SOCDMode socdMode) { 
-    if (socdMode == SOCD_MODE_BYPASS) {
-        return;
-    }
-
-    // Dual SOCD Last-Win Clean
-    switch (dualState & (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN)) {
-        case (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN): // If last state was Up or Down, exclude it from our gamepad
-            if ( socdMode == SOCD_MODE_UP_PRIORITY ) {
-                dualState ^= GAMEPAD_MASK_DOWN; // Remove Down
-				lastDualUD = DIRECTION_UP; // We're in UP mode
-            } else if ( socdMode == SOCD_MODE_SECOND_INPUT_PRIORITY && lastDualUD != DIRECTION_NONE ) {
-                dualState ^= (lastDualUD == DIRECTION_UP) ? GAMEPAD_MASK_UP : GAMEPAD_MASK_DOWN;
-            } else if ( socdMode == SOCD_MODE_FIRST_INPUT_PRIORITY && lastDualUD != DIRECTION_NONE ) {
-                dualState ^= (lastDualUD == DIRECTION_UP) ? GAMEPAD_MASK_DOWN : GAMEPAD_MASK_UP;
-            } else {
-				dualState ^= (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN); // Remove UP and Down in Neutral
-                lastDualUD = DIRECTION_NONE;
-            }
-            break;
-        case GAMEPAD_MASK_UP:
-            lastDualUD = DIRECTION_UP;
-            break;
-        case GAMEPAD_MASK_DOWN:
-            lastDualUD = DIRECTION_DOWN;
-            break;
-        default:
-            lastDualUD = DIRECTION_NONE;
-            break;
-    }
-    switch (dualState & (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT)) {
-        case (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT):
-            if ( socdMode == SOCD_MODE_UP_PRIORITY || socdMode == SOCD_MODE_NEUTRAL ) {
-                dualState ^= (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT); // Remove L + R to Neutral
-                lastDualLR = DIRECTION_NONE;
-            } else if ( socdMode == SOCD_MODE_SECOND_INPUT_PRIORITY || socdMode == SOCD_MODE_FIRST_INPUT_PRIORITY ) {
-                if (lastDualLR != DIRECTION_NONE)
-                    if (socdMode == SOCD_MODE_SECOND_INPUT_PRIORITY) dualState ^= (lastDualLR == DIRECTION_LEFT) ? GAMEPAD_MASK_LEFT : GAMEPAD_MASK_RIGHT; // Last Win
-                    else dualState ^= (lastDualLR == DIRECTION_LEFT) ? GAMEPAD_MASK_RIGHT : GAMEPAD_MASK_LEFT; // First Win
-                else
-                    lastDualLR = DIRECTION_NONE;
-            }
-            break;
-        case GAMEPAD_MASK_LEFT:
-            lastDualLR = DIRECTION_LEFT;
-            break;
-        case GAMEPAD_MASK_RIGHT:
-            lastDualLR = DIRECTION_RIGHT;
-            break;
-        default:
-            lastDualLR = DIRECTION_NONE;
-            break;
-    }
-}
-
 uint8_t DualDirectionalInput::gpadToBinary(DpadMode dpadMode, GamepadState state) {
     uint8_t out = 0;
     switch(dpadMode) { // Convert gamepad to dual if we're in mixed
@@ -15,27 +15,8 @@ void ExtraButtonAddon::setup() {
 	gpio_init(extraButtonPin);             // Initialize pin
 	gpio_set_dir(extraButtonPin, GPIO_IN); // Set as INPUT
 	gpio_pull_up(extraButtonPin);          // Set as PULLUP
-}
 
-void ExtraButtonAddon::preprocess() {
+	// extraButtonMap uses the remap target layout, the gamepad maps the pin along with the buttons
 	Gamepad * gamepad = Storage::getInstance().GetGamepad();
-	if (!gpio_get(extraButtonPin)) {
-		if (extraButtonMap > (GAMEPAD_MASK_A2)) {
-			switch (extraButtonMap) {
-				case (GAMEPAD_MASK_DU):
-					gamepad->state.dpad |= GAMEPAD_MASK_UP;
-					break;
-				case (GAMEPAD_MASK_DD):
-					gamepad->state.dpad |= GAMEPAD_MASK_DOWN;
-					break;
-				case (GAMEPAD_MASK_DL):
-					gamepad->state.dpad |= GAMEPAD_MASK_LEFT;
-					break;
-				case (GAMEPAD_MASK_DR):
-					gamepad->state.dpad |= GAMEPAD_MASK_RIGHT;
-					break;
-			}
-		}
-		else gamepad->state.buttons |= extraButtonMap;
-	}
-}
\ No newline at end of file
+	gamepad->remapper.addRule(gamepad->getRemapSource(extraButtonPin), extraButtonMap);
+}
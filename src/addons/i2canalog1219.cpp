@@ -1,9 +1,15 @@
 #include "addons/i2canalog1219.h"
 #include "storagemanager.h"
 
-#define ADS_MAX (float)((1 << 23) - 1)
+#define ADS_MAX ((1 << 23) - 1)
+#define ADS_TO_16BIT_SHIFT 7
 #define VREF_VOLTAGE 2.048f
 
+// 0 to VREF in 16 bits, readings below ground come back as negative values
+static uint16_t toPinValue(uint32_t readValue) {
+    return readValue > ADS_MAX ? 0 : readValue >> ADS_TO_16BIT_SHIFT;
+}
+
 bool I2CAnalog1219Input::available() {
     const AddonOptions& options = Storage::getInstance().getAddonOptions();
 	return (options.I2CAnalog1219InputEnabled &&
@@ -13,10 +19,16 @@ bool I2CAnalog1219Input::available() {
 
 void I2CAnalog1219Input::setup() {
     const AddonOptions& options = Storage::getInstance().getAddonOptions();
+    const BoardOptions& boardOptions = Storage::getInstance().getBoardOptions();
 
-    memset(&pins, 0, sizeof(ADS_PINS));
+    // Sticks rest at center until their channels are read
+    for (uint8_t i = 0; i < 4; i++)
+        pins.A[i] = AnalogConditioner::defaultCalibration.x.center;
     channelHop = 0;
 
+    conditioner.setDeadzone(options.analogDeadzoneMode, options.analogDeadzone);
+    conditioner.setCurve(options.analogCurve);
+
     uIntervalMS = 1;
     nextTimer = getMillis();
 
@@ -34,17 +46,32 @@ void I2CAnalog1219Input::setup() {
     ads->setDataRate(1000);                     // 1mhz (1.1ms delay)
     ads->setVoltageReference(REF_INTERNAL);     // Use internal VREF for now
     ads->start();                               // START/SYNC command
+
+    // Let interrupts fetch the conversions unless the display or the Wii extension shares the I2C block,
+    // they use blocking transfers
+    const bool sharedWithDisplay = boardOptions.hasI2CDisplay && boardOptions.i2cBlock == options.i2cAnalog1219Block;
+    const bool sharedWithWii = options.WiiExtensionAddonEnabled &&
+        options.wiiExtensionSDAPin != (uint8_t)-1 &&
+        options.wiiExtensionSCLPin != (uint8_t)-1 &&
+        options.wiiExtensionBlock == options.i2cAnalog1219Block;
+    const bool sharedBus = sharedWithDisplay || sharedWithWii;
+    if (!sharedBus)
+        ads->startScan(options.i2cAnalog1219DRDYPin == (uint8_t)-1 ? -1 : options.i2cAnalog1219DRDYPin);
 }
 
 void I2CAnalog1219Input::process()
 {
-    if (nextTimer < getMillis()) {
-        float result;
+    if (ads->isScanning()) {
+        uint32_t results[ADS1219_SCAN_CHANNELS];
+        if (ads->getScanResults(results)) {
+            for (uint8_t i = 0; i < 4; i++)
+                pins.A[i] = toPinValue(results[i]);
+        }
+    } else if (nextTimer < getMillis()) {
         uint32_t readValue;
         if ( ads->readRegister(STATUS) & REGISTER_STATUS_DRDY ) {
             readValue = ads->readConversionResult();
-            result = readValue / float(ADS_MAX); // gives us 0.0f to 1.0f (actual voltage is times voltage)
-            pins.A[channelHop] = result;
+            pins.A[channelHop] = toPinValue(readValue);
             channelHop = (channelHop+1) % 4; // Loop 0-3
             ads->setChannel(channelHop);
             nextTimer = getMillis() + uIntervalMS; // interval for read (we can't be too fast)
@@ -52,9 +79,6 @@ void I2CAnalog1219Input::process()
     }
 
     Gamepad * gamepad = Storage::getInstance().GetGamepad();
-    gamepad->state.lx = (uint16_t)(65535.f*pins.A[0]);
-    gamepad->state.ly = (uint16_t)(65535.f*pins.A[1]);
-    gamepad->state.rx = (uint16_t)(65535.f*pins.A[2]);
-    gamepad->state.ry = (uint16_t)(65535.f*pins.A[3]);
-
+    conditioner.process(pins.A[0], pins.A[1], gamepad->state.lx, gamepad->state.ly);
+    conditioner.process(pins.A[2], pins.A[3], gamepad->state.rx, gamepad->state.ry);
 }
@@ -11,6 +11,8 @@
 #include "pico/stdlib.h"
 #include "bitmaps.h"
 #include "ps4_driver.h"
+#include "usb_driver.h"
+#include "splashcodec.h"
 
 bool I2CDisplayAddon::available() {
 	const BoardOptions& boardOptions = getBoardOptions();
@@ -92,15 +94,18 @@ void I2CDisplayAddon::process() {
 			drawText(0, 3, std::string("GP2040-CE : ") + std::string(GP2040VERSION));
 			drawText(0, 4, "[http://192.168.7.1]");
 			drawText(0, 5, "Preview:");
-			drawText(5, 6, "B1 > Button");
-			drawText(5, 7, "B2 > Splash");
+			drawText(5, 6, "B1>Button B2>Splash");
+			drawText(5, 7, "B3>USB Stats");
+			break;
+		case I2CDisplayAddon::DisplayMode::USB_STATS:
+			drawUsbStats(get_saved_report_stats());
 			break;
 		case I2CDisplayAddon::DisplayMode::SPLASH:
 			if (getBoardOptions().splashMode == NOSPLASH) {
 				drawText(0, 4, " Splash NOT enabled.");
 				break;
 			}
-			drawSplashScreen(getBoardOptions().splashMode, (uint8_t*) Storage::getInstance().getSplashImage().data, 90);
+			drawSplashScreen(getBoardOptions().splashMode, Storage::getInstance().getSplashImage(), 90);
 			break;
 		case I2CDisplayAddon::DisplayMode::BUTTONS:
 			drawStatusBar(gamepad);
@@ -224,6 +229,11 @@ I2CDisplayAddon::DisplayMode I2CDisplayAddon::getDisplayMode() {
 						prevDisplayMode == I2CDisplayAddon::DisplayMode::SPLASH ?
 							I2CDisplayAddon::DisplayMode::CONFIG_INSTRUCTION : I2CDisplayAddon::DisplayMode::SPLASH;
 					break;
+				case (GAMEPAD_MASK_B3):
+					prevDisplayMode =
+						prevDisplayMode == I2CDisplayAddon::DisplayMode::USB_STATS ?
+							I2CDisplayAddon::DisplayMode::CONFIG_INSTRUCTION : I2CDisplayAddon::DisplayMode::USB_STATS;
+					break;
 				default:
 					prevDisplayMode = I2CDisplayAddon::DisplayMode::CONFIG_INSTRUCTION;
 			}
@@ -876,20 +886,30 @@ void I2CDisplayAddon::drawBlankB(int startX, int startY, int buttonSize, int but
 {
 }
 
-void I2CDisplayAddon::drawSplashScreen(int splashMode, uint8_t * splashChoice, int splashSpeed)
+void I2CDisplayAddon::drawSplashImage(const SplashImage& splashImage, int mils)
+{
+	uint8_t frame = 0;
+	if (splashImage.frameCount > 1 && splashImage.frameDelay > 0)
+		frame = (mils / (splashImage.frameDelay * 10)) % splashImage.frameCount;
+
+	// Frames are stored in page order so they decode straight into the back buffer
+	SplashCodec::decode(splashImage.data, splashImage.size, frame, ucBackBuffer, obd.width, obd.height >> 3);
+}
+
+void I2CDisplayAddon::drawSplashScreen(int splashMode, const SplashImage& splashImage, int splashSpeed)
 {
     int mils = getMillis();
     switch (splashMode)
 	{
 		case STATICSPLASH: // Default, display static or custom image
-			obdDrawSprite(&obd, splashChoice, 128, 64, 16, 0, 0, 1);
+			drawSplashImage(splashImage, mils);
 			break;
 		case CLOSEIN: // Close-in. Animate the GP2040 logo
 			obdDrawSprite(&obd, (uint8_t *)bootLogoTop, 43, 39, 6, 43, std::min<int>((mils / splashSpeed) - 39, 0), 1);
 			obdDrawSprite(&obd, (uint8_t *)bootLogoBottom, 80, 21, 10, 24, std::max<int>(64 - (mils / (splashSpeed * 2)), 44), 1);
 			break;
         case CLOSEINCUSTOM: // Close-in on custom image or delayed close-in if custom image does not exist
-            obdDrawSprite(&obd, splashChoice, 128, 64, 16, 0, 0, 1);
+            drawSplashImage(splashImage, mils);
             if (mils > 2500) {
                 int milss = mils - 2500;
                 obdRectangle(&obd, 0, 0, 127, 1 + (milss / splashSpeed), 0, 1);
@@ -905,6 +925,34 @@ void I2CDisplayAddon::drawText(int x, int y, std::string text) {
 	obdWriteString(&obd, 0, x, y, (char*)text.c_str(), FONT_6x8, 0, 0);
 }
 
+// Counters of the last gamepad session, so the report rate can be checked after switching to web config
+void I2CDisplayAddon::drawUsbStats(const UsbReportStats * stats)
+{
+	drawText(0, 0, "[USB Report Stats]");
+	if (stats == nullptr) {
+		drawText(0, 2, "No gamepad session");
+		drawText(0, 3, "recorded since boot.");
+		return;
+	}
+
+	switch (stats->inputMode)
+	{
+		case INPUT_MODE_HID:      drawText(0, 1, "Mode: DINPUT"); break;
+		case INPUT_MODE_SWITCH:   drawText(0, 1, "Mode: SWITCH"); break;
+		case INPUT_MODE_XINPUT:   drawText(0, 1, "Mode: XINPUT"); break;
+		case INPUT_MODE_PS4:      drawText(0, 1, "Mode: PS4"); break;
+		case INPUT_MODE_KEYBOARD: drawText(0, 1, "Mode: HID-KB"); break;
+		default: break;
+	}
+
+	drawText(0, 2, "Gen:  " + std::to_string(stats->generated));
+	drawText(0, 3, "Sent: " + std::to_string(stats->sent));
+	drawText(0, 4, "Dup:  " + std::to_string(stats->deduplicated));
+	drawText(0, 5, "Busy: " + std::to_string(stats->busy));
+	drawText(0, 6, "Done: " + std::to_string(stats->completed));
+	drawText(0, 7, "Poll: " + std::to_string(stats->pollInterval) + "/" + std::to_string(stats->pollIntervalMin) + "us");
+}
+
 void I2CDisplayAddon::drawStatusBar(Gamepad * gamepad)
 {
 	const BoardOptions& boardOptions = getBoardOptions();
@@ -27,11 +27,11 @@ void JSliderInput::setup()
     gpio_pull_up(pinSliderRS);          // Set as PULLUP
 }
 
-DpadMode JSliderInput::read() {
+DpadMode JSliderInput::read(const GpioSnapshot & gpio) {
     if ( pinSliderLS != (uint8_t)-1 && pinSliderRS != (uint8_t)-1) {
-        if ( !gpio_get(pinSliderLS)) {
+        if ( gpio.isPressed(pinSliderLS)) {
             return DPAD_MODE_LEFT_ANALOG;
-        } else if ( !gpio_get(pinSliderRS)) {
+        } else if ( gpio.isPressed(pinSliderRS)) {
             return DPAD_MODE_RIGHT_ANALOG;
         }
     }
@@ -53,13 +53,14 @@ void JSliderInput::debounce()
 
 void JSliderInput::process()
 {
+    Gamepad * gamepad = Storage::getInstance().GetGamepad();
+
     // Get Slider State
-    dpadState = read();
+    dpadState = read(gamepad->gpio);
 #if JSLIDER_DEBOUNCE_MILLIS > 0
     debounce();
 #endif
 
-    Gamepad * gamepad = Storage::getInstance().GetGamepad();
     if ( gamepad->options.dpadMode != dpadState) {
         gamepad->options.dpadMode = dpadState;
         gamepad->save();
@@ -15,8 +15,23 @@
 
 #include "enums.h"
 #include "helper.h"
+#include "system.h"
 
 static std::vector<uint8_t> EMPTY_VECTOR;
+static uint32_t ledMemory = 0; // Bytes reported to System::trackAllocation for the current configuration
+
+// Heap held by the LED matrix vectors and the frame buffer
+static uint32_t getLEDMemory(const PixelMatrix& matrix)
+{
+	uint32_t bytes = sizeof(NeoPico) + matrix.pixels.capacity() * sizeof(std::vector<Pixel>);
+	for (auto const& column : matrix.pixels)
+	{
+		bytes += column.capacity() * sizeof(Pixel);
+		for (auto const& pixel : column)
+			bytes += pixel.positions.capacity() * sizeof(pixel.positions[0]);
+	}
+	return bytes;
+}
 
 uint32_t rgbPLEDValues[4];
 
@@ -483,6 +498,10 @@ void NeoPicoLEDAddon::configureLEDs()
 	neopico = new NeoPico(ledOptions.dataPin, ledCount, ledOptions.ledFormat);
 	neopico->Off();
 
+	System::trackFree(System::MemoryCategory::LEDS, ledMemory);
+	ledMemory = getLEDMemory(matrix);
+	System::trackAllocation(System::MemoryCategory::LEDS, ledMemory);
+
 	Animation::format = ledOptions.ledFormat;
 	as.ConfigureBrightness(ledOptions.brightnessMaximum, ledOptions.brightnessSteps);
 	AnimationOptions animationOptions = AnimationStore.getAnimationOptions();
@@ -5,11 +5,11 @@
 
 #include "addons/ps4mode.h"
 
-#include "ps4_driver.h"
+#include "ps4_auth.h"
 
-#include "mbedtls/error.h"
-#include "mbedtls/rsa.h"
-#include "mbedtls/sha256.h"
+#include "mbedtls/bignum.h"
+#include "pico/rand.h"
+#include "hardware/timer.h"
 
 bool PS4ModeAddon::available() {
 	AddonOptions addonOptions = Storage::getInstance().getAddonOptions();
@@ -19,76 +19,84 @@ bool PS4ModeAddon::available() {
 void PS4ModeAddon::setup() {
     PS4Options * ps4Options = Storage::getInstance().getPS4Options();
 
-    rsa_context = {
-      .ver = 0,
-      .len = 256,
-      .N = { .s=1, .n=64, .p=const_cast<mbedtls_mpi_uint*>(ps4Options->rsa_n) },
-      .E = { .s=1, .n=1, .p=const_cast<mbedtls_mpi_uint*>(ps4Options->rsa_e) },
-      .D = { .s=1, .n=64, .p=const_cast<mbedtls_mpi_uint*>(ps4Options->rsa_d) },
-      .P = { .s=1, .n=32, .p=const_cast<mbedtls_mpi_uint*>(ps4Options->rsa_p) },
-      .Q = { .s=1, .n=32, .p=const_cast<mbedtls_mpi_uint*>(ps4Options->rsa_q) },
-      .DP = { .s=1, .n=32, .p=const_cast<mbedtls_mpi_uint*>(ps4Options->rsa_dp) },
-      .DQ = { .s=1, .n=32, .p=const_cast<mbedtls_mpi_uint*>(ps4Options->rsa_dq) },
-      .QP = { .s=1, .n=32, .p=const_cast<mbedtls_mpi_uint*>(ps4Options->rsa_qp) },
-      .RN = { .s=1, .n=64, .p=const_cast<mbedtls_mpi_uint*>(ps4Options->rsa_rn) },
-      .RP = { .s=0, .n=0, .p=nullptr },
-      .RQ = { .s=0, .n=0, .p=nullptr },
-      .Vi = { .s=0, .n=0, .p=nullptr },
-      .Vf = { .s=0, .n=0, .p=nullptr },
-      .padding = MBEDTLS_RSA_PKCS_V21, .hash_id = MBEDTLS_MD_SHA256,
-    };
+    // Montgomery and CRT constants only depend on the key, work them out once
+    signer.setup(*ps4Options);
+
+    // Everything but the nonce signature is fixed, so the rest of the authentication buffer is filled in up front:
+    //    256 byte - nonce signature (filled in after signing)
+    //    16 byte  - ps4 serial
+    //    256 byte - RSA N
+    //    256 byte - RSA E
+    //    256 byte - ps4 signature
+    //    24 byte  - zero padding
+    uint8_t * ps4_auth_buffer = PS4Data::getInstance().ps4_auth_buffer;
+    int offset = PS4Signer::SIGNATURE_SIZE;
+    memcpy(&ps4_auth_buffer[offset], ps4Options->serial, 16);
+    offset += 16;
+    mbedtls_mpi n = { .s=1, .n=64, .p=ps4Options->rsa_n };
+    mbedtls_mpi_write_binary(&n, &ps4_auth_buffer[offset], 256);
+    offset += 256;
+    mbedtls_mpi e = { .s=1, .n=1, .p=ps4Options->rsa_e };
+    mbedtls_mpi_write_binary(&e, &ps4_auth_buffer[offset], 256);
+    offset += 256;
+    memcpy(&ps4_auth_buffer[offset], ps4Options->signature, 256);
+    offset += 256;
+    memset(&ps4_auth_buffer[offset], 0, 24);
 }
 
 void PS4ModeAddon::process() {
-    PS4Options * ps4Options = Storage::getInstance().getPS4Options();
+    PS4Data & ps4Data = PS4Data::getInstance();
+
+    // Check to see if the PS4 Authentication needs work, a new nonce coming in cancels the current signature
+    if ( ps4Data.ps4State != PS4State::nonce_ready ) {
+      signer.reset();
+      return;
+    }
+
+    // A whole new nonce can arrive between two loop iterations without the state ever leaving nonce_ready
+    if ( signer.isBusy() && signingGeneration != ps4Data.nonceGeneration ) {
+      signer.reset();
+    }
 
-    int rss_error = 0;
+    if ( !signer.isBusy() ) {
+      uint8_t salt[PS4Signer::SALT_SIZE];
+      for (uint8_t i = 0; i < PS4Signer::SALT_SIZE; i += 4) {
+        uint32_t random = get_rand_32();
+        memcpy(&salt[i], &random, 4);
+      }
 
-    // Check to see if the PS4 Authentication needs work
-    if ( PS4Data::getInstance().ps4State == PS4State::nonce_ready ) {
+      signingStarted = time_us_32();
+      signingCpuTime = 0;
+      signingGeneration = ps4Data.nonceGeneration;
+      signer.start(ps4Data.nonce_buffer, sizeof(ps4Data.nonce_buffer), salt);
+    }
 
-      // Generate some random for RNG
-      srand(getMillis());
-      auto rng = [](void*p_rng, unsigned char* p, size_t len) {
-          (void) p_rng;
-          p[0] = rand();
-          return 0;
-      };
+    // Only spend a bounded amount of time per loop so the display and LEDs keep running while signing
+    const uint32_t tickStarted = time_us_32();
+    bool done = false;
+    do {
+      done = signer.step();
+    } while ( !done && (time_us_32() - tickStarted) < PS4_SIGNING_BUDGET_US );
 
-      uint8_t nonce_signature[256];
-      uint8_t * nonce_buffer = PS4Data::getInstance().nonce_buffer;
-      uint8_t * ps4_auth_buffer = PS4Data::getInstance().ps4_auth_buffer;
+    const uint32_t tickTime = time_us_32() - tickStarted;
+    signingCpuTime += tickTime;
+    if ( tickTime > ps4Data.signingStats.maxStall )
+      ps4Data.signingStats.maxStall = tickTime;
 
-      // Sign the nonce now that we got it!
-      //
-      if ( mbedtls_sha256_ret(nonce_buffer, 256, hashed_nonce, 0) < 0 ) {
-        return;
-      }
+    if ( done && signingGeneration != ps4Data.nonceGeneration ) {
+      // Signed a nonce that has since been replaced, start over on the next iteration
+      signer.reset();
+      return;
+    }
 
-      rss_error = mbedtls_rsa_rsassa_pss_sign(&rsa_context, rng, nullptr,
-              MBEDTLS_RSA_PRIVATE, MBEDTLS_MD_SHA256,
-              32, hashed_nonce,
-              nonce_signature);
+    if ( done ) {
+      memcpy(ps4Data.ps4_auth_buffer, signer.getSignature(), PS4Signer::SIGNATURE_SIZE);
+      signer.reset();
 
-      if ( rss_error < 0 ) {
-        return;
-      }
-      // copy the parts into our authentication buffer
-      int offset = 0;
-      memcpy(&ps4_auth_buffer[offset], nonce_signature, 256);
-      offset += 256;
-      memcpy(&ps4_auth_buffer[offset], ps4Options->serial, 16);
-      offset += 16;
-      mbedtls_mpi* mpi = static_cast<mbedtls_mpi*>(&rsa_context.N);
-      mbedtls_mpi_write_binary(mpi, &ps4_auth_buffer[offset], 256);
-      offset += 256;
-      mpi = static_cast<mbedtls_mpi*>(&rsa_context.E);
-      mbedtls_mpi_write_binary(mpi, &ps4_auth_buffer[offset], 256);
-      offset += 256;
-      memcpy(&ps4_auth_buffer[offset], ps4Options->signature, 256);
-      offset += 256;
-      memset(&ps4_auth_buffer[offset], 0, 24);
-
-      PS4Data::getInstance().ps4State = PS4State::signed_nonce_ready; // signed and ready to party
+      ps4Data.signingStats.count++;
+      ps4Data.signingStats.lastTime = time_us_32() - signingStarted;
+      ps4Data.signingStats.lastCpuTime = signingCpuTime;
+
+      ps4Data.ps4State = PS4State::signed_nonce_ready; // signed and ready to party
     }
 }
@@ -28,46 +28,36 @@ void ReverseInput::setup()
     actionUp = options.reverseActionUp;
     actionDown = options.reverseActionDown;
     actionLeft = options.reverseActionLeft;
-    actionRight = options.reverseActionDown;
+    actionRight = options.reverseActionRight;
 
+    // Reversing is a layer of the gamepad remapper that is active while the reverse button is held
     Gamepad * gamepad = Storage::getInstance().GetGamepad();
-	mapDpadUp    = gamepad->mapDpadUp;
-	mapDpadDown  = gamepad->mapDpadDown;
-	mapDpadLeft  = gamepad->mapDpadLeft;
-	mapDpadRight = gamepad->mapDpadRight;
-
-    invertXAxis = gamepad->options.invertXAxis;
-    invertYAxis = gamepad->options.invertYAxis;
+    GamepadRemapper & remapper = gamepad->remapper;
+    layer = remapper.addLayer(gamepad->getRemapSource(pinButtonReverse));
+    if (layer != REMAP_NO_LAYER) {
+        reverse(remapper, gamepad->mapDpadUp,    GAMEPAD_MASK_DD, actionUp);
+        reverse(remapper, gamepad->mapDpadDown,  GAMEPAD_MASK_DU, actionDown);
+        reverse(remapper, gamepad->mapDpadLeft,  GAMEPAD_MASK_DR, actionLeft);
+        reverse(remapper, gamepad->mapDpadRight, GAMEPAD_MASK_DL, actionRight);
+    }
 
     state = false;
 }
 
-void ReverseInput::update() {
-    state = !gpio_get(pinButtonReverse);
-}
-
-uint8_t ReverseInput::input(uint8_t valueMask, uint16_t buttonMask, uint16_t buttonMaskReverse, uint8_t action, bool invertAxis) {
-    if (state && action == 2) {
-        return 0;
+void ReverseInput::reverse(GamepadRemapper & remapper, const GamepadButtonMapping * mapping, uint32_t reverseTarget, uint8_t action) {
+    if (!mapping->isAssigned() || action == 0) {
+        return;
     }
-    bool invert = (state && action == 1) ? !invertAxis : invertAxis;
-    return (valueMask ? (invert ? buttonMaskReverse : buttonMask) : 0);
+    // Invert Y Axis is applied after the remap, so a reversed Up still ends up the opposite of Up
+    remapper.setOverride(layer, mapping->pin, action == 2 ? 0 : reverseTarget);
 }
 
 void ReverseInput::process()
 {
-    // Update Reverse State
-    update();
-
-    uint32_t values = ~gpio_get_all();
     Gamepad * gamepad = Storage::getInstance().GetGamepad();
 
-    gamepad->state.dpad = 0
-        | input(values & mapDpadUp->pinMask,    mapDpadUp->buttonMask,      mapDpadDown->buttonMask,    actionUp,       invertYAxis)
-        | input(values & mapDpadDown->pinMask,  mapDpadDown->buttonMask,    mapDpadUp->buttonMask,      actionDown,     invertYAxis)
-        | input(values & mapDpadLeft->pinMask,  mapDpadLeft->buttonMask,    mapDpadRight->buttonMask,   actionLeft,     invertXAxis)
-        | input(values & mapDpadRight->pinMask, mapDpadRight->buttonMask,   mapDpadLeft->buttonMask,    actionRight,    invertXAxis)
-    ;
+    // Update Reverse State
+    state = layer != REMAP_NO_LAYER && gamepad->remapper.getActiveLayer() == layer;
 
     if (pinLED != (uint8_t)-1) {
         gpio_put(pinLED, !state);
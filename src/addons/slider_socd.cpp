@@ -30,11 +30,11 @@ void SliderSOCDInput::setup()
     gpio_pull_up(pinSliderSOCDTwo);          // Set as PULLUP
 }
 
-SOCDMode SliderSOCDInput::read() {
+SOCDMode SliderSOCDInput::read(const GpioSnapshot & gpio) {
     if ( pinSliderSOCDOne != (uint8_t)-1 && pinSliderSOCDTwo != (uint8_t)-1) {
-        if ( !gpio_get(pinSliderSOCDOne)) {
+        if ( gpio.isPressed(pinSliderSOCDOne)) {
             return sliderSOCDModeOne;
-        } else if ( !gpio_get(pinSliderSOCDTwo)) {
+        } else if ( gpio.isPressed(pinSliderSOCDTwo)) {
             return sliderSOCDModeTwo;
         }
     }
@@ -58,13 +58,14 @@ void SliderSOCDInput::debounce()
 
 void SliderSOCDInput::process()
 {
+    Gamepad * gamepad = Storage::getInstance().GetGamepad();
+
     // Get Slider State
-    socdState = read();
+    socdState = read(gamepad->gpio);
 #if SLIDERSOCD_DEBOUNCE_MILLIS > 0
     debounce();
 #endif
 
-    Gamepad * gamepad = Storage::getInstance().GetGamepad();
     if ( gamepad->options.socdMode != socdState) {
         gamepad->options.socdMode = socdState;
         gamepad->save();
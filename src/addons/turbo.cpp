@@ -3,6 +3,7 @@
 #include "hardware/adc.h"
 
 #include "storagemanager.h"
+#include "adcsampler.h"
 
 #include <algorithm>
 
@@ -30,10 +31,9 @@ void TurboInput::setup()
     // Turbo Dial
     uint8_t turboShotCount = options.turboShotCount;
     if ( options.pinShmupDial != (uint8_t)-1 ) {
-        adc_gpio_init(options.pinShmupDial);
-        adcShmupDial = 26 - options.pinShmupDial;
-        adc_select_input(adcShmupDial);
-        dialValue = adc_read(); // setup initial Dial + Turbo Speed
+        AdcSampler::getInstance().addPin(options.pinShmupDial);
+        adc_select_input(options.pinShmupDial - 26);
+        dialValue = adc_read(); // setup initial Dial + Turbo Speed, the sampler only starts after setup
         turboShotCount = (dialValue / turboDialIncrements) + TURBO_SHOT_MIN;
     } else {
         dialValue = 0;
@@ -89,20 +89,20 @@ void TurboInput::setup()
     nextTimer = getMillis();
 }
 
-void TurboInput::read(const AddonOptions & options)
+void TurboInput::read(const AddonOptions & options, const GpioSnapshot & gpio)
 {
     // Get Charge Buttons
     if ( options.shmupMode == 1 ) {
         chargeState = 0;
         for (uint8_t i = 0; i < 4; i++) {
             if ( shmupBtnPin[i] != (uint8_t)-1 ) { // if pin, get the GPIO
-                chargeState |= (!gpio_get(shmupBtnPin[i]) ? shmupBtnMask[i] : 0);
+                chargeState |= (gpio.isPressed(shmupBtnPin[i]) ? shmupBtnMask[i] : 0);
             }
         }
     }
 
     // Get TURBO Key State
-    bTurboState = !gpio_get(options.pinButtonTurbo);
+    bTurboState = gpio.isPressed(options.pinButtonTurbo);
 }
 
 void TurboInput::debounce()
@@ -136,7 +136,7 @@ void TurboInput::process()
     uint16_t dpadPressed = gamepad->state.dpad & GAMEPAD_MASK_DPAD;
 
     // Get Turbo Button States
-    read(options);
+    read(options, gamepad->gpio);
     debounce();
 
     // Set TURBO Enable Buttons
@@ -168,8 +168,7 @@ void TurboInput::process()
 
     // Use the dial to modify our turbo shot speed (don't save on dial modify)
     if ( options.pinShmupDial != (uint8_t)-1 ) {
-        adc_select_input(adcShmupDial);
-        uint16_t rawValue = adc_read();
+        uint16_t rawValue = AdcSampler::getInstance().getValue(options.pinShmupDial) >> 4; // 12-bit like the dial increments
         if ( rawValue != dialValue ) {
             updateTurboShotCount((rawValue / turboDialIncrements) + TURBO_SHOT_MIN);
         }
@@ -1,8 +1,16 @@
 #include "addons/wiiext.h"
 #include "storagemanager.h"
 #include "hardware/gpio.h"
+#include "hardware/sync.h"
 
-bool WiiExtensionInput::available() {
+// Snapshot handed from core1 to core0. The sequence is odd while the poller writes the snapshot,
+// readers retry when it was odd or changed during their copy instead of taking a lock.
+static volatile uint32_t snapshotSequence = 0;
+static WiiExtensionSnapshot sharedSnapshot;
+
+#define SNAPSHOT_READ_ATTEMPTS 4
+
+static bool isWiiExtensionEnabled() {
     const BoardOptions& boardOptions = Storage::getInstance().getBoardOptions();
     AddonOptions options = Storage::getInstance().getAddonOptions();
 
@@ -11,7 +19,11 @@ bool WiiExtensionInput::available() {
         options.wiiExtensionSCLPin != (uint8_t)-1));
 }
 
-void WiiExtensionInput::setup() {
+bool WiiExtensionPoller::available() {
+    return isWiiExtensionEnabled();
+}
+
+void WiiExtensionPoller::setup() {
     AddonOptions options = Storage::getInstance().getAddonOptions();
     nextTimer = getMillis();
 
@@ -19,8 +31,6 @@ void WiiExtensionInput::setup() {
     stdio_init_all();
 #endif
 
-    uIntervalMS = 0;
-    
     wii = new WiiExtension(
         options.wiiExtensionSDAPin,
         options.wiiExtensionSCLPin,
@@ -31,117 +41,158 @@ void WiiExtensionInput::setup() {
     wii->start();
 }
 
-void WiiExtensionInput::process() {
-    if (nextTimer < getMillis()) {
+void WiiExtensionPoller::process() {
+    if (nextTimer > getMillis())
+        return;
+
+    // An extension missing at boot never became ready, keep looking for one
+    if (!wii->isReady) {
+        wii->reset();
+        wii->start();
+    } else {
         wii->poll();
-        
-        if (wii->extensionType == WII_EXTENSION_NUNCHUCK) {
-            buttonZ = wii->buttonZ;
-            buttonC = wii->buttonC;
-
-            leftX = map(wii->joy1X,0,1023,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-            leftY = map(wii->joy1Y,1023,0,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-            rightX = GAMEPAD_JOYSTICK_MID;
-            rightY = GAMEPAD_JOYSTICK_MID;
-
-            triggerLeft = 0;
-            triggerRight = 0;
-        } else if ((wii->extensionType == WII_EXTENSION_CLASSIC) || (wii->extensionType == WII_EXTENSION_CLASSIC_PRO)) {
-            buttonA = wii->buttonA;
-            buttonB = wii->buttonB;
-            buttonX = wii->buttonX;
-            buttonY = wii->buttonY;
-            buttonL = wii->buttonZL;
-            buttonZL = wii->buttonLT;
-            buttonR = wii->buttonZR;
-            buttonZR = wii->buttonRT;
-            dpadUp = wii->directionUp;
-            dpadDown = wii->directionDown;
-            dpadLeft = wii->directionLeft;
-            dpadRight = wii->directionRight;
-            buttonSelect = wii->buttonMinus;
-            buttonStart = wii->buttonPlus;
-            buttonHome = wii->buttonHome;
-
-            if (wii->extensionType == WII_EXTENSION_CLASSIC) {
-                triggerLeft  = wii->triggerLeft;
-                triggerRight = wii->triggerRight;
-            }
-
-            leftX = map(wii->joy1X,0,WII_ANALOG_PRECISION_3,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-            leftY = map(wii->joy1Y,WII_ANALOG_PRECISION_3,0,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-            rightX = map(wii->joy2X,0,WII_ANALOG_PRECISION_3,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-            rightY = map(wii->joy2Y,WII_ANALOG_PRECISION_3,0,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-        } else if (wii->extensionType == WII_EXTENSION_GUITAR) {
-            buttonSelect = wii->buttonMinus;
-            buttonStart = wii->buttonPlus;
-
-            dpadUp = wii->directionUp;
-            dpadDown = wii->directionDown;
-
-            buttonB = wii->fretGreen;
-            buttonA = wii->fretRed;
-            buttonX = wii->fretYellow;
-            buttonY = wii->fretBlue;
-            buttonL = wii->fretOrange;
-
-            // whammy currently maps to Joy2X in addition to the raw whammy value
-            whammyBar = wii->whammyBar;
-            buttonR = wii->pedalButton;
-
-            leftX = map(wii->joy1X,0,WII_ANALOG_PRECISION_3,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-            leftY = map(wii->joy1Y,WII_ANALOG_PRECISION_3,0,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-            rightX = map(wii->joy2X,0,WII_ANALOG_PRECISION_3,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-            rightY = GAMEPAD_JOYSTICK_MID;
-
-            triggerLeft = 0;
-            triggerRight = 0;
-        } else if (wii->extensionType == WII_EXTENSION_TAIKO) {
-            buttonL = wii->rimLeft;
-            buttonR = wii->rimRight;
-
-            dpadLeft = wii->drumLeft;
-            buttonA = wii->drumRight;
+    }
+
+    decode();
+    snapshot.polls++;
+    snapshot.timeouts = wii->timeouts;
+    snapshot.reconnects = wii->reconnects;
+    publishSnapshot(snapshot);
+
+    nextTimer = getMillis() + (wii->extensionType == WII_EXTENSION_NONE ? WII_EXTENSION_RETRY_MS : 0);
+}
+
+void WiiExtensionPoller::decode() {
+    uint32_t buttons = 0;
+    uint8_t dpad = 0;
+
+    snapshot.extensionType = wii->extensionType;
+    snapshot.leftX = WII_AXIS_CENTER;
+    snapshot.leftY = WII_AXIS_CENTER;
+    snapshot.rightX = WII_AXIS_CENTER;
+    snapshot.rightY = WII_AXIS_CENTER;
+    snapshot.triggerLeft = 0;
+    snapshot.triggerRight = 0;
+
+    if (wii->extensionType == WII_EXTENSION_NUNCHUCK) {
+        if (wii->buttonC) buttons |= GAMEPAD_MASK_B1;
+        if (wii->buttonZ) buttons |= GAMEPAD_MASK_B2;
+
+        snapshot.leftX = scaleAxis(wii->joy1X,1023,false);
+        snapshot.leftY = scaleAxis(wii->joy1Y,1023,true);
+    } else if ((wii->extensionType == WII_EXTENSION_CLASSIC) || (wii->extensionType == WII_EXTENSION_CLASSIC_PRO)) {
+        if (wii->buttonA) buttons |= GAMEPAD_MASK_B2;
+        if (wii->buttonB) buttons |= GAMEPAD_MASK_B1;
+        if (wii->buttonX) buttons |= GAMEPAD_MASK_B4;
+        if (wii->buttonY) buttons |= GAMEPAD_MASK_B3;
+        if (wii->buttonZL) buttons |= GAMEPAD_MASK_L1;
+        if (wii->buttonLT) buttons |= GAMEPAD_MASK_L2;
+        if (wii->buttonZR) buttons |= GAMEPAD_MASK_R1;
+        if (wii->buttonRT) buttons |= GAMEPAD_MASK_R2;
+        if (wii->buttonMinus) buttons |= GAMEPAD_MASK_S1;
+        if (wii->buttonPlus) buttons |= GAMEPAD_MASK_S2;
+        if (wii->buttonHome) buttons |= GAMEPAD_MASK_A1;
+        if (wii->directionUp) dpad |= GAMEPAD_MASK_UP;
+        if (wii->directionDown) dpad |= GAMEPAD_MASK_DOWN;
+        if (wii->directionLeft) dpad |= GAMEPAD_MASK_LEFT;
+        if (wii->directionRight) dpad |= GAMEPAD_MASK_RIGHT;
+
+        if (wii->extensionType == WII_EXTENSION_CLASSIC) {
+            snapshot.triggerLeft  = wii->triggerLeft;
+            snapshot.triggerRight = wii->triggerRight;
         }
-               
-        nextTimer = getMillis() + uIntervalMS;
+
+        snapshot.leftX = scaleAxis(wii->joy1X,WII_ANALOG_PRECISION_3,false);
+        snapshot.leftY = scaleAxis(wii->joy1Y,WII_ANALOG_PRECISION_3,true);
+        snapshot.rightX = scaleAxis(wii->joy2X,WII_ANALOG_PRECISION_3,false);
+        snapshot.rightY = scaleAxis(wii->joy2Y,WII_ANALOG_PRECISION_3,true);
+    } else if (wii->extensionType == WII_EXTENSION_GUITAR) {
+        if (wii->buttonMinus) buttons |= GAMEPAD_MASK_S1;
+        if (wii->buttonPlus) buttons |= GAMEPAD_MASK_S2;
+        if (wii->directionUp) dpad |= GAMEPAD_MASK_UP;
+        if (wii->directionDown) dpad |= GAMEPAD_MASK_DOWN;
+
+        if (wii->fretGreen) buttons |= GAMEPAD_MASK_B1;
+        if (wii->fretRed) buttons |= GAMEPAD_MASK_B2;
+        if (wii->fretYellow) buttons |= GAMEPAD_MASK_B4;
+        if (wii->fretBlue) buttons |= GAMEPAD_MASK_B3;
+        if (wii->fretOrange) buttons |= GAMEPAD_MASK_L1;
+        if (wii->pedalButton) buttons |= GAMEPAD_MASK_R1;
+
+        // whammy currently maps to Joy2X
+        snapshot.leftX = scaleAxis(wii->joy1X,WII_ANALOG_PRECISION_3,false);
+        snapshot.leftY = scaleAxis(wii->joy1Y,WII_ANALOG_PRECISION_3,true);
+        snapshot.rightX = scaleAxis(wii->joy2X,WII_ANALOG_PRECISION_3,false);
+    } else if (wii->extensionType == WII_EXTENSION_TAIKO) {
+        if (wii->rimLeft) buttons |= GAMEPAD_MASK_L1;
+        if (wii->rimRight) buttons |= GAMEPAD_MASK_R1;
+        if (wii->drumLeft) dpad |= GAMEPAD_MASK_LEFT;
+        if (wii->drumRight) buttons |= GAMEPAD_MASK_B2;
+    }
+
+    snapshot.buttons = buttons;
+    snapshot.dpad = dpad;
+}
+
+void WiiExtensionPoller::publishSnapshot(const WiiExtensionSnapshot& latest) {
+    snapshotSequence = snapshotSequence + 1;
+    __dmb();
+    sharedSnapshot = latest;
+    __dmb();
+    snapshotSequence = snapshotSequence + 1;
+}
+
+bool WiiExtensionPoller::readSnapshot(WiiExtensionSnapshot& copy) {
+    for (int attempt = 0; attempt < SNAPSHOT_READ_ATTEMPTS; attempt++) {
+        const uint32_t sequence = snapshotSequence;
+        if (sequence == 0)
+            return false;
+        if (sequence & 1)
+            continue;
+
+        __dmb();
+        copy = sharedSnapshot;
+        __dmb();
+        if (snapshotSequence == sequence)
+            return true;
     }
+    // The poller kept writing, the caller keeps its previous snapshot
+    return false;
+}
+
+// Scales a stick reading to the 16-bit input range of the analog conditioner
+uint16_t WiiExtensionPoller::scaleAxis(uint16_t value, uint16_t max, bool invert) {
+    const uint16_t scaled = value >= max ? 0xFFFF : ((uint32_t)value * 0xFFFF) / max;
+    return invert ? 0xFFFF - scaled : scaled;
+}
+
+bool WiiExtensionInput::available() {
+    return isWiiExtensionEnabled();
+}
+
+void WiiExtensionInput::setup() {
+    AddonOptions options = Storage::getInstance().getAddonOptions();
+
+    conditioner.setDeadzone(options.analogDeadzoneMode, options.analogDeadzone);
+    conditioner.setCurve(options.analogCurve);
+}
+
+void WiiExtensionInput::process() {
+    WiiExtensionPoller::readSnapshot(snapshot);
 
     Gamepad * gamepad = Storage::getInstance().GetGamepad();
 
-    gamepad->state.lx = leftX;
-    gamepad->state.ly = leftY;
-    gamepad->state.rx = rightX;
-    gamepad->state.ry = rightY;
+    conditioner.process(snapshot.leftX, snapshot.leftY, gamepad->state.lx, gamepad->state.ly);
+    conditioner.process(snapshot.rightX, snapshot.rightY, gamepad->state.rx, gamepad->state.ry);
 
-    if (wii->extensionType == WII_EXTENSION_CLASSIC) {
+    if (snapshot.extensionType == WII_EXTENSION_CLASSIC) {
         gamepad->hasAnalogTriggers = true;
-        gamepad->state.lt = triggerLeft;
-        gamepad->state.rt = triggerRight;
+        gamepad->state.lt = snapshot.triggerLeft;
+        gamepad->state.rt = snapshot.triggerRight;
     } else {
         gamepad->hasAnalogTriggers = false;
     }
 
-    if (buttonC) gamepad->state.buttons |= GAMEPAD_MASK_B1;
-    if (buttonZ) gamepad->state.buttons |= GAMEPAD_MASK_B2;
-
-    if (buttonA) gamepad->state.buttons |= GAMEPAD_MASK_B2;
-    if (buttonB) gamepad->state.buttons |= GAMEPAD_MASK_B1;
-    if (buttonX) gamepad->state.buttons |= GAMEPAD_MASK_B4;
-    if (buttonY) gamepad->state.buttons |= GAMEPAD_MASK_B3;
-    if (buttonL) gamepad->state.buttons |= GAMEPAD_MASK_L1;
-    if (buttonZL) gamepad->state.buttons |= GAMEPAD_MASK_L2;
-    if (buttonR) gamepad->state.buttons |= GAMEPAD_MASK_R1;
-    if (buttonZR) gamepad->state.buttons |= GAMEPAD_MASK_R2;
-    if (buttonSelect) gamepad->state.buttons |= GAMEPAD_MASK_S1;
-    if (buttonStart) gamepad->state.buttons |= GAMEPAD_MASK_S2;
-    if (buttonHome) gamepad->state.buttons |= GAMEPAD_MASK_A1;
-    if (dpadUp) gamepad->state.dpad |= GAMEPAD_MASK_UP;
-    if (dpadDown) gamepad->state.dpad |= GAMEPAD_MASK_DOWN;
-    if (dpadLeft) gamepad->state.dpad |= GAMEPAD_MASK_LEFT;
-    if (dpadRight) gamepad->state.dpad |= GAMEPAD_MASK_RIGHT;
-}
-
-uint16_t WiiExtensionInput::map(uint16_t x, uint16_t in_min, uint16_t in_max, uint16_t out_min, uint16_t out_max) {
-    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+    gamepad->state.buttons |= snapshot.buttons;
+    gamepad->state.dpad |= snapshot.dpad;
 }
@@ -0,0 +1,143 @@
+#include "analogconditioner.h"
+#include "GamepadState.h"
+
+// Axis values are signed fractions of the stick radius, centered on GAMEPAD_JOYSTICK_MID
+#define AXIS_POSITIVE (GAMEPAD_JOYSTICK_MAX - GAMEPAD_JOYSTICK_MID) // 32768
+#define AXIS_NEGATIVE (GAMEPAD_JOYSTICK_MID - GAMEPAD_JOYSTICK_MIN) // 32767
+#define CURVE_SEGMENT_SHIFT 10 // AXIS_POSITIVE / ANALOG_CURVE_SEGMENTS == 1 << CURVE_SEGMENT_SHIFT
+#define DEADZONE_MAX_PERCENT 99
+
+static_assert((ANALOG_CURVE_SEGMENTS << CURVE_SEGMENT_SHIFT) == AXIS_POSITIVE, "Curve segments must cover the axis");
+
+const AnalogStickCalibration AnalogConditioner::defaultCalibration = {
+	{ 0, 0x8000, 0xFFFF },
+	{ 0, 0x8000, 0xFFFF },
+};
+
+static uint32_t isqrt(uint32_t value) {
+	uint32_t result = 0;
+	uint32_t bit = 1u << 30;
+	while (bit > value)
+		bit >>= 2;
+
+	while (bit != 0) {
+		if (value >= result + bit) {
+			value -= result + bit;
+			result = (result >> 1) + bit;
+		} else {
+			result >>= 1;
+		}
+		bit >>= 2;
+	}
+	return result;
+}
+
+static int32_t clampAxis(int32_t value) {
+	if (value > AXIS_POSITIVE)
+		return AXIS_POSITIVE;
+	if (value < -AXIS_NEGATIVE)
+		return -AXIS_NEGATIVE;
+	return value;
+}
+
+static bool isValid(const AnalogAxisCalibration& calibration) {
+	return calibration.min < calibration.center && calibration.center < calibration.max;
+}
+
+AnalogConditioner::AnalogConditioner() :
+	calibration(defaultCalibration),
+	deadzoneMode(ANALOG_DEADZONE_NONE),
+	deadzone(0),
+	linear(true) {
+	setCurve(ANALOG_CURVE_LINEAR);
+}
+
+void AnalogConditioner::setCalibration(const AnalogStickCalibration& calibration) {
+	this->calibration.x = isValid(calibration.x) ? calibration.x : defaultCalibration.x;
+	this->calibration.y = isValid(calibration.y) ? calibration.y : defaultCalibration.y;
+}
+
+void AnalogConditioner::setDeadzone(AnalogDeadzoneMode mode, uint8_t percent) {
+	deadzoneMode = mode;
+	deadzone = (int32_t)(percent > DEADZONE_MAX_PERCENT ? DEADZONE_MAX_PERCENT : percent) * AXIS_POSITIVE / 100;
+}
+
+void AnalogConditioner::setCurve(AnalogCurve curve) {
+	linear = curve == ANALOG_CURVE_LINEAR;
+	for (uint32_t i = 0; i <= ANALOG_CURVE_SEGMENTS; i++) {
+		const uint32_t x = i << CURVE_SEGMENT_SHIFT;
+		uint32_t y;
+		switch (curve) {
+			case ANALOG_CURVE_QUADRATIC:   y = (x * x) / AXIS_POSITIVE; break;
+			case ANALOG_CURVE_CUBIC:       y = (((x * x) / AXIS_POSITIVE) * x) / AXIS_POSITIVE; break;
+			case ANALOG_CURVE_SQUARE_ROOT: y = isqrt(x * AXIS_POSITIVE); break;
+			default:                       y = x; break;
+		}
+		this->curve[i] = y > AXIS_POSITIVE ? AXIS_POSITIVE : y;
+	}
+}
+
+int32_t AnalogConditioner::normalize(uint16_t raw, const AnalogAxisCalibration& calibration) const {
+	if (raw >= calibration.center) {
+		if (raw >= calibration.max)
+			return AXIS_POSITIVE;
+		return ((uint32_t)(raw - calibration.center) * AXIS_POSITIVE) / (calibration.max - calibration.center);
+	}
+
+	if (raw <= calibration.min)
+		return -AXIS_NEGATIVE;
+	return -(int32_t)(((uint32_t)(calibration.center - raw) * AXIS_NEGATIVE) / (calibration.center - calibration.min));
+}
+
+int32_t AnalogConditioner::applyCurve(int32_t value) const {
+	const uint32_t magnitude = value < 0 ? -value : value;
+	const uint32_t index = magnitude >> CURVE_SEGMENT_SHIFT;
+	if (index >= ANALOG_CURVE_SEGMENTS)
+		return value < 0 ? -(int32_t)curve[ANALOG_CURVE_SEGMENTS] : curve[ANALOG_CURVE_SEGMENTS];
+
+	// Interpolate between the two table entries around the value
+	const uint32_t fraction = magnitude & ((1 << CURVE_SEGMENT_SHIFT) - 1);
+	const int32_t result = curve[index] + (((int32_t)(curve[index + 1] - curve[index]) * (int32_t)fraction) >> CURVE_SEGMENT_SHIFT);
+	return value < 0 ? -result : result;
+}
+
+void AnalogConditioner::process(uint16_t rawX, uint16_t rawY, uint16_t& outX, uint16_t& outY) const {
+	int32_t x = normalize(rawX, calibration.x);
+	int32_t y = normalize(rawY, calibration.y);
+
+	switch (deadzoneMode) {
+		case ANALOG_DEADZONE_AXIAL:
+			if (x < deadzone && x > -deadzone)
+				x = 0;
+			if (y < deadzone && y > -deadzone)
+				y = 0;
+			break;
+
+		case ANALOG_DEADZONE_RADIAL:
+		case ANALOG_DEADZONE_SCALED_RADIAL:
+		{
+			// x² + y² stays below 2^31 since neither axis exceeds 2^15
+			const int32_t magnitude = isqrt((uint32_t)(x * x) + (uint32_t)(y * y));
+			if (magnitude < deadzone || magnitude == 0) {
+				x = 0;
+				y = 0;
+			} else if (deadzoneMode == ANALOG_DEADZONE_SCALED_RADIAL && deadzone > 0) {
+				const int32_t scaled = ((magnitude - deadzone) * AXIS_POSITIVE) / (AXIS_POSITIVE - deadzone);
+				x = clampAxis(((int64_t)x * scaled) / magnitude);
+				y = clampAxis(((int64_t)y * scaled) / magnitude);
+			}
+			break;
+		}
+
+		default:
+			break;
+	}
+
+	if (!linear) {
+		x = applyCurve(x);
+		y = applyCurve(y);
+	}
+
+	outX = GAMEPAD_JOYSTICK_MID + clampAxis(x);
+	outY = GAMEPAD_JOYSTICK_MID + clampAxis(y);
+}
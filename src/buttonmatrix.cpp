@@ -0,0 +1,108 @@
+#include "buttonmatrix.h"
+
+#include "hardware/gpio.h"
+#include "hardware/structs/sio.h"
+
+static_assert(BUTTON_MATRIX_SCAN_US > BUTTON_MATRIX_MAX_ROWS * BUTTON_MATRIX_SETTLE_US,
+	"A scan of every row has to fit into the scan interval");
+
+// Idle time between the last row of a scan and the first row of the next one
+#define SCAN_IDLE_US(rows) (BUTTON_MATRIX_SCAN_US - (rows) * BUTTON_MATRIX_SETTLE_US)
+
+bool ButtonMatrix::setup(const uint8_t * rowPins, uint8_t rows, const uint8_t * columnPins, uint8_t columns) {
+	if (rows == 0 || columns == 0 || rows > BUTTON_MATRIX_MAX_ROWS || columns > BUTTON_MATRIX_MAX_COLUMNS ||
+		rows * columns > BUTTON_MATRIX_MAX_KEYS)
+		return false;
+
+	for (uint8_t row = 0; row < rows; row++) {
+		if (rowPins[row] >= NUM_BANK0_GPIOS)
+			return false;
+		this->rowPins[row] = rowPins[row];
+	}
+	for (uint8_t column = 0; column < columns; column++) {
+		if (columnPins[column] >= NUM_BANK0_GPIOS)
+			return false;
+		this->columnPins[column] = columnPins[column];
+	}
+	this->rows = rows;
+	this->columns = columns;
+
+	// Idle rows float on their pull-ups, a row is only driven while it is scanned so that two keys
+	// pressed in one column never short a high row against a low one
+	for (uint8_t row = 0; row < rows; row++) {
+		gpio_init(rowPins[row]);
+		gpio_put(rowPins[row], 0);
+		gpio_set_dir(rowPins[row], GPIO_IN);
+		gpio_pull_up(rowPins[row]);
+		pinMask |= 1u << rowPins[row];
+	}
+	for (uint8_t column = 0; column < columns; column++) {
+		gpio_init(columnPins[column]);
+		gpio_set_dir(columnPins[column], GPIO_IN);
+		gpio_pull_up(columnPins[column]);
+		pinMask |= 1u << columnPins[column];
+	}
+
+	// One scan right away so the keys are valid before the alarms take over, setup can wait out the settle times
+	scanRow = rows;
+	for (uint8_t step = 0; step <= rows; step++) {
+		scanStep();
+		busy_wait_us_32(BUTTON_MATRIX_SETTLE_US);
+	}
+
+	scanAlarm = add_alarm_in_us(SCAN_IDLE_US(rows), scanCallback, this, true);
+	return scanAlarm > 0;
+}
+
+int64_t ButtonMatrix::scanCallback(alarm_id_t id, void * user_data) {
+	return static_cast<ButtonMatrix*>(user_data)->scanStep();
+}
+
+int64_t ButtonMatrix::scanStep() {
+	// Negative delays count from the previous alarm, so a late interrupt doesn't stretch the scan interval
+	if (scanRow == rows) {
+		scanRow = 0;
+		sio_hw->gpio_oe_set = 1u << rowPins[0];
+		return -(BUTTON_MATRIX_SETTLE_US);
+	}
+
+	const uint32_t levels = sio_hw->gpio_in;
+	sio_hw->gpio_oe_clr = 1u << rowPins[scanRow];
+
+	uint8_t pressed = 0;
+	for (uint8_t column = 0; column < columns; column++) {
+		if (!(levels & (1u << columnPins[column])))
+			pressed |= 1 << column;
+	}
+	rowColumns[scanRow] = pressed;
+
+	if (++scanRow < rows) {
+		sio_hw->gpio_oe_set = 1u << rowPins[scanRow];
+		return -(BUTTON_MATRIX_SETTLE_US);
+	}
+
+	publish();
+	return -SCAN_IDLE_US(rows);
+}
+
+void ButtonMatrix::publish() {
+	uint32_t scanned = 0;
+	for (uint8_t row = 0; row < rows; row++)
+		scanned |= (uint32_t)rowColumns[row] << (row * columns);
+
+	// Without diodes, keys on three corners of a rectangle make the fourth read as pressed as well.
+	// Two rows sharing two or more pressed columns can't be told apart, so those keys keep their last state.
+	uint32_t ambiguous = 0;
+	for (uint8_t first = 0; first < rows; first++) {
+		for (uint8_t second = first + 1; second < rows; second++) {
+			const uint8_t shared = rowColumns[first] & rowColumns[second];
+			if (shared & (shared - 1))
+				ambiguous |= ((uint32_t)shared << (first * columns)) | ((uint32_t)shared << (second * columns));
+		}
+	}
+
+	if (ambiguous & ~ambiguousKeys)
+		ghostCount = ghostCount + 1;
+	ambiguousKeys = ambiguous;
+	keys = (scanned & ~ambiguous) | (keys & ambiguous);
+}
@@ -0,0 +1,362 @@
+#include "configs/jsonstreamparser.h"
+
+#include <cstdint>
+#include <cstdlib>
+
+namespace {
+	const size_t MAX_NUMBER_LENGTH = 32;
+	const size_t MAX_LITERAL_LENGTH = 5;
+
+	bool isWhitespace(char c)
+	{
+		return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+	}
+
+	int hexValue(char c)
+	{
+		if (c >= '0' && c <= '9') return c - '0';
+		if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+		if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+		return -1;
+	}
+
+	void appendUtf8(std::string& out, uint32_t codePoint)
+	{
+		if (codePoint < 0x80)
+		{
+			out += (char)codePoint;
+		}
+		else if (codePoint < 0x800)
+		{
+			out += (char)(0xC0 | (codePoint >> 6));
+			out += (char)(0x80 | (codePoint & 0x3F));
+		}
+		else if (codePoint < 0x10000)
+		{
+			out += (char)(0xE0 | (codePoint >> 12));
+			out += (char)(0x80 | ((codePoint >> 6) & 0x3F));
+			out += (char)(0x80 | (codePoint & 0x3F));
+		}
+		else
+		{
+			out += (char)(0xF0 | (codePoint >> 18));
+			out += (char)(0x80 | ((codePoint >> 12) & 0x3F));
+			out += (char)(0x80 | ((codePoint >> 6) & 0x3F));
+			out += (char)(0x80 | (codePoint & 0x3F));
+		}
+	}
+}
+
+void JsonStreamParser::reset(JsonDocument* doc)
+{
+	this->doc = doc;
+	doc->clear();
+	state = State::VALUE;
+	depth = 0;
+	key.clear();
+	text.clear();
+	stringIsKey = false;
+	escape = 0;
+	codePoint = 0;
+	highSurrogate = 0;
+}
+
+template <typename T>
+bool JsonStreamParser::store(const T& value)
+{
+	if (depth == 0)
+		return doc->set(value);
+
+	Frame& frame = stack[depth - 1];
+	if (!frame.object.isNull())
+		return frame.object[key].set(value);
+
+	return frame.array.add(value);
+}
+
+bool JsonStreamParser::parse(const char* data, size_t length)
+{
+	for (size_t i = 0; i < length && state != State::ERROR; i++)
+	{
+		if (!parseChar(data[i]))
+			state = State::ERROR;
+	}
+
+	return state != State::ERROR;
+}
+
+bool JsonStreamParser::finish()
+{
+	// A number or literal at the top level only ends with the input
+	if (state == State::NUMBER && !endNumber())
+		state = State::ERROR;
+	else if (state == State::LITERAL && !endLiteral())
+		state = State::ERROR;
+
+	return state == State::DONE;
+}
+
+bool JsonStreamParser::parseChar(char c)
+{
+	switch (state)
+	{
+		case State::VALUE:
+		case State::FIRST_VALUE:
+			if (isWhitespace(c))
+				return true;
+			if (c == ']' && state == State::FIRST_VALUE)
+				return endContainer();
+			if (c == '{' || c == '[')
+				return beginContainer(c == '{');
+
+			text.clear();
+			if (c == '"')
+			{
+				stringIsKey = false;
+				state = State::STRING;
+				return true;
+			}
+			text += c;
+			if (c == '-' || (c >= '0' && c <= '9'))
+			{
+				state = State::NUMBER;
+				return true;
+			}
+			if (c == 't' || c == 'f' || c == 'n')
+			{
+				state = State::LITERAL;
+				return true;
+			}
+			return false;
+
+		case State::FIRST_KEY:
+		case State::KEY:
+			if (isWhitespace(c))
+				return true;
+			if (c == '}' && state == State::FIRST_KEY)
+				return endContainer();
+			if (c != '"')
+				return false;
+
+			text.clear();
+			stringIsKey = true;
+			state = State::STRING;
+			return true;
+
+		case State::COLON:
+			if (isWhitespace(c))
+				return true;
+			if (c != ':')
+				return false;
+
+			state = State::VALUE;
+			return true;
+
+		case State::STRING:
+			if (escape != 0)
+				return parseEscape(c);
+			if (c == '\\')
+			{
+				escape = 1;
+				return true;
+			}
+			if (c == '"')
+				return endString();
+			if ((uint8_t)c < 0x20)
+				return false;
+
+			text += c;
+			return true;
+
+		case State::NUMBER:
+			if ((c >= '0' && c <= '9') || c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-')
+			{
+				text += c;
+				return text.length() <= MAX_NUMBER_LENGTH;
+			}
+			// The character that ended the number still has to be handled
+			return endNumber() && parseChar(c);
+
+		case State::LITERAL:
+			if (c >= 'a' && c <= 'z')
+			{
+				text += c;
+				return text.length() <= MAX_LITERAL_LENGTH;
+			}
+			return endLiteral() && parseChar(c);
+
+		case State::AFTER_VALUE:
+		{
+			if (isWhitespace(c))
+				return true;
+
+			const bool inObject = !stack[depth - 1].object.isNull();
+			if (c == ',')
+			{
+				state = inObject ? State::KEY : State::VALUE;
+				return true;
+			}
+			if ((c == '}' && inObject) || (c == ']' && !inObject))
+				return endContainer();
+			return false;
+		}
+
+		case State::DONE:
+			return isWhitespace(c);
+
+		default:
+			return false;
+	}
+}
+
+bool JsonStreamParser::parseEscape(char c)
+{
+	if (escape == 1)
+	{
+		escape = 0;
+		switch (c)
+		{
+			case '"': text += '"'; return true;
+			case '\\': text += '\\'; return true;
+			case '/': text += '/'; return true;
+			case 'b': text += '\b'; return true;
+			case 'f': text += '\f'; return true;
+			case 'n': text += '\n'; return true;
+			case 'r': text += '\r'; return true;
+			case 't': text += '\t'; return true;
+			case 'u':
+				escape = 2;
+				codePoint = 0;
+				return true;
+			default:
+				return false;
+		}
+	}
+
+	// \uXXXX, escape counts the hex digits read so far
+	const int value = hexValue(c);
+	if (value < 0)
+		return false;
+
+	codePoint = (codePoint << 4) | value;
+	if (++escape < 6)
+		return true;
+
+	escape = 0;
+	if (codePoint >= 0xD800 && codePoint <= 0xDBFF)
+	{
+		highSurrogate = codePoint;
+	}
+	else if (codePoint >= 0xDC00 && codePoint <= 0xDFFF && highSurrogate != 0)
+	{
+		appendUtf8(text, 0x10000 + ((uint32_t)(highSurrogate - 0xD800) << 10) + (codePoint - 0xDC00));
+		highSurrogate = 0;
+	}
+	else
+	{
+		appendUtf8(text, codePoint);
+	}
+
+	return true;
+}
+
+bool JsonStreamParser::beginContainer(bool isObject)
+{
+	if (depth == MAX_DEPTH)
+		return false;
+
+	Frame frame;
+	if (depth == 0)
+	{
+		if (isObject)
+			frame.object = doc->to<JsonObject>();
+		else
+			frame.array = doc->to<JsonArray>();
+	}
+	else
+	{
+		Frame& parent = stack[depth - 1];
+		if (!parent.object.isNull())
+		{
+			if (isObject)
+				frame.object = parent.object.createNestedObject(key);
+			else
+				frame.array = parent.object.createNestedArray(key);
+		}
+		else
+		{
+			if (isObject)
+				frame.object = parent.array.createNestedObject();
+			else
+				frame.array = parent.array.createNestedArray();
+		}
+	}
+
+	// A null container means the document ran out of memory
+	if (isObject ? frame.object.isNull() : frame.array.isNull())
+		return false;
+
+	stack[depth++] = frame;
+	state = isObject ? State::FIRST_KEY : State::FIRST_VALUE;
+	return true;
+}
+
+bool JsonStreamParser::endContainer()
+{
+	depth--;
+	return endValue();
+}
+
+bool JsonStreamParser::endValue()
+{
+	state = depth == 0 ? State::DONE : State::AFTER_VALUE;
+	return true;
+}
+
+bool JsonStreamParser::endString()
+{
+	if (stringIsKey)
+	{
+		key = text;
+		state = State::COLON;
+		return true;
+	}
+
+	return store(text) && endValue();
+}
+
+bool JsonStreamParser::endNumber()
+{
+	const char* begin = text.c_str();
+	char* end = nullptr;
+
+	// Integers are kept as such so they can be read back into the option structs without rounding
+	if (text.find_first_of(".eE") == std::string::npos)
+	{
+		const long long value = strtoll(begin, &end, 10);
+		if (end != begin && *end == '\0')
+		{
+			if (value >= INT32_MIN && value <= INT32_MAX)
+				return store((int32_t)value) && endValue();
+			if (value >= 0 && value <= UINT32_MAX)
+				return store((uint32_t)value) && endValue();
+		}
+	}
+
+	const double value = strtod(begin, &end);
+	if (end == begin || *end != '\0')
+		return false;
+
+	return store(value) && endValue();
+}
+
+bool JsonStreamParser::endLiteral()
+{
+	if (text == "true")
+		return store(true) && endValue();
+	if (text == "false")
+		return store(false) && endValue();
+	if (text == "null")
+		return store(nullptr) && endValue();
+	return false;
+}
@@ -1,12 +1,21 @@
 #include "configs/webconfig.h"
 #include "configs/base64.h"
+#include "configs/jsonstreamparser.h"
 
 #include "storagemanager.h"
 #include "configmanager.h"
 #include "AnimationStorage.hpp"
 #include "system.h"
-
+#include "adcsampler.h"
+#include "buttonmatrix.h"
+#include "inputrecorder.h"
+#include "addons/wiiext.h"
+#include "splashcodec.h"
+#include "usb_driver.h"
+
+#include <algorithm>
 #include <cstring>
+#include <deque>
 #include <string>
 #include <vector>
 
@@ -27,17 +36,56 @@
 #define PATH_CGI_ACTION "/cgi/action"
 
 #define LWIP_HTTPD_POST_MAX_PAYLOAD_LEN 4096
+#define LWIP_HTTPD_POST_MAX_CONTENT_LEN (16 * 1024)
+#define LWIP_HTTPD_POST_MAX_DOC_LEN LWIP_HTTPD_POST_MAX_PAYLOAD_LEN // As large as the document the old payload buffer was parsed into
+#define LWIP_HTTPD_POST_MAX_LARGE_DOC_LEN (2 * LWIP_HTTPD_POST_MAX_PAYLOAD_LEN) // The old payload buffer and document together
+#define LWIP_HTTPD_BATCH_MAX_RESPONSE_LEN (4 * LWIP_HTTPD_POST_MAX_PAYLOAD_LEN)
+#define LWIP_HTTPD_POST_MAX_BINARY_LEN std::max<int>(SETTINGS_SNAPSHOT_MAX_SIZE, INPUT_TRACE_MAX_SIZE)
+#define API_PREFIX "/api/"
 
 using namespace std;
 
 extern struct fsdata_file file__index_html[];
 
-const static vector<string> spaPaths = { "/display-config", "/led-config", "/pin-mapping", "/keyboard-mapping", "/settings", "/reset-settings", "/add-ons", "/custom-theme" };
-const static vector<string> excludePaths = { "/css", "/images", "/js", "/static" };
+typedef DynamicJsonDocument (*HandlerFuncPtr)();
+typedef int (*OpenFuncPtr)(struct fs_file *file, uint8_t method);
+
+enum class RouteType : uint8_t
+{
+	HANDLER, // JSON API handler
+	OPEN,    // Sets up a custom response itself
+	SPA,     // Client side route of the React app, served with index.html
+	EXCLUDE, // Never handled here, always looked up in fsdata
+};
+
+enum RouteFlags : uint8_t
+{
+	ROUTE_GET = 1 << 0,
+	ROUTE_POST = 1 << 1,
+	ROUTE_BINARY_BODY = 1 << 2, // The POST body is kept as received instead of parsed as JSON
+	ROUTE_LARGE_BODY = 1 << 3,  // The POST body is parsed into a larger document, for requests that bundle several payloads
+};
+
+struct Route
+{
+	const char* path;
+	RouteType type;
+	uint8_t flags;
+	HandlerFuncPtr handler = nullptr;
+	OpenFuncPtr open = nullptr;
+};
+
+static const Route* find_route(const char* path);
+
 const static uint32_t rebootDelayMs = 500;
-static string http_post_uri;
-static char http_post_payload[LWIP_HTTPD_POST_MAX_PAYLOAD_LEN];
-static uint16_t http_post_payload_len = 0;
+static const Route* http_post_route = nullptr;    // Route of the POST request being received
+static const Route* http_post_response = nullptr; // Route whose response httpd opens next
+static DynamicJsonDocument http_post_doc(0);
+static JsonStreamParser http_post_parser;
+static int http_post_length = 0;
+static bool http_post_error = false;
+static bool http_post_binary = false;
+static vector<uint8_t> http_post_data; // Raw body of binary POST requests
 static absolute_time_t rebootDelayTimeout = nil_time;
 static System::BootMode rebootMode = System::BootMode::DEFAULT;
 
@@ -112,44 +160,352 @@ void WebConfig::setup() {
 	rndis_init();
 }
 
+void poll_gamepad_streams();
+
 void WebConfig::loop() {
 	// rndis http server requires inline functions (non-class)
 	rndis_task();
 
+	poll_gamepad_streams();
+
 	if (!is_nil_time(rebootDelayTimeout) && time_reached(rebootDelayTimeout)) {
 		System::reboot(rebootMode);
 	}
 }
 
 // **** WEB SERVER Overrides and Special Functionality ****
-int set_file_data(struct fs_file *file, string data)
+
+// Body of a custom file that is produced while the connection drains, owned by fs_file::pextension
+class CustomResponse
+{
+public:
+	virtual ~CustomResponse() {}
+	virtual int read(struct fs_file *file, char *buffer, int count) = 0;
+
+	// Responses that are not ready yet store the callback and invoke it once they are
+	virtual bool canRead() { return true; }
+	virtual void waitRead(fs_wait_cb callback, void *arg) {}
+};
+
+// ArduinoJson writer that drops everything before offset and stops filling buffer once it is full
+class JsonChunkWriter
+{
+public:
+	JsonChunkWriter(char* buffer, int size, int offset) : buffer(buffer), size(size), skip(offset), written(0) {}
+
+	size_t write(uint8_t c)
+	{
+		return write(&c, 1);
+	}
+
+	size_t write(const uint8_t* s, size_t n)
+	{
+		const size_t total = n;
+		if (skip > 0)
+		{
+			const size_t skipped = std::min<size_t>(n, skip);
+			skip -= skipped;
+			s += skipped;
+			n -= skipped;
+		}
+
+		const size_t count = std::min<size_t>(n, size - written);
+		memcpy(buffer + written, s, count);
+		written += count;
+		return total;
+	}
+
+	int getWritten() const { return written; }
+
+private:
+	char* buffer;
+	int size;
+	int skip;
+	int written;
+};
+
+// ArduinoJson writer that only counts the characters
+class JsonLengthWriter
 {
-	static string returnData;
-	returnData.clear();
-	returnData.append(
-		"HTTP/1.0 200 OK\r\n"
+public:
+	size_t write(uint8_t c) { return 1; }
+	size_t write(const uint8_t* s, size_t n) { return n; }
+};
+
+// Serializes a document one piece at a time: an opening bracket, a closing bracket, a separator together with
+// the key that follows it, or a value that is not a container. The position in the document is kept between
+// chunks, so a chunk only repeats the piece the previous one was cut off in.
+class JsonPieceSerializer
+{
+public:
+	void begin(JsonVariantConst root)
+	{
+		this->root = root;
+		depth = 0;
+		step = Step::VALUE;
+		pieceOffset = 0;
+	}
+
+	// Fills buffer with the pieces that follow, returns the characters written
+	int read(char* buffer, int count);
+
+	// Length of the serialized document, the serializer starts over from the beginning afterwards
+	size_t measure();
+
+private:
+	enum class Step : uint8_t
+	{
+		VALUE, // The value under the iterator of the innermost container, or the root
+		NEXT,  // The separator and key of the next member, or the closing bracket
+		DONE,
+	};
+
+	struct Frame
+	{
+		bool isObject;
+		bool first;
+		JsonObjectConst object;
+		JsonObjectConst::iterator member;
+		JsonArrayConst array;
+		JsonArrayConst::iterator element;
+
+		bool atEnd() const { return isObject ? member == object.end() : element == array.end(); }
+	};
+
+	JsonVariantConst current() const;
+	bool opens(JsonVariantConst value) const;
+	template <typename Writer> size_t writePiece(Writer& writer);
+	void advance();
+
+	JsonVariantConst root;
+	Frame stack[ARDUINOJSON_DEFAULT_NESTING_LIMIT];
+	uint8_t depth;
+	Step step;
+	size_t pieceOffset; // Characters of the current piece that were written already
+};
+
+// Letter of the escape sequence that stands for c in a JSON string, 0 when c is written as is
+static char json_escape(char c)
+{
+	switch (c)
+	{
+		case '"': return '"';
+		case '\\': return '\\';
+		case '\b': return 'b';
+		case '\f': return 'f';
+		case '\n': return 'n';
+		case '\r': return 'r';
+		case '\t': return 't';
+		default: return 0;
+	}
+}
+
+JsonVariantConst JsonPieceSerializer::current() const
+{
+	if (depth == 0)
+		return root;
+
+	const Frame& frame = stack[depth - 1];
+	return frame.isObject ? frame.member->value() : *frame.element;
+}
+
+// Containers nested deeper than the stack are written as a single piece
+bool JsonPieceSerializer::opens(JsonVariantConst value) const
+{
+	return depth < ARDUINOJSON_DEFAULT_NESTING_LIMIT && (value.is<JsonObjectConst>() || value.is<JsonArrayConst>());
+}
+
+template <typename Writer>
+size_t JsonPieceSerializer::writePiece(Writer& writer)
+{
+	if (step == Step::VALUE)
+	{
+		const JsonVariantConst value = current();
+		if (opens(value))
+			return writer.write(value.is<JsonObjectConst>() ? '{' : '[');
+		return serializeJson(value, writer);
+	}
+
+	const Frame& frame = stack[depth - 1];
+	if (frame.atEnd())
+		return writer.write(frame.isObject ? '}' : ']');
+
+	size_t length = frame.first ? 0 : writer.write(',');
+	if (frame.isObject)
+	{
+		// Escaped the same way ArduinoJson escapes strings
+		const JsonString key = frame.member->key();
+		length += writer.write('"');
+		for (size_t i = 0; i < key.size(); i++)
+		{
+			const char c = key.c_str()[i];
+			const char escaped = json_escape(c);
+			if (escaped != 0)
+			{
+				length += writer.write('\\');
+				length += writer.write(escaped);
+			}
+			else
+			{
+				length += writer.write(c);
+			}
+		}
+		length += writer.write('"');
+		length += writer.write(':');
+	}
+	return length;
+}
+
+void JsonPieceSerializer::advance()
+{
+	if (step == Step::VALUE)
+	{
+		const JsonVariantConst value = current();
+		const bool container = opens(value);
+
+		// The parent moves on before the value's own members are walked
+		if (depth > 0)
+		{
+			Frame& parent = stack[depth - 1];
+			if (parent.isObject)
+				++parent.member;
+			else
+				++parent.element;
+		}
+
+		if (container)
+		{
+			Frame& frame = stack[depth++];
+			frame.isObject = value.is<JsonObjectConst>();
+			frame.first = true;
+			frame.object = value.as<JsonObjectConst>();
+			frame.member = frame.object.begin();
+			frame.array = value.as<JsonArrayConst>();
+			frame.element = frame.array.begin();
+		}
+		step = depth == 0 ? Step::DONE : Step::NEXT;
+		return;
+	}
+
+	Frame& frame = stack[depth - 1];
+	if (frame.atEnd())
+	{
+		depth--;
+		step = depth == 0 ? Step::DONE : Step::NEXT;
+	}
+	else
+	{
+		frame.first = false;
+		step = Step::VALUE;
+	}
+}
+
+int JsonPieceSerializer::read(char* buffer, int count)
+{
+	int read = 0;
+	while (step != Step::DONE && read < count)
+	{
+		JsonChunkWriter writer(buffer + read, count - read, pieceOffset);
+		const size_t length = writePiece(writer);
+		read += writer.getWritten();
+		if (pieceOffset + writer.getWritten() < length)
+		{
+			pieceOffset += writer.getWritten();
+			break;
+		}
+
+		pieceOffset = 0;
+		advance();
+	}
+	return read;
+}
+
+size_t JsonPieceSerializer::measure()
+{
+	JsonLengthWriter writer;
+	size_t length = 0;
+	while (step != Step::DONE)
+	{
+		length += writePiece(writer);
+		advance();
+	}
+
+	begin(root);
+	return length;
+}
+
+// A JSON response that is serialized straight into the httpd send buffer as the connection drains,
+// so the full response text never has to be held in memory
+class JsonResponse : public CustomResponse
+{
+public:
+	JsonResponse(DynamicJsonDocument&& doc) : doc(std::move(doc))
+	{
+		this->doc.shrinkToFit();
+		System::trackAllocation(System::MemoryCategory::JSON, this->doc.capacity());
+		serializer.begin(this->doc.as<JsonVariantConst>());
+	}
+
+	~JsonResponse()
+	{
+		System::trackFree(System::MemoryCategory::JSON, doc.capacity());
+	}
+
+	int read(struct fs_file *file, char *buffer, int count) override;
+
+	DynamicJsonDocument doc;
+	JsonPieceSerializer serializer;
+	char header[128];
+	int headerLength;
+};
+
+int JsonResponse::read(struct fs_file *file, char *buffer, int count)
+{
+	int read = 0;
+	if (file->index < headerLength)
+	{
+		read = std::min(count, headerLength - file->index);
+		memcpy(buffer, header + file->index, read);
+	}
+
+	// The serializer carries on where the previous chunk stopped
+	if (read < count)
+		read += serializer.read(buffer + read, count - read);
+
+	file->index += read;
+	return read;
+}
+
+int set_file_data(struct fs_file *file, DynamicJsonDocument&& doc)
+{
+	JsonResponse* response = new JsonResponse(std::move(doc));
+
+	// The length is measured up front so the header can go out before any of the body is serialized
+	const size_t contentLength = response->serializer.measure();
+	response->headerLength = snprintf(response->header, sizeof(response->header),
+		"HTTP/1.1 200 OK\r\n"
 		"Server: GP2040-CE " GP2040VERSION "\r\n"
 		"Content-Type: application/json\r\n"
-		"Content-Length: "
+		"Content-Length: %u\r\n"
+		"Connection: keep-alive\r\n\r\n",
+		static_cast<unsigned int>(contentLength)
 	);
-	returnData.append(std::to_string(data.length()));
-	returnData.append("\r\n\r\n");
-	returnData.append(data);
 
-	file->data = returnData.c_str();
-	file->len = returnData.size();
-	file->index = file->len;
-	file->http_header_included = file->http_header_included;
-	file->pextension = NULL;
+	file->data = NULL;
+	file->len = response->headerLength + contentLength;
+	file->index = 0;
+	// The Content-Length is exact, so the connection can be kept open for the next request
+	file->http_header_included = FS_FILE_FLAGS_HEADER_INCLUDED | FS_FILE_FLAGS_HEADER_PERSISTENT | FS_FILE_FLAGS_HEADER_HTTPVER_1_1;
+	file->pextension = response;
 
 	return 1;
 }
 
+// Hands the body of the current POST request, parsed while it was received, over to the handler
 DynamicJsonDocument get_post_data()
 {
-	DynamicJsonDocument doc(LWIP_HTTPD_POST_MAX_PAYLOAD_LEN);
-	deserializeJson(doc, http_post_payload, http_post_payload_len);
-	return doc;
+	System::trackFree(System::MemoryCategory::JSON, http_post_doc.capacity());
+	return std::move(http_post_doc);
 }
 
 // LWIP callback on HTTP POST to validate the URI
@@ -159,18 +515,41 @@ err_t httpd_post_begin(void *connection, const char *uri, const char *http_reque
 {
 	LWIP_UNUSED_ARG(http_request);
 	LWIP_UNUSED_ARG(http_request_len);
-	LWIP_UNUSED_ARG(content_len);
 	LWIP_UNUSED_ARG(response_uri);
 	LWIP_UNUSED_ARG(response_uri_len);
 	LWIP_UNUSED_ARG(post_auto_wnd);
 
-	if (!uri || strncmp(uri, "/api", 4) != 0) {
+	const Route* route = uri ? find_route(uri) : nullptr;
+	if (route == nullptr || (route->flags & ROUTE_POST) == 0) {
 		return ERR_ARG;
 	}
 
-	http_post_uri = uri;
-	http_post_payload_len = 0;
-	memset(http_post_payload, 0, LWIP_HTTPD_POST_MAX_PAYLOAD_LEN);
+	if (content_len > LWIP_HTTPD_POST_MAX_CONTENT_LEN) {
+		return ERR_MEM;
+	}
+
+	http_post_route = route;
+	http_post_length = 0;
+	http_post_error = false;
+
+	// Binary bodies, settings snapshots and input traces, are kept as received
+	http_post_binary = (route->flags & ROUTE_BINARY_BODY) != 0;
+	if (http_post_binary) {
+		if (content_len > LWIP_HTTPD_POST_MAX_BINARY_LEN) {
+			return ERR_MEM;
+		}
+		http_post_data.clear();
+		http_post_data.reserve(std::max(content_len, 0));
+		return ERR_OK;
+	}
+
+	// The parsed document copies all keys and strings, twice the body size covers the typical option payloads.
+	// The size is capped per route, so a save never needs more memory than the old payload buffer and document did.
+	const int docLimit = (route->flags & ROUTE_LARGE_BODY) ? LWIP_HTTPD_POST_MAX_LARGE_DOC_LEN : LWIP_HTTPD_POST_MAX_DOC_LEN;
+	System::trackFree(System::MemoryCategory::JSON, http_post_doc.capacity());
+	http_post_doc = DynamicJsonDocument(std::min(std::max(content_len, 0) * 2 + 1024, docLimit));
+	System::trackAllocation(System::MemoryCategory::JSON, http_post_doc.capacity());
+	http_post_parser.reset(&http_post_doc);
 	return ERR_OK;
 }
 
@@ -179,28 +558,28 @@ err_t httpd_post_receive_data(void *connection, struct pbuf *p)
 {
 	LWIP_UNUSED_ARG(connection);
 
-	// Cache the received data to http_post_payload
-	while (p != NULL)
+	// Parse the received data as it arrives, nothing of the raw body is kept
+	for (struct pbuf *q = p; q != NULL && !http_post_error; q = q->next)
 	{
-		if (http_post_payload_len + p->len <= LWIP_HTTPD_POST_MAX_PAYLOAD_LEN)
+		if (http_post_binary)
 		{
-			MEMCPY(http_post_payload + http_post_payload_len, p->payload, p->len);
-			http_post_payload_len += p->len;
+			const uint8_t* payload = static_cast<const uint8_t*>(q->payload);
+			http_post_error = http_post_data.size() + q->len > LWIP_HTTPD_POST_MAX_BINARY_LEN;
+			if (!http_post_error)
+				http_post_data.insert(http_post_data.end(), payload, payload + q->len);
 		}
-		else // Buffer overflow
+		else
 		{
-			http_post_payload_len = 0xffff;
-			break;
+			http_post_error = !http_post_parser.parse(static_cast<const char*>(q->payload), q->len);
 		}
-
-		p = p->next;
+		http_post_length += q->len;
 	}
 
-	// Need to release memory here or will leak
+	// Need to release memory here or will leak, this has to be the head of the chain
 	pbuf_free(p);
 
-	// If the buffer overflows, error out
-	if (http_post_payload_len == 0xffff) {
+	// If the body is malformed or does not fit into the document, error out
+	if (http_post_error) {
 		return ERR_BUF;
 	}
 
@@ -212,9 +591,10 @@ void httpd_post_finished(void *connection, char *response_uri, uint16_t response
 {
 	LWIP_UNUSED_ARG(connection);
 
-	if (http_post_payload_len != 0xffff) {
-		strncpy(response_uri, http_post_uri.c_str(), response_uri_len);
+	if (!http_post_error && (http_post_binary || http_post_length == 0 || http_post_parser.finish())) {
+		strncpy(response_uri, http_post_route->path, response_uri_len);
 		response_uri[response_uri_len - 1] = '\0';
+		http_post_response = http_post_route;
 	}
 }
 
@@ -230,6 +610,15 @@ void addUsedPinsArray(DynamicJsonDocument& doc)
 		}
 	};
 
+#ifdef BUTTON_MATRIX_ROW_PINS
+	// The button settings number matrix keys, the pins belong to the matrix rows and columns
+	const uint32_t matrixPins = ButtonMatrix::getInstance().getPinMask();
+	for (int pin = 0; pin < NUM_BANK0_GPIOS; pin++)
+	{
+		if (matrixPins & (1u << pin))
+			addPinIfValid(pin);
+	}
+#else
 	const BoardOptions& boardOptions = Storage::getInstance().getBoardOptions();
 	addPinIfValid(boardOptions.pinDpadUp);
 	addPinIfValid(boardOptions.pinDpadDown);
@@ -249,6 +638,7 @@ void addUsedPinsArray(DynamicJsonDocument& doc)
 	addPinIfValid(boardOptions.pinButtonR3);
 	addPinIfValid(boardOptions.pinButtonA1);
 	addPinIfValid(boardOptions.pinButtonA2);
+#endif
 	// TODO: Exclude non-button pins from validation for now, fix this when validation reworked
 	// addPinIfValid(boardOptions.i2cSDAPin);
 	// addPinIfValid(boardOptions.i2cSCLPin);
@@ -260,21 +650,32 @@ void addUsedPinsArray(DynamicJsonDocument& doc)
 	// addPinIfValid(addonOptions.buzzerPin);
 }
 
-std::string serialize_json(JsonDocument &doc)
+DynamicJsonDocument success_response(bool success)
 {
-	string data;
-	serializeJson(doc, data);
-	return data;
+	DynamicJsonDocument doc(JSON_OBJECT_SIZE(1));
+	doc["success"] = success;
+	return doc;
 }
 
-std::string getUsedPins()
+DynamicJsonDocument getUsedPins()
 {
-	DynamicJsonDocument doc(LWIP_HTTPD_POST_MAX_PAYLOAD_LEN);
+	DynamicJsonDocument doc(JSON_OBJECT_SIZE(1) + JSON_ARRAY_SIZE(NUM_BANK0_GPIOS + 2)); // The button pins and both analog pins
 	addUsedPinsArray(doc);
-	return serialize_json(doc);
+	return doc;
+}
+
+// Uncalibrated readings of the analog add-on stick, used to capture its calibration
+DynamicJsonDocument getAnalogRaw()
+{
+	DynamicJsonDocument doc(JSON_OBJECT_SIZE(2));
+	const AddonOptions& addonOptions = Storage::getInstance().getAddonOptions();
+	const AdcSampler& adcSampler = AdcSampler::getInstance();
+	writeDoc(doc, "x", addonOptions.analogAdcPinX == 0xFF ? -1 : adcSampler.getValue(addonOptions.analogAdcPinX));
+	writeDoc(doc, "y", addonOptions.analogAdcPinY == 0xFF ? -1 : adcSampler.getValue(addonOptions.analogAdcPinY));
+	return doc;
 }
 
-std::string setDisplayOptions(BoardOptions& boardOptions)
+DynamicJsonDocument setDisplayOptions(BoardOptions& boardOptions)
 {
 	DynamicJsonDocument doc = get_post_data();
 	readDoc(boardOptions.hasI2CDisplay, doc, "enabled");
@@ -304,28 +705,28 @@ std::string setDisplayOptions(BoardOptions& boardOptions)
 	readDoc(boardOptions.buttonLayoutCustomOptions.paramsRight.buttonRadius, doc, "buttonLayoutCustomOptions", "paramsRight", "buttonRadius");
 	readDoc(boardOptions.buttonLayoutCustomOptions.paramsRight.buttonPadding, doc, "buttonLayoutCustomOptions", "paramsRight", "buttonPadding");
 
-	return serialize_json(doc);
+	return doc;
 }
 
-std::string setDisplayOptions()
+DynamicJsonDocument setDisplayOptions()
 {
 	BoardOptions boardOptions = Storage::getInstance().getBoardOptions();
-	std::string response = setDisplayOptions(boardOptions);
+	DynamicJsonDocument response = setDisplayOptions(boardOptions);
 	ConfigManager::getInstance().setBoardOptions(boardOptions);
 	return response;
 }
 
-std::string setPreviewDisplayOptions()
+DynamicJsonDocument setPreviewDisplayOptions()
 {
 	BoardOptions boardOptions = Storage::getInstance().getPreviewBoardOptions();
-	std::string response = setDisplayOptions(boardOptions);
+	DynamicJsonDocument response = setDisplayOptions(boardOptions);
 	ConfigManager::getInstance().setPreviewBoardOptions(boardOptions);
 	return response;
 }
 
-std::string getDisplayOptions() // Manually set Document Attributes for the display
+DynamicJsonDocument getDisplayOptions() // Manually set Document Attributes for the display
 {
-	DynamicJsonDocument doc(LWIP_HTTPD_POST_MAX_PAYLOAD_LEN);
+	DynamicJsonDocument doc(JSON_OBJECT_SIZE(15) + JSON_OBJECT_SIZE(2) + 2 * JSON_OBJECT_SIZE(5));
 	const BoardOptions& boardOptions = Storage::getInstance().getBoardOptions();
 	writeDoc(doc, "enabled", boardOptions.hasI2CDisplay ? 1 : 0);
 	writeDoc(doc, "sdaPin", boardOptions.i2cSDAPin == 0xFF ? -1 : boardOptions.i2cSDAPin);
@@ -354,35 +755,46 @@ std::string getDisplayOptions() // Manually set Document Attributes for the disp
 	writeDoc(doc, "buttonLayoutCustomOptions", "paramsRight", "buttonRadius", boardOptions.buttonLayoutCustomOptions.paramsRight.buttonRadius);
 	writeDoc(doc, "buttonLayoutCustomOptions", "paramsRight", "buttonPadding", boardOptions.buttonLayoutCustomOptions.paramsRight.buttonPadding);
 
-	return serialize_json(doc);
+	return doc;
 }
 
 SplashImage splashImageTemp; // For splash image upload
 
-std::string getSplashImage()
+DynamicJsonDocument getSplashImage()
 {
-	DynamicJsonDocument doc(LWIP_HTTPD_POST_MAX_PAYLOAD_LEN * 10); // TODO: Figoure out correct length
 	const SplashImage& splashImage = Storage::getInstance().getSplashImage();
-	JsonArray splashImageArray = doc.createNestedArray("splashImage");
-	copyArray(splashImage.data, splashImageArray);
+	std::string encoded = Base64::Encode(std::string((const char*)splashImage.data, splashImage.size));
+	DynamicJsonDocument doc(JSON_OBJECT_SIZE(3) + JSON_STRING_SIZE(encoded.size()));
+	doc["splashImage"] = encoded;
+	doc["frameCount"] = splashImage.frameCount;
+	doc["frameDelay"] = splashImage.frameDelay;
 
-	return serialize_json(doc);
+	return doc;
 }
 
-std::string setSplashImage()
+DynamicJsonDocument setSplashImage()
 {
 	DynamicJsonDocument doc = get_post_data();
 	std::string decoded;
 	std::string base64String = doc["splashImage"];
-	Base64::Decode(base64String, decoded);
-	memcpy(splashImageTemp.data, decoded.data(), std::min(decoded.length(), sizeof(splashImageTemp.data)));
+	if (!Base64::Decode(base64String, decoded) || decoded.length() > sizeof(splashImageTemp.data))
+		return success_response(false);
+
+	memset(&splashImageTemp, 0, sizeof(splashImageTemp));
+	memcpy(splashImageTemp.data, decoded.data(), decoded.length());
+	splashImageTemp.size = decoded.length();
+	splashImageTemp.frameCount = doc["frameCount"] | 1;
+	splashImageTemp.frameDelay = doc["frameDelay"] | 0;
+	if (!SplashCodec::validate(splashImageTemp.data, splashImageTemp.size, splashImageTemp.frameCount))
+		return success_response(false);
+
 	splashImageTemp.checksum = CHECKSUM_MAGIC;
 	ConfigManager::getInstance().setSplashImage(splashImageTemp);
 
-	return serialize_json(doc);
+	return success_response(true);
 }
 
-std::string setGamepadOptions()
+DynamicJsonDocument setGamepadOptions()
 {
 	DynamicJsonDocument doc = get_post_data();
 	Gamepad * gamepad = Storage::getInstance().GetGamepad();
@@ -402,12 +814,12 @@ std::string setGamepadOptions()
 	readDoc(gamepad->options.hotkeyF2Right.action, doc, "hotkeyF2", 3, "action");
 
 	ConfigManager::getInstance().setGamepadOptions(gamepad);
-	return serialize_json(doc);
+	return doc;
 }
 
-std::string getGamepadOptions()
+DynamicJsonDocument getGamepadOptions()
 {
-	DynamicJsonDocument doc(LWIP_HTTPD_POST_MAX_PAYLOAD_LEN);
+	DynamicJsonDocument doc(JSON_OBJECT_SIZE(5) + 2 * JSON_ARRAY_SIZE(4) + 8 * JSON_OBJECT_SIZE(2));
 	GamepadOptions options = GamepadStore.getGamepadOptions();
 
 	writeDoc(doc, "dpadMode", options.dpadMode);
@@ -432,10 +844,10 @@ std::string getGamepadOptions()
 	writeDoc(doc, "hotkeyF2", 3, "action", options.hotkeyF2Right.action);
 	writeDoc(doc, "hotkeyF2", 3, "mask", options.hotkeyF2Right.dpadMask);
 
-	return serialize_json(doc);
+	return doc;
 }
 
-std::string setLedOptions()
+DynamicJsonDocument setLedOptions()
 {
 	DynamicJsonDocument doc = get_post_data();
 
@@ -483,12 +895,12 @@ std::string setLedOptions()
 	readDoc(pledColor, doc, "pledColor");
 	ledOptions.pledColor = RGB(pledColor);
 	ConfigManager::getInstance().setLedOptions(ledOptions);
-	return serialize_json(doc);
+	return doc;
 }
 
-std::string getLedOptions()
+DynamicJsonDocument getLedOptions()
 {
-	DynamicJsonDocument doc(LWIP_HTTPD_POST_MAX_PAYLOAD_LEN);
+	DynamicJsonDocument doc(JSON_OBJECT_SIZE(13) + JSON_OBJECT_SIZE(18));
 	const LEDOptions& ledOptions = Storage::getInstance().getLEDOptions();
 	writeDoc(doc, "dataPin", ledOptions.dataPin);
 	writeDoc(doc, "ledFormat", ledOptions.ledFormat);
@@ -533,10 +945,10 @@ std::string getLedOptions()
 	writeDoc(doc, "pledPin4", ledOptions.pledPin4);
 	writeDoc(doc, "pledColor", ((RGB)ledOptions.pledColor).value(LED_FORMAT_RGB));
 
-	return serialize_json(doc);
+	return doc;
 }
 
-std::string setCustomTheme()
+DynamicJsonDocument setCustomTheme()
 {
 	DynamicJsonDocument doc = get_post_data();
 
@@ -593,12 +1005,12 @@ std::string setCustomTheme()
 	AnimationStation::SetOptions(options);
 	AnimationStore.save();
 
-	return serialize_json(doc);
+	return doc;
 }
 
-std::string getCustomTheme()
+DynamicJsonDocument getCustomTheme()
 {
-	DynamicJsonDocument doc(LWIP_HTTPD_POST_MAX_PAYLOAD_LEN);
+	DynamicJsonDocument doc(JSON_OBJECT_SIZE(19) + 18 * JSON_OBJECT_SIZE(2));
 	AnimationOptions options = AnimationStore.getAnimationOptions();
 
 	writeDoc(doc, "enabled", options.hasCustomTheme);
@@ -639,10 +1051,10 @@ std::string getCustomTheme()
 	writeDoc(doc, "R3", "u", options.customThemeR3);
 	writeDoc(doc, "R3", "d", options.customThemeR3Pressed);
 
-	return serialize_json(doc);
+	return doc;
 }
 
-std::string setPinMappings()
+DynamicJsonDocument setPinMappings()
 {
 	DynamicJsonDocument doc = get_post_data();
 
@@ -677,12 +1089,12 @@ std::string setPinMappings()
 
 	Storage::getInstance().setBoardOptions(boardOptions);
 
-	return serialize_json(doc);
+	return doc;
 }
 
-std::string getPinMappings()
+DynamicJsonDocument getPinMappings()
 {
-	DynamicJsonDocument doc(LWIP_HTTPD_POST_MAX_PAYLOAD_LEN);
+	DynamicJsonDocument doc(JSON_OBJECT_SIZE(18));
 
 	// Webconfig uses -1 to denote unassigned pins
 	const auto convertPin = [] (uint8_t pin) -> int { return pin < NUM_BANK0_GPIOS ? pin : -1; };
@@ -707,10 +1119,10 @@ std::string getPinMappings()
 	writeDoc(doc, "A1", convertPin(boardOptions.pinButtonA1));
 	writeDoc(doc, "A2", convertPin(boardOptions.pinButtonA2));
 
-	return serialize_json(doc);
+	return doc;
 }
 
-std::string setKeyMappings()
+DynamicJsonDocument setKeyMappings()
 {
 	DynamicJsonDocument doc = get_post_data();
 	Gamepad* gamepad = Storage::getInstance().GetGamepad();
@@ -735,12 +1147,12 @@ std::string setKeyMappings()
 	readDoc(gamepad->options.keyButtonA2, doc, "A2");
 
 	gamepad->save();
-	return serialize_json(doc);
+	return doc;
 }
 
-std::string getKeyMappings()
+DynamicJsonDocument getKeyMappings()
 {
-	DynamicJsonDocument doc(LWIP_HTTPD_POST_MAX_PAYLOAD_LEN);
+	DynamicJsonDocument doc(JSON_OBJECT_SIZE(18));
 	Gamepad* gamepad = Storage::getInstance().GetGamepad();
 
 	writeDoc(doc, "Up", gamepad->options.keyDpadUp);
@@ -762,10 +1174,10 @@ std::string getKeyMappings()
 	writeDoc(doc, "A1", gamepad->options.keyButtonA1);
 	writeDoc(doc, "A2", gamepad->options.keyButtonA2);
 
-	return serialize_json(doc);
+	return doc;
 }
 
-std::string setAddonOptions()
+DynamicJsonDocument setAddonOptions()
 {
 	DynamicJsonDocument doc = get_post_data();
 
@@ -788,6 +1200,7 @@ std::string setAddonOptions()
 	docToValue(addonOptions.i2cAnalog1219Block, doc, "i2cAnalog1219Block");
 	docToValue(addonOptions.i2cAnalog1219Speed, doc, "i2cAnalog1219Speed");
 	docToValue(addonOptions.i2cAnalog1219Address, doc, "i2cAnalog1219Address");
+	docToPin(addonOptions.i2cAnalog1219DRDYPin, doc, "i2cAnalog1219DRDYPin");
 	docToValue(addonOptions.onBoardLedMode, doc, "onBoardLedMode");
 	docToPin(addonOptions.pinDualDirDown, doc, "dualDirDownPin");
 	docToPin(addonOptions.pinDualDirUp, doc, "dualDirUpPin");
@@ -797,6 +1210,15 @@ std::string setAddonOptions()
 	docToValue(addonOptions.dualDirCombineMode, doc, "dualDirCombineMode");
 	docToPin(addonOptions.analogAdcPinX, doc, "analogAdcPinX");
 	docToPin(addonOptions.analogAdcPinY, doc, "analogAdcPinY");
+	docToValue(addonOptions.analogDeadzoneMode, doc, "analogDeadzoneMode");
+	docToValue(addonOptions.analogDeadzone, doc, "analogDeadzone");
+	docToValue(addonOptions.analogCurve, doc, "analogCurve");
+	docToValue(addonOptions.analogCalibration.x.min, doc, "analogCalibrationXMin");
+	docToValue(addonOptions.analogCalibration.x.center, doc, "analogCalibrationXCenter");
+	docToValue(addonOptions.analogCalibration.x.max, doc, "analogCalibrationXMax");
+	docToValue(addonOptions.analogCalibration.y.min, doc, "analogCalibrationYMin");
+	docToValue(addonOptions.analogCalibration.y.center, doc, "analogCalibrationYCenter");
+	docToValue(addonOptions.analogCalibration.y.max, doc, "analogCalibrationYMax");
 	docToValue(addonOptions.bootselButtonMap, doc, "bootselButtonMap");
 	docToPin(addonOptions.buzzerPin, doc, "buzzerPin");
 	docToValue(addonOptions.buzzerVolume, doc, "buzzerVolume");
@@ -842,10 +1264,10 @@ std::string setAddonOptions()
 
 	Storage::getInstance().setAddonOptions(addonOptions);
 
-	return serialize_json(doc);
+	return doc;
 }
 
-std::string setPS4Options()
+DynamicJsonDocument setPS4Options()
 {
 	DynamicJsonDocument doc = get_post_data();
 	PS4Options * ps4Options = Storage::getInstance().getPS4Options();
@@ -938,12 +1360,12 @@ std::string setPS4Options()
 
 	Storage::getInstance().savePS4Options();
 
-	return "{\"success\":true}";
+	return success_response(true);
 }
 
-std::string getAddonOptions()
+DynamicJsonDocument getAddonOptions()
 {
-	DynamicJsonDocument doc(LWIP_HTTPD_POST_MAX_PAYLOAD_LEN);
+	DynamicJsonDocument doc(JSON_OBJECT_SIZE(79)); // One member per writeDoc below
 	const AddonOptions& addonOptions = Storage::getInstance().getAddonOptions();
 	writeDoc(doc, "turboPin", addonOptions.pinButtonTurbo == 0xFF ? -1 : addonOptions.pinButtonTurbo);
 	writeDoc(doc, "turboPinLED", addonOptions.pinTurboLED == 0xFF ? -1 : addonOptions.pinTurboLED);
@@ -963,6 +1385,7 @@ std::string getAddonOptions()
 	writeDoc(doc, "i2cAnalog1219Block", addonOptions.i2cAnalog1219Block);
 	writeDoc(doc, "i2cAnalog1219Speed", addonOptions.i2cAnalog1219Speed);
 	writeDoc(doc, "i2cAnalog1219Address", addonOptions.i2cAnalog1219Address);
+	writeDoc(doc, "i2cAnalog1219DRDYPin", addonOptions.i2cAnalog1219DRDYPin == 0xFF ? -1 : addonOptions.i2cAnalog1219DRDYPin);
 	writeDoc(doc, "onBoardLedMode", addonOptions.onBoardLedMode);
 	writeDoc(doc, "dualDirDownPin", addonOptions.pinDualDirDown == 0xFF ? -1 : addonOptions.pinDualDirDown);
 	writeDoc(doc, "dualDirUpPin", addonOptions.pinDualDirUp == 0xFF ? -1 : addonOptions.pinDualDirUp);
@@ -972,6 +1395,15 @@ std::string getAddonOptions()
 	writeDoc(doc, "dualDirCombineMode", addonOptions.dualDirCombineMode);
 	writeDoc(doc, "analogAdcPinX", addonOptions.analogAdcPinX == 0xFF ? -1 : addonOptions.analogAdcPinX);
 	writeDoc(doc, "analogAdcPinY", addonOptions.analogAdcPinY == 0xFF ? -1 : addonOptions.analogAdcPinY);
+	writeDoc(doc, "analogDeadzoneMode", addonOptions.analogDeadzoneMode);
+	writeDoc(doc, "analogDeadzone", addonOptions.analogDeadzone);
+	writeDoc(doc, "analogCurve", addonOptions.analogCurve);
+	writeDoc(doc, "analogCalibrationXMin", addonOptions.analogCalibration.x.min);
+	writeDoc(doc, "analogCalibrationXCenter", addonOptions.analogCalibration.x.center);
+	writeDoc(doc, "analogCalibrationXMax", addonOptions.analogCalibration.x.max);
+	writeDoc(doc, "analogCalibrationYMin", addonOptions.analogCalibration.y.min);
+	writeDoc(doc, "analogCalibrationYCenter", addonOptions.analogCalibration.y.center);
+	writeDoc(doc, "analogCalibrationYMax", addonOptions.analogCalibration.y.max);
 	writeDoc(doc, "bootselButtonMap", addonOptions.bootselButtonMap);
 	writeDoc(doc, "buzzerPin", addonOptions.buzzerPin == 0xFF ? -1 : addonOptions.buzzerPin);
 	writeDoc(doc, "buzzerVolume", addonOptions.buzzerVolume);
@@ -1015,45 +1447,144 @@ std::string getAddonOptions()
 	writeDoc(doc, "TurboInputEnabled", addonOptions.TurboInputEnabled);
 	writeDoc(doc, "WiiExtensionAddonEnabled", addonOptions.WiiExtensionAddonEnabled);
 
-	return serialize_json(doc);
+	return doc;
 }
 
-std::string getFirmwareVersion()
+DynamicJsonDocument getFirmwareVersion()
 {
-	DynamicJsonDocument doc(LWIP_HTTPD_POST_MAX_PAYLOAD_LEN);
+	DynamicJsonDocument doc(JSON_OBJECT_SIZE(1));
 	writeDoc(doc, "version", GP2040VERSION);
-	return serialize_json(doc);
+	return doc;
 }
 
-std::string getMemoryReport()
+DynamicJsonDocument getMemoryReport()
 {
-	DynamicJsonDocument doc(LWIP_HTTPD_POST_MAX_PAYLOAD_LEN);
+	DynamicJsonDocument doc(JSON_OBJECT_SIZE(10) + JSON_ARRAY_SIZE(NUM_CORES) + NUM_CORES * JSON_OBJECT_SIZE(4) + 4 * JSON_OBJECT_SIZE(3));
 	writeDoc(doc, "totalFlash", System::getTotalFlash());
 	writeDoc(doc, "usedFlash", System::getUsedFlash());
 	writeDoc(doc, "staticAllocs", System::getStaticAllocs());
 	writeDoc(doc, "totalHeap", System::getTotalHeap());
 	writeDoc(doc, "usedHeap", System::getUsedHeap());
-	return serialize_json(doc);
+	writeDoc(doc, "freeHeap", System::getFreeHeap());
+	writeDoc(doc, "largestFreeHeap", System::getLargestFreeHeap());
+	writeDoc(doc, "peakHeap", System::getPeakHeap());
+
+	// Stacks that reach their full size have most likely overflowed into the memory below them
+	JsonArray stacks = doc.createNestedArray("stacks");
+	for (uint32_t core = 0; core < NUM_CORES; core++)
+	{
+		JsonObject stack = stacks.createNestedObject();
+		stack["size"] = System::getStackSize(core);
+		stack["highWater"] = System::getStackHighWater(core);
+		stack["bootHighWater"] = System::getBootMemory(core).stackHighWater;
+		stack["bootUsedHeap"] = System::getBootMemory(core).usedHeap;
+	}
+
+	const auto writeCounter = [&](const char* name, System::MemoryCategory category)
+	{
+		const System::MemoryCounter& counter = System::getMemoryCounter(category);
+		writeDoc(doc, "allocations", name, "count", counter.allocations);
+		writeDoc(doc, "allocations", name, "current", counter.current);
+		writeDoc(doc, "allocations", name, "peak", counter.peak);
+	};
+	writeCounter("json", System::MemoryCategory::JSON);
+	writeCounter("leds", System::MemoryCategory::LEDS);
+	writeCounter("addons", System::MemoryCategory::ADDONS);
+	return doc;
+}
+
+// Counters are kept from the last gamepad session, web config mode does not send any reports itself
+DynamicJsonDocument getUsbReportStats()
+{
+	DynamicJsonDocument doc(JSON_OBJECT_SIZE(13) + JSON_OBJECT_SIZE(4));
+	const UsbReportStats* stats = get_saved_report_stats();
+	writeDoc(doc, "available", stats != nullptr);
+	if (stats != nullptr)
+	{
+		writeDoc(doc, "inputMode", stats->inputMode);
+		writeDoc(doc, "generated", stats->generated);
+		writeDoc(doc, "sent", stats->sent);
+		writeDoc(doc, "deduplicated", stats->deduplicated);
+		writeDoc(doc, "busy", stats->busy);
+		writeDoc(doc, "completed", stats->completed);
+		writeDoc(doc, "pollInterval", stats->pollInterval);
+		writeDoc(doc, "pollIntervalMin", stats->pollIntervalMin);
+		writeDoc(doc, "inputEdges", stats->inputEdges);
+		writeDoc(doc, "inputLatency", stats->inputLatency);
+		writeDoc(doc, "inputLatencyMax", stats->inputLatencyMax);
+		if (stats->inputMode == INPUT_MODE_PS4)
+		{
+			writeDoc(doc, "ps4Signing", "count", stats->ps4Signing.count);
+			writeDoc(doc, "ps4Signing", "lastTime", stats->ps4Signing.lastTime);
+			writeDoc(doc, "ps4Signing", "lastCpuTime", stats->ps4Signing.lastCpuTime);
+			writeDoc(doc, "ps4Signing", "maxStall", stats->ps4Signing.maxStall);
+		}
+	}
+	return doc;
+}
+
+DynamicJsonDocument getWiiExtensionStats()
+{
+	DynamicJsonDocument doc(JSON_OBJECT_SIZE(5));
+	WiiExtensionSnapshot snapshot;
+	const bool available = WiiExtensionPoller::readSnapshot(snapshot);
+	writeDoc(doc, "available", available);
+	if (available)
+	{
+		writeDoc(doc, "extensionType", snapshot.extensionType);
+		writeDoc(doc, "polls", snapshot.polls);
+		writeDoc(doc, "timeouts", snapshot.timeouts);
+		writeDoc(doc, "reconnects", snapshot.reconnects);
+	}
+	return doc;
+}
+
+DynamicJsonDocument getInputTraceStats()
+{
+	DynamicJsonDocument doc(JSON_OBJECT_SIZE(3) + JSON_OBJECT_SIZE(5) + JSON_OBJECT_SIZE(7));
+	const InputRecorder& inputRecorder = InputRecorder::getInstance();
+	writeDoc(doc, "entries", inputRecorder.getEntryCount());
+	writeDoc(doc, "dropped", inputRecorder.getDroppedCount());
+
+	const InputReplayResult* result = inputRecorder.getReplayResult();
+	if (result != nullptr)
+	{
+		writeDoc(doc, "replay", "frames", result->frames);
+		writeDoc(doc, "replay", "mismatches", result->mismatches);
+		writeDoc(doc, "replay", "pipelineTime", result->pipelineTime);
+		writeDoc(doc, "replay", "pipelineMax", result->pipelineMax);
+		if (result->mismatches > 0)
+		{
+			writeDoc(doc, "replay", "firstMismatch", "index", result->firstMismatch);
+			writeDoc(doc, "replay", "firstMismatch", "expectedButtons", result->expectedButtons);
+			writeDoc(doc, "replay", "firstMismatch", "actualButtons", result->actualButtons);
+			writeDoc(doc, "replay", "firstMismatch", "expectedDpad", result->expectedDpad);
+			writeDoc(doc, "replay", "firstMismatch", "actualDpad", result->actualDpad);
+			writeDoc(doc, "replay", "firstMismatch", "expectedAux", result->expectedAux);
+			writeDoc(doc, "replay", "firstMismatch", "actualAux", result->actualAux);
+		}
+	}
+	return doc;
 }
 
 // This should be a storage feature
-std::string resetSettings()
+DynamicJsonDocument resetSettings()
 {
 	Storage::getInstance().ResetSettings();
-	DynamicJsonDocument doc(LWIP_HTTPD_POST_MAX_PAYLOAD_LEN);
+	DynamicJsonDocument doc(JSON_OBJECT_SIZE(1));
 	doc["success"] = true;
-	return serialize_json(doc);
+	return doc;
 }
 
 #if !defined(NDEBUG)
-std::string echo()
+DynamicJsonDocument echo()
 {
 	DynamicJsonDocument doc = get_post_data();
-	return serialize_json(doc);
+	return doc;
 }
 #endif
 
-std::string reboot()
+DynamicJsonDocument reboot()
 {
 	DynamicJsonDocument doc = get_post_data();
 	doc["success"] = true;
@@ -1073,59 +1604,557 @@ std::string reboot()
 		default:
 			rebootMode = System::BootMode::DEFAULT;
 	}
-	return serialize_json(doc);
-}
-
-typedef std::string (*HandlerFuncPtr)();
-static const std::pair<const char*, HandlerFuncPtr> handlerFuncs[] =
-{
-	{ "/api/setDisplayOptions", setDisplayOptions },
-	{ "/api/setPreviewDisplayOptions", setPreviewDisplayOptions },
-	{ "/api/setGamepadOptions", setGamepadOptions },
-	{ "/api/setLedOptions", setLedOptions },
-	{ "/api/setCustomTheme", setCustomTheme },
-	{ "/api/getCustomTheme", getCustomTheme },
-	{ "/api/setPinMappings", setPinMappings },
-	{ "/api/setKeyMappings", setKeyMappings },
-	{ "/api/setAddonsOptions", setAddonOptions },
-	{ "/api/setPS4Options", setPS4Options },
-	{ "/api/setSplashImage", setSplashImage },
-	{ "/api/reboot", reboot },
-	{ "/api/getDisplayOptions", getDisplayOptions },
-	{ "/api/getGamepadOptions", getGamepadOptions },
-	{ "/api/getLedOptions", getLedOptions },
-	{ "/api/getPinMappings", getPinMappings },
-	{ "/api/getKeyMappings", getKeyMappings },
-	{ "/api/getAddonsOptions", getAddonOptions },
-	{ "/api/resetSettings", resetSettings },
-	{ "/api/getSplashImage", getSplashImage },
-	{ "/api/getFirmwareVersion", getFirmwareVersion },
-	{ "/api/getMemoryReport", getMemoryReport },
-	{ "/api/getUsedPins", getUsedPins },
+	return doc;
+}
+
+DynamicJsonDocument batch();
+DynamicJsonDocument getHandlerStats();
+DynamicJsonDocument importSettingsSnapshot();
+DynamicJsonDocument replayInputTrace();
+int open_gamepad_stream(struct fs_file *file, uint8_t method);
+int open_settings_snapshot(struct fs_file *file, uint8_t method);
+int open_input_trace(struct fs_file *file, uint8_t method);
+
+static constexpr Route routes[] =
+{
+	{ API_PREFIX "batch", RouteType::HANDLER, ROUTE_POST | ROUTE_LARGE_BODY, batch },
+	{ API_PREFIX "setDisplayOptions", RouteType::HANDLER, ROUTE_POST, setDisplayOptions },
+	{ API_PREFIX "setPreviewDisplayOptions", RouteType::HANDLER, ROUTE_POST, setPreviewDisplayOptions },
+	{ API_PREFIX "setGamepadOptions", RouteType::HANDLER, ROUTE_POST, setGamepadOptions },
+	{ API_PREFIX "setLedOptions", RouteType::HANDLER, ROUTE_POST, setLedOptions },
+	{ API_PREFIX "setCustomTheme", RouteType::HANDLER, ROUTE_POST, setCustomTheme },
+	{ API_PREFIX "getCustomTheme", RouteType::HANDLER, ROUTE_GET, getCustomTheme },
+	{ API_PREFIX "setPinMappings", RouteType::HANDLER, ROUTE_POST, setPinMappings },
+	{ API_PREFIX "setKeyMappings", RouteType::HANDLER, ROUTE_POST, setKeyMappings },
+	{ API_PREFIX "setAddonsOptions", RouteType::HANDLER, ROUTE_POST, setAddonOptions },
+	{ API_PREFIX "setPS4Options", RouteType::HANDLER, ROUTE_POST, setPS4Options },
+	{ API_PREFIX "setSplashImage", RouteType::HANDLER, ROUTE_POST, setSplashImage },
+	{ API_PREFIX "reboot", RouteType::HANDLER, ROUTE_POST, reboot },
+	{ API_PREFIX "getDisplayOptions", RouteType::HANDLER, ROUTE_GET, getDisplayOptions },
+	{ API_PREFIX "getGamepadOptions", RouteType::HANDLER, ROUTE_GET, getGamepadOptions },
+	{ API_PREFIX "getLedOptions", RouteType::HANDLER, ROUTE_GET, getLedOptions },
+	{ API_PREFIX "getPinMappings", RouteType::HANDLER, ROUTE_GET, getPinMappings },
+	{ API_PREFIX "getKeyMappings", RouteType::HANDLER, ROUTE_GET, getKeyMappings },
+	{ API_PREFIX "getAddonsOptions", RouteType::HANDLER, ROUTE_GET, getAddonOptions },
+	{ API_PREFIX "resetSettings", RouteType::HANDLER, ROUTE_GET, resetSettings },
+	{ API_PREFIX "getSplashImage", RouteType::HANDLER, ROUTE_GET, getSplashImage },
+	{ API_PREFIX "getFirmwareVersion", RouteType::HANDLER, ROUTE_GET, getFirmwareVersion },
+	{ API_PREFIX "getMemoryReport", RouteType::HANDLER, ROUTE_GET, getMemoryReport },
+	{ API_PREFIX "getUsbReportStats", RouteType::HANDLER, ROUTE_GET, getUsbReportStats },
+	{ API_PREFIX "getWiiExtensionStats", RouteType::HANDLER, ROUTE_GET, getWiiExtensionStats },
+	{ API_PREFIX "getInputTraceStats", RouteType::HANDLER, ROUTE_GET, getInputTraceStats },
+	{ API_PREFIX "getUsedPins", RouteType::HANDLER, ROUTE_GET, getUsedPins },
+	{ API_PREFIX "getAnalogRaw", RouteType::HANDLER, ROUTE_GET, getAnalogRaw },
+	{ API_PREFIX "getHandlerStats", RouteType::HANDLER, ROUTE_GET, getHandlerStats },
+	{ API_PREFIX "importSettingsSnapshot", RouteType::HANDLER, ROUTE_POST | ROUTE_BINARY_BODY, importSettingsSnapshot },
+	{ API_PREFIX "replayInputTrace", RouteType::HANDLER, ROUTE_POST | ROUTE_BINARY_BODY, replayInputTrace },
 #if !defined(NDEBUG)
-	{ "/api/echo", echo },
+	{ API_PREFIX "echo", RouteType::HANDLER, ROUTE_POST, echo },
 #endif
+	{ API_PREFIX "exportSettingsSnapshot", RouteType::OPEN, ROUTE_GET | ROUTE_POST, nullptr, open_settings_snapshot },
+	{ API_PREFIX "exportInputTrace", RouteType::OPEN, ROUTE_GET, nullptr, open_input_trace },
+	{ API_PREFIX "streamGamepadState", RouteType::OPEN, ROUTE_GET | ROUTE_POST, nullptr, open_gamepad_stream },
+	{ "/display-config", RouteType::SPA, ROUTE_GET },
+	{ "/led-config", RouteType::SPA, ROUTE_GET },
+	{ "/pin-mapping", RouteType::SPA, ROUTE_GET },
+	{ "/keyboard-mapping", RouteType::SPA, ROUTE_GET },
+	{ "/settings", RouteType::SPA, ROUTE_GET },
+	{ "/reset-settings", RouteType::SPA, ROUTE_GET },
+	{ "/add-ons", RouteType::SPA, ROUTE_GET },
+	{ "/custom-theme", RouteType::SPA, ROUTE_GET },
+	{ "/playground", RouteType::SPA, ROUTE_GET },
+	{ "/css", RouteType::EXCLUDE, ROUTE_GET },
+	{ "/images", RouteType::EXCLUDE, ROUTE_GET },
+	{ "/js", RouteType::EXCLUDE, ROUTE_GET },
+	{ "/static", RouteType::EXCLUDE, ROUTE_GET },
 };
 
-int fs_open_custom(struct fs_file *file, const char *name)
+static constexpr size_t routeCount = sizeof(routes) / sizeof(routes[0]);
+
+// Routes are found through a perfect hash that is computed at compile time: the seed is chosen so that
+// every path lands in its own slot, a single strcmp then confirms the match. Keep the table at least four
+// times the route count, a fuller one needs so many seeds that the search exceeds the constexpr evaluation limit.
+static constexpr size_t ROUTE_SLOTS = 256;
+static constexpr uint8_t ROUTE_NONE = 0xff;
+static_assert(routeCount < ROUTE_NONE && routeCount <= ROUTE_SLOTS / 4, "Increase ROUTE_SLOTS");
+
+constexpr uint32_t route_hash(const char* path, uint32_t seed)
+{
+	// FNV-1a with the seed folded into the offset basis
+	uint32_t hash = 2166136261u ^ seed;
+	while (*path != '\0')
+	{
+		hash ^= static_cast<uint8_t>(*path++);
+		hash *= 16777619u;
+	}
+	return hash ^ (hash >> 15);
+}
+
+struct RouteTable
+{
+	uint32_t seed;
+	uint8_t slots[ROUTE_SLOTS];
+};
+
+constexpr RouteTable make_route_table()
 {
-	for (const auto& handlerFunc : handlerFuncs)
+	for (uint32_t seed = 0; seed < 100000; seed++)
 	{
-		if (strcmp(handlerFunc.first, name) == 0)
+		RouteTable table = { seed, {} };
+		for (uint8_t& slot : table.slots)
+			slot = ROUTE_NONE;
+
+		bool collision = false;
+		for (size_t i = 0; i < routeCount && !collision; i++)
 		{
-			return set_file_data(file, handlerFunc.second());
+			uint8_t& slot = table.slots[route_hash(routes[i].path, seed) & (ROUTE_SLOTS - 1)];
+			collision = slot != ROUTE_NONE;
+			slot = static_cast<uint8_t>(i);
 		}
+
+		if (!collision)
+			return table;
 	}
 
-	bool isExclude = false;
-	for (const auto &excludePath : excludePaths)
-		if (!excludePath.compare(name))
+	return RouteTable { UINT32_MAX, {} };
+}
+
+static constexpr RouteTable routeTable = make_route_table();
+static_assert(routeTable.seed != UINT32_MAX, "No collision free seed found for the route table");
+
+static const Route* find_route(const char* path)
+{
+	const uint8_t index = routeTable.slots[route_hash(path, routeTable.seed) & (ROUTE_SLOTS - 1)];
+	if (index == ROUTE_NONE || strcmp(routes[index].path, path) != 0)
+		return nullptr;
+
+	return &routes[index];
+}
+
+// Timing and heap use per handler, so slow or memory hungry handlers can be found on the device
+struct HandlerStats
+{
+	uint32_t calls;
+	uint32_t lastUs;
+	uint32_t maxUs;
+	uint32_t maxHeap; // Most heap in use while the handler ran, its response document included
+	uint32_t overflows; // Responses that did not fit into the document the handler sized for them
+};
+
+static HandlerStats handlerStats[routeCount] = { };
+
+static DynamicJsonDocument run_handler(size_t index)
+{
+	System::resetHeapHighWater();
+	const uint32_t start = time_us_32();
+	DynamicJsonDocument result = routes[index].handler();
+	const uint32_t elapsed = time_us_32() - start;
+
+	HandlerStats& stats = handlerStats[index];
+	stats.calls++;
+	stats.lastUs = elapsed;
+	stats.maxUs = std::max(stats.maxUs, elapsed);
+	stats.maxHeap = std::max(stats.maxHeap, System::getHeapHighWater());
+	if (result.overflowed())
+		stats.overflows++;
+	return result;
+}
+
+DynamicJsonDocument getHandlerStats()
+{
+	DynamicJsonDocument doc(JSON_OBJECT_SIZE(3) + JSON_OBJECT_SIZE(routeCount) + routeCount * JSON_OBJECT_SIZE(5));
+	writeDoc(doc, "usedHeap", System::getUsedHeap());
+	writeDoc(doc, "peakHeap", System::getPeakHeap());
+
+	JsonObject handlers = doc.createNestedObject("handlers");
+	for (size_t i = 0; i < routeCount; i++)
+	{
+		// Handlers that never ran are left out to keep the response small
+		const HandlerStats& stats = handlerStats[i];
+		if (stats.calls == 0)
+			continue;
+
+		JsonObject entry = handlers.createNestedObject(routes[i].path + strlen(API_PREFIX));
+		entry["calls"] = stats.calls;
+		entry["lastUs"] = stats.lastUs;
+		entry["maxUs"] = stats.maxUs;
+		entry["maxHeap"] = stats.maxHeap;
+		entry["overflows"] = stats.overflows;
+	}
+	return doc;
+}
+
+// Answers several API calls with a single response. The request is an object keyed by handler name without
+// the /api/ prefix, getters take null and setters their usual payload, e.g.
+// {"getGamepadOptions":null,"setLedOptions":{...}}. Each result is stored under the same key, setters only
+// report their success flag. Results that do not fit into the response are left out and have to be
+// requested separately.
+//
+// Each result is shrunk to its contents as soon as its handler returns and the response is sized to the
+// results that were kept, every result is released as soon as it has been copied into the response.
+DynamicJsonDocument batch()
+{
+	std::deque<std::pair<std::string, DynamicJsonDocument>> results;
+	size_t responseSize = 0;
+	{
+		DynamicJsonDocument requestDoc = get_post_data();
+		if (!requestDoc.is<JsonObject>())
+			return success_response(false);
+
+		responseSize = JSON_OBJECT_SIZE(requestDoc.size());
+		for (JsonPair entry : requestDoc.as<JsonObject>())
+		{
+			// Getters are called like a GET request, setters like a POST
+			char path[64];
+			snprintf(path, sizeof(path), API_PREFIX "%s", entry.key().c_str());
+			const Route* route = find_route(path);
+			const uint8_t method = entry.value().isNull() ? ROUTE_GET : ROUTE_POST;
+			if (route == nullptr || route->type != RouteType::HANDLER || route->handler == batch ||
+				(route->flags & method) == 0 || (route->flags & ROUTE_BINARY_BODY) != 0)
+				continue;
+
+			// Setters pick up their payload through get_post_data
+			System::trackFree(System::MemoryCategory::JSON, http_post_doc.capacity());
+			http_post_doc = DynamicJsonDocument(entry.value().memoryUsage() + JSON_OBJECT_SIZE(1));
+			http_post_doc.set(entry.value());
+			System::trackAllocation(System::MemoryCategory::JSON, http_post_doc.capacity());
+
+			// Keys are copied as the request document is released before the response is built
+			std::string key = entry.key().c_str();
+			DynamicJsonDocument result = run_handler(route - routes);
+			if (!entry.value().isNull())
+			{
+				// Echoing the setter payloads would only grow the response
+				DynamicJsonDocument status(JSON_OBJECT_SIZE(1));
+				writeDoc(status, "success", result["success"] | true);
+				result = std::move(status);
+			}
+
+			result.shrinkToFit();
+			const size_t entrySize = JSON_STRING_SIZE(key.size()) + result.memoryUsage();
+			if (responseSize + entrySize > LWIP_HTTPD_BATCH_MAX_RESPONSE_LEN)
+				continue;
+
+			responseSize += entrySize;
+			results.emplace_back(std::move(key), std::move(result));
+		}
+	}
+
+	DynamicJsonDocument response(responseSize);
+	while (!results.empty())
+	{
+		writeDoc(response, results.front().first, results.front().second);
+		results.pop_front();
+	}
+
+	return response;
+}
+
+// Server-sent event stream of the gamepad state while in web config mode. Each event carries a compact
+// little endian snapshot as hex: buttons (16 bit), dpad (8 bit), aux (16 bit), lx, ly, rx, ry (16 bit),
+// lt, rt (8 bit) and the time the state was sampled (32 bit microseconds). Events are only sent when
+// the state changes, at most once per interval, with a comment line as heartbeat while idle.
+class GamepadStateStream : public CustomResponse
+{
+public:
+	static const uint32_t HEARTBEAT_US = 1000000;
+	static const int SNAPSHOT_SIZE = 19;
+	static const int EVENT_SIZE = 6 + SNAPSHOT_SIZE * 2 + 2; // "data: " + hex + "\n\n"
+
+	GamepadStateStream(uint32_t intervalUs);
+	~GamepadStateStream();
+
+	int read(struct fs_file *file, char *buffer, int count) override;
+	bool canRead() override;
+	void waitRead(fs_wait_cb callback, void *arg) override;
+
+	// Wakes up the connection once new data can be sent, returns true if it did
+	bool poll();
+
+private:
+	bool stateChanged() const;
+
+	uint32_t interval;
+	absolute_time_t nextEvent;
+	absolute_time_t nextHeartbeat;
+	bool headerSent;
+	GamepadState lastState;
+	fs_wait_cb callback;
+	void* callbackArg;
+};
+
+static vector<GamepadStateStream*> gamepadStreams;
+
+GamepadStateStream::GamepadStateStream(uint32_t intervalUs) :
+	interval(intervalUs),
+	nextEvent(get_absolute_time()),
+	nextHeartbeat(make_timeout_time_us(HEARTBEAT_US)),
+	headerSent(false),
+	callback(nullptr),
+	callbackArg(nullptr)
+{
+	lastState = Storage::getInstance().GetGamepad()->state;
+	gamepadStreams.push_back(this);
+}
+
+GamepadStateStream::~GamepadStateStream()
+{
+	gamepadStreams.erase(std::remove(gamepadStreams.begin(), gamepadStreams.end(), this), gamepadStreams.end());
+}
+
+bool GamepadStateStream::stateChanged() const
+{
+	const GamepadState& state = Storage::getInstance().GetGamepad()->state;
+	return state.buttons != lastState.buttons || state.dpad != lastState.dpad || state.aux != lastState.aux ||
+		state.lx != lastState.lx || state.ly != lastState.ly || state.rx != lastState.rx || state.ry != lastState.ry ||
+		state.lt != lastState.lt || state.rt != lastState.rt;
+}
+
+bool GamepadStateStream::canRead()
+{
+	return !headerSent || time_reached(nextHeartbeat) || (time_reached(nextEvent) && stateChanged());
+}
+
+void GamepadStateStream::waitRead(fs_wait_cb callback, void *arg)
+{
+	this->callback = callback;
+	this->callbackArg = arg;
+}
+
+bool GamepadStateStream::poll()
+{
+	if (callback == nullptr || !canRead())
+		return false;
+
+	fs_wait_cb pending = callback;
+	callback = nullptr;
+	pending(callbackArg);
+	return true;
+}
+
+void poll_gamepad_streams()
+{
+	// Sending can close the connection and delete the stream, so only one stream is woken up per call
+	for (GamepadStateStream* stream : gamepadStreams)
+	{
+		if (stream->poll())
+			break;
+	}
+}
+
+int GamepadStateStream::read(struct fs_file *file, char *buffer, int count)
+{
+	static const char header[] =
+		"HTTP/1.1 200 OK\r\n"
+		"Server: GP2040-CE " GP2040VERSION "\r\n"
+		"Content-Type: text/event-stream\r\n"
+		"Cache-Control: no-cache\r\n"
+		"Connection: close\r\n\r\n";
+
+	int read = 0;
+	if (!headerSent)
+	{
+		if (count < static_cast<int>(sizeof(header)) - 1 + EVENT_SIZE)
 			return 0;
 
-	for (const auto &spaPath : spaPaths)
+		memcpy(buffer, header, sizeof(header) - 1);
+		read = sizeof(header) - 1;
+		headerSent = true;
+	}
+	else if (count < EVENT_SIZE)
+	{
+		return 0;
+	}
+
+	if (read > 0 || (time_reached(nextEvent) && stateChanged()))
 	{
-		if (!spaPath.compare(name))
+		const GamepadState& state = Storage::getInstance().GetGamepad()->state;
+		const uint32_t timestamp = time_us_32();
+		const uint8_t snapshot[SNAPSHOT_SIZE] = {
+			(uint8_t)state.buttons, (uint8_t)(state.buttons >> 8),
+			state.dpad,
+			(uint8_t)state.aux, (uint8_t)(state.aux >> 8),
+			(uint8_t)state.lx, (uint8_t)(state.lx >> 8),
+			(uint8_t)state.ly, (uint8_t)(state.ly >> 8),
+			(uint8_t)state.rx, (uint8_t)(state.rx >> 8),
+			(uint8_t)state.ry, (uint8_t)(state.ry >> 8),
+			state.lt, state.rt,
+			(uint8_t)timestamp, (uint8_t)(timestamp >> 8), (uint8_t)(timestamp >> 16), (uint8_t)(timestamp >> 24),
+		};
+
+		static const char hex[] = "0123456789abcdef";
+		char* out = buffer + read;
+		memcpy(out, "data: ", 6);
+		out += 6;
+		for (uint8_t value : snapshot)
 		{
+			*out++ = hex[value >> 4];
+			*out++ = hex[value & 0xf];
+		}
+		*out++ = '\n';
+		*out++ = '\n';
+		read += EVENT_SIZE;
+
+		lastState = state;
+		nextEvent = delayed_by_us(get_absolute_time(), interval);
+	}
+	else
+	{
+		memcpy(buffer, ":\n\n", 3);
+		read = 3;
+	}
+
+	nextHeartbeat = make_timeout_time_us(HEARTBEAT_US);
+	file->index += read;
+	return read;
+}
+
+int open_gamepad_stream(struct fs_file *file, uint8_t method)
+{
+	// The optional POST body selects the minimum time between events in milliseconds. The body only belongs
+	// to this connection when it is the POST httpd just finished, a GET must not take another request's body
+	DynamicJsonDocument doc = method == ROUTE_POST ? get_post_data() : DynamicJsonDocument(0);
+	const uint32_t intervalMs = std::min<uint32_t>(std::max<uint32_t>(doc["interval"] | 16, 1), 1000);
+
+	file->data = NULL;
+	file->len = INT32_MAX; // Runs until the client disconnects
+	file->index = 0;
+	file->http_header_included = FS_FILE_FLAGS_HEADER_INCLUDED;
+	file->pextension = new GamepadStateStream(intervalMs * 1000);
+
+	return 1;
+}
+
+// A response that is fully built up front and served from memory, the payload is taken over instead of
+// copied so it is only held once
+class BinaryResponse : public CustomResponse
+{
+public:
+	int read(struct fs_file *file, char *buffer, int count) override
+	{
+		int read = 0;
+		if (file->index < headerLength)
+		{
+			read = std::min(count, headerLength - file->index);
+			memcpy(buffer, header + file->index, read);
+		}
+
+		if (read < count)
+		{
+			const int offset = file->index + read - headerLength;
+			const int payloadRead = std::min<int>(count - read, length - offset);
+			memcpy(buffer + read, data.data() + offset, payloadRead);
+			read += payloadRead;
+		}
+
+		file->index += read;
+		return read;
+	}
+
+	char header[192];
+	int headerLength = 0;
+	vector<uint8_t> data;
+	size_t length = 0; // Bytes of data that are sent, the vector may be larger
+};
+
+static int open_binary_response(struct fs_file *file, vector<uint8_t>&& data, size_t length)
+{
+	BinaryResponse* response = new BinaryResponse();
+	response->headerLength = snprintf(response->header, sizeof(response->header),
+		"HTTP/1.1 200 OK\r\n"
+		"Server: GP2040-CE " GP2040VERSION "\r\n"
+		"Content-Type: application/octet-stream\r\n"
+		"Content-Length: %u\r\n"
+		"Connection: keep-alive\r\n\r\n",
+		static_cast<unsigned int>(length)
+	);
+	response->data = std::move(data);
+	response->length = length;
+
+	file->data = NULL;
+	file->len = response->headerLength + length;
+	file->index = 0;
+	file->http_header_included = FS_FILE_FLAGS_HEADER_INCLUDED | FS_FILE_FLAGS_HEADER_PERSISTENT | FS_FILE_FLAGS_HEADER_HTTPVER_1_1;
+	file->pextension = response;
+
+	return 1;
+}
+
+int open_settings_snapshot(struct fs_file *file, uint8_t method)
+{
+	// The PS4 keys are device specific, they are only part of the snapshot when a POST asks for them. A GET
+	// must not take the body another connection is still posting
+	DynamicJsonDocument doc = method == ROUTE_POST ? get_post_data() : DynamicJsonDocument(0);
+	const bool includePS4 = doc["includePS4"] | false;
+
+	vector<uint8_t> snapshot(SETTINGS_SNAPSHOT_MAX_SIZE);
+	const size_t snapshotLength = Storage::getInstance().exportSnapshot(snapshot.data(), snapshot.size(), includePS4);
+	if (snapshotLength == 0)
+		return 0;
+
+	return open_binary_response(file, std::move(snapshot), snapshotLength);
+}
+
+// The trace of the last gamepad session, or of the latest replay, see InputTraceHeader for the layout
+int open_input_trace(struct fs_file *file, uint8_t method)
+{
+	vector<uint8_t> trace(INPUT_TRACE_MAX_SIZE);
+	const size_t traceLength = InputRecorder::getInstance().exportTrace(trace.data(), trace.size());
+	if (traceLength == 0)
+		return 0;
+
+	return open_binary_response(file, std::move(trace), traceLength);
+}
+
+// Writes all sections of the snapshot with a single flash commit, then reboots so every module picks them up
+DynamicJsonDocument importSettingsSnapshot()
+{
+	const bool success = Storage::getInstance().importSnapshot(http_post_data.data(), http_post_data.size());
+	vector<uint8_t>().swap(http_post_data);
+
+	if (success)
+	{
+		rebootDelayTimeout = make_timeout_time_ms(rebootDelayMs);
+		rebootMode = System::BootMode::WEBCONFIG;
+	}
+
+	return success_response(success);
+}
+
+// Stores the trace and reboots into gamepad mode, which replays it and comes back to web config with the result
+DynamicJsonDocument replayInputTrace()
+{
+	const bool success = InputRecorder::getInstance().importTrace(http_post_data.data(), http_post_data.size());
+	vector<uint8_t>().swap(http_post_data);
+
+	if (success)
+	{
+		rebootDelayTimeout = make_timeout_time_ms(rebootDelayMs);
+		rebootMode = System::BootMode::GAMEPAD;
+	}
+
+	return success_response(success);
+}
+
+int fs_open_custom(struct fs_file *file, const char *name)
+{
+	// httpd opens the response of a POST request right after httpd_post_finished, anything else is a GET
+	const uint8_t method = http_post_response != nullptr && strcmp(name, http_post_response->path) == 0 ? ROUTE_POST : ROUTE_GET;
+	http_post_response = nullptr;
+
+	const Route* route = find_route(name);
+	if (route == nullptr || (route->flags & method) == 0)
+		return 0;
+
+	switch (route->type)
+	{
+		case RouteType::HANDLER:
+			return set_file_data(file, run_handler(route - routes));
+
+		case RouteType::OPEN:
+			return route->open(file, method);
+
+		case RouteType::SPA:
 			file->data = (const char *)file__index_html[0].data;
 			file->len = file__index_html[0].len;
 			file->index = file__index_html[0].len;
@@ -1133,17 +2162,42 @@ int fs_open_custom(struct fs_file *file, const char *name)
 			file->pextension = NULL;
 			file->is_custom_file = 0;
 			return 1;
-		}
+
+		default:
+			return 0;
 	}
+}
+
+int fs_read_custom(struct fs_file *file, char *buffer, int count)
+{
+	CustomResponse* response = static_cast<CustomResponse*>(file->pextension);
+	if (response == nullptr)
+		return FS_READ_EOF;
 
-	return 0;
+	return response->read(file, buffer, count);
+}
+
+u8_t fs_canread_custom(struct fs_file *file)
+{
+	CustomResponse* response = static_cast<CustomResponse*>(file->pextension);
+	return !file->is_custom_file || response == nullptr || response->canRead();
+}
+
+u8_t fs_wait_read_custom(struct fs_file *file, fs_wait_cb callback_fn, void *callback_arg)
+{
+	CustomResponse* response = static_cast<CustomResponse*>(file->pextension);
+	if (!file->is_custom_file || response == nullptr)
+		return 0;
+
+	response->waitRead(callback_fn, callback_arg);
+	return 1;
 }
 
 void fs_close_custom(struct fs_file *file)
 {
 	if (file && file->is_custom_file && file->pextension)
 	{
-		mem_free(file->pextension);
+		delete static_cast<CustomResponse*>(file->pextension);
 		file->pextension = NULL;
 	}
 }
@@ -6,21 +6,30 @@
 // GP2040 Libraries
 #include "gamepad.h"
 #include "storagemanager.h"
+#include "inputscanner.h"
+#include "buttonmatrix.h"
+#include "inputrecorder.h"
 
 #include "FlashPROM.h"
 #include "CRC32.h"
 
 // MUST BE DEFINED for mpgs
 uint32_t getMillis() {
-	return to_ms_since_boot(get_absolute_time());
+	return getMicro() / 1000;
 }
 
 uint64_t getMicro() {
+	// A trace replay runs core0's input pipeline on the recorded clock, core1 keeps the real one
+	if (get_core_num() == 0) {
+		InputRecorder& inputRecorder = InputRecorder::getInstance();
+		if (inputRecorder.isReplaying())
+			return inputRecorder.getReplayTime();
+	}
 	return to_us_since_boot(get_absolute_time());
 }
 
 
-static HIDReport hidReport
+static const HIDReport defaultHIDReport
 {
 	.square_btn = 0, .cross_btn = 0, .circle_btn = 0, .triangle_btn = 0,
 	.l1_btn = 0, .r1_btn = 0, .l2_btn = 0, .r2_btn = 0,
@@ -32,7 +41,7 @@ static HIDReport hidReport
 	.l1_axis = 0x00, .r1_axis = 0x00, .l2_axis = 0x00, .r2_axis = 0x00
 };
 
-static PS4Report ps4Report
+static const PS4Report defaultPS4Report
 {
 	.report_id = 0x01,
 	.left_stick_x = 0x80, .left_stick_y = 0x80, .right_stick_x = 0x80, .right_stick_y = 0x80,
@@ -46,7 +55,7 @@ static PS4Report ps4Report
 	.mystery_2 = { }
 };
 
-static SwitchReport switchReport
+static const SwitchReport defaultSwitchReport
 {
 	.buttons = 0,
 	.hat = SWITCH_HAT_NOTHING,
@@ -57,7 +66,7 @@ static SwitchReport switchReport
 	.vendor = 0,
 };
 
-static XInputReport xinputReport
+static const XInputReport defaultXInputReport
 {
 	.report_id = 0,
 	.report_size = XINPUT_ENDPOINT_SIZE,
@@ -76,7 +85,7 @@ static TouchpadData touchpadData;
 static uint8_t last_report_counter = 0;
 
 
-static KeyboardReport keyboardReport
+static const KeyboardReport defaultKeyboardReport
 {
 	.keycode = { 0 }
 };
@@ -118,6 +127,12 @@ void Gamepad::setup()
 		mapButtonA1, mapButtonA2
 	};
 
+#ifdef BUTTON_MATRIX_ROW_PINS
+	// The button mappings number matrix keys instead of pins
+	static const uint8_t matrixRowPins[] = BUTTON_MATRIX_ROW_PINS;
+	static const uint8_t matrixColumnPins[] = BUTTON_MATRIX_COLUMN_PINS;
+	ButtonMatrix::getInstance().setup(matrixRowPins, sizeof(matrixRowPins), matrixColumnPins, sizeof(matrixColumnPins));
+#else
 	for (int i = 0; i < GAMEPAD_DIGITAL_INPUT_COUNT; i++)
 	{
 		if (gamepadMappings[i]->isAssigned())
@@ -127,6 +142,9 @@ void Gamepad::setup()
 			gpio_pull_up(gamepadMappings[i]->pin);          // Set as PULLUP
 		}
 	}
+#endif
+
+	compileMappings();
 
 	#ifdef PIN_SETTINGS
 		gpio_init(PIN_SETTINGS);             // Initialize pin
@@ -148,7 +166,7 @@ void Gamepad::process()
 {
 	memcpy(&rawState, &state, sizeof(GamepadState));
 
-	state.dpad = runSOCDCleaner(resolveSOCDMode(options), state.dpad);
+	state.dpad = socdCleaner.clean(resolveSOCDMode(options), state.dpad);
 
 	switch (options.dpadMode)
 	{
@@ -188,37 +206,82 @@ void Gamepad::process()
 void Gamepad::read()
 {
 	// Need to invert since we're using pullups
-	uint32_t values = ~gpio_get_all();
+	InputScanner& inputScanner = InputScanner::getInstance();
+	if (inputScanner.isRunning()) {
+		gpio.pressed = ~inputScanner.drain();
+		gpio.firstEdge = inputScanner.getFirstEdgeTime();
+		gpio.edges = inputScanner.getDrainedEdges();
+	} else {
+		gpio.pressed = ~gpio_get_all();
+		gpio.edges = 0;
+	}
+	gpio.timestamp = getMicro();
+#ifdef BUTTON_MATRIX_ROW_PINS
+	gpio.keys = ButtonMatrix::getInstance().getKeys();
+#else
+	gpio.keys = gpio.pressed;
+#endif
+	mapInputs();
+}
 
+void Gamepad::read(const GpioSnapshot& snapshot)
+{
+	gpio = snapshot;
+	mapInputs();
+}
+
+static void addSelectableLayer(GamepadRemapper& remapper, const GamepadRemapRule* rules, size_t count)
+{
+	const uint8_t layer = remapper.addLayer();
+	for (size_t i = 0; i < count; i++)
+		remapper.setOverride(layer, rules[i].source, rules[i].target);
+}
+
+void Gamepad::compileMappings()
+{
+	// The D-pad masks of the mappings move up to the D-pad bits of the remap targets
+	remapper.reset();
+	for (int i = 0; i < GAMEPAD_DIGITAL_INPUT_COUNT; i++)
+	{
+		if (gamepadMappings[i]->isAssigned())
+		{
+			const uint32_t target = (i < 4) ? (gamepadMappings[i]->buttonMask << 16) : gamepadMappings[i]->buttonMask;
+			remapper.addRule(gamepadMappings[i]->pin, target);
+		}
+	}
+
+	// Board layers override some of the button mappings and are switched with the Next Remap Layer hotkey
+#ifdef REMAP_LAYER_1
+	static const GamepadRemapRule remapLayer1[] = REMAP_LAYER_1;
+	addSelectableLayer(remapper, remapLayer1, sizeof(remapLayer1) / sizeof(*remapLayer1));
+#endif
+#ifdef REMAP_LAYER_2
+	static const GamepadRemapRule remapLayer2[] = REMAP_LAYER_2;
+	addSelectableLayer(remapper, remapLayer2, sizeof(remapLayer2) / sizeof(*remapLayer2));
+#endif
+}
+
+void Gamepad::mapInputs()
+{
 	#ifdef PIN_SETTINGS
 	state.aux = 0
-		| ((values & (1 << PIN_SETTINGS)) ? (1 << 0) : 0)
+		| (gpio.isPressed(PIN_SETTINGS) ? (1 << 0) : 0)
 	;
 	#endif
 
-	state.dpad = 0
-		| ((values & mapDpadUp->pinMask)    ? (options.invertYAxis ? mapDpadDown->buttonMask : mapDpadUp->buttonMask) : 0)
-		| ((values & mapDpadDown->pinMask)  ? (options.invertYAxis ? mapDpadUp->buttonMask : mapDpadDown->buttonMask) : 0)
-		| ((values & mapDpadLeft->pinMask)  ? mapDpadLeft->buttonMask  : 0)
-		| ((values & mapDpadRight->pinMask) ? mapDpadRight->buttonMask : 0)
-	;
+#ifdef BUTTON_MATRIX_ROW_PINS
+	uint32_t mapped = remapper.apply(gpio.keys | (static_cast<uint64_t>(gpio.pressed) << 32));
+#else
+	uint32_t mapped = remapper.apply(gpio.keys);
+#endif
 
-	state.buttons = 0
-		| ((values & mapButtonB1->pinMask)  ? mapButtonB1->buttonMask  : 0)
-		| ((values & mapButtonB2->pinMask)  ? mapButtonB2->buttonMask  : 0)
-		| ((values & mapButtonB3->pinMask)  ? mapButtonB3->buttonMask  : 0)
-		| ((values & mapButtonB4->pinMask)  ? mapButtonB4->buttonMask  : 0)
-		| ((values & mapButtonL1->pinMask)  ? mapButtonL1->buttonMask  : 0)
-		| ((values & mapButtonR1->pinMask)  ? mapButtonR1->buttonMask  : 0)
-		| ((values & mapButtonL2->pinMask)  ? mapButtonL2->buttonMask  : 0)
-		| ((values & mapButtonR2->pinMask)  ? mapButtonR2->buttonMask  : 0)
-		| ((values & mapButtonS1->pinMask)  ? mapButtonS1->buttonMask  : 0)
-		| ((values & mapButtonS2->pinMask)  ? mapButtonS2->buttonMask  : 0)
-		| ((values & mapButtonL3->pinMask)  ? mapButtonL3->buttonMask  : 0)
-		| ((values & mapButtonR3->pinMask)  ? mapButtonR3->buttonMask  : 0)
-		| ((values & mapButtonA1->pinMask)  ? mapButtonA1->buttonMask  : 0)
-		| ((values & mapButtonA2->pinMask)  ? mapButtonA2->buttonMask  : 0)
-	;
+	// Inverting after the remap also inverts the D-pad targets of add-on rules and layers
+	const uint32_t vertical = mapped & (GAMEPAD_MASK_DU | GAMEPAD_MASK_DD);
+	if (options.invertYAxis && vertical != 0 && vertical != (GAMEPAD_MASK_DU | GAMEPAD_MASK_DD))
+		mapped ^= (GAMEPAD_MASK_DU | GAMEPAD_MASK_DD);
+
+	state.dpad = (mapped >> 16) & GAMEPAD_MASK_DPAD;
+	state.buttons = mapped & 0xFFFF;
 
 	state.lx = GAMEPAD_JOYSTICK_MID;
 	state.ly = GAMEPAD_JOYSTICK_MID;
@@ -234,6 +297,10 @@ void Gamepad::debounce() {
 
 void Gamepad::save()
 {
+	// A replay runs add-ons that save on input, like the sliders, it must not rewrite the saved options
+	if (InputRecorder::getInstance().isReplaying())
+		return;
+
 	bool dirty = false;
 	GamepadOptions savedOptions = mpgStorage->getGamepadOptions();
 	if (memcmp(&savedOptions, &options, sizeof(GamepadOptions)))
@@ -272,7 +339,7 @@ GamepadHotkey Gamepad::hotkey()
 	}
 
 	switch (action) {
-		case HOTKEY_NONE              : return action;
+		case HOTKEY_NONE              : break;
 		case HOTKEY_DPAD_DIGITAL      : options.dpadMode = DPAD_MODE_DIGITAL; break;
 		case HOTKEY_DPAD_LEFT_ANALOG  : options.dpadMode = DPAD_MODE_LEFT_ANALOG; break;
 		case HOTKEY_DPAD_RIGHT_ANALOG : options.dpadMode = DPAD_MODE_RIGHT_ANALOG; break;
@@ -289,7 +356,13 @@ GamepadHotkey Gamepad::hotkey()
 			if (lastAction != HOTKEY_INVERT_Y_AXIS)
 				options.invertYAxis = !options.invertYAxis;
 			break;
+		case HOTKEY_NEXT_REMAP_LAYER  :
+			// Layers live in RAM only, the unchanged options skip the flash write in save()
+			if (lastAction != HOTKEY_NEXT_REMAP_LAYER)
+				remapper.nextLayer();
+			break;
 	}
+	lastAction = action;
 
 	GamepadHotkey hotkey = action;
 	if (hotkey != GamepadHotkey::HOTKEY_NONE)
@@ -299,24 +372,46 @@ GamepadHotkey Gamepad::hotkey()
 }
 
 
-void * Gamepad::getReport()
+const void * Gamepad::getDefaultReport()
+{
+	switch (options.inputMode)
+	{
+		case INPUT_MODE_XINPUT:
+			return &defaultXInputReport;
+
+		case INPUT_MODE_SWITCH:
+			return &defaultSwitchReport;
+
+		case INPUT_MODE_PS4:
+			return &defaultPS4Report;
+
+		case INPUT_MODE_KEYBOARD:
+			return &defaultKeyboardReport;
+
+		default:
+			return &defaultHIDReport;
+	}
+}
+
+
+void * Gamepad::getReport(void *report)
 {
 	switch (options.inputMode)
 	{
 		case INPUT_MODE_XINPUT:
-			return getXInputReport();
+			return getXInputReport(static_cast<XInputReport *>(report));
 
 		case INPUT_MODE_SWITCH:
-			return getSwitchReport();
+			return getSwitchReport(static_cast<SwitchReport *>(report));
 
 		case INPUT_MODE_PS4:
-			return getPS4Report();
+			return getPS4Report(static_cast<PS4Report *>(report));
 
 		case INPUT_MODE_KEYBOARD:
-			return getKeyboardReport();
+			return getKeyboardReport(static_cast<KeyboardReport *>(report));
 
 		default:
-			return getHIDReport();
+			return getHIDReport(static_cast<HIDReport *>(report));
 	}
 }
 
@@ -343,61 +438,61 @@ uint16_t Gamepad::getReportSize()
 }
 
 
-HIDReport *Gamepad::getHIDReport()
+HIDReport *Gamepad::getHIDReport(HIDReport *report)
 {
 	switch (state.dpad & GAMEPAD_MASK_DPAD)
 	{
-		case GAMEPAD_MASK_UP:                        hidReport.direction = HID_HAT_UP;        break;
-		case GAMEPAD_MASK_UP | GAMEPAD_MASK_RIGHT:   hidReport.direction = HID_HAT_UPRIGHT;   break;
-		case GAMEPAD_MASK_RIGHT:                     hidReport.direction = HID_HAT_RIGHT;     break;
-		case GAMEPAD_MASK_DOWN | GAMEPAD_MASK_RIGHT: hidReport.direction = HID_HAT_DOWNRIGHT; break;
-		case GAMEPAD_MASK_DOWN:                      hidReport.direction = HID_HAT_DOWN;      break;
-		case GAMEPAD_MASK_DOWN | GAMEPAD_MASK_LEFT:  hidReport.direction = HID_HAT_DOWNLEFT;  break;
-		case GAMEPAD_MASK_LEFT:                      hidReport.direction = HID_HAT_LEFT;      break;
-		case GAMEPAD_MASK_UP | GAMEPAD_MASK_LEFT:    hidReport.direction = HID_HAT_UPLEFT;    break;
-		default:                                     hidReport.direction = HID_HAT_NOTHING;   break;
+		case GAMEPAD_MASK_UP:                        report->direction = HID_HAT_UP;        break;
+		case GAMEPAD_MASK_UP | GAMEPAD_MASK_RIGHT:   report->direction = HID_HAT_UPRIGHT;   break;
+		case GAMEPAD_MASK_RIGHT:                     report->direction = HID_HAT_RIGHT;     break;
+		case GAMEPAD_MASK_DOWN | GAMEPAD_MASK_RIGHT: report->direction = HID_HAT_DOWNRIGHT; break;
+		case GAMEPAD_MASK_DOWN:                      report->direction = HID_HAT_DOWN;      break;
+		case GAMEPAD_MASK_DOWN | GAMEPAD_MASK_LEFT:  report->direction = HID_HAT_DOWNLEFT;  break;
+		case GAMEPAD_MASK_LEFT:                      report->direction = HID_HAT_LEFT;      break;
+		case GAMEPAD_MASK_UP | GAMEPAD_MASK_LEFT:    report->direction = HID_HAT_UPLEFT;    break;
+		default:                                     report->direction = HID_HAT_NOTHING;   break;
 	}
 
-	hidReport.cross_btn    = pressedB1();
-	hidReport.circle_btn   = pressedB2();
-	hidReport.square_btn   = pressedB3();
-	hidReport.triangle_btn = pressedB4();
-	hidReport.l1_btn       = pressedL1();
-	hidReport.r1_btn       = pressedR1();
-	hidReport.l2_btn       = pressedL2();
-	hidReport.r2_btn       = pressedR2();
-	hidReport.select_btn   = pressedS1();
-	hidReport.start_btn    = pressedS2();
-	hidReport.l3_btn       = pressedL3();
-	hidReport.r3_btn       = pressedR3();
-	hidReport.ps_btn       = pressedA1();
-	hidReport.tp_btn       = pressedA2();
-
-	hidReport.l_x_axis = static_cast<uint8_t>(state.lx >> 8);
-	hidReport.l_y_axis = static_cast<uint8_t>(state.ly >> 8);
-	hidReport.r_x_axis = static_cast<uint8_t>(state.rx >> 8);
-	hidReport.r_y_axis = static_cast<uint8_t>(state.ry >> 8);
-
-	return &hidReport;
+	report->cross_btn    = pressedB1();
+	report->circle_btn   = pressedB2();
+	report->square_btn   = pressedB3();
+	report->triangle_btn = pressedB4();
+	report->l1_btn       = pressedL1();
+	report->r1_btn       = pressedR1();
+	report->l2_btn       = pressedL2();
+	report->r2_btn       = pressedR2();
+	report->select_btn   = pressedS1();
+	report->start_btn    = pressedS2();
+	report->l3_btn       = pressedL3();
+	report->r3_btn       = pressedR3();
+	report->ps_btn       = pressedA1();
+	report->tp_btn       = pressedA2();
+
+	report->l_x_axis = static_cast<uint8_t>(state.lx >> 8);
+	report->l_y_axis = static_cast<uint8_t>(state.ly >> 8);
+	report->r_x_axis = static_cast<uint8_t>(state.rx >> 8);
+	report->r_y_axis = static_cast<uint8_t>(state.ry >> 8);
+
+	return report;
 }
 
 
-SwitchReport *Gamepad::getSwitchReport()
+SwitchReport *Gamepad::getSwitchReport(SwitchReport *report)
 {
 	switch (state.dpad & GAMEPAD_MASK_DPAD)
 	{
-		case GAMEPAD_MASK_UP:                        switchReport.hat = SWITCH_HAT_UP;        break;
-		case GAMEPAD_MASK_UP | GAMEPAD_MASK_RIGHT:   switchReport.hat = SWITCH_HAT_UPRIGHT;   break;
-		case GAMEPAD_MASK_RIGHT:                     switchReport.hat = SWITCH_HAT_RIGHT;     break;
-		case GAMEPAD_MASK_DOWN | GAMEPAD_MASK_RIGHT: switchReport.hat = SWITCH_HAT_DOWNRIGHT; break;
-		case GAMEPAD_MASK_DOWN:                      switchReport.hat = SWITCH_HAT_DOWN;      break;
-		case GAMEPAD_MASK_DOWN | GAMEPAD_MASK_LEFT:  switchReport.hat = SWITCH_HAT_DOWNLEFT;  break;
-		case GAMEPAD_MASK_LEFT:                      switchReport.hat = SWITCH_HAT_LEFT;      break;
-		case GAMEPAD_MASK_UP | GAMEPAD_MASK_LEFT:    switchReport.hat = SWITCH_HAT_UPLEFT;    break;
-		default:                                     switchReport.hat = SWITCH_HAT_NOTHING;   break;
+		case GAMEPAD_MASK_UP:                        report->hat = SWITCH_HAT_UP;        break;
+		case GAMEPAD_MASK_UP | GAMEPAD_MASK_RIGHT:   report->hat = SWITCH_HAT_UPRIGHT;   break;
+		case GAMEPAD_MASK_RIGHT:                     report->hat = SWITCH_HAT_RIGHT;     break;
+		case GAMEPAD_MASK_DOWN | GAMEPAD_MASK_RIGHT: report->hat = SWITCH_HAT_DOWNRIGHT; break;
+		case GAMEPAD_MASK_DOWN:                      report->hat = SWITCH_HAT_DOWN;      break;
+		case GAMEPAD_MASK_DOWN | GAMEPAD_MASK_LEFT:  report->hat = SWITCH_HAT_DOWNLEFT;  break;
+		case GAMEPAD_MASK_LEFT:                      report->hat = SWITCH_HAT_LEFT;      break;
+		case GAMEPAD_MASK_UP | GAMEPAD_MASK_LEFT:    report->hat = SWITCH_HAT_UPLEFT;    break;
+		default:                                     report->hat = SWITCH_HAT_NOTHING;   break;
 	}
 
-	switchReport.buttons = 0
+	report->buttons = 0
 		| (pressedB1() ? SWITCH_MASK_B       : 0)
 		| (pressedB2() ? SWITCH_MASK_A       : 0)
 		| (pressedB3() ? SWITCH_MASK_Y       : 0)
@@ -414,18 +509,18 @@ SwitchReport *Gamepad::getSwitchReport()
 		| (pressedA2() ? SWITCH_MASK_CAPTURE : 0)
 	;
 
-	switchReport.lx = static_cast<uint8_t>(state.lx >> 8);
-	switchReport.ly = static_cast<uint8_t>(state.ly >> 8);
-	switchReport.rx = static_cast<uint8_t>(state.rx >> 8);
-	switchReport.ry = static_cast<uint8_t>(state.ry >> 8);
+	report->lx = static_cast<uint8_t>(state.lx >> 8);
+	report->ly = static_cast<uint8_t>(state.ly >> 8);
+	report->rx = static_cast<uint8_t>(state.rx >> 8);
+	report->ry = static_cast<uint8_t>(state.ry >> 8);
 
-	return &switchReport;
+	return report;
 }
 
 
-XInputReport *Gamepad::getXInputReport()
+XInputReport *Gamepad::getXInputReport(XInputReport *report)
 {
-	xinputReport.buttons1 = 0
+	report->buttons1 = 0
 		| (pressedUp()    ? XBOX_MASK_UP    : 0)
 		| (pressedDown()  ? XBOX_MASK_DOWN  : 0)
 		| (pressedLeft()  ? XBOX_MASK_LEFT  : 0)
@@ -436,7 +531,7 @@ XInputReport *Gamepad::getXInputReport()
 		| (pressedR3()    ? XBOX_MASK_RS    : 0)
 	;
 
-	xinputReport.buttons2 = 0
+	report->buttons2 = 0
 		| (pressedL1() ? XBOX_MASK_LB   : 0)
 		| (pressedR1() ? XBOX_MASK_RB   : 0)
 		| (pressedA1() ? XBOX_MASK_HOME : 0)
@@ -446,81 +541,81 @@ XInputReport *Gamepad::getXInputReport()
 		| (pressedB4() ? XBOX_MASK_Y    : 0)
 	;
 
-	xinputReport.lx = static_cast<int16_t>(state.lx) + INT16_MIN;
-	xinputReport.ly = static_cast<int16_t>(~state.ly) + INT16_MIN;
-	xinputReport.rx = static_cast<int16_t>(state.rx) + INT16_MIN;
-	xinputReport.ry = static_cast<int16_t>(~state.ry) + INT16_MIN;
+	report->lx = static_cast<int16_t>(state.lx) + INT16_MIN;
+	report->ly = static_cast<int16_t>(~state.ly) + INT16_MIN;
+	report->rx = static_cast<int16_t>(state.rx) + INT16_MIN;
+	report->ry = static_cast<int16_t>(~state.ry) + INT16_MIN;
 
 	if (hasAnalogTriggers)
 	{
-		xinputReport.lt = state.lt;
-		xinputReport.rt = state.rt;
+		report->lt = state.lt;
+		report->rt = state.rt;
 	}
 	else
 	{
-		xinputReport.lt = pressedL2() ? 0xFF : 0;
-		xinputReport.rt = pressedR2() ? 0xFF : 0;
+		report->lt = pressedL2() ? 0xFF : 0;
+		report->rt = pressedR2() ? 0xFF : 0;
 	}
 
-	return &xinputReport;
+	return report;
 }
 
 
-PS4Report *Gamepad::getPS4Report()
+PS4Report *Gamepad::getPS4Report(PS4Report *report)
 {
 	switch (state.dpad & GAMEPAD_MASK_DPAD)
 	{
-		case GAMEPAD_MASK_UP:                        ps4Report.dpad = HID_HAT_UP;        break;
-		case GAMEPAD_MASK_UP | GAMEPAD_MASK_RIGHT:   ps4Report.dpad = HID_HAT_UPRIGHT;   break;
-		case GAMEPAD_MASK_RIGHT:                     ps4Report.dpad = HID_HAT_RIGHT;     break;
-		case GAMEPAD_MASK_DOWN | GAMEPAD_MASK_RIGHT: ps4Report.dpad = HID_HAT_DOWNRIGHT; break;
-		case GAMEPAD_MASK_DOWN:                      ps4Report.dpad = HID_HAT_DOWN;      break;
-		case GAMEPAD_MASK_DOWN | GAMEPAD_MASK_LEFT:  ps4Report.dpad = HID_HAT_DOWNLEFT;  break;
-		case GAMEPAD_MASK_LEFT:                      ps4Report.dpad = HID_HAT_LEFT;      break;
-		case GAMEPAD_MASK_UP | GAMEPAD_MASK_LEFT:    ps4Report.dpad = HID_HAT_UPLEFT;    break;
-		default:                                     ps4Report.dpad = PS4_HAT_NOTHING;   break;
+		case GAMEPAD_MASK_UP:                        report->dpad = HID_HAT_UP;        break;
+		case GAMEPAD_MASK_UP | GAMEPAD_MASK_RIGHT:   report->dpad = HID_HAT_UPRIGHT;   break;
+		case GAMEPAD_MASK_RIGHT:                     report->dpad = HID_HAT_RIGHT;     break;
+		case GAMEPAD_MASK_DOWN | GAMEPAD_MASK_RIGHT: report->dpad = HID_HAT_DOWNRIGHT; break;
+		case GAMEPAD_MASK_DOWN:                      report->dpad = HID_HAT_DOWN;      break;
+		case GAMEPAD_MASK_DOWN | GAMEPAD_MASK_LEFT:  report->dpad = HID_HAT_DOWNLEFT;  break;
+		case GAMEPAD_MASK_LEFT:                      report->dpad = HID_HAT_LEFT;      break;
+		case GAMEPAD_MASK_UP | GAMEPAD_MASK_LEFT:    report->dpad = HID_HAT_UPLEFT;    break;
+		default:                                     report->dpad = PS4_HAT_NOTHING;   break;
 	}
 
-	ps4Report.button_south    = pressedB1();
-	ps4Report.button_east     = pressedB2();
-	ps4Report.button_west     = pressedB3();
-	ps4Report.button_north    = pressedB4();
-	ps4Report.button_l1       = pressedL1();
-	ps4Report.button_r1       = pressedR1();
-	ps4Report.button_l2       = pressedL2();
-	ps4Report.button_r2       = pressedR2();
-	ps4Report.button_select   = pressedS1();
-	ps4Report.button_start    = pressedS2();
-	ps4Report.button_l3       = pressedL3();
-	ps4Report.button_r3       = pressedR3();
-	ps4Report.button_home     = pressedA1();
-	ps4Report.button_touchpad = pressedA2();
+	report->button_south    = pressedB1();
+	report->button_east     = pressedB2();
+	report->button_west     = pressedB3();
+	report->button_north    = pressedB4();
+	report->button_l1       = pressedL1();
+	report->button_r1       = pressedR1();
+	report->button_l2       = pressedL2();
+	report->button_r2       = pressedR2();
+	report->button_select   = pressedS1();
+	report->button_start    = pressedS2();
+	report->button_l3       = pressedL3();
+	report->button_r3       = pressedR3();
+	report->button_home     = pressedA1();
+	report->button_touchpad = pressedA2();
 
 	// report counter is 6 bits, but we circle 0-255
-	ps4Report.report_counter = last_report_counter++;
+	report->report_counter = last_report_counter++;
 
-	ps4Report.left_stick_x = static_cast<uint8_t>(state.lx >> 8);
-	ps4Report.left_stick_y = static_cast<uint8_t>(state.ly >> 8);
-	ps4Report.right_stick_x = static_cast<uint8_t>(state.rx >> 8);
-	ps4Report.right_stick_y = static_cast<uint8_t>(state.ry >> 8);
+	report->left_stick_x = static_cast<uint8_t>(state.lx >> 8);
+	report->left_stick_y = static_cast<uint8_t>(state.ly >> 8);
+	report->right_stick_x = static_cast<uint8_t>(state.rx >> 8);
+	report->right_stick_y = static_cast<uint8_t>(state.ry >> 8);
 
 	if (hasAnalogTriggers)
 	{
-		ps4Report.left_trigger = state.lt;
-		ps4Report.right_trigger = state.rt;
+		report->left_trigger = state.lt;
+		report->right_trigger = state.rt;
 	}
 	else
 	{
-		ps4Report.left_trigger = pressedL2() ? 0xFF : 0;
-		ps4Report.right_trigger = pressedR2() ? 0xFF : 0;
+		report->left_trigger = pressedL2() ? 0xFF : 0;
+		report->right_trigger = pressedR2() ? 0xFF : 0;
 	}
 
 	// set touchpad to nothing
 	touchpadData.p1.unpressed = 1;
 	touchpadData.p2.unpressed = 1;
-	ps4Report.touchpad_data = touchpadData;
+	report->touchpad_data = touchpadData;
 
-	return &ps4Report;
+	return report;
 }
 
 uint8_t Gamepad::getModifier(uint8_t code) {
@@ -538,42 +633,42 @@ uint8_t Gamepad::getModifier(uint8_t code) {
 	return 0;
 }
 
-void Gamepad::pressKey(uint8_t code) {
+void Gamepad::pressKey(KeyboardReport *report, uint8_t code) {
 	if (code >= HID_KEY_CONTROL_LEFT) {
-		keyboardReport.keycode[0] |= getModifier(code);
+		report->keycode[0] |= getModifier(code);
 	} else if ((code >> 3) < KEY_COUNT - 2) {
-		keyboardReport.keycode[(code >> 3) + 1] |= 1 << (code & 7);
+		report->keycode[(code >> 3) + 1] |= 1 << (code & 7);
 	}
 }
 
-void Gamepad::releaseAllKeys(void) {
-	for (uint8_t i = 0; i < (sizeof(keyboardReport.keycode) / sizeof(keyboardReport.keycode[0])); i++) {
-		keyboardReport.keycode[i] = 0;
+void Gamepad::releaseAllKeys(KeyboardReport *report) {
+	for (uint8_t i = 0; i < (sizeof(report->keycode) / sizeof(report->keycode[0])); i++) {
+		report->keycode[i] = 0;
 	}
 }
 
-KeyboardReport *Gamepad::getKeyboardReport()
+KeyboardReport *Gamepad::getKeyboardReport(KeyboardReport *report)
 {
-	releaseAllKeys();
-	if(pressedUp())     { pressKey(options.keyDpadUp); }
-	if(pressedDown())   { pressKey(options.keyDpadDown); }
-	if(pressedLeft())	{ pressKey(options.keyDpadLeft); }
-	if(pressedRight()) 	{ pressKey(options.keyDpadRight); }
-	if(pressedB1()) 	{ pressKey(options.keyButtonB1); }
-	if(pressedB2()) 	{ pressKey(options.keyButtonB2); }
-	if(pressedB3()) 	{ pressKey(options.keyButtonB3); }
-	if(pressedB4()) 	{ pressKey(options.keyButtonB4); }
-	if(pressedL1()) 	{ pressKey(options.keyButtonL1); }
-	if(pressedR1()) 	{ pressKey(options.keyButtonR1); }
-	if(pressedL2()) 	{ pressKey(options.keyButtonL2); }
-	if(pressedR2()) 	{ pressKey(options.keyButtonR2); }
-	if(pressedS1()) 	{ pressKey(options.keyButtonS1); }
-	if(pressedS2()) 	{ pressKey(options.keyButtonS2); }
-	if(pressedL3()) 	{ pressKey(options.keyButtonL3); }
-	if(pressedR3()) 	{ pressKey(options.keyButtonR3); }
-	if(pressedA1()) 	{ pressKey(options.keyButtonA1); }
-	if(pressedA2()) 	{ pressKey(options.keyButtonA2); }
-	return &keyboardReport;
+	releaseAllKeys(report);
+	if(pressedUp())     { pressKey(report, options.keyDpadUp); }
+	if(pressedDown())   { pressKey(report, options.keyDpadDown); }
+	if(pressedLeft())	{ pressKey(report, options.keyDpadLeft); }
+	if(pressedRight()) 	{ pressKey(report, options.keyDpadRight); }
+	if(pressedB1()) 	{ pressKey(report, options.keyButtonB1); }
+	if(pressedB2()) 	{ pressKey(report, options.keyButtonB2); }
+	if(pressedB3()) 	{ pressKey(report, options.keyButtonB3); }
+	if(pressedB4()) 	{ pressKey(report, options.keyButtonB4); }
+	if(pressedL1()) 	{ pressKey(report, options.keyButtonL1); }
+	if(pressedR1()) 	{ pressKey(report, options.keyButtonR1); }
+	if(pressedL2()) 	{ pressKey(report, options.keyButtonL2); }
+	if(pressedR2()) 	{ pressKey(report, options.keyButtonR2); }
+	if(pressedS1()) 	{ pressKey(report, options.keyButtonS1); }
+	if(pressedS2()) 	{ pressKey(report, options.keyButtonS2); }
+	if(pressedL3()) 	{ pressKey(report, options.keyButtonL3); }
+	if(pressedR3()) 	{ pressKey(report, options.keyButtonR3); }
+	if(pressedA1()) 	{ pressKey(report, options.keyButtonA1); }
+	if(pressedA2()) 	{ pressKey(report, options.keyButtonA2); }
+	return report;
 }
 
 
@@ -0,0 +1,141 @@
+#include "gamepad/GamepadRemapper.h"
+
+#include <string.h>
+
+uint32_t GamepadRemapper::apply(uint64_t sources)
+{
+	uint8_t layer = selectedLayer;
+	if (sources & triggerMask)
+	{
+		// The highest held layer wins
+		for (uint8_t i = layerCount - 1; i > REMAP_BASE_LAYER; i--)
+		{
+			if (triggers[i] != REMAP_NO_SOURCE && (sources & (1ULL << triggers[i])))
+			{
+				layer = i;
+				break;
+			}
+		}
+	}
+	activeLayer = layer;
+
+	// Split the sources so the shifts stay 32 bit
+	const uint32_t words[2] = { static_cast<uint32_t>(sources), static_cast<uint32_t>(sources >> 32) };
+	const uint32_t (*table)[16] = tables[layer];
+	uint32_t target = 0;
+	for (uint8_t i = 0; i < nibbleCount; i++)
+	{
+		const uint8_t nibble = nibbles[i];
+		target |= table[nibble][(words[nibble >> 3] >> ((nibble & 7) * 4)) & 0xF];
+	}
+	return target;
+}
+
+void GamepadRemapper::addRule(uint8_t source, uint32_t target)
+{
+	if (source >= REMAP_SOURCE_COUNT)
+		return;
+
+	rules[source] |= target;
+	compile(source / 4);
+}
+
+void GamepadRemapper::setOverride(uint8_t layer, uint8_t source, uint32_t target)
+{
+	if (layer == REMAP_BASE_LAYER || layer >= layerCount || source >= REMAP_SOURCE_COUNT)
+		return;
+
+	overrides[layer][source] = target;
+	overridden[layer] |= 1ULL << source;
+	compile(source / 4);
+}
+
+uint8_t GamepadRemapper::addLayer(uint8_t trigger)
+{
+	if (layerCount == REMAP_MAX_LAYERS)
+		return REMAP_NO_LAYER;
+
+	const uint8_t layer = layerCount++;
+	if (trigger < REMAP_SOURCE_COUNT)
+	{
+		triggers[layer] = trigger;
+		triggerMask |= 1ULL << trigger;
+
+		// Compiled as a selectable layer so far, it has to pick up the selected layer instead
+		compileAll();
+	}
+	return layer;
+}
+
+void GamepadRemapper::selectLayer(uint8_t layer)
+{
+	if (layer < layerCount && triggers[layer] == REMAP_NO_SOURCE && layer != selectedLayer)
+	{
+		selectedLayer = layer;
+		compileAll();
+	}
+}
+
+void GamepadRemapper::nextLayer()
+{
+	uint8_t layer = selectedLayer;
+	do
+		layer = (layer + 1) % layerCount;
+	while (triggers[layer] != REMAP_NO_SOURCE);
+	selectLayer(layer);
+}
+
+void GamepadRemapper::reset()
+{
+	memset(rules, 0, sizeof(rules));
+	memset(overrides, 0, sizeof(overrides));
+	memset(overridden, 0, sizeof(overridden));
+	memset(tables, 0, sizeof(tables));
+	memset(triggers, REMAP_NO_SOURCE, sizeof(triggers));
+	nibbleCount = 0;
+	triggerMask = 0;
+	layerCount = 1;
+	selectedLayer = REMAP_BASE_LAYER;
+	activeLayer = REMAP_BASE_LAYER;
+}
+
+uint32_t GamepadRemapper::target(uint8_t layer, uint8_t source) const
+{
+	return (overridden[layer] & (1ULL << source)) ? overrides[layer][source] : rules[source];
+}
+
+void GamepadRemapper::compileAll()
+{
+	for (uint8_t i = 0; i < nibbleCount; i++)
+		compile(nibbles[i]);
+}
+
+void GamepadRemapper::compile(uint8_t nibble)
+{
+	// Layers that are not added yet compile to the base layer, so adding a selectable layer needs no compile.
+	// Trigger layers stack on the selected layer: what they don't override maps as in the selected layer.
+	for (uint8_t layer = 0; layer < REMAP_MAX_LAYERS; layer++)
+	{
+		const uint8_t fallback = triggers[layer] != REMAP_NO_SOURCE ? selectedLayer : layer;
+		uint32_t targets[4];
+		for (uint8_t bit = 0; bit < 4; bit++)
+		{
+			const uint8_t source = nibble * 4 + bit;
+			targets[bit] = (overridden[layer] & (1ULL << source)) ? overrides[layer][source] : target(fallback, source);
+		}
+
+		// Every index is the OR of one lower index and the target of its highest bit
+		uint32_t *table = tables[layer][nibble];
+		table[0] = 0;
+		for (uint8_t index = 1; index < 16; index++)
+		{
+			const uint8_t bit = 31 - __builtin_clz(index);
+			table[index] = table[index & ~(1 << bit)] | targets[bit];
+		}
+	}
+
+	for (uint8_t i = 0; i < nibbleCount; i++)
+		if (nibbles[i] == nibble)
+			return;
+	nibbles[nibbleCount++] = nibble;
+}
@@ -0,0 +1,72 @@
+#include "gamepad/GamepadSOCDCleaner.h"
+
+/*
+ * Both axes are cleaned the same way, only Up Priority treats them differently. An axis reads as two bits:
+ * bit 0 for Up/Left and bit 1 for Down/Right, which matches the D-pad masks of the Up-Down axis and, shifted
+ * right by two, of the Left-Right axis. The history of an axis uses the same bits for the direction that was
+ * pressed last on its own, or 0 for none.
+ *
+ * A table entry holds the clean D-pad in bits 0-3 and the next history in bits 4-7, tables are indexed by
+ * the current history in bits 4-7 and the raw D-pad in bits 0-3.
+ */
+
+#define SOCD_MODE_COUNT (SOCD_MODE_BYPASS + 1)
+#define SOCD_AXIS_BOTH 0x3
+
+struct AxisStep
+{
+	uint8_t output;
+	uint8_t history;
+};
+
+static constexpr AxisStep cleanAxis(SOCDMode mode, bool upDown, uint8_t history, uint8_t input)
+{
+	if (mode == SOCD_MODE_BYPASS)
+		return { input, history };
+
+	if (input != SOCD_AXIS_BOTH)
+		return { input, input };
+
+	if (upDown && mode == SOCD_MODE_UP_PRIORITY)
+		return { GAMEPAD_MASK_UP, GAMEPAD_MASK_UP };
+	if (mode == SOCD_MODE_SECOND_INPUT_PRIORITY && history != 0)
+		return { static_cast<uint8_t>(history ^ SOCD_AXIS_BOTH), history };
+	if (mode == SOCD_MODE_FIRST_INPUT_PRIORITY && history != 0)
+		return { history, history };
+
+	return { 0, 0 };
+}
+
+struct SOCDTables
+{
+	uint8_t entries[SOCD_MODE_COUNT][256];
+};
+
+static constexpr SOCDTables makeTables()
+{
+	SOCDTables tables = {};
+	for (int mode = 0; mode < SOCD_MODE_COUNT; mode++)
+	{
+		for (int index = 0; index < 256; index++)
+		{
+			const uint8_t history = index >> 4;
+			const uint8_t dpad = index & 0xF;
+			const AxisStep upDown = cleanAxis(static_cast<SOCDMode>(mode), true, history & 0x3, dpad & 0x3);
+			const AxisStep leftRight = cleanAxis(static_cast<SOCDMode>(mode), false, history >> 2, dpad >> 2);
+			tables.entries[mode][index] = static_cast<uint8_t>(
+				upDown.output | (leftRight.output << 2) | (upDown.history << 4) | (leftRight.history << 6));
+		}
+	}
+	return tables;
+}
+
+static constexpr SOCDTables socdTables = makeTables();
+
+uint8_t GamepadSOCDCleaner::clean(SOCDMode mode, uint8_t dpad)
+{
+	// Unknown modes clean like Neutral, as the branches before the tables did
+	const uint8_t* table = socdTables.entries[mode < SOCD_MODE_COUNT ? mode : SOCD_MODE_NEUTRAL];
+	const uint8_t entry = table[(history << 4) | (dpad & GAMEPAD_MASK_DPAD)];
+	history = entry >> 4;
+	return entry & GAMEPAD_MASK_DPAD;
+}
@@ -2,6 +2,10 @@
 #include "gp2040.h"
 #include "helper.h"
 #include "system.h"
+#include "adcsampler.h"
+#include "inputscanner.h"
+#include "buttonmatrix.h"
+#include "inputrecorder.h"
 
 #include "configmanager.h" // Global Managers
 #include "storagemanager.h"
@@ -89,6 +93,10 @@ void GP2040::setup() {
 				}
 
 				initialize_driver(inputMode);
+				init_report_buffers(gamepad->getDefaultReport(), gamepad->getReportSize());
+
+				// Record this session, or replay an uploaded trace, before any add-on reads the clock
+				InputRecorder::getInstance().begin();
 				break;
 			}
 	}
@@ -108,12 +116,20 @@ void GP2040::setup() {
 	addons.LoadAddon(new WiiExtensionInput(), CORE0_INPUT);
 	addons.LoadAddon(new PlayerNumAddon(), CORE0_USBREPORT);
 	addons.LoadAddon(new SliderSOCDInput(), CORE0_INPUT);
+
+	// Start sampling the ADC pins the add-ons registered
+	AdcSampler::getInstance().start();
+
+	// Scan the buttons in the background once every add-on has configured its input pins
+	InputScanner::getInstance().start(ButtonMatrix::getInstance().getPinMask());
 }
 
 void GP2040::run() {
 	Gamepad * gamepad = Storage::getInstance().GetGamepad();
 	Gamepad * processedGamepad = Storage::getInstance().GetProcessedGamepad();
 	bool configMode = Storage::getInstance().GetConfigMode();
+	InputScanner& inputScanner = InputScanner::getInstance();
+	InputRecorder& inputRecorder = InputRecorder::getInstance();
 	while (1) { // LOOP
 		// Config Loop (Web-Config does not require gamepad)
 		if (configMode == true) {
@@ -121,23 +137,36 @@ void GP2040::run() {
 			ConfigManager::getInstance().loop();
 
 			gamepad->read();
+			AdcSampler::getInstance().update(); // raw analog readings for calibration
 			webConfigHotkey.process(gamepad, configMode);
 
 			continue;
 		}
 
 		if (nextRuntime > getMicro()) { // fix for unsigned
-			sleep_us(50); // Give some time back to our CPU (lower power consumption)
-			continue;
+			// Give some time back to our CPU (lower power consumption), an input edge starts the next frame early
+			if (!inputScanner.hasPendingEdges()) {
+				best_effort_wfe_or_timeout(from_us_since_boot(nextRuntime));
+				continue;
+			}
 		}
 
+		// A replay feeds the recorded frames back to back and leaves out hotkeys, so it can't change the saved options
+		const bool replaying = inputRecorder.isReplaying();
+
 		// Gamepad Features
-		gamepad->read(); 	// gpio pin reads
+		if (replaying)
+			inputRecorder.replay(gamepad); // recorded pin reads on the recorded clock
+		else
+			gamepad->read(); 	// gpio pin reads
 	#if GAMEPAD_DEBOUNCE_MILLIS > 0
 		gamepad->debounce();
 	#endif
-		gamepad->hotkey(); 	// check for MPGS hotkeys
-		webConfigHotkey.process(gamepad, configMode);
+		AdcSampler::getInstance().update(); // latest filtered analog values for the add-ons
+		if (!replaying) {
+			gamepad->hotkey(); 	// check for MPGS hotkeys
+			webConfigHotkey.process(gamepad, configMode);
+		}
 
 		// Pre-Process add-ons for MPGS
 		addons.PreprocessAddons(ADDON_PROCESS::CORE0_INPUT);
@@ -147,11 +176,19 @@ void GP2040::run() {
 		// (Post) Process for add-ons
 		addons.ProcessAddons(ADDON_PROCESS::CORE0_INPUT);
 
+		inputRecorder.capture(gamepad->gpio, gamepad->state);
+		if (replaying) {
+			tud_task(); // No reports are sent, but the host still gets its control requests answered
+			continue;
+		}
+
 		// Copy Processed Gamepad for Core1 (race condition otherwise)
 		memcpy(&processedGamepad->state, &gamepad->state, sizeof(GamepadState));
 
 		// USB FEATURES : Send/Get USB Features (including Player LEDs on X-Input)
-		send_report(gamepad->getReport(), gamepad->getReportSize());
+		if (gamepad->gpio.edges > 0)
+			report_input_edges(gamepad->gpio.firstEdge, gamepad->gpio.edges);
+		send_report(gamepad->getReport(get_report_buffer()), gamepad->getReportSize());
 		Storage::getInstance().ClearFeatureData();
 		receive_report(Storage::getInstance().GetFeatureData());
 
@@ -231,6 +268,8 @@ void GP2040::WebConfigHotkey::process(Gamepad* gamepad, bool configMode) {
 
 			if (time_reached(webConfigHotkeyHoldTimeout)) {
 				// If we are in webconfig mode we go to gamepad mode and vice versa
+				if (!configMode)
+					save_report_stats();
 				System::reboot(configMode ? System::BootMode::GAMEPAD : System::BootMode::WEBCONFIG);
 			}
 		} else {
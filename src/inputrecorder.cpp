@@ -0,0 +1,197 @@
+#include "inputrecorder.h"
+#include "system.h"
+
+#include <cstring>
+
+#include "hardware/timer.h"
+#include "pico/platform.h"
+
+enum class TraceMode : uint32_t
+{
+	RECORDING = 1,
+	REPLAY_PENDING,
+	REPLAYING,
+	REPLAYED,
+};
+
+struct TraceStore
+{
+	uint32_t magic;
+	TraceMode mode;
+	uint32_t head;    // Next entry to be written
+	uint32_t count;
+	uint32_t dropped;
+	InputReplayResult result;
+	InputTraceEntry entries[INPUT_RECORDER_ENTRIES];
+};
+
+// Kept in RAM that is not cleared on boot, so the trace of a gamepad session survives the reboot into web config
+static TraceStore __uninitialized_ram(traceStore);
+
+static bool isStoreValid() {
+	return traceStore.magic == INPUT_TRACE_MAGIC && traceStore.head < INPUT_RECORDER_ENTRIES &&
+		traceStore.count <= INPUT_RECORDER_ENTRIES;
+}
+
+// Entries counted from the oldest one in the ring
+static const InputTraceEntry& entryAt(uint32_t index) {
+	return traceStore.entries[(traceStore.head + INPUT_RECORDER_ENTRIES - traceStore.count + index) % INPUT_RECORDER_ENTRIES];
+}
+
+static bool stateEquals(const GamepadState& a, const GamepadState& b) {
+	return a.buttons == b.buttons && a.dpad == b.dpad && a.aux == b.aux &&
+		a.lx == b.lx && a.ly == b.ly && a.rx == b.rx && a.ry == b.ry && a.lt == b.lt && a.rt == b.rt;
+}
+
+void InputRecorder::begin() {
+	if (isStoreValid() && traceStore.mode == TraceMode::REPLAY_PENDING && traceStore.count > 0) {
+		// A reset in the middle of the replay starts a recording instead of replaying again
+		traceStore.mode = TraceMode::REPLAYING;
+		traceStore.result = {};
+		replayIndex = 0;
+		replayTime = entryAt(0).time;
+		replaying = true;
+		return;
+	}
+
+	traceStore.magic = INPUT_TRACE_MAGIC;
+	traceStore.mode = TraceMode::RECORDING;
+	traceStore.head = 0;
+	traceStore.count = 0;
+	traceStore.dropped = 0;
+	recording = true;
+}
+
+void InputRecorder::replay(Gamepad* gamepad) {
+	const InputTraceEntry& entry = entryAt(replayIndex);
+
+	// The stamps only hold 32 bits, the gaps between two changes are far below their 71 minute wrap
+	if (replayIndex > 0)
+		replayTime += entry.time - entryAt(replayIndex - 1).time;
+
+	GpioSnapshot gpio;
+	gpio.pressed = entry.pressed;
+	gpio.keys = entry.keys;
+	gpio.timestamp = replayTime;
+
+	frameStart = time_us_32();
+	gamepad->read(gpio);
+}
+
+void InputRecorder::capture(const GpioSnapshot& gpio, const GamepadState& state) {
+	if (replaying) {
+		const uint32_t elapsed = time_us_32() - frameStart;
+		InputReplayResult& result = traceStore.result;
+		result.pipelineTime += elapsed;
+		if (elapsed > result.pipelineMax)
+			result.pipelineMax = elapsed;
+
+		const InputTraceEntry& entry = entryAt(replayIndex);
+		if (state.buttons != entry.buttons || state.dpad != entry.dpad || state.aux != entry.aux) {
+			if (result.mismatches == 0) {
+				result.firstMismatch = replayIndex;
+				result.expectedButtons = entry.buttons;
+				result.actualButtons = state.buttons;
+				result.expectedDpad = entry.dpad;
+				result.actualDpad = state.dpad;
+				result.expectedAux = entry.aux;
+				result.actualAux = state.aux;
+			}
+			result.mismatches++;
+		}
+		result.frames++;
+
+		if (++replayIndex == traceStore.count)
+			finishReplay();
+		return;
+	}
+
+	if (!recording)
+		return;
+
+	// Frames where nothing changed are implied by the gap between two entries
+	if (traceStore.count > 0 && gpio.pressed == lastGpio.pressed && gpio.keys == lastGpio.keys && stateEquals(state, lastState))
+		return;
+
+	InputTraceEntry& entry = traceStore.entries[traceStore.head];
+	entry.time = (uint32_t)gpio.timestamp;
+	entry.pressed = gpio.pressed;
+	entry.keys = gpio.keys;
+	entry.buttons = state.buttons;
+	entry.aux = state.aux;
+	entry.dpad = state.dpad;
+	entry.lt = state.lt;
+	entry.rt = state.rt;
+	entry.reserved = 0;
+	entry.lx = state.lx;
+	entry.ly = state.ly;
+	entry.rx = state.rx;
+	entry.ry = state.ry;
+
+	traceStore.head = (traceStore.head + 1) % INPUT_RECORDER_ENTRIES;
+	if (traceStore.count < INPUT_RECORDER_ENTRIES)
+		traceStore.count++;
+	else
+		traceStore.dropped++;
+
+	lastGpio = gpio;
+	lastState = state;
+}
+
+void InputRecorder::finishReplay() {
+	replaying = false;
+	traceStore.mode = TraceMode::REPLAYED;
+	System::reboot(System::BootMode::WEBCONFIG);
+}
+
+size_t InputRecorder::exportTrace(uint8_t* buffer, size_t size) const {
+	const uint32_t count = getEntryCount();
+	const size_t length = sizeof(InputTraceHeader) + count * sizeof(InputTraceEntry);
+	if (count == 0 || size < length)
+		return 0;
+
+	const InputTraceHeader header = {
+		INPUT_TRACE_MAGIC,
+		INPUT_TRACE_VERSION,
+		sizeof(InputTraceEntry),
+		count,
+		traceStore.dropped,
+	};
+	memcpy(buffer, &header, sizeof(header));
+	for (uint32_t index = 0; index < count; index++)
+		memcpy(buffer + sizeof(header) + index * sizeof(InputTraceEntry), &entryAt(index), sizeof(InputTraceEntry));
+
+	return length;
+}
+
+bool InputRecorder::importTrace(const uint8_t* data, size_t length) {
+	InputTraceHeader header;
+	if (length < sizeof(header))
+		return false;
+
+	memcpy(&header, data, sizeof(header));
+	if (header.magic != INPUT_TRACE_MAGIC || header.version != INPUT_TRACE_VERSION ||
+		header.entrySize != sizeof(InputTraceEntry) || header.count == 0 || header.count > INPUT_RECORDER_ENTRIES ||
+		length != sizeof(header) + header.count * sizeof(InputTraceEntry))
+		return false;
+
+	memcpy(traceStore.entries, data + sizeof(header), header.count * sizeof(InputTraceEntry));
+	traceStore.magic = INPUT_TRACE_MAGIC;
+	traceStore.mode = TraceMode::REPLAY_PENDING;
+	traceStore.head = header.count % INPUT_RECORDER_ENTRIES;
+	traceStore.count = header.count;
+	traceStore.dropped = header.dropped;
+	return true;
+}
+
+uint32_t InputRecorder::getEntryCount() const {
+	return isStoreValid() ? traceStore.count : 0;
+}
+
+uint32_t InputRecorder::getDroppedCount() const {
+	return isStoreValid() ? traceStore.dropped : 0;
+}
+
+const InputReplayResult* InputRecorder::getReplayResult() const {
+	return isStoreValid() && traceStore.mode == TraceMode::REPLAYED ? &traceStore.result : nullptr;
+}
@@ -0,0 +1,181 @@
+#include "inputscanner.h"
+
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+#include "hardware/pio.h"
+#include "hardware/timer.h"
+#include "pico/platform.h"
+
+#define SCAN_PROGRAM_LENGTH 7
+#define SCAN_LOOP_CYCLES 5 // Instructions per sample while the levels stay the same
+#define SCAN_NOISE_LIMIT 16 // Pushes without an input change tolerated in one drain before the scanner gives up
+
+static_assert((INPUT_SCANNER_RING_SIZE & (INPUT_SCANNER_RING_SIZE - 1)) == 0, "Ring size must be a power of two");
+
+// Every edge takes one entry in both rings, DMA rings wrap on an address boundary of their own size
+static volatile uint32_t levelRing[INPUT_SCANNER_RING_SIZE] __attribute__((aligned(INPUT_SCANNER_RING_SIZE * sizeof(uint32_t))));
+static volatile uint32_t timeRing[INPUT_SCANNER_RING_SIZE] __attribute__((aligned(INPUT_SCANNER_RING_SIZE * sizeof(uint32_t))));
+
+static PIO scanPio = pio1;
+static int scanSm = -1;
+static uint scanFirstPin = 0;
+static int scanIrqChannel = -1;
+
+// Only here to wake the core from its idle wait, the edges are read in drain()
+static void scanIRQ() {
+	if (dma_channel_get_irq1_status(scanIrqChannel))
+		dma_channel_acknowledge_irq1(scanIrqChannel);
+}
+
+bool InputScanner::start(uint32_t excludedPins) {
+	if (running)
+		return true;
+
+	for (uint pin = 0; pin < NUM_BANK0_GPIOS; pin++) {
+		if (gpio_get_function(pin) == GPIO_FUNC_SIO && !gpio_is_dir_out(pin) && !(excludedPins & (1u << pin)))
+			pinMask |= 1u << pin;
+	}
+	if (pinMask == 0)
+		return false;
+
+	// The state machine reads one contiguous span, a toggling output or bus inside it would flood the ring
+	const uint firstPin = __builtin_ctz(pinMask);
+	const uint span = 32 - __builtin_clz(pinMask) - firstPin;
+	for (uint pin = firstPin; pin < firstPin + span; pin++) {
+		if (!(pinMask & (1u << pin)) && gpio_get_function(pin) != GPIO_FUNC_NULL) {
+			pinMask = 0;
+			return false;
+		}
+	}
+
+	// X holds the levels pushed last, Y the current sample. Only a change pushes, and the push blocks
+	// rather than losing the final levels when the FIFO is full.
+	const uint16_t instructions[SCAN_PROGRAM_LENGTH] = {
+		(uint16_t)pio_encode_mov(pio_isr, pio_null), // wrap target
+		(uint16_t)pio_encode_in(pio_pins, span),
+		(uint16_t)pio_encode_mov(pio_y, pio_isr),
+		(uint16_t)pio_encode_jmp_x_ne_y(5),
+		(uint16_t)pio_encode_jmp(0),
+		(uint16_t)pio_encode_mov(pio_x, pio_y),
+		(uint16_t)pio_encode_push(false, true),      // wrap
+	};
+	const pio_program program = { instructions, SCAN_PROGRAM_LENGTH, -1 };
+
+	const int sm = pio_claim_unused_sm(scanPio, false);
+	if (sm < 0 || !pio_can_add_program(scanPio, &program)) {
+		if (sm >= 0)
+			pio_sm_unclaim(scanPio, sm);
+		pinMask = 0;
+		return false;
+	}
+
+	levelChannel = dma_claim_unused_channel(false);
+	timeChannel = dma_claim_unused_channel(false);
+	if (levelChannel < 0 || timeChannel < 0) {
+		if (levelChannel >= 0)
+			dma_channel_unclaim(levelChannel);
+		if (timeChannel >= 0)
+			dma_channel_unclaim(timeChannel);
+		levelChannel = timeChannel = -1;
+		pio_sm_unclaim(scanPio, sm);
+		pinMask = 0;
+		return false;
+	}
+
+	const uint offset = pio_add_program(scanPio, &program);
+	pio_sm_config config = pio_get_default_sm_config();
+	sm_config_set_wrap(&config, offset, offset + SCAN_PROGRAM_LENGTH - 1);
+	sm_config_set_in_pins(&config, firstPin);
+	sm_config_set_in_shift(&config, false, false, 32);
+	sm_config_set_fifo_join(&config, PIO_FIFO_JOIN_RX);
+	sm_config_set_clkdiv(&config, (float)clock_get_hz(clk_sys) / (INPUT_SCANNER_SAMPLE_RATE * SCAN_LOOP_CYCLES));
+	pio_sm_init(scanPio, sm, offset, &config);
+	// No pushed levels can match all ones, so the first sample is always pushed
+	pio_sm_exec(scanPio, sm, pio_encode_mov_not(pio_x, pio_null));
+
+	// The level channel waits for a push, then the time channel stamps it and hands back
+	dma_channel_config levelConfig = dma_channel_get_default_config(levelChannel);
+	channel_config_set_transfer_data_size(&levelConfig, DMA_SIZE_32);
+	channel_config_set_read_increment(&levelConfig, false);
+	channel_config_set_write_increment(&levelConfig, true);
+	channel_config_set_ring(&levelConfig, true, __builtin_ctz(sizeof(levelRing)));
+	channel_config_set_dreq(&levelConfig, pio_get_dreq(scanPio, sm, false));
+	channel_config_set_chain_to(&levelConfig, timeChannel);
+	dma_channel_configure(levelChannel, &levelConfig, levelRing, &scanPio->rxf[sm], 1, false);
+
+	dma_channel_config timeConfig = dma_channel_get_default_config(timeChannel);
+	channel_config_set_transfer_data_size(&timeConfig, DMA_SIZE_32);
+	channel_config_set_read_increment(&timeConfig, false);
+	channel_config_set_write_increment(&timeConfig, true);
+	channel_config_set_ring(&timeConfig, true, __builtin_ctz(sizeof(timeRing)));
+	channel_config_set_chain_to(&timeConfig, levelChannel);
+	dma_channel_configure(timeChannel, &timeConfig, timeRing, &timer_hw->timerawl, 1, false);
+
+	scanIrqChannel = timeChannel;
+	dma_channel_set_irq1_enabled(timeChannel, true);
+	irq_add_shared_handler(DMA_IRQ_1, scanIRQ, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+	irq_set_enabled(DMA_IRQ_1, true);
+
+	scanSm = sm;
+	scanFirstPin = firstPin;
+	levels = gpio_get_all() & pinMask;
+	readIndex = 0;
+	synced = false;
+	dma_channel_start(levelChannel);
+	pio_sm_set_enabled(scanPio, sm, true);
+	running = true;
+	return true;
+}
+
+void InputScanner::stop() {
+	// Without pushes the level channel only waits on its request, so it can be aborted once the stamp is written
+	pio_sm_set_enabled(scanPio, scanSm, false);
+	dma_channel_set_irq1_enabled(timeChannel, false);
+	while (dma_channel_is_busy(timeChannel))
+		tight_loop_contents();
+	dma_channel_abort(levelChannel);
+	dma_channel_abort(timeChannel);
+	running = false;
+}
+
+uint32_t InputScanner::getWriteIndex() const {
+	// The time channel writes last, so every entry before its write address is complete
+	return (dma_channel_hw_addr(timeChannel)->write_addr - (uintptr_t)timeRing) / sizeof(uint32_t);
+}
+
+bool InputScanner::hasPendingEdges() const {
+	return running && getWriteIndex() != readIndex;
+}
+
+uint32_t InputScanner::drain() {
+	// Entries hold absolute levels, so even a ring that lapped between drains ends on the right ones
+	// The oldest change is the one that has waited longest for its report
+	// Noise is counted per drain, so stray pushes (a lap during a long flash write, a floating pin) are forgiven
+	// while a toggling pin still floods a single frame. The sync push that follows start() is not noise.
+	const uint32_t writeIndex = getWriteIndex();
+	uint32_t noiseCount = 0;
+	drainedEdges = 0;
+	while (readIndex != writeIndex) {
+		const uint32_t sample = (levelRing[readIndex] << scanFirstPin) & pinMask;
+		if (sample != levels) {
+			levels = sample;
+			if (drainedEdges++ == 0)
+				firstEdgeTime = timeRing[readIndex];
+		} else if (synced) {
+			noiseCount++;
+		}
+		synced = true;
+		readIndex = (readIndex + 1) & (INPUT_SCANNER_RING_SIZE - 1);
+	}
+
+	// Only pins outside the mask changed, core1 has probably turned one inside the span into an output
+	if (noiseCount > SCAN_NOISE_LIMIT) {
+		stop();
+		return gpio_get_all();
+	}
+
+	// Pins outside the scan read as released
+	return levels | ~pinMask;
+}
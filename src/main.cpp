@@ -9,21 +9,28 @@
 // GP2040 includes
 #include "gp2040.h"
 #include "gp2040aux.h"
+#include "system.h"
 
 // Launch our second core with additional modules loaded in
 void core1() {
+	System::paintStack(1);
 	multicore_lockout_victim_init(); // block core 1
 
 	// Create GP2040 w/ Additional Modules for Core 1
 	GP2040Aux * gp2040Core1 = new GP2040Aux();
 	gp2040Core1->setup();
+	System::recordBootMemory(1);
 	gp2040Core1->run();
 }
 
 int main() {
+	// Paint the stack first thing so its high-water mark covers everything
+	System::paintStack(0);
+
 	// Create GP2040 Main Core (core0), Core1 is dependent on Core0
 	GP2040 * gp2040 = new GP2040();
 	gp2040->setup();
+	System::recordBootMemory(0);
 
 	// Create GP2040 Thread for Core1
 	multicore_launch_core1(core1);
@@ -0,0 +1,352 @@
+#include "ps4signer.h"
+
+#include <cstring>
+
+#include "mbedtls/sha256.h"
+
+static_assert(sizeof(mbedtls_mpi_uint) == sizeof(uint32_t), "PS4Signer expects 32 bit bignum limbs");
+
+namespace {
+	const uint16_t LIMBS = PS4Signer::PRIME_LIMBS;
+	const uint16_t WINDOW_BITS = 4;
+	const int16_t LAST_WINDOW = (LIMBS * 32 / WINDOW_BITS) - 1;
+	const uint16_t DB_SIZE = PS4Signer::SIGNATURE_SIZE - PS4Signer::HASH_SIZE - 1;
+	const uint32_t ONE[LIMBS] = { 1 };
+
+	int compare(const uint32_t* a, const uint32_t* b)
+	{
+		for (int i = LIMBS - 1; i >= 0; i--)
+		{
+			if (a[i] != b[i])
+				return a[i] > b[i] ? 1 : -1;
+		}
+		return 0;
+	}
+
+	uint32_t add(uint32_t* a, const uint32_t* b)
+	{
+		uint64_t carry = 0;
+		for (uint16_t i = 0; i < LIMBS; i++)
+		{
+			carry += static_cast<uint64_t>(a[i]) + b[i];
+			a[i] = static_cast<uint32_t>(carry);
+			carry >>= 32;
+		}
+		return static_cast<uint32_t>(carry);
+	}
+
+	uint32_t subtract(uint32_t* a, const uint32_t* b)
+	{
+		uint32_t borrow = 0;
+		for (uint16_t i = 0; i < LIMBS; i++)
+		{
+			const uint64_t difference = static_cast<uint64_t>(a[i]) - b[i] - borrow;
+			a[i] = static_cast<uint32_t>(difference);
+			borrow = (difference >> 32) ? 1 : 0;
+		}
+		return borrow;
+	}
+
+	// out = a * b * R^-1 mod m (CIOS), out may alias either input
+	void montgomeryMultiply(uint32_t* out, const uint32_t* a, const uint32_t* b, const uint32_t* m, uint32_t mInv)
+	{
+		uint32_t t[LIMBS + 2] = { };
+		for (uint16_t i = 0; i < LIMBS; i++)
+		{
+			uint64_t carry = 0;
+			for (uint16_t j = 0; j < LIMBS; j++)
+			{
+				carry += static_cast<uint64_t>(a[j]) * b[i] + t[j];
+				t[j] = static_cast<uint32_t>(carry);
+				carry >>= 32;
+			}
+			carry += t[LIMBS];
+			t[LIMBS] = static_cast<uint32_t>(carry);
+			t[LIMBS + 1] = static_cast<uint32_t>(carry >> 32);
+
+			const uint32_t u = t[0] * mInv;
+			carry = (static_cast<uint64_t>(u) * m[0] + t[0]) >> 32;
+			for (uint16_t j = 1; j < LIMBS; j++)
+			{
+				carry += static_cast<uint64_t>(u) * m[j] + t[j];
+				t[j - 1] = static_cast<uint32_t>(carry);
+				carry >>= 32;
+			}
+			carry += t[LIMBS];
+			t[LIMBS - 1] = static_cast<uint32_t>(carry);
+			t[LIMBS] = t[LIMBS + 1] + static_cast<uint32_t>(carry >> 32);
+		}
+
+		if (t[LIMBS] != 0 || compare(t, m) >= 0)
+			subtract(t, m);
+
+		memcpy(out, t, sizeof(uint32_t) * LIMBS);
+	}
+
+	// x = 2x mod m, x must already be reduced
+	void modularDouble(uint32_t* x, const uint32_t* m)
+	{
+		uint32_t carry = 0;
+		for (uint16_t i = 0; i < LIMBS; i++)
+		{
+			const uint32_t next = x[i] >> 31;
+			x[i] = (x[i] << 1) | carry;
+			carry = next;
+		}
+
+		if (carry != 0 || compare(x, m) >= 0)
+			subtract(x, m);
+	}
+
+	void mgf1Mask(uint8_t* dest, uint16_t size, const uint8_t* seed)
+	{
+		uint8_t block[PS4Signer::HASH_SIZE + 4];
+		uint8_t mask[PS4Signer::HASH_SIZE];
+		memcpy(block, seed, PS4Signer::HASH_SIZE);
+
+		for (uint32_t counter = 0, offset = 0; offset < size; counter++)
+		{
+			block[PS4Signer::HASH_SIZE + 0] = counter >> 24;
+			block[PS4Signer::HASH_SIZE + 1] = counter >> 16;
+			block[PS4Signer::HASH_SIZE + 2] = counter >> 8;
+			block[PS4Signer::HASH_SIZE + 3] = counter;
+			mbedtls_sha256_ret(block, sizeof(block), mask, 0);
+
+			for (uint16_t i = 0; i < PS4Signer::HASH_SIZE && offset < size; i++, offset++)
+				dest[offset] ^= mask[i];
+		}
+	}
+}
+
+void PS4Signer::setup(const PS4Options& options)
+{
+	const auto setupModulus = [](Modulus& modulus, const mbedtls_mpi_uint* value)
+	{
+		memcpy(modulus.m, value, sizeof(modulus.m));
+
+		// Newton iteration for m^-1 mod 2^32, every round doubles the number of correct bits
+		uint32_t inverse = modulus.m[0];
+		for (uint8_t i = 0; i < 4; i++)
+			inverse *= 2 - modulus.m[0] * inverse;
+		modulus.mInv = -inverse;
+
+		// R^2 mod m by doubling 1 up 2 * 32 * LIMBS times
+		memcpy(modulus.rr, ONE, sizeof(modulus.rr));
+		for (uint16_t i = 0; i < 2 * 32 * LIMBS; i++)
+			modularDouble(modulus.rr, modulus.m);
+	};
+
+	setupModulus(p, options.rsa_p);
+	setupModulus(q, options.rsa_q);
+	memcpy(dp, options.rsa_dp, sizeof(dp));
+	memcpy(dq, options.rsa_dq, sizeof(dq));
+
+	uint32_t qInv[LIMBS];
+	memcpy(qInv, options.rsa_qp, sizeof(qInv));
+	montgomeryMultiply(qInvMont, qInv, p.rr, p.m, p.mInv);
+
+	state = State::IDLE;
+}
+
+void PS4Signer::start(const uint8_t* nonce, uint16_t nonceSize, const uint8_t* nonceSalt)
+{
+	mbedtls_sha256_ret(nonce, nonceSize, hash, 0);
+	memcpy(salt, nonceSalt, SALT_SIZE);
+	state = State::ENCODE;
+}
+
+bool PS4Signer::step()
+{
+	switch (state)
+	{
+		case State::ENCODE:
+			{
+				// EMSA-PSS: EM = maskedDB || H || 0xBC with H = SHA-256(0x00 * 8 || mHash || salt)
+				uint8_t prefix[8 + HASH_SIZE + SALT_SIZE] = { };
+				memcpy(&prefix[8], hash, HASH_SIZE);
+				memcpy(&prefix[8 + HASH_SIZE], salt, SALT_SIZE);
+
+				uint8_t* h = &signature[DB_SIZE];
+				mbedtls_sha256_ret(prefix, sizeof(prefix), h, 0);
+
+				// DB = PS || 0x01 || salt
+				memset(signature, 0, DB_SIZE);
+				signature[DB_SIZE - SALT_SIZE - 1] = 0x01;
+				memcpy(&signature[DB_SIZE - SALT_SIZE], salt, SALT_SIZE);
+				mgf1Mask(signature, DB_SIZE, h);
+
+				// emBits is 2047 for a 2048 bit modulus, so the top bit has to be cleared
+				signature[0] &= 0x7F;
+				signature[SIGNATURE_SIZE - 1] = 0xBC;
+				state = State::REDUCE;
+			}
+			break;
+
+		case State::REDUCE:
+			{
+				// Big endian encoded message to little endian limbs
+				uint32_t message[2 * LIMBS];
+				for (uint16_t i = 0; i < 2 * LIMBS; i++)
+				{
+					const uint8_t* bytes = &signature[SIGNATURE_SIZE - (i + 1) * 4];
+					message[i] = (bytes[0] << 24) | (bytes[1] << 16) | (bytes[2] << 8) | bytes[3];
+				}
+
+				// message mod m = (high * R + low) mod m, with high * R mod m being a single Montgomery product
+				const auto reduce = [&message](uint32_t* dest, const Modulus& modulus)
+				{
+					uint32_t low[LIMBS];
+					memcpy(low, message, sizeof(low));
+					while (compare(low, modulus.m) >= 0)
+						subtract(low, modulus.m);
+
+					montgomeryMultiply(dest, &message[LIMBS], modulus.rr, modulus.m, modulus.mInv);
+					if (add(dest, low) != 0 || compare(dest, modulus.m) >= 0)
+						subtract(dest, modulus.m);
+				};
+
+				reduce(mp, p);
+				reduce(mq, q);
+				beginExponentiation(p, dp, mp);
+				state = State::TABLE_P;
+			}
+			break;
+
+		case State::TABLE_P:
+			if (buildTable())
+				state = State::EXP_P;
+			break;
+
+		case State::EXP_P:
+			if (exponentiate())
+			{
+				beginExponentiation(q, dq, mq);
+				state = State::TABLE_Q;
+			}
+			break;
+
+		case State::TABLE_Q:
+			if (buildTable())
+				state = State::EXP_Q;
+			break;
+
+		case State::EXP_Q:
+			if (exponentiate())
+				state = State::COMBINE;
+			break;
+
+		case State::COMBINE:
+			combine();
+			state = State::DONE;
+			break;
+
+		case State::IDLE:
+		case State::DONE:
+			break;
+	}
+
+	return state == State::DONE;
+}
+
+void PS4Signer::beginExponentiation(const Modulus& modulus, const uint32_t* exponent, uint32_t* value)
+{
+	exp.modulus = &modulus;
+	exp.exponent = exponent;
+	exp.value = value;
+	exp.window = LAST_WINDOW;
+	exp.operation = 0;
+	exp.tableIndex = 0;
+}
+
+// Fills table[i] = value^i in Montgomery form, one product per call
+bool PS4Signer::buildTable()
+{
+	const Modulus& modulus = *exp.modulus;
+	const uint8_t i = exp.tableIndex++;
+
+	if (i == 0)
+		montgomeryMultiply(table[0], modulus.rr, ONE, modulus.m, modulus.mInv);
+	else if (i == 1)
+		montgomeryMultiply(table[1], exp.value, modulus.rr, modulus.m, modulus.mInv);
+	else
+		montgomeryMultiply(table[i], table[i - 1], table[1], modulus.m, modulus.mInv);
+
+	if (exp.tableIndex < 16)
+		return false;
+
+	memcpy(accumulator, table[0], sizeof(accumulator));
+	return true;
+}
+
+// Fixed window exponentiation, one product per call so every step takes the same time
+bool PS4Signer::exponentiate()
+{
+	const Modulus& modulus = *exp.modulus;
+
+	if (exp.window < 0)
+	{
+		montgomeryMultiply(exp.value, accumulator, ONE, modulus.m, modulus.mInv);
+		return true;
+	}
+
+	if (exp.operation < WINDOW_BITS)
+	{
+		montgomeryMultiply(accumulator, accumulator, accumulator, modulus.m, modulus.mInv);
+		exp.operation++;
+	}
+	else
+	{
+		const uint8_t bits = (exp.exponent[exp.window / 8] >> ((exp.window % 8) * WINDOW_BITS)) & 0x0F;
+		montgomeryMultiply(accumulator, accumulator, table[bits], modulus.m, modulus.mInv);
+		exp.operation = 0;
+		exp.window--;
+	}
+
+	return false;
+}
+
+// Garner recombination: s = mq + q * ((mp - mq) * q^-1 mod p)
+void PS4Signer::combine()
+{
+	uint32_t h[LIMBS];
+	memcpy(h, mq, sizeof(h));
+	while (compare(h, p.m) >= 0)
+		subtract(h, p.m);
+
+	uint32_t difference[LIMBS];
+	memcpy(difference, mp, sizeof(difference));
+	if (subtract(difference, h) != 0)
+		add(difference, p.m);
+
+	montgomeryMultiply(h, difference, qInvMont, p.m, p.mInv);
+
+	uint32_t result[2 * LIMBS] = { };
+	for (uint16_t i = 0; i < LIMBS; i++)
+	{
+		uint64_t carry = 0;
+		for (uint16_t j = 0; j < LIMBS; j++)
+		{
+			carry += static_cast<uint64_t>(h[i]) * q.m[j] + result[i + j];
+			result[i + j] = static_cast<uint32_t>(carry);
+			carry >>= 32;
+		}
+		result[i + LIMBS] = static_cast<uint32_t>(carry);
+	}
+
+	uint64_t carry = 0;
+	for (uint16_t i = 0; i < 2 * LIMBS; i++)
+	{
+		carry += static_cast<uint64_t>(result[i]) + (i < LIMBS ? mq[i] : 0);
+		result[i] = static_cast<uint32_t>(carry);
+		carry >>= 32;
+	}
+
+	for (uint16_t i = 0; i < 2 * LIMBS; i++)
+	{
+		uint8_t* bytes = &signature[SIGNATURE_SIZE - (i + 1) * 4];
+		bytes[0] = result[i] >> 24;
+		bytes[1] = result[i] >> 16;
+		bytes[2] = result[i] >> 8;
+		bytes[3] = result[i];
+	}
+}
@@ -0,0 +1,249 @@
+#include "splashcodec.h"
+
+using namespace SplashCodec;
+
+namespace {
+	const uint8_t TOKEN_REPEAT = 0x80;
+	const uint16_t MAX_LITERAL = 128;
+	const uint16_t MAX_REPEAT = 129;
+	const uint16_t MIN_REPEAT = 3; // Shorter runs are cheaper to keep in a literal
+
+	struct FrameHeader {
+		uint8_t type;
+		uint16_t length;
+	};
+
+	bool readHeader(const uint8_t* data, uint16_t size, uint16_t offset, FrameHeader& header)
+	{
+		if (offset + FRAME_HEADER_SIZE > size)
+			return false;
+
+		header.type = data[offset];
+		header.length = data[offset + 1] | (data[offset + 2] << 8);
+
+		if (header.type == FRAME_RAW && header.length != FRAME_SIZE)
+			return false;
+
+		return (header.type == FRAME_KEY || header.type == FRAME_DELTA || header.type == FRAME_RAW) &&
+			(offset + FRAME_HEADER_SIZE + header.length) <= size;
+	}
+
+	// Copies a raw frame into dest, clipped to the destination size
+	void copyRawFrame(const uint8_t* src, uint8_t* dest, uint16_t pitch, uint8_t pages)
+	{
+		for (uint8_t page = 0; page < pages && page < FRAME_PAGES; page++)
+		{
+			for (uint16_t column = 0; column < pitch && column < FRAME_WIDTH; column++)
+				dest[page * pitch + column] = src[page * FRAME_WIDTH + column];
+		}
+	}
+
+	// Expands a single frame into dest, or only checks it when dest is null
+	bool decodeFrame(const uint8_t* src, uint16_t length, bool delta, uint8_t* dest, uint16_t pitch, uint8_t pages)
+	{
+		const uint8_t* end = src + length;
+		uint16_t pos = 0;
+
+		while (src < end)
+		{
+			const uint8_t token = *src++;
+			const bool repeat = token & TOKEN_REPEAT;
+			const uint16_t count = repeat ? (token & ~TOKEN_REPEAT) + 2 : token + 1;
+			const uint16_t consumed = repeat ? 1 : count;
+
+			if (pos + count > FRAME_SIZE || src + consumed > end)
+				return false;
+
+			// Zero runs are a no-op on delta frames, which is where most of the savings come from
+			if (dest != nullptr && !(delta && repeat && *src == 0))
+			{
+				for (uint16_t i = 0; i < count; i++)
+				{
+					const uint16_t page = (pos + i) / FRAME_WIDTH;
+					const uint16_t column = (pos + i) % FRAME_WIDTH;
+					if (page >= pages || column >= pitch)
+						continue;
+
+					const uint8_t value = repeat ? src[0] : src[i];
+					uint8_t& out = dest[page * pitch + column];
+					out = delta ? (out ^ value) : value;
+				}
+			}
+
+			src += consumed;
+			pos += count;
+		}
+
+		return pos == FRAME_SIZE;
+	}
+
+	// Returns the page ordered byte at pos from a row-major 128x64 bitmap
+	uint8_t pageByte(const uint8_t* bitmap, uint16_t pos)
+	{
+		const uint16_t page = pos / FRAME_WIDTH;
+		const uint16_t column = pos % FRAME_WIDTH;
+		const uint8_t mask = 0x80 >> (column & 7);
+
+		uint8_t value = 0;
+		for (uint8_t bit = 0; bit < 8; bit++)
+		{
+			const uint16_t row = page * 8 + bit;
+			if (bitmap[row * (FRAME_WIDTH / 8) + column / 8] & mask)
+				value |= (1 << bit);
+		}
+
+		return value;
+	}
+}
+
+bool SplashCodec::decode(const uint8_t* data, uint16_t size, uint8_t frameIndex, uint8_t* dest, uint16_t pitch, uint8_t pages)
+{
+	// Find the last key frame at or before frameIndex, everything before it does not need decoding
+	FrameHeader header;
+	uint16_t startOffset = 0;
+	uint8_t startFrame = 0;
+	uint16_t offset = 0;
+	for (uint16_t frame = 0; frame <= frameIndex; frame++)
+	{
+		if (!readHeader(data, size, offset, header))
+			return false;
+
+		if (header.type != FRAME_DELTA)
+		{
+			startOffset = offset;
+			startFrame = frame;
+		}
+
+		offset += FRAME_HEADER_SIZE + header.length;
+	}
+
+	offset = startOffset;
+	for (uint16_t frame = startFrame; frame <= frameIndex; frame++)
+	{
+		readHeader(data, size, offset, header);
+		if (header.type == FRAME_RAW)
+			copyRawFrame(&data[offset + FRAME_HEADER_SIZE], dest, pitch, pages);
+		else if (!decodeFrame(&data[offset + FRAME_HEADER_SIZE], header.length, header.type == FRAME_DELTA, dest, pitch, pages))
+			return false;
+
+		offset += FRAME_HEADER_SIZE + header.length;
+	}
+
+	return true;
+}
+
+bool SplashCodec::validate(const uint8_t* data, uint16_t size, uint8_t frameCount)
+{
+	FrameHeader header;
+	uint16_t offset = 0;
+	for (uint8_t frame = 0; frame < frameCount; frame++)
+	{
+		if (!readHeader(data, size, offset, header))
+			return false;
+
+		if (frame == 0 && header.type == FRAME_DELTA)
+			return false;
+
+		if (header.type != FRAME_RAW && !decodeFrame(&data[offset + FRAME_HEADER_SIZE], header.length, false, nullptr, 0, 0))
+			return false;
+
+		offset += FRAME_HEADER_SIZE + header.length;
+	}
+
+	return frameCount > 0 && offset == size;
+}
+
+namespace {
+	uint16_t encodeRawBitmap(const uint8_t* bitmap, uint8_t* out, uint16_t maxSize)
+	{
+		if (maxSize < MAX_FRAME_SIZE)
+			return 0;
+
+		out[0] = FRAME_RAW;
+		out[1] = FRAME_SIZE & 0xFF;
+		out[2] = FRAME_SIZE >> 8;
+		for (uint16_t pos = 0; pos < FRAME_SIZE; pos++)
+			out[FRAME_HEADER_SIZE + pos] = pageByte(bitmap, pos);
+
+		return MAX_FRAME_SIZE;
+	}
+
+	// Returns 0 if the compressed frame does not fit into maxSize
+	uint16_t encodeCompressedBitmap(const uint8_t* bitmap, uint8_t* out, uint16_t maxSize)
+	{
+		if (maxSize < FRAME_HEADER_SIZE)
+			return 0;
+
+		uint16_t outPos = FRAME_HEADER_SIZE;
+		uint16_t literalStart = 0;
+		uint16_t literalLength = 0;
+
+		const auto flushLiteral = [&]() -> bool
+		{
+			if (literalLength == 0)
+				return true;
+
+			if (outPos + 1 + literalLength > maxSize)
+				return false;
+
+			out[outPos++] = literalLength - 1;
+			for (uint16_t i = 0; i < literalLength; i++)
+				out[outPos++] = pageByte(bitmap, literalStart + i);
+
+			literalLength = 0;
+			return true;
+		};
+
+		uint16_t pos = 0;
+		while (pos < FRAME_SIZE)
+		{
+			const uint8_t value = pageByte(bitmap, pos);
+			uint16_t run = 1;
+			while (pos + run < FRAME_SIZE && run < MAX_REPEAT && pageByte(bitmap, pos + run) == value)
+				run++;
+
+			if (run >= MIN_REPEAT)
+			{
+				if (!flushLiteral() || outPos + 2 > maxSize)
+					return 0;
+
+				out[outPos++] = TOKEN_REPEAT | (run - 2);
+				out[outPos++] = value;
+				pos += run;
+			}
+			else
+			{
+				for (uint16_t i = 0; i < run; i++)
+				{
+					if (literalLength == 0)
+						literalStart = pos;
+
+					literalLength++;
+					pos++;
+					if (literalLength == MAX_LITERAL && !flushLiteral())
+						return 0;
+				}
+			}
+		}
+
+		if (!flushLiteral())
+			return 0;
+
+		const uint16_t length = outPos - FRAME_HEADER_SIZE;
+		out[0] = FRAME_KEY;
+		out[1] = length & 0xFF;
+		out[2] = length >> 8;
+
+		return outPos;
+	}
+}
+
+uint16_t SplashCodec::encodeBitmap(const uint8_t* bitmap, uint8_t* out, uint16_t maxSize)
+{
+	// Compression can only grow a frame past the raw size on noisy images, which then go out uncompressed
+	const uint16_t size = encodeCompressedBitmap(bitmap, out, maxSize < MAX_FRAME_SIZE ? maxSize : MAX_FRAME_SIZE);
+	if (size != 0)
+		return size;
+
+	return encodeRawBitmap(bitmap, out, maxSize);
+}
@@ -13,6 +13,7 @@
 #include "hardware/watchdog.h"
 #include "Animation.hpp"
 #include "CRC32.h"
+#include "inputrecorder.h"
 
 #include "addons/analog.h"
 #include "addons/board_led.h"
@@ -33,9 +34,12 @@
 #include "addons/wiiext.h"
 
 #include "bitmaps.h"
+#include "splashcodec.h"
 
 #include "helper.h"
 
+#include <cstddef>
+
 /* Board stuffs */
 void Storage::initBoardOptions() {
 	EEPROM.get(BOARD_STORAGE_INDEX, boardOptions);
@@ -51,17 +55,215 @@ void Storage::initAddonOptions() {
 	uint32_t lastCRC = addonOptions.checksum;
 	addonOptions.checksum = CHECKSUM_MAGIC;
 	if (lastCRC != CRC32::calculate(&addonOptions)) {
-		setDefaultAddonOptions();
+		if (!migrateLegacyAddonOptions()) {
+			setDefaultAddonOptions();
+		}
+	}
+}
+
+// Add-on options gained the ADS1219 DRDY pin and the analog stick conditioning, move the settings of the
+// previous layout over and default only the new fields
+bool Storage::migrateLegacyAddonOptions() {
+	struct LegacyAddonOptions {
+		uint8_t pinButtonTurbo;
+		uint8_t pinButtonReverse;
+		uint8_t pinSliderLS;
+		uint8_t pinSliderRS;
+		uint8_t pinSliderSOCDOne;
+		uint8_t pinSliderSOCDTwo;
+		uint8_t turboShotCount; // Turbo
+		uint8_t pinTurboLED;    // Turbo LED
+		uint8_t pinReverseLED;    // Reverse LED
+		uint8_t reverseActionUp;
+		uint8_t reverseActionDown;
+		uint8_t reverseActionLeft;
+		uint8_t reverseActionRight;
+		uint8_t i2cAnalog1219SDAPin;
+		uint8_t i2cAnalog1219SCLPin;
+		int i2cAnalog1219Block;
+		uint32_t i2cAnalog1219Speed;
+		uint8_t i2cAnalog1219Address;
+		uint8_t pinDualDirUp;    // Pins for Dual Directional Input
+		uint8_t pinDualDirDown;
+		uint8_t pinDualDirLeft;
+		uint8_t pinDualDirRight;
+		DpadMode dualDirDpadMode;    // LS/DP/RS
+		uint8_t dualDirCombineMode; // Mix/Gamepad/Dual/None
+		OnBoardLedMode onBoardLedMode;
+		uint8_t analogAdcPinX;
+		uint8_t analogAdcPinY;
+		uint16_t bootselButtonMap;
+		uint8_t extraButtonPin;
+		uint32_t extraButtonMap;
+		uint8_t buzzerPin;
+		uint8_t buzzerVolume;
+		uint8_t playerNumber;
+		uint8_t shmupMode; // Turbo SHMUP Mode
+		uint8_t shmupMixMode; // How we mix turbo and non-turbo buttons
+		uint16_t shmupAlwaysOn1;
+		uint16_t shmupAlwaysOn2;
+		uint16_t shmupAlwaysOn3;
+		uint16_t shmupAlwaysOn4;
+		uint8_t pinShmupBtn1;
+		uint8_t pinShmupBtn2;
+		uint8_t pinShmupBtn3;
+		uint8_t pinShmupBtn4;
+		uint16_t shmupBtnMask1;
+		uint16_t shmupBtnMask2;
+		uint16_t shmupBtnMask3;
+		uint16_t shmupBtnMask4;
+		uint8_t pinShmupDial;
+		SOCDMode sliderSOCDModeOne;
+		SOCDMode sliderSOCDModeTwo;
+		SOCDMode sliderSOCDModeDefault;
+		uint8_t wiiExtensionSDAPin;
+		uint8_t wiiExtensionSCLPin;
+		int wiiExtensionBlock;
+		uint32_t wiiExtensionSpeed;
+		uint8_t AnalogInputEnabled;
+		uint8_t BoardLedAddonEnabled;
+		uint8_t BootselButtonAddonEnabled;
+		uint8_t BuzzerSpeakerAddonEnabled;
+		uint8_t DualDirectionalInputEnabled;
+		uint8_t ExtraButtonAddonEnabled;
+		uint8_t I2CAnalog1219InputEnabled;
+		//bool I2CDisplayAddonEnabled; // I2C is special case
+		uint8_t JSliderInputEnabled;
+		//bool NeoPicoLEDAddonEnabled; // NeoPico is special case
+		//bool PlayerLEDAddonEnabled; // PlayerLED is special case
+		uint8_t PlayerNumAddonEnabled;
+		uint8_t PS4ModeAddonEnabled;
+		uint8_t ReverseInputEnabled;
+		uint8_t TurboInputEnabled;
+		uint8_t SliderSOCDInputEnabled;
+		uint8_t WiiExtensionAddonEnabled;
+		uint32_t checksum;
+	} legacyOptions;
+
+	EEPROM.get(ADDON_STORAGE_INDEX, legacyOptions);
+	uint32_t lastCRC = legacyOptions.checksum;
+	legacyOptions.checksum = CHECKSUM_MAGIC;
+	if (lastCRC != CRC32::calculate(&legacyOptions)) {
+		return false;
 	}
+
+	AddonOptions options = { };
+#define MIGRATE_ADDON_OPTION(field) options.field = legacyOptions.field
+	MIGRATE_ADDON_OPTION(pinButtonTurbo);
+	MIGRATE_ADDON_OPTION(pinButtonReverse);
+	MIGRATE_ADDON_OPTION(pinSliderLS);
+	MIGRATE_ADDON_OPTION(pinSliderRS);
+	MIGRATE_ADDON_OPTION(pinSliderSOCDOne);
+	MIGRATE_ADDON_OPTION(pinSliderSOCDTwo);
+	MIGRATE_ADDON_OPTION(turboShotCount);
+	MIGRATE_ADDON_OPTION(pinTurboLED);
+	MIGRATE_ADDON_OPTION(pinReverseLED);
+	MIGRATE_ADDON_OPTION(reverseActionUp);
+	MIGRATE_ADDON_OPTION(reverseActionDown);
+	MIGRATE_ADDON_OPTION(reverseActionLeft);
+	MIGRATE_ADDON_OPTION(reverseActionRight);
+	MIGRATE_ADDON_OPTION(i2cAnalog1219SDAPin);
+	MIGRATE_ADDON_OPTION(i2cAnalog1219SCLPin);
+	MIGRATE_ADDON_OPTION(i2cAnalog1219Block);
+	MIGRATE_ADDON_OPTION(i2cAnalog1219Speed);
+	MIGRATE_ADDON_OPTION(i2cAnalog1219Address);
+	MIGRATE_ADDON_OPTION(pinDualDirUp);
+	MIGRATE_ADDON_OPTION(pinDualDirDown);
+	MIGRATE_ADDON_OPTION(pinDualDirLeft);
+	MIGRATE_ADDON_OPTION(pinDualDirRight);
+	MIGRATE_ADDON_OPTION(dualDirDpadMode);
+	MIGRATE_ADDON_OPTION(dualDirCombineMode);
+	MIGRATE_ADDON_OPTION(onBoardLedMode);
+	MIGRATE_ADDON_OPTION(analogAdcPinX);
+	MIGRATE_ADDON_OPTION(analogAdcPinY);
+	MIGRATE_ADDON_OPTION(bootselButtonMap);
+	MIGRATE_ADDON_OPTION(extraButtonPin);
+	MIGRATE_ADDON_OPTION(extraButtonMap);
+	MIGRATE_ADDON_OPTION(buzzerPin);
+	MIGRATE_ADDON_OPTION(buzzerVolume);
+	MIGRATE_ADDON_OPTION(playerNumber);
+	MIGRATE_ADDON_OPTION(shmupMode);
+	MIGRATE_ADDON_OPTION(shmupMixMode);
+	MIGRATE_ADDON_OPTION(shmupAlwaysOn1);
+	MIGRATE_ADDON_OPTION(shmupAlwaysOn2);
+	MIGRATE_ADDON_OPTION(shmupAlwaysOn3);
+	MIGRATE_ADDON_OPTION(shmupAlwaysOn4);
+	MIGRATE_ADDON_OPTION(pinShmupBtn1);
+	MIGRATE_ADDON_OPTION(pinShmupBtn2);
+	MIGRATE_ADDON_OPTION(pinShmupBtn3);
+	MIGRATE_ADDON_OPTION(pinShmupBtn4);
+	MIGRATE_ADDON_OPTION(shmupBtnMask1);
+	MIGRATE_ADDON_OPTION(shmupBtnMask2);
+	MIGRATE_ADDON_OPTION(shmupBtnMask3);
+	MIGRATE_ADDON_OPTION(shmupBtnMask4);
+	MIGRATE_ADDON_OPTION(pinShmupDial);
+	MIGRATE_ADDON_OPTION(sliderSOCDModeOne);
+	MIGRATE_ADDON_OPTION(sliderSOCDModeTwo);
+	MIGRATE_ADDON_OPTION(sliderSOCDModeDefault);
+	MIGRATE_ADDON_OPTION(wiiExtensionSDAPin);
+	MIGRATE_ADDON_OPTION(wiiExtensionSCLPin);
+	MIGRATE_ADDON_OPTION(wiiExtensionBlock);
+	MIGRATE_ADDON_OPTION(wiiExtensionSpeed);
+	MIGRATE_ADDON_OPTION(AnalogInputEnabled);
+	MIGRATE_ADDON_OPTION(BoardLedAddonEnabled);
+	MIGRATE_ADDON_OPTION(BootselButtonAddonEnabled);
+	MIGRATE_ADDON_OPTION(BuzzerSpeakerAddonEnabled);
+	MIGRATE_ADDON_OPTION(DualDirectionalInputEnabled);
+	MIGRATE_ADDON_OPTION(ExtraButtonAddonEnabled);
+	MIGRATE_ADDON_OPTION(I2CAnalog1219InputEnabled);
+	MIGRATE_ADDON_OPTION(JSliderInputEnabled);
+	MIGRATE_ADDON_OPTION(PlayerNumAddonEnabled);
+	MIGRATE_ADDON_OPTION(PS4ModeAddonEnabled);
+	MIGRATE_ADDON_OPTION(ReverseInputEnabled);
+	MIGRATE_ADDON_OPTION(TurboInputEnabled);
+	MIGRATE_ADDON_OPTION(SliderSOCDInputEnabled);
+	MIGRATE_ADDON_OPTION(WiiExtensionAddonEnabled);
+#undef MIGRATE_ADDON_OPTION
+	options.i2cAnalog1219DRDYPin = I2C_ANALOG1219_DRDY_PIN;
+	options.analogDeadzoneMode   = ANALOG_DEADZONE_MODE;
+	options.analogDeadzone       = ANALOG_DEADZONE_SIZE;
+	options.analogCurve          = ANALOG_CURVE;
+	options.analogCalibration    = AnalogConditioner::defaultCalibration;
+	setAddonOptions(options);
+	return true;
 }
 
 void Storage::initSplashImage() {
 	EEPROM.get(SPLASH_IMAGE_STORAGE_INDEX, splashImage);
 	uint32_t lastCRC = splashImage.checksum;
 	splashImage.checksum = CHECKSUM_MAGIC;
-	if (lastCRC != CRC32::calculate(&splashImage)) {
-		setDefaultSplashImage();
+	if (lastCRC != CRC32::calculate(&splashImage) ||
+		!SplashCodec::validate(splashImage.data, splashImage.size, splashImage.frameCount)) {
+		if (!migrateLegacySplashImage()) {
+			setDefaultSplashImage();
+		}
+	}
+}
+
+static_assert(SPLASH_IMAGE_DATA_SIZE >= SplashCodec::MAX_FRAME_SIZE, "Every legacy splash image must fit, if only as a raw frame");
+
+// Splash images used to be stored as a raw 128x64 bitmap, re-encode them so custom images survive the upgrade
+bool Storage::migrateLegacySplashImage() {
+	struct LegacySplashImage {
+		uint8_t data[16*64];
+		uint32_t checksum;
+	} legacyImage;
+
+	EEPROM.get(SPLASH_IMAGE_STORAGE_INDEX, legacyImage);
+	uint32_t lastCRC = legacyImage.checksum;
+	legacyImage.checksum = CHECKSUM_MAGIC;
+	if (lastCRC != CRC32::calculate(&legacyImage)) {
+		return false;
+	}
+
+	SplashImage image = { };
+	image.size = SplashCodec::encodeBitmap(legacyImage.data, image.data, sizeof(image.data));
+	if (image.size == 0) {
+		return false;
 	}
+	image.frameCount = 1;
+	setSplashImage(image);
+	return true;
 }
 
 void Storage::initPS4Options() {
@@ -167,11 +369,16 @@ void Storage::setDefaultAddonOptions()
 	addonOptions.i2cAnalog1219Block     = (I2C_ANALOG1219_BLOCK == i2c0) ? 0 : 1;
 	addonOptions.i2cAnalog1219Speed     = I2C_ANALOG1219_SPEED;
 	addonOptions.i2cAnalog1219Address   = I2C_ANALOG1219_ADDRESS;
+	addonOptions.i2cAnalog1219DRDYPin   = I2C_ANALOG1219_DRDY_PIN;
 	addonOptions.onBoardLedMode			= BOARD_LED_TYPE;
 	addonOptions.dualDirDpadMode        = DUAL_DIRECTIONAL_STICK_MODE;
 	addonOptions.dualDirCombineMode     = DUAL_DIRECTIONAL_COMBINE_MODE;
 	addonOptions.analogAdcPinX      	= ANALOG_ADC_VRX;
 	addonOptions.analogAdcPinY      	= ANALOG_ADC_VRY;
+	addonOptions.analogDeadzoneMode     = ANALOG_DEADZONE_MODE;
+	addonOptions.analogDeadzone         = ANALOG_DEADZONE_SIZE;
+	addonOptions.analogCurve            = ANALOG_CURVE;
+	addonOptions.analogCalibration      = AnalogConditioner::defaultCalibration;
 	addonOptions.bootselButtonMap		= BOOTSEL_BUTTON_MASK;
 	addonOptions.buzzerPin              = BUZZER_PIN;
 	addonOptions.buzzerVolume           = BUZZER_VOLUME;
@@ -231,8 +438,10 @@ void Storage::setAddonOptions(AddonOptions options)
 
 void Storage::setDefaultSplashImage()
 {
-	memcpy(&splashImage.data, &splashImageMain, sizeof(splashImageMain));
-	setSplashImage(splashImage);
+	SplashImage image = { };
+	image.size = SplashCodec::encodeBitmap(splashImageMain, image.data, sizeof(image.data));
+	image.frameCount = 1;
+	setSplashImage(image);
 }
 
 void Storage::setSplashImage(const SplashImage& image)
@@ -335,6 +544,155 @@ void Storage::ResetSettings()
 	watchdog_reboot(0, SRAM_END, 2000);
 }
 
+/* Settings snapshot
+ *
+ * Layout, all little endian:
+ *   SnapshotHeader
+ *   sectionCount x (SnapshotSectionHeader, raw section bytes as stored in EEPROM)
+ *   uint32_t CRC32 of everything before it
+ *
+ * Sections keep their own checksum, and their size has to match this firmware's struct exactly,
+ * so a snapshot from a firmware with a different layout is rejected instead of misread.
+ */
+namespace {
+	enum class SnapshotSectionId : uint16_t {
+		GAMEPAD = 1,
+		BOARD,
+		LED,
+		ANIMATION,
+		ADDON,
+		SPLASH,
+		PS4,
+	};
+
+	struct __attribute__((packed)) SnapshotHeader {
+		uint32_t magic;
+		uint16_t version;
+		uint16_t sectionCount;
+	};
+
+	struct __attribute__((packed)) SnapshotSectionHeader {
+		uint16_t id;
+		uint16_t size;
+	};
+
+	struct SnapshotSection {
+		SnapshotSectionId id;
+		uint16_t index;
+		uint16_t size;
+		uint16_t checksumOffset;
+		bool hasCRC; // PS4 options are only marked with NOCHECKSUM_MAGIC
+	};
+
+	const SnapshotSection snapshotSections[] = {
+		{ SnapshotSectionId::GAMEPAD,   GAMEPAD_STORAGE_INDEX,      sizeof(GamepadOptions),   offsetof(GamepadOptions, checksum),   true },
+		{ SnapshotSectionId::BOARD,     BOARD_STORAGE_INDEX,        sizeof(BoardOptions),     offsetof(BoardOptions, checksum),     true },
+		{ SnapshotSectionId::LED,       LED_STORAGE_INDEX,          sizeof(LEDOptions),       offsetof(LEDOptions, checksum),       true },
+		{ SnapshotSectionId::ANIMATION, ANIMATION_STORAGE_INDEX,    sizeof(AnimationOptions), offsetof(AnimationOptions, checksum), true },
+		{ SnapshotSectionId::ADDON,     ADDON_STORAGE_INDEX,        sizeof(AddonOptions),     offsetof(AddonOptions, checksum),     true },
+		{ SnapshotSectionId::SPLASH,    SPLASH_IMAGE_STORAGE_INDEX, sizeof(SplashImage),      offsetof(SplashImage, checksum),      true },
+		{ SnapshotSectionId::PS4,       PS4_STORAGE_INDEX,          sizeof(PS4Options),       offsetof(PS4Options, checksum),       false },
+	};
+
+	const SnapshotSection* findSnapshotSection(uint16_t id) {
+		for (const SnapshotSection& section : snapshotSections) {
+			if (static_cast<uint16_t>(section.id) == id)
+				return &section;
+		}
+		return nullptr;
+	}
+
+	// Same check the init functions do, with the checksum field counted as CHECKSUM_MAGIC
+	bool isSnapshotSectionValid(const SnapshotSection& section, const uint8_t* data) {
+		uint32_t checksum;
+		memcpy(&checksum, data + section.checksumOffset, sizeof(checksum));
+		if (!section.hasCRC)
+			return checksum == NOCHECKSUM_MAGIC;
+
+		const uint32_t magic = CHECKSUM_MAGIC;
+		CRC32 crc;
+		crc.update(data, section.checksumOffset);
+		crc.update(&magic, 1);
+		crc.update(data + section.checksumOffset + sizeof(checksum), section.size - section.checksumOffset - sizeof(checksum));
+		return crc.finalize() == checksum;
+	}
+
+	// Walks the sections of a snapshot whose framing CRC has been checked, writing them to EEPROM if apply is set
+	bool applySnapshotSections(const uint8_t* data, size_t length, uint16_t sectionCount, bool apply) {
+		size_t offset = sizeof(SnapshotHeader);
+		for (uint16_t i = 0; i < sectionCount; i++) {
+			SnapshotSectionHeader sectionHeader;
+			if (offset + sizeof(sectionHeader) > length)
+				return false;
+			memcpy(&sectionHeader, data + offset, sizeof(sectionHeader));
+			offset += sizeof(sectionHeader);
+
+			const SnapshotSection* section = findSnapshotSection(sectionHeader.id);
+			if (section == nullptr || sectionHeader.size != section->size || offset + section->size > length)
+				return false;
+			if (!isSnapshotSectionValid(*section, data + offset))
+				return false;
+
+			if (apply)
+				EEPROM.setBytes(section->index, data + offset, section->size);
+			offset += section->size;
+		}
+
+		return offset == length;
+	}
+}
+
+size_t Storage::exportSnapshot(uint8_t* buffer, size_t size, bool includePS4)
+{
+	SnapshotHeader header = { SETTINGS_SNAPSHOT_MAGIC, SETTINGS_SNAPSHOT_VERSION, 0 };
+	size_t length = sizeof(header);
+
+	for (const SnapshotSection& section : snapshotSections) {
+		if (section.id == SnapshotSectionId::PS4 && !includePS4)
+			continue;
+
+		const SnapshotSectionHeader sectionHeader = { static_cast<uint16_t>(section.id), section.size };
+		if (length + sizeof(sectionHeader) + section.size + sizeof(uint32_t) > size)
+			return 0;
+
+		// Sections that never got saved fall back to defaults on boot, there is nothing to export for them
+		EEPROM.getBytes(section.index, buffer + length + sizeof(sectionHeader), section.size);
+		if (!isSnapshotSectionValid(section, buffer + length + sizeof(sectionHeader)))
+			continue;
+
+		memcpy(buffer + length, &sectionHeader, sizeof(sectionHeader));
+		length += sizeof(sectionHeader) + section.size;
+		header.sectionCount++;
+	}
+
+	memcpy(buffer, &header, sizeof(header));
+	const uint32_t crc = CRC32::calculate(buffer, length);
+	memcpy(buffer + length, &crc, sizeof(crc));
+	return length + sizeof(crc);
+}
+
+bool Storage::importSnapshot(const uint8_t* data, size_t length)
+{
+	SnapshotHeader header;
+	uint32_t crc;
+	if (length < sizeof(header) + sizeof(crc) || length > SETTINGS_SNAPSHOT_MAX_SIZE)
+		return false;
+
+	length -= sizeof(crc);
+	memcpy(&header, data, sizeof(header));
+	memcpy(&crc, data + length, sizeof(crc));
+	if (header.magic != SETTINGS_SNAPSHOT_MAGIC || header.version != SETTINGS_SNAPSHOT_VERSION || crc != CRC32::calculate(data, length))
+		return false;
+
+	// Everything is validated before the first write so a bad image never leaves the settings half restored
+	if (!applySnapshotSections(data, length, header.sectionCount, false))
+		return false;
+
+	applySnapshotSections(data, length, header.sectionCount, true);
+	EEPROM.commit();
+	return true;
+}
+
 void Storage::initPreviewBoardOptions()
 {
 	memcpy(&previewBoardOptions, &boardOptions, sizeof(BoardOptions));
@@ -460,6 +818,10 @@ void AnimationStorage::setAnimationOptions(AnimationOptions options)
 
 void AnimationStorage::save()
 {
+	// LED hotkeys pressed during a replay only change the running animation
+	if (InputRecorder::getInstance().isReplaying())
+		return;
+
 	bool dirty = false;
 	AnimationOptions savedOptions = getAnimationOptions();
 
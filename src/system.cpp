@@ -6,12 +6,23 @@
 #include <pico/multicore.h>
 
 #include <malloc.h>
+#include <reent.h>
+
+#include <algorithm>
 
 extern char __flash_binary_start;
 extern char __flash_binary_end;
 extern char __bss_end__;
 extern char __StackLimit;
 extern char __StackTop;
+extern uint32_t __StackBottom;
+extern uint32_t __StackOneBottom;
+extern uint32_t __StackOneTop;
+
+static const uint32_t STACK_PAINT = 0xa5a5a5a5;
+
+static System::BootMemory bootMemory[NUM_CORES] = { };
+static System::MemoryCounter memoryCounters[static_cast<size_t>(System::MemoryCategory::COUNT)] = { };
 
 uint32_t System::getTotalFlash() {
 #if defined(PICO_FLASH_SIZE_BYTES)
@@ -40,6 +51,169 @@ uint32_t System::getUsedHeap() {
     return mallinfo().uordblks;
 }
 
+// newlib does not hand memory back once the heap has grown, so the arena size is its high-water mark
+uint32_t System::getPeakHeap() {
+    return mallinfo().arena;
+}
+
+uint32_t System::getFreeHeap() {
+    return getTotalHeap() - getUsedHeap();
+}
+
+// The memory above the arena plus the free chunk at its top can always be handed out as one block.
+// Free holes further down are not included, so this is a lower bound of the largest possible allocation.
+uint32_t System::getLargestFreeHeap() {
+    const struct mallinfo info = mallinfo();
+    return getTotalHeap() - info.arena + info.keepcost;
+}
+
+// Heap in use as the allocator hands it out, kept by the wrappers below so that a peak between two
+// mallinfo() readings is not missed. Like the category counters these are not locked, core1 rarely
+// allocates once it is set up.
+static uint32_t heapInUse = 0;
+static uint32_t heapHighWater = 0;
+static uint32_t heapCallDepth = 0; // newlib's realloc, calloc and memalign call malloc and free themselves
+
+static void addHeap(void* ptr) {
+    if (ptr) {
+        heapInUse += malloc_usable_size(ptr);
+        heapHighWater = std::max(heapHighWater, heapInUse);
+    }
+}
+
+static void removeHeap(void* ptr) {
+    if (ptr) {
+        heapInUse -= std::min<uint32_t>(heapInUse, malloc_usable_size(ptr));
+    }
+}
+
+// The newlib entry points are wrapped at link time, see the --wrap options in CMakeLists.txt
+extern "C" {
+void* __real__malloc_r(struct _reent* r, size_t size);
+void* __real__calloc_r(struct _reent* r, size_t count, size_t size);
+void* __real__realloc_r(struct _reent* r, void* ptr, size_t size);
+void* __real__memalign_r(struct _reent* r, size_t alignment, size_t size);
+void __real__free_r(struct _reent* r, void* ptr);
+
+void* __wrap__malloc_r(struct _reent* r, size_t size) {
+    heapCallDepth++;
+    void* ptr = __real__malloc_r(r, size);
+    if (--heapCallDepth == 0) {
+        addHeap(ptr);
+    }
+    return ptr;
+}
+
+void* __wrap__calloc_r(struct _reent* r, size_t count, size_t size) {
+    heapCallDepth++;
+    void* ptr = __real__calloc_r(r, count, size);
+    if (--heapCallDepth == 0) {
+        addHeap(ptr);
+    }
+    return ptr;
+}
+
+void* __wrap__realloc_r(struct _reent* r, void* ptr, size_t size) {
+    if (heapCallDepth++ == 0) {
+        removeHeap(ptr);
+    }
+    void* resized = __real__realloc_r(r, ptr, size);
+    if (--heapCallDepth == 0) {
+        // A failed realloc leaves the old block allocated
+        addHeap(resized ? resized : (size ? ptr : nullptr));
+    }
+    return resized;
+}
+
+void* __wrap__memalign_r(struct _reent* r, size_t alignment, size_t size) {
+    heapCallDepth++;
+    void* ptr = __real__memalign_r(r, alignment, size);
+    if (--heapCallDepth == 0) {
+        addHeap(ptr);
+    }
+    return ptr;
+}
+
+void __wrap__free_r(struct _reent* r, void* ptr) {
+    if (heapCallDepth == 0) {
+        removeHeap(ptr);
+    }
+    heapCallDepth++;
+    __real__free_r(r, ptr);
+    heapCallDepth--;
+}
+}
+
+void System::resetHeapHighWater() {
+    heapHighWater = heapInUse;
+}
+
+uint32_t System::getHeapHighWater() {
+    return heapHighWater;
+}
+
+static uint32_t* getStackBottom(uint32_t core) {
+    return core == 0 ? &__StackBottom : &__StackOneBottom;
+}
+
+static uint32_t* getStackTop(uint32_t core) {
+    return core == 0 ? reinterpret_cast<uint32_t*>(&__StackTop) : &__StackOneTop;
+}
+
+void System::paintStack(uint32_t core) {
+    volatile uint32_t* top = getStackTop(core);
+
+    // Leave the frames of the running core alone, with some room for this function itself
+    if (core == get_core_num()) {
+        volatile uint32_t marker = 0;
+        top = std::min(top, &marker - 16);
+    }
+
+    for (volatile uint32_t* p = getStackBottom(core); p < top; p++) {
+        *p = STACK_PAINT;
+    }
+}
+
+uint32_t System::getStackSize(uint32_t core) {
+    return (getStackTop(core) - getStackBottom(core)) * sizeof(uint32_t);
+}
+
+// The stack grows down, the first word from the bottom that is not painted anymore marks the deepest use
+uint32_t System::getStackHighWater(uint32_t core) {
+    const uint32_t* top = getStackTop(core);
+    const uint32_t* p = getStackBottom(core);
+    while (p < top && *p == STACK_PAINT) {
+        p++;
+    }
+    return (top - p) * sizeof(uint32_t);
+}
+
+void System::recordBootMemory(uint32_t core) {
+    bootMemory[core].stackHighWater = getStackHighWater(core);
+    bootMemory[core].usedHeap = getUsedHeap();
+}
+
+const System::BootMemory& System::getBootMemory(uint32_t core) {
+    return bootMemory[core];
+}
+
+// The counters are not locked, each category is only updated from one core at a time
+void System::trackAllocation(MemoryCategory category, uint32_t bytes) {
+    MemoryCounter& counter = memoryCounters[static_cast<size_t>(category)];
+    counter.allocations++;
+    counter.current += bytes;
+    counter.peak = std::max(counter.peak, counter.current);
+}
+
+void System::trackFree(MemoryCategory category, uint32_t bytes) {
+    MemoryCounter& counter = memoryCounters[static_cast<size_t>(category)];
+    counter.current -= std::min(counter.current, bytes);
+}
+
+const System::MemoryCounter& System::getMemoryCounter(MemoryCategory category) {
+    return memoryCounters[static_cast<size_t>(category)];
+}
+
 void System::reboot(BootMode bootMode) {
     // Make sure that the other core is halted
     // We do not want it to be talking to devices (e.g. OLED display) while we reboot
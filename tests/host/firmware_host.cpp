@@ -0,0 +1,247 @@
+#include "firmware_host.h"
+
+#include <algorithm>
+#include <chrono>
+#include <malloc.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "AnimationStation.hpp"
+#include "FlashPROM.h"
+#include "adcsampler.h"
+#include "addons/wiiext.h"
+#include "hardware/timer.h"
+#include "hardware/watchdog.h"
+#include "inputscanner.h"
+#include "pico/time.h"
+#include "usb_driver.h"
+
+// Heap
+
+// Every allocation goes through these, so the high-water mark catches peaks between two readings like the
+// newlib wrappers in system.cpp do on the device
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void __libc_free(void* ptr);
+}
+
+static uint32_t heapInUse = 0;
+static uint32_t heapHighWater = 0;
+static uint32_t heapPeak = 0;
+
+static void addHeap(void* ptr)
+{
+	if (ptr)
+	{
+		heapInUse += malloc_usable_size(ptr);
+		heapHighWater = std::max(heapHighWater, heapInUse);
+		heapPeak = std::max(heapPeak, heapInUse);
+	}
+}
+
+static void removeHeap(void* ptr)
+{
+	if (ptr)
+		heapInUse -= std::min<uint32_t>(heapInUse, malloc_usable_size(ptr));
+}
+
+extern "C" void* malloc(size_t size)
+{
+	void* ptr = __libc_malloc(size);
+	addHeap(ptr);
+	return ptr;
+}
+
+extern "C" void* calloc(size_t count, size_t size)
+{
+	void* ptr = __libc_calloc(count, size);
+	addHeap(ptr);
+	return ptr;
+}
+
+extern "C" void* realloc(void* ptr, size_t size)
+{
+	removeHeap(ptr);
+	void* resized = __libc_realloc(ptr, size);
+	addHeap(resized ? resized : (size ? ptr : nullptr));
+	return resized;
+}
+
+extern "C" void free(void* ptr)
+{
+	removeHeap(ptr);
+	__libc_free(ptr);
+}
+
+// System
+
+static const uint32_t HOST_TOTAL_HEAP = 256 * 1024; // About what the RP2040 has left, so the free figures stay in range
+
+static System::BootMemory bootMemory[NUM_CORES] = { };
+static System::MemoryCounter memoryCounters[static_cast<size_t>(System::MemoryCategory::COUNT)] = { };
+static System::BootMode rebootMode = System::BootMode::DEFAULT;
+
+uint32_t System::getTotalFlash() { return 2 * 1024 * 1024; }
+uint32_t System::getUsedFlash() { return 0; }
+uint32_t System::getStaticAllocs() { return 0; }
+uint32_t System::getTotalHeap() { return HOST_TOTAL_HEAP; }
+uint32_t System::getUsedHeap() { return heapInUse; }
+uint32_t System::getPeakHeap() { return heapPeak; }
+uint32_t System::getFreeHeap() { return HOST_TOTAL_HEAP - std::min(HOST_TOTAL_HEAP, heapInUse); }
+uint32_t System::getLargestFreeHeap() { return getFreeHeap(); }
+void System::resetHeapHighWater() { heapHighWater = heapInUse; }
+uint32_t System::getHeapHighWater() { return heapHighWater; }
+
+// The host stacks are not the device's, they are reported as unmeasured
+void System::paintStack(uint32_t core) {}
+uint32_t System::getStackSize(uint32_t core) { return 0; }
+uint32_t System::getStackHighWater(uint32_t core) { return 0; }
+void System::recordBootMemory(uint32_t core) {}
+const System::BootMemory& System::getBootMemory(uint32_t core) { return bootMemory[core]; }
+
+void System::trackAllocation(MemoryCategory category, uint32_t bytes)
+{
+	MemoryCounter& counter = memoryCounters[static_cast<size_t>(category)];
+	counter.allocations++;
+	counter.current += bytes;
+	counter.peak = std::max(counter.peak, counter.current);
+}
+
+void System::trackFree(MemoryCategory category, uint32_t bytes)
+{
+	MemoryCounter& counter = memoryCounters[static_cast<size_t>(category)];
+	counter.current -= std::min(counter.current, bytes);
+}
+
+const System::MemoryCounter& System::getMemoryCounter(MemoryCategory category)
+{
+	return memoryCounters[static_cast<size_t>(category)];
+}
+
+void System::reboot(BootMode bootMode)
+{
+	printf("reboot requested, mode %08x\n", static_cast<uint32_t>(bootMode));
+	rebootMode = bootMode;
+}
+
+System::BootMode System::takeBootMode() { return BootMode::DEFAULT; }
+
+System::BootMode host_reboot_mode()
+{
+	return rebootMode;
+}
+
+void watchdog_reboot(uint32_t pc, uint32_t sp, uint32_t delay_ms)
+{
+	System::reboot(System::BootMode::DEFAULT);
+}
+
+// Flash
+
+uint8_t FlashPROM::cache[EEPROM_SIZE_BYTES] = { };
+static const char * flashPath = nullptr;
+
+void host_flash_open(const char * path)
+{
+	flashPath = path;
+}
+
+// Erased flash reads as all ones, which the device turns into zeros like here
+void FlashPROM::start()
+{
+	memset(cache, 0xff, EEPROM_SIZE_BYTES);
+	FILE * file = flashPath ? fopen(flashPath, "rb") : nullptr;
+	if (file)
+	{
+		fread(cache, 1, EEPROM_SIZE_BYTES, file);
+		fclose(file);
+	}
+
+	if (std::all_of(cache, cache + EEPROM_SIZE_BYTES, [](uint8_t value) { return value == 0xff; }))
+		reset();
+}
+
+// Written straight away, the device waits EEPROM_WRITE_WAIT for more changes first
+void FlashPROM::commit()
+{
+	FILE * file = flashPath ? fopen(flashPath, "wb") : nullptr;
+	if (file)
+	{
+		fwrite(cache, 1, EEPROM_SIZE_BYTES, file);
+		fclose(file);
+	}
+}
+
+void FlashPROM::reset()
+{
+	memset(cache, 0, EEPROM_SIZE_BYTES);
+	commit();
+}
+
+// Clock
+
+static bool timeSet = false;
+static uint64_t setTime = 0;
+
+static uint64_t host_time_us()
+{
+	static const auto boot = std::chrono::steady_clock::now();
+	if (timeSet)
+		return setTime;
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - boot).count();
+}
+
+void host_set_time(uint64_t us)
+{
+	timeSet = true;
+	setTime = us;
+}
+
+uint32_t time_us_32(void) { return static_cast<uint32_t>(host_time_us()); }
+absolute_time_t get_absolute_time(void) { return host_time_us(); }
+absolute_time_t make_timeout_time_us(uint64_t us) { return host_time_us() + us; }
+absolute_time_t make_timeout_time_ms(uint32_t ms) { return host_time_us() + ms * 1000ull; }
+int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to) { return static_cast<int64_t>(to - from); }
+uint32_t to_ms_since_boot(absolute_time_t t) { return static_cast<uint32_t>(t / 1000); }
+
+// Inputs, the pins are pulled up so a pressed one reads low
+
+static uint32_t pressedPins = 0;
+
+void host_set_pressed(uint32_t pressed)
+{
+	pressedPins = pressed;
+}
+
+uint32_t gpio_get_all(void) { return ~pressedPins; }
+
+// Never started on the host
+uint32_t InputScanner::drain() { return gpio_get_all(); }
+
+uint16_t AdcSampler::getValue(uint8_t pin) const { return 0; }
+
+bool WiiExtensionPoller::readSnapshot(WiiExtensionSnapshot& copy) { return false; }
+
+const UsbReportStats *get_saved_report_stats(void) { return NULL; }
+
+// Cores
+
+static uint currentCore = 0;
+
+void host_set_core(uint core)
+{
+	currentCore = core;
+}
+
+uint get_core_num(void) { return currentCore; }
+
+// LEDs
+
+AnimationOptions AnimationStation::options = { };
+
+void AnimationStation::SetOptions(AnimationOptions options)
+{
+	AnimationStation::options = options;
+}
@@ -0,0 +1,25 @@
+// Device side of the firmware modules built for the host: their flash, heap, clock, pins and cores
+
+#pragma once
+
+#include <stdint.h>
+
+#include "pico/types.h"
+#include "system.h"
+
+// Keeps the settings in a file between runs, without one every run starts from the board defaults.
+// Must be called before anything touches Storage, its constructor loads the flash.
+void host_flash_open(const char * path);
+
+// The mode of the last reboot a handler asked for, DEFAULT until then. The host keeps serving with the
+// settings it has, a snapshot import only shows up after a restart like on the device.
+System::BootMode host_reboot_mode();
+
+// Stops the clock at us, from then on it only moves when set again. It runs from the start of the process until then.
+void host_set_time(uint64_t us);
+
+// Pins read as pressed by gpio_get_all() from now on, all of them read as released until set
+void host_set_pressed(uint32_t pressed);
+
+// Core that get_core_num() reports, 0 until set
+void host_set_core(uint core);
@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+"""
+Generates ps4auth_vectors.h, the known answers of the PS4 authentication harness.
+
+Keys, SHA-256, MGF1 and RSASSA-PSS are all worked out here with plain Python integers so the
+vectors do not share any code with the firmware or a crypto library.
+
+    python3 gen_vectors.py > ps4auth_vectors.h
+"""
+
+import random
+
+K = [
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+]
+
+
+def sha256(message):
+    def rotr(x, n):
+        return ((x >> n) | (x << (32 - n))) & 0xFFFFFFFF
+
+    h = [0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19]
+    padded = message + b'\x80' + b'\0' * ((55 - len(message)) % 64) + (len(message) * 8).to_bytes(8, 'big')
+    for block in range(0, len(padded), 64):
+        w = [int.from_bytes(padded[block + i:block + i + 4], 'big') for i in range(0, 64, 4)]
+        for i in range(16, 64):
+            s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3)
+            s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10)
+            w.append((w[i - 16] + s0 + w[i - 7] + s1) & 0xFFFFFFFF)
+        a, b, c, d, e, f, g, hh = h
+        for i in range(64):
+            t1 = hh + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + K[i] + w[i]
+            t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c))
+            a, b, c, d, e, f, g, hh = (t1 + t2) & 0xFFFFFFFF, a, b, c, (d + t1) & 0xFFFFFFFF, e, f, g
+        h = [(x + y) & 0xFFFFFFFF for x, y in zip(h, [a, b, c, d, e, f, g, hh])]
+    return b''.join(x.to_bytes(4, 'big') for x in h)
+
+
+def is_prime(n, rng):
+    for small in (2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37):
+        if n % small == 0:
+            return n == small
+    d, r = n - 1, 0
+    while d % 2 == 0:
+        d, r = d // 2, r + 1
+    for _ in range(32):
+        x = pow(rng.randrange(2, n - 1), d, n)
+        if x in (1, n - 1):
+            continue
+        for _ in range(r - 1):
+            x = x * x % n
+            if x == n - 1:
+                break
+        else:
+            return False
+    return True
+
+
+def prime(rng, e):
+    while True:
+        candidate = rng.getrandbits(1024) | (3 << 1022) | 1
+        if (candidate - 1) % e and is_prime(candidate, rng):
+            return candidate
+
+
+def key(seed, p_above_q):
+    rng = random.Random(seed)
+    e = 65537
+    p, q = prime(rng, e), prime(rng, e)
+    if (p > q) != p_above_q:
+        p, q = q, p
+    d = pow(e, -1, (p - 1) * (q - 1))
+    return dict(n=p * q, e=e, p=p, q=q, dp=d % (p - 1), dq=d % (q - 1), qp=pow(q, -1, p), d=d)
+
+
+def pss_sign(k, nonce, salt):
+    m_hash = sha256(nonce)
+    h = sha256(b'\0' * 8 + m_hash + salt)
+    db = b'\0' * (256 - 32 - 32 - 2) + b'\x01' + salt
+    mask = b''.join(sha256(h + i.to_bytes(4, 'big')) for i in range(7))[:len(db)]
+    masked = bytearray(x ^ y for x, y in zip(db, mask))
+    masked[0] &= 0x7F  # emBits = 2047
+    em = int.from_bytes(bytes(masked) + h + b'\xbc', 'big')
+    signature = pow(em, k['d'], k['n'])
+    assert pow(signature, k['e'], k['n']) == em
+    return signature.to_bytes(256, 'big')
+
+
+def array(name, data, indent='\t'):
+    lines = [indent + '\t' + ', '.join('0x%02x' % b for b in data[i:i + 16]) + ',' for i in range(0, len(data), 16)]
+    return indent + 'const uint8_t %s[%d] = {\n' % (name, len(data)) + '\n'.join(lines) + '\n' + indent + '};\n'
+
+
+def main():
+    assert sha256(b'abc').hex() == 'ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad'
+
+    rng = random.Random(2040)
+    keys = [('keyPAboveQ', key(1, True)), ('keyQAboveP', key(2, False))]
+    vectors = []
+    for key_index, (_, k) in enumerate(keys):
+        for _ in range(2):
+            nonce = bytes(rng.getrandbits(8) for _ in range(256))
+            salt = bytes(rng.getrandbits(8) for _ in range(32))
+            vectors.append((key_index, nonce, salt, pss_sign(k, nonce, salt)))
+
+    out = ['// Generated by gen_vectors.py, do not edit\n', '#pragma once\n', '#include <stdint.h>\n',
+           'struct PS4AuthKey {\n\tuint8_t n[256];\n\tuint8_t p[128];\n\tuint8_t q[128];\n'
+           '\tuint8_t dp[128];\n\tuint8_t dq[128];\n\tuint8_t qp[128];\n};\n',
+           'struct PS4AuthVector {\n\tuint8_t key;\n\tuint8_t nonce[256];\n\tuint8_t salt[32];\n\tuint8_t signature[256];\n};\n']
+    out.append('const PS4AuthKey PS4_AUTH_KEYS[] = {')
+    for name, k in keys:
+        fields = ''.join(array(f, k[f].to_bytes(size, 'big'), '\t\t').replace('\t\tconst uint8_t %s[%d] = ' % (f, size), '\t\t/* %s */ ' % f).replace('};\n', '},\n')
+                         for f, size in (('n', 256), ('p', 128), ('q', 128), ('dp', 128), ('dq', 128), ('qp', 128)))
+        out.append('\t// %s\n\t{\n%s\t},' % (name, fields))
+    out.append('};\n')
+    out.append('const PS4AuthVector PS4_AUTH_VECTORS[] = {')
+    for key_index, nonce, salt, signature in vectors:
+        fields = ''.join(array(f, data, '\t\t').replace('\t\tconst uint8_t %s[%d] = ' % (f, len(data)), '\t\t/* %s */ ' % f).replace('};\n', '},\n')
+                         for f, data in (('nonce', nonce), ('salt', salt), ('signature', signature)))
+        out.append('\t{\n\t\t%d,\n%s\t},' % (key_index, fields))
+    out.append('};\n')
+    print('\n'.join(out), end='')
+
+
+if __name__ == '__main__':
+    main()
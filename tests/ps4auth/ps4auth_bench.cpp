@@ -0,0 +1,60 @@
+// Times the PS4 authentication from the first nonce page to the last response page
+//
+//    ps4auth_bench [runs]
+//
+// The host is much faster than the RP2040, the loop iteration count and the share of the time spent
+// signing are the numbers to compare between builds.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ps4auth_host.h"
+
+int main(int argc, char * argv[])
+{
+	const int runs = argc > 1 ? atoi(argv[1]) : 20;
+	if (runs <= 0) {
+		printf("usage: %s [runs]\n", argv[0]);
+		return 1;
+	}
+
+	PS4ModeAddon addon;
+	PS4Console console(addon);
+	host_load_key(PS4_AUTH_KEYS[0]);
+	addon.setup();
+
+	uint64_t total = 0;
+	uint64_t signing = 0;
+	uint32_t best = UINT32_MAX;
+	uint32_t worst = 0;
+	uint32_t iterations = 0;
+	for (int run = 0; run < runs; run++) {
+		const PS4AuthVector & vector = PS4_AUTH_VECTORS[run % 2];
+		host_rand_queue(vector.salt, sizeof(vector.salt));
+
+		const uint32_t started = time_us_32();
+		console.sendNonce(static_cast<uint8_t>(run), vector.nonce);
+		iterations += console.waitForSignature();
+		uint8_t response[1064];
+		const bool read = console.readResponse(response);
+		const uint32_t elapsed = time_us_32() - started;
+
+		if (!read || memcmp(response, vector.signature, 256) != 0) {
+			printf("run %d: wrong response\n", run);
+			return 1;
+		}
+		total += elapsed;
+		signing += PS4Data::getInstance().signingStats.lastCpuTime;
+		if (elapsed < best)
+			best = elapsed;
+		if (elapsed > worst)
+			worst = elapsed;
+	}
+
+	printf("%d runs, budget %u us per loop iteration\n", runs, PS4_SIGNING_BUDGET_US);
+	printf("end to end: %llu us average, %u us best, %u us worst\n", (unsigned long long)(total / runs), best, worst);
+	printf("signing: %llu us average, %u loop iterations average, %u us longest stall\n",
+		(unsigned long long)(signing / runs), iterations / runs, PS4Data::getInstance().signingStats.maxStall);
+	return 0;
+}
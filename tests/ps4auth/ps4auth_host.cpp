@@ -0,0 +1,138 @@
+#include "ps4auth_host.h"
+
+#include <chrono>
+#include <deque>
+#include <string.h>
+
+#include "CRC32.h"
+#include "storagemanager.h"
+
+static std::deque<uint8_t> randBytes;
+
+uint32_t get_rand_32(void)
+{
+	uint32_t value = 0;
+	for (uint8_t i = 0; i < 4 && !randBytes.empty(); i++) {
+		value |= static_cast<uint32_t>(randBytes.front()) << (i * 8);
+		randBytes.pop_front();
+	}
+	return value;
+}
+
+uint32_t time_us_32(void)
+{
+	static const auto boot = std::chrono::steady_clock::now();
+	return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - boot).count());
+}
+
+void host_rand_queue(const uint8_t * bytes, uint16_t size)
+{
+	randBytes.insert(randBytes.end(), bytes, bytes + size);
+}
+
+static void read_binary(mbedtls_mpi_uint * limbs, uint16_t limbCount, const uint8_t * bytes, uint16_t size)
+{
+	memset(limbs, 0, limbCount * sizeof(mbedtls_mpi_uint));
+	for (uint16_t i = 0; i < size; i++)
+		limbs[i / 4] |= static_cast<mbedtls_mpi_uint>(bytes[size - 1 - i]) << ((i % 4) * 8);
+}
+
+void host_load_key(const PS4AuthKey & key)
+{
+	PS4Options * options = Storage::getInstance().getPS4Options();
+	memset(options, 0, sizeof(PS4Options));
+	for (uint8_t i = 0; i < 16; i++)
+		options->serial[i] = 0xA0 + i;
+	for (uint16_t i = 0; i < 256; i++)
+		options->signature[i] = static_cast<uint8_t>(i * 7 + 3);
+	read_binary(options->rsa_n, 64, key.n, sizeof(key.n));
+	options->rsa_e[0] = 65537;
+	read_binary(options->rsa_p, 32, key.p, sizeof(key.p));
+	read_binary(options->rsa_q, 32, key.q, sizeof(key.q));
+	read_binary(options->rsa_dp, 32, key.dp, sizeof(key.dp));
+	read_binary(options->rsa_dq, 32, key.dq, sizeof(key.dq));
+	read_binary(options->rsa_qp, 32, key.qp, sizeof(key.qp));
+}
+
+void host_expected_response(const PS4AuthKey & key, const uint8_t * signature, uint8_t * response)
+{
+	PS4Options * options = Storage::getInstance().getPS4Options();
+	memset(response, 0, sizeof(PS4Data::getInstance().ps4_auth_buffer));
+	memcpy(response, signature, 256);
+	memcpy(&response[256], options->serial, 16);
+	memcpy(&response[272], key.n, 256);
+	response[528 + 253] = 0x01; // e = 65537, big endian
+	response[528 + 255] = 0x01;
+	memcpy(&response[784], options->signature, 256);
+}
+
+void PS4Console::sendPage(uint8_t nonceId, uint8_t page, const uint8_t * nonce, bool corruptCrc)
+{
+	uint8_t report[64] = { PS4AuthReport::PS4_SET_AUTH_PAYLOAD, nonceId, page, 0 };
+	const uint16_t offset = page * PS4_AUTH_PAGE_SIZE;
+	const uint16_t size = page == PS4_NONCE_PAGES - 1 ? 256 - offset : PS4_AUTH_PAGE_SIZE;
+	if (page < PS4_NONCE_PAGES)
+		memcpy(&report[4], &nonce[offset], size);
+
+	uint32_t crc32 = CRC32::calculate(report, 60);
+	if (corruptCrc)
+		crc32 ^= 1;
+	memcpy(&report[60], &crc32, sizeof(crc32));
+	set_ps4_report(report[0], &report[1], 63);
+}
+
+void PS4Console::sendNonce(uint8_t nonceId, const uint8_t * nonce)
+{
+	currentNonceId = nonceId;
+	for (uint8_t page = 0; page < PS4_NONCE_PAGES; page++)
+		sendPage(nonceId, page, nonce);
+}
+
+bool PS4Console::pollSigningState()
+{
+	uint8_t report[16] = { PS4AuthReport::PS4_GET_SIGNING_STATE };
+	if (get_ps4_report(report[0], &report[1], 15) != 15)
+		return false;
+
+	const uint32_t crc32 = CRC32::calculate(report, 12);
+	return memcmp(&report[12], &crc32, sizeof(crc32)) == 0 && report[1] == currentNonceId && report[2] == 0;
+}
+
+bool PS4Console::readPage(uint8_t page, uint8_t * response)
+{
+	uint8_t report[64] = { PS4AuthReport::PS4_GET_SIGNATURE_NONCE };
+	if (get_ps4_report(report[0], &report[1], 63) != 63)
+		return false;
+
+	const uint32_t crc32 = CRC32::calculate(report, 60);
+	if (memcmp(&report[60], &crc32, sizeof(crc32)) != 0 || report[1] != currentNonceId || report[2] != page)
+		return false;
+
+	memcpy(&response[page * PS4_AUTH_PAGE_SIZE], &report[4], PS4_AUTH_PAGE_SIZE);
+	return true;
+}
+
+void PS4Console::resetAuth()
+{
+	uint8_t report[8] = { PS4AuthReport::PS4_RESET_AUTH };
+	get_ps4_report(report[0], &report[1], 7);
+}
+
+uint32_t PS4Console::waitForSignature(uint32_t maxIterations)
+{
+	uint32_t iterations = 0;
+	while (iterations < maxIterations && !pollSigningState()) {
+		addon.process();
+		iterations++;
+	}
+	return iterations;
+}
+
+bool PS4Console::readResponse(uint8_t * response)
+{
+	for (uint8_t page = 0; page < PS4_RESPONSE_PAGES; page++) {
+		if (!readPage(page, response))
+			return false;
+	}
+	return true;
+}
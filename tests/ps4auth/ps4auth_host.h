@@ -0,0 +1,45 @@
+// Plays the console side of the PS4 authentication against ps4_auth.cpp and the PS4 mode add-on
+
+#pragma once
+
+#include <stdint.h>
+
+#include "addons/ps4mode.h"
+#include "hardware/timer.h"
+#include "ps4_auth.h"
+
+#include "ps4auth_vectors.h"
+
+// Bytes handed out by get_rand_32, the salt of the next signature
+void host_rand_queue(const uint8_t * bytes, uint16_t size);
+
+// Fills the stored PS4 options with a test key, a fixed serial and a fixed console signature
+void host_load_key(const PS4AuthKey & key);
+
+// The response the add-on pages out for a key and nonce signature
+void host_expected_response(const PS4AuthKey & key, const uint8_t * signature, uint8_t * response);
+
+class PS4Console {
+public:
+	PS4Console(PS4ModeAddon & addon) : addon(addon) {}
+
+	// One SET_AUTH_PAYLOAD page, corruptCrc sends it with a broken checksum
+	void sendPage(uint8_t nonceId, uint8_t page, const uint8_t * nonce, bool corruptCrc = false);
+	void sendNonce(uint8_t nonceId, const uint8_t * nonce);
+
+	// GET_SIGNING_STATE, returns true once the signature is ready
+	bool pollSigningState();
+	// GET_SIGNATURE_NONCE, returns false when the page is refused or fails its checks
+	bool readPage(uint8_t page, uint8_t * response);
+	void resetAuth();
+
+	// Runs the add-on between polls until the signature is ready, returns the number of loop iterations
+	uint32_t waitForSignature(uint32_t maxIterations = 100000);
+	bool readResponse(uint8_t * response);
+
+	uint8_t nonceId() const { return currentNonceId; }
+
+private:
+	PS4ModeAddon & addon;
+	uint8_t currentNonceId = 0;
+};
@@ -0,0 +1,189 @@
+// Known answer and paging tests for the PS4 authentication, see gen_vectors.py for the vectors
+
+#include <stdio.h>
+#include <string.h>
+
+#include "mbedtls/sha256.h"
+
+#include "ps4auth_host.h"
+
+static int failures = 0;
+
+#define CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+			failures++; \
+		} \
+	} while (0)
+
+static const uint16_t RESPONSE_SIZE = sizeof(PS4Data::getInstance().ps4_auth_buffer);
+static const uint8_t ZERO_NONCE[256] = {};
+
+static PS4ModeAddon addon;
+static PS4Console console(addon);
+
+static void setupKey(uint8_t key)
+{
+	console.resetAuth();
+	host_load_key(PS4_AUTH_KEYS[key]);
+	addon.setup();
+}
+
+static void checkSha256()
+{
+	static const uint8_t abc[32] = {
+		0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+		0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad,
+	};
+	static const uint8_t twoBlocks[32] = {
+		0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8, 0xe5, 0xc0, 0x26, 0x93, 0x0c, 0x3e, 0x60, 0x39,
+		0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff, 0x21, 0x67, 0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1,
+	};
+	uint8_t hash[32];
+	mbedtls_sha256_ret(reinterpret_cast<const uint8_t *>("abc"), 3, hash, 0);
+	CHECK(memcmp(hash, abc, 32) == 0);
+	const char * message = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+	mbedtls_sha256_ret(reinterpret_cast<const uint8_t *>(message), strlen(message), hash, 0);
+	CHECK(memcmp(hash, twoBlocks, 32) == 0);
+}
+
+// The whole exchange as the console runs it, compared against the generated signature
+static void checkKnownAnswers()
+{
+	uint8_t nonceId = 1;
+	for (const PS4AuthVector & vector : PS4_AUTH_VECTORS) {
+		setupKey(vector.key);
+		host_rand_queue(vector.salt, sizeof(vector.salt));
+
+		const uint32_t started = time_us_32();
+		console.sendNonce(nonceId, vector.nonce);
+		const uint32_t iterations = console.waitForSignature();
+		uint8_t response[1064];
+		const bool read = console.readResponse(response);
+		const uint32_t elapsed = time_us_32() - started;
+
+		uint8_t expected[1064];
+		host_expected_response(PS4_AUTH_KEYS[vector.key], vector.signature, expected);
+		CHECK(read);
+		CHECK(memcmp(response, vector.signature, 256) == 0);
+		CHECK(memcmp(response, expected, RESPONSE_SIZE) == 0);
+		CHECK(PS4Data::getInstance().authsent);
+		CHECK(PS4Data::getInstance().ps4State == PS4State::no_nonce);
+
+		const PS4SigningStats & stats = PS4Data::getInstance().signingStats;
+		printf("nonce %u key %u: %u loop iterations, signed in %u us (%u us signing, %u us longest stall), %u us end to end\n",
+			nonceId, vector.key, iterations, stats.lastTime, stats.lastCpuTime, stats.maxStall, elapsed);
+		nonceId++;
+	}
+}
+
+// A nonce that is not complete and intact must never be signed
+static void checkRejectedNonces()
+{
+	const PS4AuthVector & vector = PS4_AUTH_VECTORS[0];
+	setupKey(vector.key);
+
+	// Broken checksum on a middle page
+	for (uint8_t page = 0; page < PS4_NONCE_PAGES; page++)
+		console.sendPage(10, page, vector.nonce, page == 2);
+	CHECK(PS4Data::getInstance().ps4State == PS4State::no_nonce);
+
+	// A page of another nonce
+	for (uint8_t page = 0; page < PS4_NONCE_PAGES; page++)
+		console.sendPage(page == 3 ? 12 : 11, page, vector.nonce);
+	CHECK(PS4Data::getInstance().ps4State == PS4State::no_nonce);
+
+	// A missing page
+	for (uint8_t page = 0; page < PS4_NONCE_PAGES; page++) {
+		if (page != 1)
+			console.sendPage(13, page, vector.nonce);
+	}
+	CHECK(PS4Data::getInstance().ps4State == PS4State::no_nonce);
+
+	// A page past the end of the nonce
+	for (uint8_t page = 0; page < PS4_NONCE_PAGES - 1; page++)
+		console.sendPage(14, page, vector.nonce);
+	console.sendPage(14, PS4_NONCE_PAGES, vector.nonce);
+	CHECK(PS4Data::getInstance().ps4State == PS4State::no_nonce);
+
+	// Nothing was signed, so there is nothing to page out
+	uint8_t response[1064];
+	CHECK(!console.pollSigningState());
+	CHECK(!console.readPage(0, response));
+	addon.process();
+	CHECK(PS4Data::getInstance().ps4State == PS4State::no_nonce);
+}
+
+// The response is refused until signed and restarts when the console resets or sends a new nonce
+static void checkPaging()
+{
+	const PS4AuthVector & first = PS4_AUTH_VECTORS[0];
+	const PS4AuthVector & second = PS4_AUTH_VECTORS[1];
+	uint8_t response[1064];
+	setupKey(first.key);
+
+	host_rand_queue(first.salt, sizeof(first.salt));
+	console.sendNonce(20, first.nonce);
+	CHECK(!console.readPage(0, response));
+	addon.process();
+	CHECK(!console.readPage(0, response));
+	console.waitForSignature();
+
+	// Reset halfway through the response
+	CHECK(console.readPage(0, response));
+	CHECK(console.readPage(1, response));
+	console.resetAuth();
+	CHECK(!console.pollSigningState());
+	CHECK(!console.readPage(2, response));
+
+	// A new nonce halfway through the response of the previous one
+	host_rand_queue(first.salt, sizeof(first.salt));
+	console.sendNonce(21, first.nonce);
+	console.waitForSignature();
+	CHECK(console.readPage(0, response));
+	host_rand_queue(second.salt, sizeof(second.salt));
+	console.sendNonce(22, second.nonce);
+	CHECK(!console.readPage(1, response));
+	console.waitForSignature();
+	CHECK(console.readResponse(response));
+	CHECK(memcmp(response, second.signature, 256) == 0);
+}
+
+// A nonce replacing the one being signed between two loop iterations must restart the signature
+static void checkReplacedNonce()
+{
+	const PS4AuthVector & second = PS4_AUTH_VECTORS[1];
+	uint8_t response[1064];
+	setupKey(second.key);
+
+	static const uint8_t discardedSalt[32] = { 0x5A };
+	host_rand_queue(discardedSalt, sizeof(discardedSalt));
+	console.sendNonce(30, ZERO_NONCE);
+	for (uint8_t i = 0; i < 3; i++)
+		addon.process();
+	CHECK(PS4Data::getInstance().ps4State == PS4State::nonce_ready);
+
+	host_rand_queue(second.salt, sizeof(second.salt));
+	console.sendNonce(31, second.nonce);
+	CHECK(PS4Data::getInstance().ps4State == PS4State::nonce_ready);
+	console.waitForSignature();
+	CHECK(console.readResponse(response));
+	CHECK(memcmp(response, second.signature, 256) == 0);
+}
+
+int main()
+{
+	checkSha256();
+	checkKnownAnswers();
+	checkRejectedNonces();
+	checkPaging();
+	checkReplacedNonce();
+
+	if (failures) {
+		printf("%d checks failed\n", failures);
+		return 1;
+	}
+	printf("all checks passed\n");
+	return 0;
+}
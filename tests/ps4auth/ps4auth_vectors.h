@@ -0,0 +1,341 @@
+// Generated by gen_vectors.py, do not edit
+
+#pragma once
+
+#include <stdint.h>
+
+struct PS4AuthKey {
+	uint8_t n[256];
+	uint8_t p[128];
+	uint8_t q[128];
+	uint8_t dp[128];
+	uint8_t dq[128];
+	uint8_t qp[128];
+};
+
+struct PS4AuthVector {
+	uint8_t key;
+	uint8_t nonce[256];
+	uint8_t salt[32];
+	uint8_t signature[256];
+};
+
+const PS4AuthKey PS4_AUTH_KEYS[] = {
+	// keyPAboveQ
+	{
+		/* n */ {
+			0xc9, 0xef, 0xd5, 0xe2, 0xbf, 0x12, 0xd5, 0xa2, 0xa6, 0x5a, 0x06, 0x4b, 0x1b, 0x15, 0xfe, 0xb2,
+			0x20, 0x10, 0x88, 0x48, 0x37, 0x51, 0x76, 0xcb, 0x7f, 0x3f, 0x59, 0xa5, 0xc1, 0x1e, 0x52, 0x54,
+			0xe5, 0x07, 0x1f, 0xa8, 0xf5, 0xff, 0x32, 0x88, 0x02, 0x42, 0xd6, 0x7b, 0xf4, 0x54, 0x57, 0x3d,
+			0xee, 0x08, 0x34, 0x5b, 0xed, 0x1c, 0xc3, 0xa3, 0x13, 0x62, 0x5d, 0xb8, 0xc4, 0xda, 0x7f, 0x01,
+			0xc6, 0xda, 0x73, 0xd0, 0xb0, 0x03, 0xe0, 0xfe, 0x15, 0xf0, 0xf4, 0x60, 0xfe, 0xba, 0x03, 0x70,
+			0xeb, 0xf0, 0x04, 0x86, 0x27, 0x73, 0x85, 0x20, 0x55, 0x86, 0x96, 0x66, 0xe1, 0x7b, 0x09, 0x9a,
+			0xc1, 0xa5, 0x7a, 0x80, 0xd3, 0x12, 0x52, 0x2c, 0xd9, 0xf2, 0x7d, 0x72, 0xfe, 0xec, 0x3f, 0x23,
+			0x7b, 0x30, 0x41, 0xf4, 0xb5, 0x7e, 0xdc, 0x41, 0x8a, 0xd5, 0xea, 0x42, 0xbf, 0x3f, 0xbc, 0xbd,
+			0x81, 0x0f, 0x07, 0xe4, 0xb7, 0xc0, 0x36, 0x0c, 0xc5, 0xb3, 0xf4, 0x74, 0x97, 0xf3, 0x3e, 0x0c,
+			0x01, 0x41, 0x67, 0xd2, 0x79, 0xe7, 0x4d, 0xa4, 0xd4, 0x05, 0x72, 0xb1, 0x8d, 0x0d, 0xff, 0x0a,
+			0xed, 0xe1, 0xdf, 0x80, 0xe6, 0x54, 0xfd, 0x87, 0xd4, 0x2a, 0x20, 0xb9, 0x8e, 0xa2, 0xb5, 0x6a,
+			0xde, 0x2e, 0x2d, 0xb5, 0x8a, 0x80, 0x34, 0x5f, 0x37, 0xf6, 0xd1, 0x11, 0x86, 0xbf, 0x81, 0xfc,
+			0x50, 0x53, 0xad, 0xf4, 0x2c, 0x45, 0xf8, 0xdd, 0x56, 0x96, 0x8f, 0xfd, 0x0b, 0xfc, 0x31, 0xf4,
+			0xa9, 0x53, 0x49, 0xa8, 0x40, 0x79, 0xe0, 0x2d, 0x0b, 0x93, 0x90, 0xde, 0xfa, 0x28, 0x49, 0x18,
+			0x32, 0x36, 0xd8, 0x37, 0x72, 0x7f, 0x00, 0x7a, 0x66, 0x7e, 0x87, 0xe8, 0x6a, 0xa6, 0x3b, 0xf2,
+			0x1a, 0xd4, 0xb5, 0x88, 0xce, 0xbb, 0x80, 0x29, 0xb5, 0xdc, 0x33, 0x72, 0x05, 0xcb, 0xad, 0xf1,
+		},
+		/* p */ {
+			0xea, 0xb7, 0x1c, 0xab, 0x52, 0x9b, 0x97, 0x72, 0x8b, 0x9d, 0x3f, 0x47, 0x84, 0x44, 0x97, 0xa4,
+			0x62, 0xe1, 0xfa, 0xa4, 0x49, 0x1b, 0x8f, 0x6e, 0xdc, 0x59, 0xbb, 0x7f, 0x84, 0xfe, 0x09, 0xa3,
+			0x4e, 0x1c, 0x2f, 0x72, 0xf9, 0xe1, 0x16, 0x7a, 0x3d, 0xa1, 0x4a, 0x11, 0x8a, 0x55, 0xfc, 0x2e,
+			0x5b, 0x4e, 0x60, 0x12, 0x86, 0x8b, 0xef, 0xb0, 0xd3, 0xbd, 0xc6, 0x98, 0x56, 0xc1, 0x29, 0x4d,
+			0xe2, 0xa1, 0xbc, 0xfd, 0x6f, 0x20, 0xab, 0x1f, 0xdb, 0xe3, 0xef, 0x75, 0x17, 0x20, 0x59, 0xb2,
+			0x0e, 0x8e, 0xac, 0x3e, 0x86, 0x20, 0xe7, 0x4d, 0x0d, 0x7e, 0x54, 0x1a, 0xe6, 0xd9, 0xc9, 0xc4,
+			0x5b, 0x33, 0xa9, 0xc6, 0x97, 0x82, 0x27, 0x7f, 0x86, 0xe1, 0xcc, 0xc0, 0x98, 0xd5, 0xa3, 0xe6,
+			0xfa, 0xa3, 0x4c, 0xd4, 0x5a, 0x03, 0x22, 0xd9, 0x48, 0xb7, 0x00, 0x83, 0xee, 0x09, 0xf9, 0x73,
+		},
+		/* q */ {
+			0xdc, 0x3f, 0xc6, 0xb4, 0xdf, 0x96, 0x19, 0xb6, 0xcc, 0x4f, 0x0e, 0x98, 0x1b, 0x77, 0xd5, 0x3b,
+			0x16, 0x31, 0xe1, 0x44, 0xd9, 0x81, 0x5a, 0x6d, 0x59, 0x3d, 0x40, 0x76, 0x8c, 0xc3, 0xf3, 0x5f,
+			0x92, 0x5b, 0x0c, 0xec, 0x2b, 0xac, 0x23, 0x33, 0x77, 0x9f, 0x56, 0x58, 0xea, 0x18, 0x88, 0xa4,
+			0x20, 0xc6, 0xb9, 0xb3, 0xbb, 0x76, 0xd3, 0xd4, 0xf8, 0x34, 0xa4, 0x21, 0x12, 0x1a, 0xcc, 0x7c,
+			0x46, 0xb8, 0x7f, 0x72, 0xe7, 0x86, 0xc6, 0xdf, 0x1a, 0x0f, 0x28, 0xdd, 0x6b, 0x1a, 0x24, 0x64,
+			0x3b, 0x90, 0x97, 0x81, 0xbf, 0x34, 0x56, 0xe8, 0xc2, 0x14, 0x78, 0x7f, 0x36, 0xd5, 0xff, 0x58,
+			0x87, 0x8c, 0x6a, 0xd5, 0x58, 0x5f, 0x53, 0x4e, 0x38, 0x7f, 0xc1, 0x36, 0x4b, 0xa6, 0x67, 0x4b,
+			0x5c, 0x3a, 0x62, 0x81, 0x34, 0x6b, 0x1a, 0x20, 0xc2, 0x63, 0xee, 0x29, 0x29, 0x64, 0xb2, 0x0b,
+		},
+		/* dp */ {
+			0x18, 0x39, 0x85, 0xef, 0xf8, 0xba, 0xae, 0x4a, 0xd8, 0x36, 0x06, 0x8d, 0xef, 0x0c, 0xd5, 0x49,
+			0xd6, 0x1a, 0xd4, 0xaf, 0x98, 0x0c, 0x0c, 0x25, 0xb9, 0x00, 0x59, 0xe5, 0xb3, 0x68, 0x34, 0xbe,
+			0x72, 0x15, 0x5e, 0xa0, 0x53, 0x41, 0xf3, 0xfb, 0xf1, 0xd8, 0x6f, 0xb8, 0x97, 0xba, 0x80, 0x28,
+			0x98, 0xab, 0xe2, 0x26, 0x87, 0x54, 0x72, 0x0c, 0xa2, 0x0d, 0xf8, 0x2d, 0x48, 0xe6, 0xee, 0xc8,
+			0x67, 0x17, 0xa2, 0x55, 0xd5, 0xde, 0x5d, 0x4b, 0x10, 0x7a, 0xda, 0x00, 0x0f, 0xbe, 0xfb, 0x02,
+			0xf1, 0x95, 0xb0, 0x19, 0x53, 0xe6, 0x99, 0x78, 0xce, 0x67, 0xb7, 0x6e, 0x7f, 0x5d, 0x03, 0x02,
+			0x0d, 0x17, 0xab, 0xf2, 0x1f, 0x39, 0x03, 0xb2, 0x99, 0xcd, 0x3c, 0x40, 0xb4, 0x85, 0x78, 0x41,
+			0x22, 0xa5, 0x30, 0x0c, 0xca, 0xad, 0x80, 0x2f, 0x44, 0xdd, 0xfe, 0x63, 0x9f, 0x71, 0xd0, 0x19,
+		},
+		/* dq */ {
+			0x2f, 0xd0, 0xd8, 0xbe, 0xe3, 0xdb, 0x9e, 0x71, 0x85, 0x21, 0x94, 0xb5, 0x89, 0x21, 0x16, 0xf5,
+			0xe0, 0xf7, 0xab, 0x44, 0x5b, 0x44, 0x2d, 0xf1, 0x97, 0x72, 0x28, 0xd0, 0x93, 0xf6, 0xe6, 0x9b,
+			0x55, 0x16, 0xd7, 0x53, 0x5e, 0x97, 0xdc, 0x7c, 0x8b, 0xf7, 0xd7, 0xb3, 0x2d, 0xff, 0x6d, 0x8a,
+			0xd4, 0x62, 0xd0, 0x66, 0x28, 0xc8, 0xbf, 0x6c, 0x79, 0x06, 0x54, 0xab, 0xa9, 0x56, 0x90, 0x16,
+			0x5a, 0xf4, 0x2b, 0x17, 0x33, 0x14, 0x9b, 0x90, 0x4c, 0x04, 0x06, 0x87, 0x2b, 0x7d, 0x5d, 0x71,
+			0x35, 0x4d, 0x4a, 0xd7, 0x2c, 0x3f, 0x9c, 0xae, 0xa3, 0x93, 0xf6, 0x25, 0x08, 0x2e, 0xa5, 0x64,
+			0xfe, 0xe8, 0x89, 0x39, 0x10, 0x1a, 0x81, 0xe7, 0x75, 0x74, 0xa6, 0xe9, 0xb6, 0xba, 0xc5, 0xaa,
+			0x22, 0xb7, 0xba, 0x32, 0xfa, 0xc2, 0x55, 0xc5, 0xce, 0xee, 0x0b, 0x02, 0x7c, 0xae, 0x13, 0xc9,
+		},
+		/* qp */ {
+			0x6c, 0x5e, 0x75, 0xf8, 0x23, 0xcd, 0xef, 0x21, 0xe5, 0x32, 0x4f, 0x30, 0xca, 0x13, 0xf5, 0x86,
+			0xd2, 0x3c, 0xfe, 0xdd, 0x88, 0xbf, 0xf2, 0x06, 0x92, 0x98, 0x29, 0xf3, 0x05, 0xea, 0xbe, 0x8d,
+			0x70, 0x60, 0x47, 0xcb, 0x58, 0x9c, 0x09, 0x6b, 0x24, 0xff, 0xd2, 0xe8, 0x6b, 0x80, 0xc0, 0xa9,
+			0x1e, 0xbf, 0x0d, 0x9e, 0x86, 0xce, 0x33, 0x14, 0x40, 0xd8, 0x72, 0x90, 0xb8, 0x8a, 0xbe, 0x45,
+			0x5f, 0x51, 0x87, 0x6d, 0xee, 0x6c, 0xe9, 0x2c, 0xe5, 0x4e, 0xcf, 0xc1, 0x38, 0xc1, 0x51, 0x8c,
+			0xb0, 0x16, 0xab, 0x8d, 0x20, 0x07, 0x39, 0xe4, 0x72, 0x01, 0x32, 0xf5, 0x5f, 0xa8, 0x87, 0x01,
+			0x3f, 0x1e, 0x5f, 0x46, 0xe4, 0xa4, 0x17, 0xb8, 0x26, 0xe2, 0x37, 0x32, 0x1b, 0xed, 0x78, 0x6d,
+			0x01, 0x51, 0x59, 0x94, 0xaf, 0xa9, 0x84, 0x90, 0x95, 0x6c, 0xef, 0xd0, 0x85, 0x47, 0x9c, 0x9f,
+		},
+	},
+	// keyQAboveP
+	{
+		/* n */ {
+			0xcc, 0xdb, 0xb7, 0x9a, 0xa7, 0x08, 0x5b, 0x1f, 0xcd, 0xee, 0xaa, 0x2e, 0x36, 0x91, 0x36, 0x04,
+			0x25, 0xab, 0x32, 0xcb, 0x75, 0xb7, 0x80, 0xea, 0xbf, 0xcf, 0x23, 0x4c, 0x62, 0xa5, 0xae, 0x46,
+			0xfe, 0x71, 0xb8, 0xea, 0x48, 0x30, 0xbe, 0xc5, 0x89, 0xb5, 0x6c, 0x49, 0xc1, 0x73, 0x02, 0xc8,
+			0xef, 0x85, 0xcc, 0x60, 0xec, 0x87, 0x29, 0x91, 0x1e, 0x8a, 0x53, 0x2f, 0x5f, 0x0a, 0x2b, 0x22,
+			0x46, 0x09, 0xf2, 0xd1, 0xdd, 0x2e, 0xb3, 0x2a, 0x50, 0x8b, 0x58, 0xe1, 0xae, 0x32, 0x16, 0xa6,
+			0xbd, 0x24, 0x91, 0xac, 0x94, 0x08, 0x27, 0x5e, 0x1c, 0x0e, 0x89, 0xf5, 0x9c, 0x06, 0x70, 0x20,
+			0x23, 0xc0, 0x72, 0x96, 0xcc, 0xdc, 0xb0, 0x6a, 0x2e, 0x2d, 0xcb, 0xd9, 0xe3, 0x30, 0x3d, 0x32,
+			0xdd, 0x89, 0x8d, 0x28, 0xb1, 0xe3, 0xde, 0x82, 0x83, 0xe2, 0x06, 0x6c, 0x46, 0x39, 0xf4, 0x9a,
+			0xf7, 0x4a, 0x35, 0xfd, 0xcd, 0x67, 0x5c, 0xb2, 0x0f, 0x78, 0x81, 0xdc, 0x37, 0x84, 0x33, 0xb1,
+			0xe5, 0xec, 0xda, 0x3d, 0x59, 0x5b, 0xf5, 0x5a, 0xf5, 0x0a, 0xe8, 0x0d, 0x02, 0x86, 0x64, 0xe2,
+			0xb4, 0x24, 0xe6, 0xfe, 0xed, 0x09, 0x75, 0x42, 0xd1, 0xfe, 0x06, 0xfa, 0xd7, 0xa5, 0x6e, 0xd4,
+			0x2d, 0x66, 0xc2, 0xaa, 0x96, 0x62, 0xa6, 0x6a, 0xdd, 0x74, 0xc0, 0xfd, 0x41, 0x47, 0xf7, 0xcc,
+			0x7f, 0xf1, 0x7d, 0x13, 0xb6, 0x8f, 0xe1, 0x46, 0xcf, 0xdc, 0xa2, 0x00, 0x09, 0xbf, 0x23, 0xc7,
+			0x9e, 0x57, 0x56, 0x6c, 0x3b, 0x04, 0xd0, 0x5b, 0xcd, 0xc8, 0xdd, 0x3c, 0xd6, 0x0c, 0x5d, 0x2d,
+			0x5b, 0x74, 0x8e, 0xfc, 0xb5, 0x2c, 0x65, 0x7c, 0x3d, 0x34, 0x94, 0xdd, 0x4c, 0xe4, 0xaf, 0xe0,
+			0xac, 0x31, 0xf2, 0x74, 0xdf, 0x16, 0xf5, 0x1c, 0x1c, 0x13, 0x95, 0x76, 0x79, 0xe1, 0xbe, 0x4d,
+		},
+		/* p */ {
+			0xd3, 0xb1, 0x72, 0xcb, 0xff, 0xbd, 0x2f, 0x1a, 0xd5, 0x88, 0xa6, 0x8b, 0x29, 0x18, 0x10, 0x94,
+			0x67, 0x0d, 0x6b, 0x18, 0x97, 0x9d, 0xdd, 0x01, 0x78, 0x92, 0x93, 0xc5, 0x19, 0x86, 0x13, 0x88,
+			0x17, 0x9b, 0xc2, 0xc6, 0xa7, 0xae, 0x00, 0x20, 0x99, 0xf1, 0x22, 0x60, 0x9e, 0xc3, 0x35, 0x85,
+			0xae, 0x37, 0xaa, 0x89, 0x50, 0x4c, 0x61, 0x72, 0xa4, 0x51, 0xdb, 0xfa, 0xbb, 0x7e, 0xab, 0xfc,
+			0xfe, 0x0f, 0x9a, 0x6b, 0x8f, 0x12, 0x67, 0x71, 0x3a, 0x3e, 0xa2, 0x3b, 0xc8, 0x0c, 0x66, 0x7f,
+			0x6a, 0x8f, 0xf2, 0xf8, 0xe8, 0xec, 0x6d, 0xb7, 0xd5, 0xe6, 0x37, 0x6c, 0x97, 0xab, 0xf8, 0x2a,
+			0xa8, 0x7f, 0x7b, 0xe9, 0x01, 0x63, 0xe8, 0xea, 0xb4, 0x75, 0x97, 0x99, 0x0c, 0xd2, 0xc6, 0xf3,
+			0xc5, 0x1a, 0xc1, 0x0e, 0xe3, 0x61, 0xc8, 0xd3, 0xc7, 0xc8, 0x8a, 0x89, 0x83, 0xd1, 0xc7, 0xd1,
+		},
+		/* q */ {
+			0xf7, 0xbc, 0x0d, 0xf1, 0x44, 0x6f, 0xcc, 0xb4, 0xe7, 0x11, 0xd9, 0x8b, 0x99, 0x44, 0x6a, 0xe1,
+			0x30, 0x75, 0x09, 0xc9, 0x95, 0x92, 0x41, 0x30, 0xfb, 0xc2, 0xb7, 0x24, 0xaa, 0x15, 0x74, 0x11,
+			0x5d, 0x32, 0xee, 0xc3, 0x6d, 0x3c, 0xcf, 0x16, 0xe6, 0x13, 0xd3, 0xb4, 0xbf, 0xb2, 0xde, 0xbb,
+			0xc8, 0x9e, 0x4a, 0xb0, 0x3c, 0x81, 0x02, 0x0b, 0x58, 0x48, 0x05, 0xe8, 0xff, 0x8e, 0xbe, 0x5a,
+			0x5a, 0x65, 0x0e, 0x3f, 0x7d, 0x22, 0x54, 0xcb, 0x2e, 0xbd, 0x6b, 0xc1, 0xf7, 0x2d, 0x32, 0x4b,
+			0x8b, 0xa2, 0xc4, 0x18, 0x62, 0xa3, 0x39, 0x5b, 0x85, 0xaf, 0xc9, 0x7e, 0xa5, 0xb8, 0x3e, 0x79,
+			0xa6, 0x34, 0xe5, 0x12, 0x13, 0x1c, 0x62, 0x57, 0xd3, 0x01, 0x15, 0x36, 0x6f, 0x8e, 0x33, 0x97,
+			0x6a, 0x38, 0xc4, 0xe2, 0x2e, 0x70, 0x00, 0x42, 0x04, 0xf8, 0x8a, 0x3f, 0xd3, 0xe4, 0xe9, 0xbd,
+		},
+		/* dp */ {
+			0x7c, 0x1a, 0x07, 0x06, 0x78, 0xc2, 0x5b, 0x9f, 0x0b, 0x97, 0xb4, 0xaa, 0xd8, 0x48, 0x77, 0x4f,
+			0xc8, 0xaa, 0x21, 0x22, 0xa5, 0x9f, 0xb2, 0x34, 0x6e, 0x8e, 0xdf, 0x7a, 0x28, 0xe0, 0x65, 0x0a,
+			0xdf, 0x6c, 0x3c, 0xdf, 0x60, 0xe5, 0xac, 0xc5, 0x6f, 0xf9, 0xe1, 0x01, 0x6b, 0x91, 0x5d, 0x0b,
+			0x25, 0x7b, 0x14, 0xca, 0xb2, 0xfc, 0x54, 0x14, 0x75, 0x28, 0x58, 0x21, 0xc1, 0x51, 0x1d, 0x5a,
+			0x8f, 0x46, 0x6e, 0x6c, 0xa7, 0xcf, 0x4e, 0x3d, 0x1e, 0xbc, 0x21, 0x37, 0x92, 0xab, 0x52, 0x5b,
+			0x58, 0x09, 0x53, 0x93, 0x80, 0x59, 0x3a, 0x69, 0x0f, 0x48, 0x8b, 0x2d, 0x6a, 0x2d, 0x32, 0xab,
+			0x2f, 0x64, 0xad, 0x2b, 0x87, 0xd9, 0x1e, 0x6e, 0x99, 0xa4, 0x66, 0x5f, 0x1f, 0x19, 0x61, 0xf0,
+			0xfe, 0x98, 0x14, 0x9d, 0xb9, 0xc7, 0x55, 0x88, 0x72, 0x12, 0xaa, 0xc4, 0xbb, 0x36, 0x7c, 0x41,
+		},
+		/* dq */ {
+			0x94, 0x5c, 0x3a, 0xbd, 0x52, 0x8e, 0xe1, 0xb9, 0x34, 0xe8, 0xab, 0xaf, 0xbe, 0x8a, 0x0a, 0xb7,
+			0xf1, 0x9d, 0x25, 0xcf, 0x63, 0x93, 0xc3, 0x16, 0xe2, 0xaf, 0x29, 0x9e, 0xfb, 0x7c, 0xfd, 0x95,
+			0xa8, 0x8a, 0xe8, 0x12, 0x81, 0x48, 0xf9, 0x7c, 0x6d, 0x2d, 0x52, 0x8b, 0xdc, 0x81, 0xf2, 0x81,
+			0xe3, 0x13, 0x69, 0x07, 0x42, 0x34, 0xc0, 0x54, 0xaa, 0xf9, 0xf7, 0x10, 0x22, 0x7c, 0x09, 0xe3,
+			0x72, 0x5f, 0x32, 0xb9, 0x32, 0xe7, 0x6c, 0x80, 0x81, 0xed, 0x4e, 0xab, 0x4a, 0xab, 0xf6, 0x82,
+			0xe7, 0x8d, 0x02, 0x82, 0xd8, 0x0f, 0x88, 0x3a, 0x17, 0x45, 0xbf, 0x15, 0xe9, 0x88, 0xfd, 0x61,
+			0x3c, 0xf8, 0x50, 0x77, 0x12, 0x9a, 0xdd, 0x0a, 0x5b, 0x83, 0x3a, 0x80, 0xef, 0x2d, 0xea, 0x17,
+			0xb3, 0xb5, 0x6b, 0xb3, 0x48, 0xbc, 0x2a, 0x6b, 0x5f, 0x2e, 0xb9, 0x1c, 0xa0, 0x79, 0x66, 0xc1,
+		},
+		/* qp */ {
+			0x9d, 0x89, 0x26, 0x5c, 0x52, 0x57, 0xfd, 0x5c, 0x22, 0x5a, 0x66, 0x6b, 0xec, 0x45, 0x38, 0xdd,
+			0x11, 0xc3, 0x31, 0xb8, 0xf7, 0xe6, 0x9a, 0x66, 0xf1, 0xb7, 0xe0, 0x96, 0xe3, 0x00, 0xd7, 0x6c,
+			0x67, 0x05, 0x23, 0x0a, 0x22, 0x12, 0x10, 0x99, 0x24, 0x46, 0x02, 0xf3, 0x70, 0x11, 0x8b, 0x0a,
+			0xf2, 0x94, 0xfb, 0x29, 0x65, 0x14, 0xca, 0xed, 0x67, 0x6e, 0x49, 0x7e, 0x1a, 0xc3, 0x6f, 0x67,
+			0x2b, 0x3b, 0x35, 0x1a, 0x6b, 0x34, 0xd2, 0x0c, 0x24, 0x44, 0x2b, 0x8a, 0xd1, 0x52, 0xf1, 0xd7,
+			0x2c, 0xa6, 0xcd, 0x6a, 0x09, 0x3c, 0x34, 0xdd, 0x20, 0xcc, 0xca, 0xcd, 0xbc, 0x88, 0x02, 0xbb,
+			0x14, 0xf5, 0x7d, 0xfd, 0x8f, 0xef, 0xa0, 0x48, 0x5d, 0xb2, 0x35, 0x7d, 0x22, 0x17, 0x46, 0xc2,
+			0xf8, 0xb8, 0x7d, 0x17, 0x1f, 0x3b, 0xfb, 0xf5, 0xa9, 0xc9, 0xdf, 0x77, 0x5a, 0xde, 0xea, 0x4e,
+		},
+	},
+};
+
+const PS4AuthVector PS4_AUTH_VECTORS[] = {
+	{
+		0,
+		/* nonce */ {
+			0x61, 0xda, 0x8e, 0x54, 0x92, 0xce, 0x7f, 0x7c, 0xf9, 0x68, 0xd4, 0xe0, 0x82, 0x59, 0x28, 0xce,
+			0x2a, 0x0a, 0x0b, 0xb5, 0xfd, 0x3a, 0xc2, 0x75, 0x17, 0x9e, 0xdd, 0x5e, 0xff, 0xf8, 0x5a, 0x5a,
+			0x14, 0xbb, 0xcc, 0xee, 0x52, 0x2b, 0xc5, 0xee, 0xd0, 0x00, 0x02, 0xa1, 0x43, 0xa0, 0xf3, 0x43,
+			0x75, 0x29, 0x06, 0x0c, 0xd3, 0xc9, 0xa4, 0x16, 0xfc, 0xe9, 0x2a, 0xe5, 0xd0, 0x3f, 0x9d, 0x49,
+			0x96, 0xa5, 0x16, 0x0e, 0x6a, 0x2a, 0xd1, 0xd6, 0xde, 0x82, 0x5b, 0x4e, 0x36, 0xf7, 0x54, 0x7e,
+			0x41, 0x99, 0xf0, 0xec, 0xfa, 0x16, 0x64, 0xfa, 0x00, 0x82, 0x0f, 0x79, 0x4c, 0xec, 0x8e, 0x94,
+			0xaa, 0x6f, 0xa7, 0x1b, 0x12, 0x94, 0xaa, 0xfb, 0xf3, 0x76, 0x8b, 0x38, 0xfb, 0x19, 0xd9, 0x0c,
+			0xba, 0x3b, 0xd4, 0x4b, 0xff, 0x33, 0xc6, 0xfa, 0x6f, 0x20, 0xcc, 0x12, 0xc5, 0x50, 0x06, 0xc3,
+			0x4b, 0xd1, 0x33, 0x4c, 0x31, 0x45, 0x62, 0x8f, 0xbb, 0xf8, 0x7f, 0x7f, 0x11, 0x76, 0x7e, 0x5c,
+			0xfc, 0x72, 0x75, 0xc6, 0xda, 0x6f, 0xd7, 0x9d, 0x27, 0xa5, 0xf2, 0x59, 0x0c, 0x2b, 0xe1, 0xf1,
+			0x35, 0x61, 0x1b, 0xa9, 0xe2, 0x2f, 0x21, 0xa6, 0xb9, 0x26, 0x03, 0xa8, 0xc0, 0x52, 0xd5, 0x02,
+			0xf9, 0x97, 0xd5, 0xb9, 0xe5, 0x58, 0x84, 0xf1, 0x3d, 0x42, 0xd8, 0x76, 0x5b, 0xad, 0x53, 0x78,
+			0xee, 0x98, 0xcd, 0x0f, 0xc7, 0x36, 0x12, 0x73, 0x76, 0x21, 0xa1, 0x46, 0x2a, 0x85, 0x84, 0x96,
+			0x83, 0x63, 0x0f, 0xc6, 0x95, 0xfc, 0x68, 0xe1, 0x29, 0x3e, 0x98, 0x8c, 0xe4, 0xd4, 0x9e, 0x19,
+			0x53, 0x77, 0x6e, 0xda, 0x77, 0xe3, 0xc5, 0x93, 0x11, 0xb2, 0xf8, 0x20, 0xae, 0x23, 0x72, 0x43,
+			0x1c, 0xb0, 0xd7, 0xb8, 0x72, 0x86, 0x55, 0x14, 0xcd, 0x52, 0x2a, 0x41, 0x8f, 0xf1, 0xa9, 0x71,
+		},
+		/* salt */ {
+			0x36, 0x67, 0x36, 0x98, 0x4d, 0x36, 0x6f, 0x63, 0x80, 0x28, 0x14, 0xa1, 0xf8, 0xde, 0x9a, 0xb2,
+			0xc2, 0x96, 0x2f, 0xae, 0x8a, 0x5f, 0xfa, 0x3e, 0x44, 0x04, 0x31, 0x10, 0xc9, 0x8c, 0x1e, 0x25,
+		},
+		/* signature */ {
+			0x27, 0x6e, 0x2d, 0x83, 0xea, 0x7c, 0xaa, 0xa7, 0xe1, 0xdb, 0xa3, 0x9a, 0xe4, 0xe2, 0x92, 0x5c,
+			0xe2, 0xec, 0xf2, 0x5a, 0xa1, 0xfa, 0x53, 0x33, 0x70, 0xcb, 0x5f, 0x65, 0xb3, 0xdd, 0xf2, 0x57,
+			0xec, 0x75, 0xde, 0x59, 0x61, 0x6e, 0x4e, 0x96, 0xf9, 0xdb, 0x4d, 0xef, 0xbf, 0x57, 0x2b, 0x4e,
+			0x62, 0x75, 0xb3, 0xd6, 0x02, 0x85, 0xe5, 0x4e, 0x1e, 0xe1, 0x77, 0xcd, 0xa8, 0x4a, 0x40, 0x4b,
+			0x21, 0xf9, 0x6f, 0xeb, 0xf3, 0x01, 0xea, 0xa5, 0x2d, 0x53, 0x59, 0x7f, 0xf0, 0x0b, 0x3f, 0x38,
+			0x3c, 0x9b, 0x8b, 0x44, 0xb7, 0x67, 0xa2, 0xd3, 0x2c, 0x65, 0xba, 0xa7, 0xda, 0xb8, 0x48, 0xed,
+			0xd5, 0xa3, 0xac, 0xcf, 0xb3, 0xd0, 0x96, 0xc6, 0x65, 0x32, 0x9a, 0xaa, 0x0e, 0xf8, 0x7e, 0x65,
+			0xc0, 0xec, 0x3b, 0x19, 0xf3, 0xf4, 0xd1, 0xde, 0x18, 0xa1, 0xd6, 0x92, 0x02, 0x82, 0x51, 0x01,
+			0xe6, 0x69, 0xbb, 0xd6, 0x00, 0x75, 0xf2, 0x4b, 0xb9, 0x17, 0x8d, 0xac, 0x52, 0x62, 0x3c, 0x67,
+			0xa4, 0x9a, 0xec, 0x2f, 0x27, 0x3e, 0x4b, 0xe9, 0x82, 0x77, 0x38, 0xf6, 0xf5, 0x7d, 0x0a, 0x85,
+			0x7d, 0x07, 0xb4, 0x68, 0xfe, 0x9c, 0x95, 0x5e, 0x19, 0x46, 0x68, 0x78, 0x6b, 0x69, 0x6e, 0x62,
+			0xcb, 0x80, 0x79, 0x00, 0x5c, 0xa2, 0x45, 0xf0, 0xbc, 0xfc, 0x04, 0xc1, 0x62, 0xf4, 0x12, 0xc7,
+			0xd2, 0x3a, 0x2e, 0x9e, 0xd6, 0x89, 0xce, 0x60, 0xc2, 0xa5, 0x4e, 0xa8, 0xd7, 0x67, 0x91, 0x13,
+			0x0d, 0x3b, 0x87, 0x2f, 0xa7, 0xdb, 0x20, 0xf3, 0x80, 0x24, 0xa4, 0xf3, 0x2c, 0x29, 0x56, 0xfd,
+			0x1e, 0x29, 0x69, 0x4a, 0x0c, 0xae, 0xe1, 0x6e, 0xa2, 0xb0, 0x48, 0x62, 0x2d, 0x2e, 0x37, 0x23,
+			0x52, 0x66, 0x43, 0xe9, 0x1c, 0x9d, 0x23, 0xfd, 0x03, 0xe1, 0x85, 0x8b, 0x69, 0xcc, 0xa2, 0xb2,
+		},
+	},
+	{
+		0,
+		/* nonce */ {
+			0x70, 0x0d, 0xae, 0xea, 0x18, 0x86, 0x93, 0xcb, 0x77, 0x83, 0x46, 0x5f, 0x24, 0x73, 0x27, 0xb5,
+			0xa1, 0x44, 0xef, 0x9a, 0x3a, 0x9d, 0x5e, 0xda, 0x88, 0x9e, 0x63, 0xd4, 0xf0, 0xf8, 0xfc, 0x9e,
+			0x6a, 0xef, 0x99, 0x90, 0xac, 0x84, 0x1f, 0xdf, 0x4f, 0xb7, 0xdc, 0x77, 0xf9, 0x63, 0xa6, 0xeb,
+			0x2c, 0x1b, 0x1b, 0x1e, 0xd7, 0xed, 0x72, 0x65, 0xab, 0x23, 0x4e, 0x87, 0x5c, 0x44, 0xa0, 0x08,
+			0xd5, 0x1a, 0xbc, 0x78, 0x59, 0x61, 0xd1, 0xec, 0xa2, 0x26, 0x8d, 0x7a, 0xef, 0x65, 0xdd, 0x4d,
+			0x31, 0xc0, 0x4f, 0xf0, 0x16, 0x89, 0xf9, 0xa6, 0x94, 0x9e, 0x91, 0xbe, 0xd1, 0xb2, 0xa6, 0xd0,
+			0x33, 0x95, 0x0a, 0x2a, 0xb2, 0x82, 0x69, 0x4f, 0x45, 0xff, 0xb4, 0x64, 0x9d, 0x6d, 0x78, 0x1f,
+			0xc4, 0x42, 0xfd, 0x01, 0xfa, 0x8c, 0xf0, 0x77, 0x91, 0x3e, 0x35, 0x07, 0x2b, 0x8e, 0x1f, 0xf7,
+			0x21, 0x62, 0xe8, 0x40, 0x42, 0xd6, 0xdc, 0x64, 0x30, 0xaa, 0x17, 0x84, 0x20, 0xd6, 0xc3, 0xad,
+			0x29, 0x81, 0x67, 0x0a, 0xde, 0xa3, 0x69, 0x53, 0xd6, 0x1e, 0x79, 0x09, 0x28, 0x78, 0x1c, 0xea,
+			0xde, 0x60, 0x50, 0xfb, 0xe6, 0x2f, 0x15, 0x6a, 0xbd, 0xdd, 0x29, 0x2e, 0xff, 0x8d, 0xa6, 0x47,
+			0xd9, 0x70, 0xa5, 0xc2, 0x66, 0x7e, 0xcc, 0x28, 0x2a, 0xc4, 0xbb, 0x8d, 0x85, 0x19, 0x59, 0x86,
+			0xae, 0x2d, 0xdb, 0x86, 0xa1, 0x2c, 0xd1, 0x16, 0x37, 0x87, 0xb4, 0x3f, 0x91, 0x94, 0xb4, 0xd3,
+			0x99, 0xa9, 0x8b, 0xab, 0x04, 0x95, 0x28, 0x52, 0x51, 0x7f, 0x9d, 0x09, 0xc9, 0x49, 0xaf, 0x12,
+			0xd0, 0x14, 0x66, 0x2c, 0x49, 0xf8, 0xaa, 0x0d, 0x20, 0xfe, 0x3f, 0xf1, 0xef, 0x62, 0x53, 0x52,
+			0xf6, 0x86, 0x54, 0x94, 0x87, 0x43, 0x56, 0xcd, 0x54, 0xfb, 0xf6, 0xdc, 0x6a, 0xba, 0xc5, 0x14,
+		},
+		/* salt */ {
+			0xd1, 0xbf, 0x0f, 0x03, 0xa9, 0x09, 0xa5, 0x62, 0xd2, 0x06, 0x94, 0x40, 0x5d, 0xff, 0x36, 0x86,
+			0x03, 0x5b, 0x68, 0xa6, 0x2b, 0x9a, 0x54, 0x9a, 0xb2, 0xad, 0x3c, 0x15, 0x58, 0x33, 0x6b, 0x22,
+		},
+		/* signature */ {
+			0x7b, 0x90, 0x8d, 0x07, 0x6c, 0x8b, 0x4a, 0x51, 0x01, 0xc1, 0x71, 0xe0, 0x00, 0x4a, 0xfe, 0x4e,
+			0xfb, 0x8b, 0xca, 0x7b, 0x12, 0x55, 0x3e, 0xeb, 0x22, 0x2d, 0x57, 0x1d, 0xeb, 0xf4, 0x0d, 0xba,
+			0x1f, 0x04, 0x62, 0x25, 0xa3, 0x8c, 0x09, 0x48, 0x0e, 0x09, 0x79, 0xd2, 0x2b, 0xb5, 0x31, 0xad,
+			0xd1, 0x15, 0x15, 0xce, 0x13, 0xdd, 0xbe, 0xe1, 0x0c, 0xb5, 0x37, 0x8d, 0x71, 0x68, 0x43, 0x73,
+			0x33, 0x60, 0xbf, 0x47, 0x5c, 0x75, 0x77, 0x85, 0x58, 0x43, 0x8f, 0xfd, 0x35, 0xf5, 0x8d, 0x13,
+			0x4d, 0x7e, 0x2c, 0x04, 0xf5, 0x6e, 0x83, 0xd3, 0xd2, 0x29, 0xe5, 0x31, 0xb3, 0xf2, 0x01, 0x21,
+			0xec, 0x81, 0x53, 0x56, 0x9d, 0x2c, 0xa7, 0x4b, 0xbb, 0x7f, 0xf4, 0x07, 0x48, 0x1b, 0x97, 0xd8,
+			0x4e, 0x5e, 0x3f, 0xd8, 0xd9, 0x8e, 0x4b, 0x7a, 0xf7, 0x2d, 0x4f, 0xe7, 0xa8, 0xe1, 0xd5, 0x71,
+			0x5b, 0x32, 0x8e, 0x92, 0x4d, 0x84, 0x38, 0xd8, 0x0a, 0x66, 0x10, 0x1e, 0x01, 0x58, 0xd5, 0x35,
+			0xad, 0xf6, 0xee, 0x38, 0x7d, 0xc5, 0x97, 0x59, 0x62, 0x0a, 0x89, 0x14, 0x58, 0x6b, 0x44, 0x8c,
+			0x37, 0x7a, 0x03, 0xbe, 0x4d, 0xeb, 0xe5, 0x64, 0x1b, 0xa8, 0x14, 0x1d, 0xee, 0x2b, 0x2a, 0x6f,
+			0x28, 0x19, 0xc4, 0xb5, 0x5f, 0x92, 0x5d, 0xa2, 0x09, 0x52, 0xfe, 0x88, 0x90, 0x21, 0x4e, 0x4d,
+			0x31, 0xaa, 0x9b, 0x1a, 0x54, 0xd0, 0xbb, 0x47, 0xb9, 0x8f, 0x2d, 0x5c, 0x2e, 0x19, 0xcd, 0x68,
+			0xda, 0x7c, 0x4b, 0xa3, 0x5f, 0xa3, 0xcc, 0xa1, 0xee, 0xea, 0xbb, 0xbf, 0x7b, 0x5f, 0x41, 0xd0,
+			0x55, 0x9e, 0xd8, 0x80, 0x63, 0x66, 0xa5, 0xcd, 0xb5, 0x67, 0x0e, 0xef, 0x8f, 0xe4, 0x35, 0xed,
+			0x47, 0xcb, 0xa3, 0x5b, 0x5c, 0x79, 0x0d, 0xbb, 0xab, 0x4c, 0x45, 0xff, 0x3f, 0x14, 0x37, 0x05,
+		},
+	},
+	{
+		1,
+		/* nonce */ {
+			0x1b, 0x77, 0xee, 0x93, 0x94, 0xc0, 0xfe, 0x37, 0xc2, 0x35, 0x33, 0x8c, 0x5e, 0x75, 0x0f, 0xaa,
+			0xdb, 0xef, 0xf8, 0x5b, 0xaf, 0xa1, 0x6c, 0xaf, 0x97, 0x12, 0x25, 0x45, 0xab, 0x3c, 0x15, 0x2c,
+			0x07, 0xf4, 0x28, 0xe5, 0x9e, 0xc9, 0x5c, 0xb3, 0x1f, 0xbc, 0xda, 0xb2, 0x40, 0xc0, 0xe0, 0x07,
+			0xef, 0x1a, 0x77, 0x64, 0x24, 0x2f, 0x95, 0xc3, 0x9d, 0x1f, 0x14, 0xb3, 0x8e, 0xa8, 0x76, 0x80,
+			0x00, 0x43, 0x4a, 0x59, 0xa7, 0x53, 0x85, 0xc8, 0x34, 0xed, 0xfc, 0x94, 0x2b, 0xdc, 0xfd, 0x57,
+			0x6e, 0x58, 0x70, 0x05, 0xdf, 0xaa, 0x90, 0x26, 0x72, 0xba, 0x9c, 0x0f, 0xf9, 0x4d, 0xcd, 0x86,
+			0x1a, 0x14, 0xcd, 0xdf, 0x40, 0xae, 0xa8, 0x48, 0xac, 0x4e, 0xaf, 0x45, 0x66, 0x5b, 0x87, 0xc9,
+			0xb2, 0x84, 0x1c, 0xdb, 0xf3, 0x60, 0x45, 0x7e, 0x4c, 0xfc, 0x4d, 0xb7, 0xb4, 0x09, 0x49, 0xaf,
+			0x8f, 0x54, 0x32, 0x16, 0x38, 0xf0, 0x2b, 0x27, 0x8b, 0x81, 0x02, 0x13, 0xd4, 0xf1, 0x3a, 0x82,
+			0x64, 0xb7, 0xf8, 0x81, 0x53, 0xfd, 0x2c, 0xe2, 0x48, 0x70, 0x6c, 0x95, 0x76, 0x5b, 0xdf, 0x55,
+			0x20, 0x22, 0xcb, 0xec, 0x60, 0xdd, 0x11, 0x47, 0xfe, 0xf8, 0xc7, 0x33, 0xa3, 0xcc, 0x24, 0x69,
+			0x4c, 0xee, 0xb2, 0x47, 0x65, 0x7a, 0x86, 0xb9, 0x50, 0xff, 0x55, 0xa0, 0xf8, 0xf4, 0x79, 0x95,
+			0xfc, 0x09, 0x75, 0xbe, 0xdd, 0x3b, 0xcf, 0xa6, 0x45, 0x00, 0x47, 0x3b, 0x54, 0x91, 0xa1, 0x35,
+			0x0e, 0x48, 0x56, 0x80, 0x80, 0xb9, 0x50, 0xa8, 0x73, 0x04, 0x62, 0x05, 0x38, 0xd2, 0x97, 0x34,
+			0x12, 0xaf, 0x76, 0xc4, 0xe2, 0xe6, 0xf0, 0xed, 0x11, 0xc2, 0xc1, 0xb4, 0xea, 0x41, 0x8b, 0xeb,
+			0xc8, 0x2c, 0xe9, 0x86, 0x30, 0x65, 0xdf, 0x5d, 0xf1, 0x0d, 0xac, 0x03, 0x45, 0x22, 0x11, 0x63,
+		},
+		/* salt */ {
+			0x94, 0x7d, 0x20, 0x46, 0x9b, 0x48, 0x34, 0x8f, 0x9e, 0x92, 0x74, 0x9e, 0x0e, 0xd2, 0x12, 0xa7,
+			0x53, 0xb2, 0x7a, 0x84, 0xbf, 0xd6, 0xfb, 0xab, 0xf5, 0x1f, 0x4d, 0xa1, 0x43, 0xd3, 0x91, 0x8b,
+		},
+		/* signature */ {
+			0x87, 0x5a, 0xea, 0xd7, 0x5d, 0x82, 0x79, 0xe7, 0x1d, 0xe3, 0x38, 0x3c, 0xf3, 0x40, 0xb8, 0xba,
+			0x83, 0x72, 0xee, 0xf9, 0xeb, 0x37, 0x56, 0xb1, 0x40, 0x6d, 0x80, 0xa5, 0x70, 0x13, 0x35, 0x70,
+			0x21, 0xef, 0x6b, 0xf8, 0x91, 0x24, 0xc9, 0xba, 0x79, 0x49, 0x62, 0xce, 0x0e, 0xc6, 0x8e, 0xcd,
+			0x10, 0x50, 0x36, 0xdb, 0x15, 0xe3, 0x50, 0xa5, 0x56, 0x6c, 0x89, 0xf9, 0x92, 0xe5, 0x02, 0x9c,
+			0x6b, 0x5c, 0xce, 0x06, 0x5a, 0xb7, 0x32, 0xf7, 0xa6, 0x30, 0x95, 0x04, 0x7f, 0x13, 0x2b, 0x53,
+			0xb1, 0xd2, 0x0c, 0x4b, 0xbb, 0xb4, 0x6e, 0x8e, 0x76, 0x87, 0x10, 0x39, 0x33, 0xfd, 0xda, 0xd3,
+			0xa1, 0xbc, 0x94, 0x77, 0xd2, 0xde, 0xd0, 0x2d, 0x1f, 0xc0, 0x9c, 0xae, 0x0d, 0xee, 0x07, 0x48,
+			0x67, 0x22, 0x4f, 0xe6, 0xcc, 0x4e, 0x4e, 0xc5, 0x1e, 0x50, 0x8c, 0x68, 0x69, 0xea, 0x0e, 0x36,
+			0x3c, 0x64, 0x55, 0x09, 0x15, 0xaa, 0x69, 0x22, 0x77, 0x53, 0x44, 0x27, 0xa3, 0x03, 0x15, 0x9b,
+			0xa4, 0x00, 0x97, 0xac, 0x67, 0x27, 0x0e, 0x97, 0xa6, 0x8f, 0x22, 0xdc, 0x6e, 0x4e, 0x1d, 0x8b,
+			0x10, 0x19, 0xac, 0xcb, 0xca, 0x3a, 0x5b, 0x03, 0x72, 0x0a, 0xbe, 0xdd, 0x0c, 0x5f, 0x8c, 0xa4,
+			0x86, 0xd4, 0x7e, 0x01, 0x69, 0xcb, 0xe5, 0xa3, 0xec, 0x2b, 0x83, 0x95, 0xab, 0x3b, 0x80, 0xb6,
+			0xe1, 0x9e, 0x77, 0xb0, 0x8f, 0x27, 0x0c, 0x50, 0xed, 0x74, 0xed, 0x29, 0x3e, 0x26, 0x93, 0x5c,
+			0x07, 0x22, 0x4c, 0x37, 0x2b, 0x8b, 0x5c, 0x8a, 0xcc, 0xd7, 0xbb, 0x36, 0xba, 0x71, 0x87, 0x65,
+			0x72, 0xd2, 0xea, 0x65, 0xa7, 0x2d, 0x71, 0xfd, 0x9a, 0x2f, 0x02, 0x96, 0xbb, 0x99, 0x7c, 0x24,
+			0xa0, 0xf0, 0xf1, 0xeb, 0x3c, 0x00, 0xa9, 0x08, 0x84, 0x7c, 0x70, 0x0c, 0xb9, 0x4d, 0xd0, 0x90,
+		},
+	},
+	{
+		1,
+		/* nonce */ {
+			0xdb, 0x1d, 0x4c, 0x6c, 0xfa, 0x7e, 0x18, 0xc3, 0x57, 0x45, 0xf9, 0x1f, 0x6e, 0xf9, 0x39, 0xc6,
+			0x93, 0x4e, 0x1a, 0x64, 0xf0, 0xcd, 0xab, 0xf2, 0x85, 0xe1, 0x36, 0x29, 0xd3, 0x29, 0xe1, 0x32,
+			0x2a, 0x01, 0xf2, 0x36, 0x29, 0x4c, 0x0f, 0xba, 0x9a, 0x44, 0x60, 0xf5, 0x8c, 0x48, 0xbc, 0x4c,
+			0x6d, 0x82, 0x59, 0x26, 0xb7, 0xde, 0x94, 0x62, 0x01, 0xbd, 0xe6, 0x08, 0x8b, 0x78, 0x82, 0x76,
+			0xc4, 0x55, 0x90, 0x7c, 0x3f, 0xc4, 0xcd, 0x52, 0x5e, 0x34, 0x9d, 0x2f, 0x7c, 0x1c, 0x9b, 0xed,
+			0x4c, 0x0f, 0x15, 0xd4, 0x87, 0xa2, 0xf8, 0x24, 0xee, 0x90, 0xc1, 0x1e, 0x9b, 0x0c, 0xdc, 0x72,
+			0x09, 0xbc, 0x02, 0x87, 0xba, 0xd2, 0xe7, 0x8a, 0x98, 0x9e, 0x9b, 0x5e, 0x19, 0x7b, 0xb8, 0x05,
+			0x9e, 0xf5, 0x69, 0x56, 0x44, 0xb1, 0x2d, 0xe7, 0x15, 0x8f, 0x96, 0x44, 0xa3, 0xba, 0x2c, 0x3c,
+			0xb0, 0x59, 0x0a, 0xec, 0x49, 0x79, 0xfb, 0xa8, 0xeb, 0x7e, 0x95, 0xb6, 0x90, 0x62, 0x3a, 0xd6,
+			0x43, 0x12, 0x7a, 0x47, 0xcf, 0xd8, 0xc5, 0x4f, 0x9f, 0xa9, 0xae, 0xad, 0x94, 0x2b, 0xd2, 0xcf,
+			0xa7, 0x2a, 0xe7, 0x8a, 0x7b, 0x21, 0xef, 0x47, 0x13, 0x10, 0xb7, 0xc8, 0x09, 0x83, 0xfb, 0xf9,
+			0xd4, 0x83, 0xd5, 0xfa, 0xd7, 0x84, 0x01, 0xe3, 0x99, 0x69, 0x7a, 0x1c, 0x35, 0xe3, 0x5c, 0x95,
+			0xa6, 0x2b, 0x18, 0xae, 0x5b, 0x05, 0xb0, 0xf1, 0xa0, 0xc6, 0x60, 0x07, 0x42, 0x1f, 0x8a, 0x38,
+			0x1c, 0x46, 0x24, 0x59, 0x5a, 0xe7, 0xab, 0xa7, 0x95, 0x7c, 0x6c, 0xbf, 0xa8, 0xab, 0x01, 0xdc,
+			0x7c, 0x38, 0xac, 0xac, 0x27, 0xab, 0x87, 0x79, 0x11, 0x3c, 0x38, 0x7f, 0xca, 0x20, 0x7b, 0x69,
+			0xa8, 0x15, 0xd5, 0x18, 0xc8, 0x63, 0x27, 0xfa, 0x8b, 0x7d, 0x11, 0x81, 0xdb, 0x91, 0xe7, 0x15,
+		},
+		/* salt */ {
+			0x2a, 0x94, 0x77, 0x94, 0xae, 0xd8, 0xf4, 0x41, 0xac, 0x87, 0x4e, 0xc7, 0x4f, 0x60, 0xde, 0x25,
+			0x3f, 0x9d, 0x1a, 0x52, 0x08, 0x32, 0x2a, 0xdd, 0x08, 0x13, 0x33, 0xf2, 0x9b, 0x20, 0x48, 0xb0,
+		},
+		/* signature */ {
+			0x86, 0x18, 0x21, 0x13, 0x2c, 0x01, 0x38, 0x85, 0xba, 0x70, 0x7b, 0x43, 0x63, 0xa0, 0x01, 0x59,
+			0x81, 0xb5, 0x80, 0x6f, 0x02, 0xd2, 0x33, 0x4f, 0xce, 0x46, 0xbb, 0xfe, 0x08, 0xa6, 0xfe, 0x44,
+			0xf2, 0xaf, 0x8b, 0x2e, 0xf1, 0x51, 0x65, 0xbd, 0x7e, 0xe4, 0x9b, 0x3e, 0xb5, 0x1a, 0x00, 0x24,
+			0x37, 0x6d, 0x66, 0x39, 0x4c, 0xd8, 0x4d, 0xbb, 0x2a, 0x04, 0x8c, 0x18, 0x72, 0x68, 0xc7, 0xfd,
+			0x13, 0x17, 0x55, 0x7a, 0x36, 0x33, 0x2b, 0x7b, 0x19, 0xf2, 0x49, 0xcb, 0xb4, 0xc3, 0x92, 0xf7,
+			0xa7, 0xdc, 0x12, 0x57, 0x40, 0x7f, 0xee, 0x7e, 0x88, 0xbd, 0xf9, 0x9c, 0xc6, 0xd6, 0xf2, 0x7d,
+			0x40, 0x77, 0x0c, 0xa5, 0x73, 0x15, 0x9b, 0x8d, 0x7f, 0xce, 0x56, 0x41, 0xa5, 0x7d, 0x30, 0x8e,
+			0xbd, 0x85, 0xe8, 0x34, 0x01, 0x7f, 0x83, 0x4a, 0xf3, 0x9c, 0x06, 0xd2, 0xbf, 0x77, 0x05, 0xc0,
+			0x48, 0xfa, 0x28, 0xe1, 0x78, 0x9f, 0xe9, 0xc9, 0xe9, 0x02, 0xba, 0xd2, 0xdf, 0x3d, 0x10, 0x85,
+			0x19, 0x2d, 0xb3, 0x3e, 0xf9, 0x9f, 0xe7, 0x27, 0x59, 0x61, 0xd7, 0xe9, 0xd0, 0x59, 0x3c, 0xf7,
+			0x6b, 0x66, 0x12, 0xa4, 0x87, 0x75, 0xbe, 0xe0, 0xfd, 0x60, 0xa0, 0xb9, 0xfe, 0xe5, 0xf2, 0xa7,
+			0xcf, 0xb8, 0x63, 0xc4, 0xf7, 0xa3, 0x6a, 0xc3, 0x3a, 0x5e, 0xaf, 0xb4, 0x3d, 0xad, 0x22, 0x03,
+			0x8f, 0x93, 0xb1, 0x92, 0x30, 0xde, 0xac, 0x63, 0xf9, 0x0e, 0xe7, 0xfa, 0xbe, 0xf5, 0x27, 0x96,
+			0xd0, 0x30, 0xba, 0x11, 0x17, 0x25, 0x2c, 0xa7, 0x82, 0xbf, 0x96, 0x87, 0x4a, 0x1a, 0xd1, 0xb6,
+			0xba, 0x3f, 0x8e, 0x09, 0x28, 0xbb, 0x68, 0xf2, 0xd6, 0xd7, 0x34, 0x91, 0x48, 0x58, 0xc5, 0xd2,
+			0x2d, 0x41, 0x3f, 0x88, 0xf7, 0xec, 0x06, 0x44, 0x60, 0xf1, 0x82, 0x6c, 0x96, 0xc0, 0x4c, 0x3b,
+		},
+	},
+};
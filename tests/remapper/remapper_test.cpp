@@ -0,0 +1,245 @@
+// Checks GamepadRemapper's compiled tables against a per-bit reference of its rules and layers
+
+#include <map>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gamepad/GamepadRemapper.h"
+
+static int failures = 0;
+
+#define CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+			failures++; \
+		} \
+	} while (0)
+
+// Walks every pressed source and resolves its target through the layers, as the rules are documented
+struct ReferenceRemapper
+{
+	uint32_t rules[REMAP_SOURCE_COUNT] {};
+	std::map<uint8_t, uint32_t> overrides[REMAP_MAX_LAYERS];
+	uint8_t triggers[REMAP_MAX_LAYERS] { REMAP_NO_SOURCE, REMAP_NO_SOURCE, REMAP_NO_SOURCE, REMAP_NO_SOURCE };
+	uint8_t layerCount = 1;
+	uint8_t selected = REMAP_BASE_LAYER;
+
+	uint32_t target(uint8_t layer, uint8_t source) const
+	{
+		const auto found = overrides[layer].find(source);
+		if (found != overrides[layer].end())
+			return found->second;
+		if (triggers[layer] != REMAP_NO_SOURCE)
+			return target(selected, source);
+		return rules[source];
+	}
+
+	uint32_t apply(uint64_t sources) const
+	{
+		uint8_t layer = selected;
+		for (uint8_t i = layerCount - 1; i > REMAP_BASE_LAYER; i--)
+		{
+			if (triggers[i] != REMAP_NO_SOURCE && (sources & (1ULL << triggers[i])))
+			{
+				layer = i;
+				break;
+			}
+		}
+
+		uint32_t mapped = 0;
+		for (uint8_t source = 0; source < REMAP_SOURCE_COUNT; source++)
+			if (sources & (1ULL << source))
+				mapped |= target(layer, source);
+		return mapped;
+	}
+};
+
+// Reverse held while a board layer is selected keeps the board layer's remap of the other buttons
+static void checkTriggerStacksOnSelected()
+{
+	GamepadRemapper remapper;
+	remapper.addRule(2, GAMEPAD_MASK_DU);
+	remapper.addRule(3, GAMEPAD_MASK_DD);
+	remapper.addRule(4, GAMEPAD_MASK_B1);
+	remapper.addRule(5, GAMEPAD_MASK_B2);
+
+	const uint8_t board = remapper.addLayer();
+	remapper.setOverride(board, 4, GAMEPAD_MASK_B3);
+
+	const uint8_t reverse = remapper.addLayer(20);
+	remapper.setOverride(reverse, 2, GAMEPAD_MASK_DD);
+	remapper.setOverride(reverse, 3, GAMEPAD_MASK_DU);
+
+	const uint64_t held = (1ULL << 2) | (1ULL << 4) | (1ULL << 20);
+	CHECK(remapper.apply(held) == (GAMEPAD_MASK_DD | GAMEPAD_MASK_B1));
+	CHECK(remapper.getActiveLayer() == reverse);
+
+	remapper.selectLayer(board);
+	CHECK(remapper.apply(held) == (GAMEPAD_MASK_DD | GAMEPAD_MASK_B3));
+	CHECK(remapper.getActiveLayer() == reverse);
+	CHECK(remapper.apply(1ULL << 4) == GAMEPAD_MASK_B3);
+	CHECK(remapper.getActiveLayer() == board);
+
+	// Trigger layers can't be selected, and selecting the base layer again drops the board remap
+	remapper.selectLayer(reverse);
+	CHECK(remapper.getSelectedLayer() == board);
+	remapper.nextLayer();
+	CHECK(remapper.getSelectedLayer() == REMAP_BASE_LAYER);
+	CHECK(remapper.apply(held) == (GAMEPAD_MASK_DD | GAMEPAD_MASK_B1));
+
+	// A trigger layer added while a board layer is selected starts out on it too
+	GamepadRemapper late;
+	late.addRule(4, GAMEPAD_MASK_B1);
+	const uint8_t lateBoard = late.addLayer();
+	late.setOverride(lateBoard, 4, GAMEPAD_MASK_B3);
+	late.selectLayer(lateBoard);
+	late.addLayer(20);
+	CHECK(late.apply((1ULL << 4) | (1ULL << 20)) == GAMEPAD_MASK_B3);
+}
+
+// Reverse's "Neutral" action overrides a direction with nothing
+static void checkDisabledSource()
+{
+	GamepadRemapper remapper;
+	remapper.addRule(2, GAMEPAD_MASK_DL);
+	remapper.addRule(3, GAMEPAD_MASK_DR);
+	const uint8_t reverse = remapper.addLayer(9);
+	remapper.setOverride(reverse, 2, 0);
+
+	CHECK(remapper.apply(1ULL << 2) == GAMEPAD_MASK_DL);
+	CHECK(remapper.apply((1ULL << 2) | (1ULL << 9)) == 0);
+	CHECK(remapper.apply((1ULL << 2) | (1ULL << 3) | (1ULL << 9)) == GAMEPAD_MASK_DR);
+
+	// Overriding a source without a base rule maps it only in the layer
+	remapper.setOverride(reverse, 7, GAMEPAD_MASK_B4);
+	CHECK(remapper.apply(1ULL << 7) == 0);
+	CHECK(remapper.apply((1ULL << 7) | (1ULL << 9)) == GAMEPAD_MASK_B4);
+}
+
+// With a button matrix the keys take the low 32 sources and the raw pins the upper 32, as Gamepad::mapInputs feeds them
+static void checkMatrixAndPins()
+{
+	GamepadRemapper remapper;
+	remapper.addRule(0, GAMEPAD_MASK_B1);
+	remapper.addRule(31, GAMEPAD_MASK_B2);
+	remapper.addRule(32 + 6, GAMEPAD_MASK_S1);   // An add-on button on GPIO 6
+	remapper.addRule(32 + 29, GAMEPAD_MASK_A1);
+	const uint8_t reverse = remapper.addLayer(32 + 22);
+	remapper.setOverride(reverse, 31, GAMEPAD_MASK_B3);
+	remapper.setOverride(reverse, 32 + 29, GAMEPAD_MASK_A2);
+
+	const uint32_t keys = (1u << 0) | (1u << 31);
+	const uint32_t pins = (1u << 6) | (1u << 29);
+	const uint64_t sources = keys | (static_cast<uint64_t>(pins) << 32);
+	CHECK(remapper.apply(sources) == (GAMEPAD_MASK_B1 | GAMEPAD_MASK_B2 | GAMEPAD_MASK_S1 | GAMEPAD_MASK_A1));
+	CHECK(remapper.apply(sources | (1ULL << (32 + 22))) == (GAMEPAD_MASK_B1 | GAMEPAD_MASK_B3 | GAMEPAD_MASK_S1 | GAMEPAD_MASK_A2));
+
+	// The same pin number as a key and as a raw pin are separate sources
+	CHECK(remapper.apply(1ULL << 6) == 0);
+	CHECK(remapper.apply(1ULL << 38) == GAMEPAD_MASK_S1);
+
+	// Sources past the 64 bits are ignored
+	remapper.addRule(REMAP_SOURCE_COUNT, GAMEPAD_MASK_B4);
+	CHECK(remapper.addLayer(REMAP_SOURCE_COUNT) != REMAP_NO_LAYER);
+	CHECK(remapper.apply(~0ULL) & GAMEPAD_MASK_B1);
+	CHECK(!(remapper.apply(~0ULL) & GAMEPAD_MASK_B4));
+}
+
+// Random rule sets and layer changes, compared with the reference after every change
+static void checkRandom()
+{
+	uint32_t seed = 2040;
+	auto next = [&seed]() {
+		seed = seed * 1664525 + 1013904223;
+		return seed >> 8;
+	};
+	auto randomSources = [&next]() {
+		const uint64_t sources = (static_cast<uint64_t>(next()) << 40) ^ (static_cast<uint64_t>(next()) << 20) ^ next();
+		return sources & ((static_cast<uint64_t>(next()) << 40) | (static_cast<uint64_t>(next()) << 20) | next());
+	};
+
+	long frames = 0;
+	long mismatches = 0;
+	for (int round = 0; round < 2000; round++)
+	{
+		GamepadRemapper remapper;
+		ReferenceRemapper reference;
+		for (int change = 0; change < 60; change++)
+		{
+			switch (next() % 10)
+			{
+				case 0: case 1: case 2: case 3:
+				{
+					const uint8_t source = next() % REMAP_SOURCE_COUNT;
+					const uint32_t target = 1u << (next() % 20);
+					remapper.addRule(source, target);
+					reference.rules[source] |= target;
+					break;
+				}
+				case 4: case 5:
+				{
+					const uint8_t layer = next() % REMAP_MAX_LAYERS;
+					const uint8_t source = next() % REMAP_SOURCE_COUNT;
+					const uint32_t target = (next() % 3) ? 1u << (next() % 20) : 0;
+					remapper.setOverride(layer, source, target);
+					if (layer != REMAP_BASE_LAYER && layer < reference.layerCount)
+						reference.overrides[layer][source] = target;
+					break;
+				}
+				case 6:
+				{
+					const uint8_t trigger = (next() % 2) ? next() % REMAP_SOURCE_COUNT : REMAP_NO_SOURCE;
+					remapper.addLayer(trigger);
+					if (reference.layerCount < REMAP_MAX_LAYERS)
+						reference.triggers[reference.layerCount++] = trigger;
+					break;
+				}
+				case 7:
+				{
+					const uint8_t layer = next() % REMAP_MAX_LAYERS;
+					remapper.selectLayer(layer);
+					if (layer < reference.layerCount && reference.triggers[layer] == REMAP_NO_SOURCE)
+						reference.selected = layer;
+					break;
+				}
+				case 8:
+				{
+					remapper.nextLayer();
+					uint8_t layer = reference.selected;
+					do
+						layer = (layer + 1) % reference.layerCount;
+					while (reference.triggers[layer] != REMAP_NO_SOURCE);
+					reference.selected = layer;
+					break;
+				}
+			}
+
+			for (int frame = 0; frame < 20; frame++, frames++)
+			{
+				const uint64_t sources = randomSources();
+				if (remapper.apply(sources) != reference.apply(sources))
+					mismatches++;
+			}
+			CHECK(remapper.getSelectedLayer() == reference.selected);
+		}
+	}
+	CHECK(mismatches == 0);
+	printf("%ld random frames, %ld mismatches\n", frames, mismatches);
+}
+
+int main()
+{
+	checkTriggerStacksOnSelected();
+	checkDisabledSource();
+	checkMatrixAndPins();
+	checkRandom();
+
+	if (failures)
+	{
+		printf("%d checks failed\n", failures);
+		return 1;
+	}
+	printf("all checks passed\n");
+	return 0;
+}
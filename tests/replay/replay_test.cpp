@@ -0,0 +1,269 @@
+// Replays input traces through Gamepad::read, debounce and process, with the SOCD cleaner and the remapper,
+// the way a gamepad boot replays an uploaded trace. The add-ons are not built for the host.
+//
+//   replay_test                                      records sessions and checks their replays
+//   replay_test [--flash settings.bin] trace.bin...  replays traces downloaded from web config with the saved options
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+
+#include "gamepad.h"
+#include "inputrecorder.h"
+#include "storagemanager.h"
+
+#include "firmware_host.h"
+
+#define REPLAY_DEBOUNCE_MILLIS 5 // GAMEPAD_DEBOUNCE_MILLIS of gp2040.cpp
+#define SESSION_START 1000000    // Recordings start a second after boot, past the debouncer's first interval
+
+// Pins of configs/Pico
+#define PIN_RIGHT 4
+#define PIN_LEFT 5
+#define PIN_B1 6
+
+static int failures = 0;
+
+#define CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+			failures++; \
+		} \
+	} while (0)
+
+static Gamepad* gamepad = nullptr;
+
+// A new gamepad set up from the saved options, like the one a boot starts with
+static void bootGamepad()
+{
+	gamepad = new Gamepad(REPLAY_DEBOUNCE_MILLIS);
+	Storage::getInstance().SetGamepad(gamepad);
+	gamepad->setup();
+}
+
+// One frame of GP2040::run up to the trace capture, without the hotkeys and add-ons
+static void runFrame()
+{
+	InputRecorder& inputRecorder = InputRecorder::getInstance();
+	if (inputRecorder.isReplaying())
+		inputRecorder.replay(gamepad);
+	else
+		gamepad->read();
+	gamepad->debounce();
+	gamepad->process();
+	inputRecorder.capture(gamepad->gpio, gamepad->state);
+}
+
+// Runs the replay that InputRecorder::begin started to its end, returns false if it never finishes
+static bool runReplay()
+{
+	const uint32_t frames = InputRecorder::getInstance().getEntryCount();
+	for (uint32_t frame = 0; frame < frames && InputRecorder::getInstance().isReplaying(); frame++)
+		runFrame();
+	return !InputRecorder::getInstance().isReplaying();
+}
+
+struct SessionStep
+{
+	uint32_t ms;      // Since the start of the session
+	uint32_t pressed; // Pins held from then on
+};
+
+// A bouncing B1, then Left held while Right is pressed, which the SOCD modes resolve differently
+static const SessionStep session[] = {
+	{ 10, 1 << PIN_B1 },
+	{ 12, 0 },
+	{ 13, 1 << PIN_B1 },
+	{ 30, 0 },
+	{ 40, 1 << PIN_LEFT },
+	{ 60, (1 << PIN_LEFT) | (1 << PIN_RIGHT) },
+	{ 80, 1 << PIN_RIGHT },
+	{ 100, 0 },
+};
+
+// Samples the session once a millisecond like a recording gamepad boot, returns the downloaded trace
+static std::vector<uint8_t> recordSession()
+{
+	bootGamepad();
+	InputRecorder::getInstance().begin();
+
+	const SessionStep* step = session;
+	const SessionStep* end = session + sizeof(session) / sizeof(*session);
+	for (uint32_t ms = 0; ms <= end[-1].ms + 20; ms++)
+	{
+		if (step != end && step->ms == ms)
+			host_set_pressed((step++)->pressed);
+		host_set_time(SESSION_START + ms * 1000ull);
+		runFrame();
+	}
+
+	std::vector<uint8_t> trace(INPUT_TRACE_MAX_SIZE);
+	trace.resize(InputRecorder::getInstance().exportTrace(trace.data(), trace.size()));
+	return trace;
+}
+
+static const InputTraceEntry& traceEntry(const std::vector<uint8_t>& trace, uint32_t index)
+{
+	return reinterpret_cast<const InputTraceEntry*>(trace.data() + sizeof(InputTraceHeader))[index];
+}
+
+static uint32_t traceCount(const std::vector<uint8_t>& trace)
+{
+	return (trace.size() - sizeof(InputTraceHeader)) / sizeof(InputTraceEntry);
+}
+
+// The recording holds the remapped B1 once it settled, and Left and Right cancelled by the default neutral SOCD
+static void checkRecording(const std::vector<uint8_t>& trace)
+{
+	CHECK(trace.size() > sizeof(InputTraceHeader));
+
+	bool sawB1 = false;
+	bool sawBoth = false;
+	for (uint32_t index = 0; index < traceCount(trace); index++)
+	{
+		const InputTraceEntry& entry = traceEntry(trace, index);
+		sawB1 |= entry.pressed == (1u << PIN_B1) && entry.buttons == GAMEPAD_MASK_B1;
+		if (entry.pressed == ((1u << PIN_LEFT) | (1u << PIN_RIGHT)))
+		{
+			sawBoth = true;
+			CHECK((entry.dpad & (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT)) == 0);
+		}
+	}
+	CHECK(sawB1);
+	CHECK(sawBoth);
+}
+
+// The replay runs back to back while the real clock stands still, the debouncer only passes the recorded
+// changes on the recorded clock. Core1 keeps reading the real clock meanwhile.
+static void checkReplay(const std::vector<uint8_t>& trace)
+{
+	const uint64_t wallTime = 50000000;
+	host_set_time(wallTime);
+
+	bootGamepad();
+	CHECK(InputRecorder::getInstance().importTrace(trace.data(), trace.size()));
+	InputRecorder::getInstance().begin();
+	CHECK(InputRecorder::getInstance().isReplaying());
+
+	CHECK(getMicro() == traceEntry(trace, 0).time);
+	host_set_core(1);
+	CHECK(getMicro() == wallTime);
+	host_set_core(0);
+
+	CHECK(runReplay());
+	CHECK(getMicro() == wallTime);
+	CHECK(host_reboot_mode() == System::BootMode::WEBCONFIG);
+
+	const InputReplayResult* result = InputRecorder::getInstance().getReplayResult();
+	CHECK(result != nullptr);
+	if (result)
+	{
+		CHECK(result->frames == traceCount(trace));
+		CHECK(result->mismatches == 0);
+	}
+}
+
+// Replayed with another SOCD mode than it was recorded with, the first frame with both directions differs
+static void checkSOCDMismatch(const std::vector<uint8_t>& trace)
+{
+	bootGamepad();
+	gamepad->options.socdMode = SOCD_MODE_SECOND_INPUT_PRIORITY;
+	CHECK(InputRecorder::getInstance().importTrace(trace.data(), trace.size()));
+	InputRecorder::getInstance().begin();
+	CHECK(runReplay());
+
+	const InputReplayResult* result = InputRecorder::getInstance().getReplayResult();
+	CHECK(result != nullptr);
+	if (result)
+	{
+		CHECK(result->mismatches > 0);
+		CHECK(traceEntry(trace, result->firstMismatch).pressed == ((1u << PIN_LEFT) | (1u << PIN_RIGHT)));
+		CHECK(result->expectedDpad == 0);
+		CHECK(result->actualDpad == GAMEPAD_MASK_RIGHT);
+		CHECK(result->expectedButtons == result->actualButtons);
+	}
+}
+
+// A broken trace is refused and leaves nothing to replay
+static void checkInvalidTrace(std::vector<uint8_t> trace)
+{
+	trace.pop_back();
+	CHECK(!InputRecorder::getInstance().importTrace(trace.data(), trace.size()));
+	InputRecorder::getInstance().begin();
+	CHECK(!InputRecorder::getInstance().isReplaying());
+}
+
+static bool replayFile(const char* path)
+{
+	std::vector<uint8_t> trace(INPUT_TRACE_MAX_SIZE + 1);
+	FILE* file = fopen(path, "rb");
+	if (!file)
+	{
+		printf("%s: cannot open\n", path);
+		return false;
+	}
+	trace.resize(fread(trace.data(), 1, trace.size(), file));
+	fclose(file);
+
+	bootGamepad();
+	if (!InputRecorder::getInstance().importTrace(trace.data(), trace.size()))
+	{
+		printf("%s: not an input trace\n", path);
+		return false;
+	}
+	InputRecorder::getInstance().begin();
+	runReplay();
+
+	const InputReplayResult* result = InputRecorder::getInstance().getReplayResult();
+	printf("%s: %u frames, %u mismatches", path, result->frames, result->mismatches);
+	if (InputRecorder::getInstance().getDroppedCount() > 0)
+		printf(", %u entries dropped before the first", InputRecorder::getInstance().getDroppedCount());
+	if (result->mismatches > 0)
+		printf(", first at entry %u: buttons %04x dpad %x aux %04x, expected %04x %x %04x", result->firstMismatch,
+			result->actualButtons, result->actualDpad, result->actualAux,
+			result->expectedButtons, result->expectedDpad, result->expectedAux);
+	printf("\n");
+	return result->mismatches == 0;
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<const char*> traces;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--flash") == 0 && i + 1 < argc)
+			host_flash_open(argv[++i]);
+		else if (argv[i][0] != '-')
+			traces.push_back(argv[i]);
+		else
+		{
+			printf("usage: %s [--flash settings.bin] [trace.bin...]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	if (!traces.empty())
+	{
+		bool matched = true;
+		for (const char* path : traces)
+			matched &= replayFile(path);
+		return matched ? 0 : 1;
+	}
+
+	const std::vector<uint8_t> trace = recordSession();
+	checkRecording(trace);
+	checkReplay(trace);
+	checkSOCDMismatch(trace);
+	checkInvalidTrace(trace);
+
+	if (failures)
+	{
+		printf("%d checks failed\n", failures);
+		return 1;
+	}
+	printf("all checks passed\n");
+	return 0;
+}
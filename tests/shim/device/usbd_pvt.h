@@ -0,0 +1,16 @@
+// Host stand-in for TinyUSB's device/usbd_pvt.h
+
+#pragma once
+
+#include "tusb.h"
+
+typedef struct
+{
+	char const *name;
+	void (*init)(void);
+	void (*reset)(uint8_t rhport);
+	uint16_t (*open)(uint8_t rhport, tusb_desc_interface_t const *desc_intf, uint16_t max_len);
+	bool (*control_xfer_cb)(uint8_t rhport, uint8_t stage, tusb_control_request_t const *request);
+	bool (*xfer_cb)(uint8_t rhport, uint8_t ep_addr, xfer_result_t result, uint32_t xferred_bytes);
+	void (*sof)(uint8_t rhport);
+} usbd_class_driver_t;
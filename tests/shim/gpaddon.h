@@ -0,0 +1,15 @@
+// Host stand-in for gpaddon.h without the gamepad and its hardware
+
+#pragma once
+
+#include <string>
+
+class GPAddon
+{
+public:
+	virtual bool available() = 0;
+	virtual void setup() = 0;
+	virtual void process() = 0;
+	virtual void preprocess() = 0;
+	virtual std::string name() = 0;
+};
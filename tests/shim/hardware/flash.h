@@ -0,0 +1,8 @@
+// Host stand-in for hardware/flash.h
+
+#pragma once
+
+#include "pico/types.h"
+
+#define FLASH_PAGE_SIZE (1u << 8)
+#define FLASH_SECTOR_SIZE (1u << 12)
@@ -0,0 +1,14 @@
+// Host stand-in for hardware/gpio.h, setup calls do nothing and the target defines what the pins read
+
+#pragma once
+
+#include "pico/types.h"
+
+#define GPIO_IN false
+#define GPIO_OUT true
+
+static inline void gpio_init(uint gpio) {}
+static inline void gpio_set_dir(uint gpio, bool out) {}
+static inline void gpio_pull_up(uint gpio) {}
+
+uint32_t gpio_get_all(void);
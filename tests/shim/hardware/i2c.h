@@ -0,0 +1,10 @@
+// Host stand-in for hardware/i2c.h, only the instance type that headers hold on to
+
+#pragma once
+
+#include "pico/types.h"
+
+typedef struct i2c_inst i2c_inst_t;
+
+#define i2c0 ((i2c_inst_t *)0)
+#define i2c1 ((i2c_inst_t *)1)
@@ -0,0 +1,9 @@
+// Host stand-in for hardware/pio.h, only the types that headers hold on to
+
+#pragma once
+
+typedef struct pio_hw pio_hw_t;
+typedef pio_hw_t *PIO;
+
+#define pio0 ((PIO)0)
+#define pio1 ((PIO)1)
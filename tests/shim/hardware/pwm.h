@@ -0,0 +1,5 @@
+// Host stand-in for hardware/pwm.h
+
+#pragma once
+
+#include "pico/types.h"
@@ -0,0 +1,7 @@
+// Host stand-in for hardware/spi.h, only the instance type that headers hold on to
+
+#pragma once
+
+#include "pico/types.h"
+
+typedef struct spi_inst spi_inst_t;
@@ -0,0 +1,7 @@
+// Host stand-in for hardware/timer.h, a microsecond clock that wraps like the RP2040 timer
+
+#pragma once
+
+#include <stdint.h>
+
+uint32_t time_us_32(void);
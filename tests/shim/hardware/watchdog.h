@@ -0,0 +1,9 @@
+// Host stand-in for hardware/watchdog.h, a reboot ends the host process
+
+#pragma once
+
+#include "pico/types.h"
+
+#define SRAM_END _u(0x20042000)
+
+void watchdog_reboot(uint32_t pc, uint32_t sp, uint32_t delay_ms);
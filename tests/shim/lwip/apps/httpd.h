@@ -0,0 +1,22 @@
+// Host stand-in for lwip/apps/httpd.h, the POST callbacks the application implements
+
+#pragma once
+
+#include "lwip/err.h"
+#include "lwip/pbuf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void httpd_init(void);
+
+err_t httpd_post_begin(void *connection, const char *uri, const char *http_request,
+	u16_t http_request_len, int content_len, char *response_uri,
+	u16_t response_uri_len, u8_t *post_auto_wnd);
+err_t httpd_post_receive_data(void *connection, struct pbuf *p);
+void httpd_post_finished(void *connection, char *response_uri, u16_t response_uri_len);
+
+#ifdef __cplusplus
+}
+#endif
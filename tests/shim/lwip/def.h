@@ -0,0 +1,8 @@
+// Host stand-in for lwip/def.h
+
+#pragma once
+
+#include "lwip/opt.h"
+
+#define LWIP_MAX(x, y) (((x) > (y)) ? (x) : (y))
+#define LWIP_MIN(x, y) (((x) < (y)) ? (x) : (y))
@@ -0,0 +1,13 @@
+// Host stand-in for lwip/err.h
+
+#pragma once
+
+#include "lwip/opt.h"
+
+typedef s8_t err_t;
+
+#define ERR_OK    0
+#define ERR_MEM  -1
+#define ERR_BUF  -2
+#define ERR_VAL  -6
+#define ERR_ARG -16
@@ -0,0 +1,10 @@
+// Host stand-in for lwip/mem.h, the heap is the host's
+
+#pragma once
+
+#include <stdlib.h>
+
+#include "lwip/opt.h"
+
+static inline void *mem_malloc(size_t size) { return malloc(size); }
+static inline void mem_free(void *mem) { free(mem); }
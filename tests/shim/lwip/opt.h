@@ -0,0 +1,19 @@
+// Host stand-in for lwip/opt.h, takes the httpd options from the firmware's lwipopts.h
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lwipopts.h"
+
+typedef uint8_t u8_t;
+typedef int8_t s8_t;
+typedef uint16_t u16_t;
+typedef int16_t s16_t;
+typedef uint32_t u32_t;
+typedef int32_t s32_t;
+
+#define LWIP_UNUSED_ARG(x) (void)x
+#define MEMCPY(dst, src, len) memcpy(dst, src, len)
@@ -0,0 +1,15 @@
+// Host stand-in for lwip/pbuf.h, the host server hands received data over as a chain like lwIP does
+
+#pragma once
+
+#include "lwip/opt.h"
+
+struct pbuf
+{
+	struct pbuf *next;
+	void *payload;
+	u16_t tot_len;
+	u16_t len;
+};
+
+u8_t pbuf_free(struct pbuf *p);
@@ -0,0 +1,24 @@
+// Host stand-in for the parts of mbedtls/bignum.h the firmware uses, limbs are 32 bit like on the RP2040
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef uint32_t mbedtls_mpi_uint;
+
+typedef struct mbedtls_mpi {
+	int s;
+	size_t n;
+	mbedtls_mpi_uint *p;
+} mbedtls_mpi;
+
+// Big endian export, zero padded to buflen
+static inline int mbedtls_mpi_write_binary(const mbedtls_mpi *X, unsigned char *buf, size_t buflen)
+{
+	for (size_t i = 0; i < buflen; i++) {
+		const size_t byte = buflen - 1 - i;
+		buf[i] = byte / 4 < X->n ? static_cast<unsigned char>(X->p[byte / 4] >> ((byte % 4) * 8)) : 0;
+	}
+	return 0;
+}
@@ -0,0 +1,5 @@
+// Host stand-in for mbedtls/rsa.h, the stored PS4 key is only held as bignum limbs
+
+#pragma once
+
+#include "mbedtls/bignum.h"
@@ -0,0 +1,5 @@
+// Host stand-in for pico/lock_core.h
+
+#pragma once
+
+#include "pico/types.h"
@@ -0,0 +1,5 @@
+// Host stand-in for pico/multicore.h
+
+#pragma once
+
+#include "pico/types.h"
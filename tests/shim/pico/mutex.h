@@ -0,0 +1,12 @@
+// Host stand-in for pico/mutex.h, the host server runs on a single thread
+
+#pragma once
+
+#include "pico/types.h"
+
+typedef struct { int owner; } mutex_t;
+
+static inline void mutex_init(mutex_t *mtx) {}
+static inline void mutex_enter_blocking(mutex_t *mtx) {}
+static inline bool mutex_try_enter(mutex_t *mtx, uint32_t *owner_out) { return true; }
+static inline void mutex_exit(mutex_t *mtx) {}
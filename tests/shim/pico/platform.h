@@ -0,0 +1,12 @@
+// Host stand-in for pico/platform.h, the target defines which core the caller runs on
+
+#pragma once
+
+#include "pico/types.h"
+
+#define __not_in_flash_func(name) name
+#define __uninitialized_ram(name) name
+
+static inline void tight_loop_contents(void) {}
+
+uint get_core_num(void);
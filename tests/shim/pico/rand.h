@@ -0,0 +1,7 @@
+// Host stand-in for pico/rand.h, the harness decides which bytes come out
+
+#pragma once
+
+#include <stdint.h>
+
+uint32_t get_rand_32(void);
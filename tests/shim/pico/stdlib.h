@@ -0,0 +1,10 @@
+// Host stand-in for pico/stdlib.h
+
+#pragma once
+
+#include <assert.h>
+
+#include "pico/platform.h"
+#include "pico/types.h"
+#include "pico/time.h"
+#include "hardware/gpio.h"
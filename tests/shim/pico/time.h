@@ -0,0 +1,22 @@
+// Host stand-in for pico/time.h, backed by the host's monotonic clock
+
+#pragma once
+
+#include "pico/types.h"
+
+#define nil_time ((absolute_time_t)0)
+
+typedef int32_t alarm_id_t;
+typedef struct repeating_timer { int64_t delay_us; alarm_id_t alarm_id; void *user_data; } repeating_timer_t;
+
+absolute_time_t get_absolute_time(void);
+absolute_time_t make_timeout_time_us(uint64_t us);
+absolute_time_t make_timeout_time_ms(uint32_t ms);
+int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to);
+uint32_t to_ms_since_boot(absolute_time_t t);
+
+static inline uint64_t to_us_since_boot(absolute_time_t t) { return t; }
+static inline bool is_nil_time(absolute_time_t t) { return t == nil_time; }
+static inline bool time_reached(absolute_time_t t) { return get_absolute_time() >= t; }
+static inline absolute_time_t delayed_by_us(absolute_time_t t, uint64_t us) { return t + us; }
+static inline absolute_time_t delayed_by_ms(absolute_time_t t, uint32_t ms) { return t + ms * 1000ull; }
@@ -0,0 +1,15 @@
+// Host stand-in for pico/types.h with the platform constants the firmware headers use
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef unsigned int uint;
+typedef uint64_t absolute_time_t;
+
+#define _u(x) x##u
+
+#define NUM_CORES 2
+#define NUM_BANK0_GPIOS 30
@@ -0,0 +1,41 @@
+// Host stand-in for storagemanager.h with only the options the PS4 authentication reads
+
+#pragma once
+
+#include <stdint.h>
+
+#include "mbedtls/bignum.h"
+
+struct PS4Options {
+	uint8_t serial[16];
+	uint8_t signature[256];
+	mbedtls_mpi_uint rsa_n[64];
+	mbedtls_mpi_uint rsa_e[1];
+	mbedtls_mpi_uint rsa_d[64];
+	mbedtls_mpi_uint rsa_p[32];
+	mbedtls_mpi_uint rsa_q[32];
+	mbedtls_mpi_uint rsa_dp[32];
+	mbedtls_mpi_uint rsa_dq[32];
+	mbedtls_mpi_uint rsa_qp[32];
+	mbedtls_mpi_uint rsa_rn[64];
+	uint32_t checksum;
+};
+
+struct AddonOptions {
+	uint8_t PS4ModeAddonEnabled;
+};
+
+class Storage {
+public:
+	static Storage& getInstance()
+	{
+		static Storage instance;
+		return instance;
+	}
+
+	AddonOptions getAddonOptions() { return addonOptions; }
+	PS4Options * getPS4Options() { return &ps4Options; }
+
+	AddonOptions addonOptions = { 1 };
+	PS4Options ps4Options = {};
+};
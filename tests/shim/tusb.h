@@ -0,0 +1,109 @@
+// Host stand-in for tusb.h, the types the class driver headers declare with and the descriptor macros
+// the gamepad descriptors are built from, as TinyUSB defines them
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef enum
+{
+	XFER_RESULT_SUCCESS,
+	XFER_RESULT_FAILED,
+	XFER_RESULT_STALLED,
+	XFER_RESULT_TIMEOUT,
+} xfer_result_t;
+
+typedef struct tusb_desc_interface tusb_desc_interface_t;
+typedef struct tusb_control_request tusb_control_request_t;
+
+#define TU_ATTR_PACKED __attribute__((packed))
+#define TU_BIT(n) (1UL << (n))
+#define TU_U16_HIGH(u16) ((uint8_t)(((u16) >> 8) & 0x00ff))
+#define TU_U16_LOW(u16) ((uint8_t)((u16) & 0x00ff))
+#define U16_TO_U8S_LE(u16) TU_U16_LOW(u16), TU_U16_HIGH(u16)
+
+#define CFG_TUD_HID_EP_BUFSIZE 64
+
+enum
+{
+	TUSB_DESC_DEVICE = 0x01,
+	TUSB_DESC_CONFIGURATION = 0x02,
+	TUSB_DESC_INTERFACE = 0x04,
+	TUSB_DESC_ENDPOINT = 0x05,
+};
+
+enum
+{
+	TUSB_XFER_INTERRUPT = 3,
+	TUSB_CLASS_HID = 3,
+	HID_SUBCLASS_BOOT = 1,
+	HID_ITF_PROTOCOL_KEYBOARD = 1,
+	HID_DESC_TYPE_HID = 0x21,
+	HID_DESC_TYPE_REPORT = 0x22,
+};
+
+typedef struct TU_ATTR_PACKED
+{
+	uint8_t bLength;
+	uint8_t bDescriptorType;
+	uint16_t bcdUSB;
+	uint8_t bDeviceClass;
+	uint8_t bDeviceSubClass;
+	uint8_t bDeviceProtocol;
+	uint8_t bMaxPacketSize0;
+	uint16_t idVendor;
+	uint16_t idProduct;
+	uint16_t bcdDevice;
+	uint8_t iManufacturer;
+	uint8_t iProduct;
+	uint8_t iSerialNumber;
+	uint8_t bNumConfigurations;
+} tusb_desc_device_t;
+
+#define TUD_CONFIG_DESC_LEN (9)
+#define TUD_CONFIG_DESCRIPTOR(config_num, _itfcount, _stridx, _total_len, _attribute, _power_ma) \
+	9, TUSB_DESC_CONFIGURATION, U16_TO_U8S_LE(_total_len), _itfcount, config_num, _stridx, TU_BIT(7) | _attribute, (_power_ma) / 2
+
+#define TUD_HID_DESC_LEN (9 + 9 + 7)
+#define TUD_HID_DESCRIPTOR(_itfnum, _stridx, _boot_protocol, _report_desc_len, _epin, _epsize, _ep_interval) \
+	9, TUSB_DESC_INTERFACE, _itfnum, 0, 1, TUSB_CLASS_HID, (uint8_t)((_boot_protocol) ? (uint8_t)HID_SUBCLASS_BOOT : 0), _boot_protocol, _stridx, \
+	9, HID_DESC_TYPE_HID, U16_TO_U8S_LE(0x0111), 0, 1, HID_DESC_TYPE_REPORT, U16_TO_U8S_LE(_report_desc_len), \
+	7, TUSB_DESC_ENDPOINT, _epin, TUSB_XFER_INTERRUPT, U16_TO_U8S_LE(_epsize), _ep_interval
+
+// Keyboard usages and modifiers from TinyUSB's class/hid/hid.h that the keyboard mappings use
+enum
+{
+	KEYBOARD_MODIFIER_LEFTCTRL = TU_BIT(0),
+	KEYBOARD_MODIFIER_LEFTSHIFT = TU_BIT(1),
+	KEYBOARD_MODIFIER_LEFTALT = TU_BIT(2),
+	KEYBOARD_MODIFIER_LEFTGUI = TU_BIT(3),
+	KEYBOARD_MODIFIER_RIGHTCTRL = TU_BIT(4),
+	KEYBOARD_MODIFIER_RIGHTSHIFT = TU_BIT(5),
+	KEYBOARD_MODIFIER_RIGHTALT = TU_BIT(6),
+	KEYBOARD_MODIFIER_RIGHTGUI = TU_BIT(7),
+};
+
+#define HID_KEY_C             0x06
+#define HID_KEY_V             0x19
+#define HID_KEY_X             0x1B
+#define HID_KEY_Z             0x1D
+#define HID_KEY_1             0x1E
+#define HID_KEY_5             0x22
+#define HID_KEY_9             0x26
+#define HID_KEY_SPACE         0x2C
+#define HID_KEY_MINUS         0x2D
+#define HID_KEY_EQUAL         0x2E
+#define HID_KEY_F2            0x3B
+#define HID_KEY_ARROW_RIGHT   0x4F
+#define HID_KEY_ARROW_LEFT    0x50
+#define HID_KEY_ARROW_DOWN    0x51
+#define HID_KEY_ARROW_UP      0x52
+#define HID_KEY_CONTROL_LEFT  0xE0
+#define HID_KEY_SHIFT_LEFT    0xE1
+#define HID_KEY_ALT_LEFT      0xE2
+#define HID_KEY_GUI_LEFT      0xE3
+#define HID_KEY_CONTROL_RIGHT 0xE4
+#define HID_KEY_SHIFT_RIGHT   0xE5
+#define HID_KEY_ALT_RIGHT     0xE6
+#define HID_KEY_GUI_RIGHT     0xE7
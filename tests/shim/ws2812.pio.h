@@ -0,0 +1,5 @@
+// Host stand-in for the generated ws2812.pio.h, NeoPico.hpp only needs the PIO type from it
+
+#pragma once
+
+#include "hardware/pio.h"
@@ -0,0 +1,58 @@
+// Times GamepadSOCDCleaner::clean against the old runSOCDCleaner on the same inputs
+//
+//    socd_bench [cleans]
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "gamepad/GamepadSOCDCleaner.h"
+
+#include "socd_reference.h"
+
+template <typename Clean>
+static double nanosecondsPerClean(const std::vector<uint8_t> & inputs, SOCDMode mode, Clean clean)
+{
+	uint8_t sink = 0;
+	const auto started = std::chrono::steady_clock::now();
+	for (uint8_t dpad : inputs)
+		sink ^= clean(mode, dpad);
+	const auto elapsed = std::chrono::steady_clock::now() - started;
+
+	// Keeps the loop from being optimised away
+	asm volatile("" :: "r"(sink));
+	return std::chrono::duration<double, std::nano>(elapsed).count() / inputs.size();
+}
+
+int main(int argc, char * argv[])
+{
+	const long count = argc > 1 ? atol(argv[1]) : 50000000;
+	if (count <= 0)
+	{
+		printf("usage: %s [cleans]\n", argv[0]);
+		return 1;
+	}
+
+	std::vector<uint8_t> inputs(count);
+	uint32_t seed = 2040;
+	for (uint8_t & dpad : inputs)
+	{
+		seed = seed * 1664525 + 1013904223;
+		dpad = (seed >> 16) & GAMEPAD_MASK_DPAD;
+	}
+
+	static const char * names[] = { "Up Priority", "Neutral", "Last Win", "First Win", "Off" };
+	printf("%ld cleans per mode\n", count);
+	for (int mode = SOCD_MODE_UP_PRIORITY; mode <= SOCD_MODE_BYPASS; mode++)
+	{
+		GamepadSOCDCleaner cleaner;
+		ReferenceSOCDCleaner reference;
+		const double table = nanosecondsPerClean(inputs, static_cast<SOCDMode>(mode),
+			[&cleaner](SOCDMode m, uint8_t dpad) { return cleaner.clean(m, dpad); });
+		const double branches = nanosecondsPerClean(inputs, static_cast<SOCDMode>(mode),
+			[&reference](SOCDMode m, uint8_t dpad) { return reference.run(m, dpad); });
+		printf("%-12s table %.2f ns, runSOCDCleaner %.2f ns\n", names[mode], table, branches);
+	}
+	return 0;
+}
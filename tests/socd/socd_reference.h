@@ -0,0 +1,79 @@
+// runSOCDCleaner as it was before the transition tables, with its static history turned into members
+
+#pragma once
+
+#include "gamepad/GamepadState.h"
+
+struct ReferenceSOCDCleaner
+{
+	DpadDirection lastUD = DIRECTION_NONE;
+	DpadDirection lastLR = DIRECTION_NONE;
+
+	uint8_t run(SOCDMode mode, uint8_t dpad)
+	{
+		if (mode == SOCD_MODE_BYPASS) {
+			return dpad;
+		}
+
+		uint8_t newDpad = 0;
+
+		switch (dpad & (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN))
+		{
+			case (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN):
+				if (mode == SOCD_MODE_UP_PRIORITY)
+				{
+					newDpad |= GAMEPAD_MASK_UP;
+					lastUD = DIRECTION_UP;
+				}
+				else if (mode == SOCD_MODE_SECOND_INPUT_PRIORITY && lastUD != DIRECTION_NONE)
+					newDpad |= (lastUD == DIRECTION_UP) ? GAMEPAD_MASK_DOWN : GAMEPAD_MASK_UP;
+				else if (mode == SOCD_MODE_FIRST_INPUT_PRIORITY && lastUD != DIRECTION_NONE)
+					newDpad |= (lastUD == DIRECTION_UP) ? GAMEPAD_MASK_UP : GAMEPAD_MASK_DOWN;
+				else
+					lastUD = DIRECTION_NONE;
+				break;
+
+			case GAMEPAD_MASK_UP:
+				newDpad |= GAMEPAD_MASK_UP;
+				lastUD = DIRECTION_UP;
+				break;
+
+			case GAMEPAD_MASK_DOWN:
+				newDpad |= GAMEPAD_MASK_DOWN;
+				lastUD = DIRECTION_DOWN;
+				break;
+
+			default:
+				lastUD = DIRECTION_NONE;
+				break;
+		}
+
+		switch (dpad & (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT))
+		{
+			case (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT):
+				if (mode == SOCD_MODE_SECOND_INPUT_PRIORITY && lastLR != DIRECTION_NONE)
+					newDpad |= (lastLR == DIRECTION_LEFT) ? GAMEPAD_MASK_RIGHT : GAMEPAD_MASK_LEFT;
+				else if (mode == SOCD_MODE_FIRST_INPUT_PRIORITY && lastLR != DIRECTION_NONE)
+					newDpad |= (lastLR == DIRECTION_LEFT) ? GAMEPAD_MASK_LEFT : GAMEPAD_MASK_RIGHT;
+				else
+					lastLR = DIRECTION_NONE;
+				break;
+
+			case GAMEPAD_MASK_LEFT:
+				newDpad |= GAMEPAD_MASK_LEFT;
+				lastLR = DIRECTION_LEFT;
+				break;
+
+			case GAMEPAD_MASK_RIGHT:
+				newDpad |= GAMEPAD_MASK_RIGHT;
+				lastLR = DIRECTION_RIGHT;
+				break;
+
+			default:
+				lastLR = DIRECTION_NONE;
+				break;
+		}
+
+		return newDpad;
+	}
+};
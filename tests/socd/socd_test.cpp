@@ -0,0 +1,116 @@
+// Checks every SOCD transition table entry against the old runSOCDCleaner
+
+#include <stdio.h>
+
+// Included rather than linked so the test can read the compiled tables
+#include "../../src/gamepad/GamepadSOCDCleaner.cpp"
+
+#include "socd_reference.h"
+
+static int failures = 0;
+
+#define CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+			failures++; \
+		} \
+	} while (0)
+
+// Axis history of the tables: 0 for none, the mask of the axis direction otherwise, 3 never happens
+static const DpadDirection UP_DOWN[4] = { DIRECTION_NONE, DIRECTION_UP, DIRECTION_DOWN, DIRECTION_NONE };
+static const DpadDirection LEFT_RIGHT[4] = { DIRECTION_NONE, DIRECTION_LEFT, DIRECTION_RIGHT, DIRECTION_NONE };
+
+static uint8_t toHistory(DpadDirection lastUD, DpadDirection lastLR)
+{
+	const uint8_t upDown = lastUD == DIRECTION_UP ? 1 : lastUD == DIRECTION_DOWN ? 2 : 0;
+	const uint8_t leftRight = lastLR == DIRECTION_LEFT ? 1 : lastLR == DIRECTION_RIGHT ? 2 : 0;
+	return upDown | (leftRight << 2);
+}
+
+static bool reachable(uint8_t history)
+{
+	return (history & 0x3) != 0x3 && (history >> 2) != 0x3;
+}
+
+// All 5 modes x 16 histories x 16 D-pads
+static void checkTables()
+{
+	int compared = 0;
+	int unreachable = 0;
+	for (int mode = 0; mode < SOCD_MODE_COUNT; mode++)
+	{
+		for (int history = 0; history < 16; history++)
+		{
+			for (int dpad = 0; dpad < 16; dpad++)
+			{
+				const uint8_t entry = socdTables.entries[mode][(history << 4) | dpad];
+				if (!reachable(history))
+				{
+					unreachable++;
+					continue;
+				}
+
+				ReferenceSOCDCleaner reference;
+				reference.lastUD = UP_DOWN[history & 0x3];
+				reference.lastLR = LEFT_RIGHT[history >> 2];
+				const uint8_t expected = reference.run(static_cast<SOCDMode>(mode), dpad);
+				const uint8_t next = toHistory(reference.lastUD, reference.lastLR);
+
+				if ((entry & 0xF) != expected || (entry >> 4) != next)
+				{
+					printf("mode %d history %x dpad %x: table %02x, reference %x with history %x\n",
+						mode, history, dpad, entry, expected, next);
+					failures++;
+				}
+				compared++;
+			}
+		}
+	}
+
+	CHECK(compared == SOCD_MODE_COUNT * 9 * 16);
+	CHECK(unreachable == SOCD_MODE_COUNT * 7 * 16);
+	printf("%d table entries match the reference, %d belong to histories that can't occur\n", compared, unreachable);
+}
+
+// Long runs through clean(), switching modes and feeding bits outside the D-pad
+static void checkSequences()
+{
+	uint32_t seed = 2040;
+	auto next = [&seed]() {
+		seed = seed * 1664525 + 1013904223;
+		return seed >> 16;
+	};
+
+	GamepadSOCDCleaner cleaner;
+	ReferenceSOCDCleaner reference;
+	SOCDMode mode = SOCD_MODE_NEUTRAL;
+	int mismatches = 0;
+	for (int i = 0; i < 1000000; i++)
+	{
+		if (next() % 64 == 0)
+			mode = static_cast<SOCDMode>(next() % SOCD_MODE_COUNT);
+		const uint8_t dpad = next() & 0xFF;
+		if (cleaner.clean(mode, dpad) != (reference.run(mode, dpad & GAMEPAD_MASK_DPAD) & GAMEPAD_MASK_DPAD))
+			mismatches++;
+	}
+	CHECK(mismatches == 0);
+
+	// Unknown modes clean like Neutral
+	cleaner.reset();
+	CHECK(cleaner.clean(static_cast<SOCDMode>(SOCD_MODE_COUNT), GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN | GAMEPAD_MASK_LEFT) == GAMEPAD_MASK_LEFT);
+}
+
+int main()
+{
+	checkTables();
+	checkSequences();
+
+	if (failures)
+	{
+		printf("%d checks failed\n", failures);
+		return 1;
+	}
+	printf("all checks passed\n");
+	return 0;
+}
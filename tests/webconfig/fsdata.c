@@ -0,0 +1,25 @@
+// Host stand-in for the generated lib/httpd/fsdata.c, only used until the React app has been built with
+// npm run build in www/, which generates the real one
+
+#include "fsdata.h"
+
+static const unsigned char data__index_html[] =
+	"/index.html\0"
+	"HTTP/1.1 200 OK\r\n"
+	"Server: GP2040-CE\r\n"
+	"Content-Length: 81\r\n"
+	"Content-Type: text/html\r\n"
+	"Connection: keep-alive\r\n"
+	"\r\n"
+	"<html><body>Run npm run build in www/ to serve the web config app.</body></html>\n";
+
+const struct fsdata_file file__index_html[] = { {
+	NULL,
+	data__index_html,
+	data__index_html + 12,
+	sizeof(data__index_html) - 1 - 12,
+	FS_FILE_FLAGS_HEADER_INCLUDED | FS_FILE_FLAGS_HEADER_PERSISTENT | FS_FILE_FLAGS_HEADER_HTTPVER_1_1,
+} };
+
+#define FS_ROOT file__index_html
+#define FS_NUMFILES 1
@@ -0,0 +1,588 @@
+// Serves web config from the host: a socket stand-in for the lwIP httpd in front of fs.c and the custom
+// file and POST callbacks of webconfig.cpp, the way rndis_task() serves them on the device.
+//
+//   webconfig_server [--port 8080] [--flash settings.bin]   serves until interrupted
+//   webconfig_server --check                                 requests every API route and checks the answers
+//
+// The app is served from lib/httpd/fsdata.c once npm run build has generated it in www/.
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <ArduinoJson.h>
+
+// fs.c is built as C like on the device, its header does not say so itself
+extern "C" {
+#include "fs.h"
+}
+
+#include "configmanager.h"
+#include "configs/jsonstreamparser.h"
+#include "gamepad.h"
+#include "lwip/apps/httpd.h"
+#include "rndis.h"
+#include "storagemanager.h"
+
+#include "firmware_host.h"
+
+#define HTTP_SEND_BUFFER 5840 // TCP_SND_BUF of lwipopts.h, httpd fills at most that much before it waits
+#define HTTP_SEGMENT 1460     // TCP_MSS, the largest pbuf a POST body arrives in
+
+static const char HTTP_NOT_FOUND[] =
+	"HTTP/1.0 404 File not found\r\n"
+	"Server: lwIP/host\r\n"
+	"Content-Type: text/html\r\n"
+	"\r\n"
+	"<html><body><h2>404: The requested file cannot be found.</h2></body></html>\r\n";
+
+static int listenPort = 8080;
+static int listenSocket = -1;
+static int readChunk = HTTP_SEND_BUFFER; // Largest single fs_read, the check shrinks it to split responses
+
+struct Connection
+{
+	int socket;
+	std::string input;
+	std::string output;
+	bool receivingBody = false;
+	int bodyLeft = 0;
+	bool fileOpen = false;
+	bool waiting = false;   // fs_wait_read_custom holds the callback until the file can be read again
+	bool keepAlive = false;
+	bool responding = false; // A request was answered, the connection stays open after it with keep-alive
+	struct fs_file file = { };
+};
+
+static std::vector<Connection*> connections;
+
+static void http_continue(void *arg)
+{
+	static_cast<Connection*>(arg)->waiting = false;
+}
+
+u8_t pbuf_free(struct pbuf *p)
+{
+	u8_t count = 0;
+	while (p != NULL)
+	{
+		struct pbuf *next = p->next;
+		free(p);
+		p = next;
+		count++;
+	}
+	return count;
+}
+
+static void close_file(Connection* connection)
+{
+	if (connection->fileOpen)
+		fs_close(&connection->file);
+	connection->fileOpen = false;
+	connection->waiting = false;
+}
+
+// Looks the file up like httpd does, the 404 page included
+static void http_open(Connection* connection, const char* uri, bool keepAliveRequested)
+{
+	std::string path(uri);
+	path = path.substr(0, path.find('?'));
+	if (path == "/")
+		path = "/index.html";
+
+	if (fs_open(&connection->file, path.c_str()) != ERR_OK && fs_open(&connection->file, "/404.html") != ERR_OK)
+	{
+		connection->output += HTTP_NOT_FOUND;
+		connection->keepAlive = false;
+		return;
+	}
+
+	connection->fileOpen = true;
+	const u8_t flags = connection->file.http_header_included;
+	connection->keepAlive = keepAliveRequested && (flags & FS_FILE_FLAGS_HEADER_PERSISTENT);
+	if (!(flags & FS_FILE_FLAGS_HEADER_INCLUDED))
+	{
+		connection->output += "HTTP/1.0 200 OK\r\nServer: lwIP/host\r\nContent-Length: " +
+			std::to_string(connection->file.len) + "\r\n\r\n";
+		connection->keepAlive = false;
+	}
+
+	// Files from fsdata are complete in memory, custom ones are read as the connection drains
+	if (connection->file.data != NULL)
+		connection->output.append(connection->file.data, connection->file.len);
+}
+
+static void http_fill(Connection* connection)
+{
+	std::vector<char> buffer(readChunk);
+	while (connection->fileOpen && !connection->waiting && connection->output.size() < HTTP_SEND_BUFFER)
+	{
+		const int room = std::min<int>(readChunk, HTTP_SEND_BUFFER - connection->output.size());
+		const int read = fs_read_async(&connection->file, buffer.data(), room, http_continue, connection);
+		if (read == FS_READ_DELAYED)
+			connection->waiting = true;
+		else if (read == FS_READ_EOF)
+			close_file(connection);
+		else if (read == 0)
+			break;
+		else
+			connection->output.append(buffer.data(), read);
+	}
+}
+
+// Feeds the body to httpd_post_receive_data in segments, then opens the response the application chose
+static void http_receive_body(Connection* connection)
+{
+	while (connection->bodyLeft > 0 && !connection->input.empty())
+	{
+		const int length = std::min<int>({ connection->bodyLeft, (int)connection->input.size(), HTTP_SEGMENT });
+		struct pbuf *p = static_cast<struct pbuf*>(malloc(sizeof(struct pbuf) + length));
+		p->next = NULL;
+		p->payload = p + 1;
+		p->tot_len = p->len = length;
+		memcpy(p->payload, connection->input.data(), length);
+		connection->input.erase(0, length);
+		connection->bodyLeft -= length;
+		if (httpd_post_receive_data(connection, p) != ERR_OK)
+		{
+			connection->input.erase(0, connection->bodyLeft);
+			connection->bodyLeft = 0;
+		}
+	}
+
+	if (connection->bodyLeft == 0)
+	{
+		char responseUri[64] = "";
+		httpd_post_finished(connection, responseUri, sizeof(responseUri));
+		connection->receivingBody = false;
+		if (responseUri[0] == '\0')
+		{
+			// The application refused the body
+			connection->output += HTTP_NOT_FOUND;
+			connection->keepAlive = false;
+		}
+		else
+		{
+			http_open(connection, responseUri, connection->keepAlive);
+		}
+	}
+}
+
+// Returns false once the connection has to be closed
+static bool http_process(Connection* connection)
+{
+	while (!connection->fileOpen && connection->output.empty())
+	{
+		if (connection->receivingBody)
+		{
+			http_receive_body(connection);
+			if (connection->receivingBody)
+				return true;
+			continue;
+		}
+
+		if (connection->responding && !connection->keepAlive)
+			return false;
+		connection->responding = false;
+
+		const size_t end = connection->input.find("\r\n\r\n");
+		if (end == std::string::npos)
+			return true;
+
+		const std::string request = connection->input.substr(0, end + 4);
+		connection->input.erase(0, end + 4);
+
+		char method[8] = "";
+		char uri[256] = "";
+		if (sscanf(request.c_str(), "%7s %255s", method, uri) != 2)
+			return false;
+		connection->responding = true;
+
+		// Like httpd, only an explicit keep-alive keeps the connection open
+		const bool keepAlive = request.find("Connection: keep-alive") != std::string::npos ||
+			request.find("Connection: Keep-Alive") != std::string::npos;
+
+		if (strcmp(method, "POST") == 0)
+		{
+			const size_t lengthHeader = request.find("Content-Length: ");
+			const int contentLength = lengthHeader != std::string::npos ? atoi(request.c_str() + lengthHeader + 16) : 0;
+			char responseUri[64] = "";
+			u8_t postAutoWindow = 1;
+			connection->keepAlive = keepAlive;
+			if (httpd_post_begin(connection, uri, request.c_str(), request.size(), contentLength,
+				responseUri, sizeof(responseUri), &postAutoWindow) != ERR_OK)
+			{
+				connection->output += HTTP_NOT_FOUND;
+				connection->keepAlive = false;
+				continue;
+			}
+			connection->receivingBody = true;
+			connection->bodyLeft = contentLength;
+		}
+		else if (strcmp(method, "GET") == 0)
+		{
+			http_open(connection, uri, keepAlive);
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	http_fill(connection);
+	return true;
+}
+
+static void http_close(Connection* connection)
+{
+	close_file(connection);
+	close(connection->socket);
+	connections.erase(std::remove(connections.begin(), connections.end(), connection), connections.end());
+	delete connection;
+}
+
+int rndis_init(void)
+{
+	listenSocket = socket(AF_INET, SOCK_STREAM, 0);
+	const int reuse = 1;
+	setsockopt(listenSocket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+	struct sockaddr_in address = { };
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	address.sin_port = htons(listenPort);
+	socklen_t addressLength = sizeof(address);
+	if (bind(listenSocket, (struct sockaddr*)&address, sizeof(address)) != 0 || listen(listenSocket, 8) != 0 ||
+		getsockname(listenSocket, (struct sockaddr*)&address, &addressLength) != 0)
+	{
+		perror("webconfig_server");
+		exit(1);
+	}
+	listenPort = ntohs(address.sin_port);
+	fcntl(listenSocket, F_SETFL, O_NONBLOCK);
+	return 0;
+}
+
+// One pass over every socket, like a single rndis_task() runs lwIP once
+void rndis_task(void)
+{
+	std::vector<struct pollfd> fds = { { listenSocket, POLLIN, 0 } };
+	for (Connection* connection : connections)
+		fds.push_back({ connection->socket, (short)(POLLIN | (connection->output.empty() ? 0 : POLLOUT)), 0 });
+
+	if (poll(fds.data(), fds.size(), 1) <= 0)
+		return;
+
+	if (fds[0].revents & POLLIN)
+	{
+		const int socket = accept(listenSocket, NULL, NULL);
+		if (socket >= 0)
+		{
+			fcntl(socket, F_SETFL, O_NONBLOCK);
+			connections.push_back(new Connection { socket });
+		}
+	}
+
+	const std::vector<Connection*> polled(connections.begin(), connections.begin() + (fds.size() - 1));
+	for (size_t i = 0; i < polled.size(); i++)
+	{
+		Connection* connection = polled[i];
+		bool open = true;
+		if (fds[i + 1].revents & (POLLIN | POLLHUP | POLLERR))
+		{
+			char buffer[HTTP_SEGMENT];
+			const ssize_t received = recv(connection->socket, buffer, sizeof(buffer), 0);
+			if (received > 0)
+				connection->input.append(buffer, received);
+			else if (received == 0 || errno != EAGAIN)
+				open = false;
+		}
+
+		if (open)
+			open = http_process(connection);
+
+		if (open && !connection->output.empty())
+		{
+			const ssize_t sent = send(connection->socket, connection->output.data(), connection->output.size(), MSG_NOSIGNAL);
+			if (sent > 0)
+				connection->output.erase(0, sent);
+			else if (sent < 0 && errno != EAGAIN)
+				open = false;
+			if (open)
+				open = http_process(connection);
+		}
+
+		if (!open)
+			http_close(connection);
+	}
+}
+
+// The check: a client on the other end of the socket, driven from the same loop as the server
+
+static int failures = 0;
+
+#define CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+			failures++; \
+		} \
+	} while (0)
+
+struct Response
+{
+	int status = 0;
+	std::string header;
+	std::string body;
+	int contentLength = -1;
+};
+
+class Client
+{
+public:
+	Client()
+	{
+		socket = ::socket(AF_INET, SOCK_STREAM, 0);
+		struct sockaddr_in address = { };
+		address.sin_family = AF_INET;
+		address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		address.sin_port = htons(listenPort);
+		fcntl(socket, F_SETFL, O_NONBLOCK);
+		connect(socket, (struct sockaddr*)&address, sizeof(address));
+	}
+
+	~Client() { close(socket); }
+
+	// Sends the request and runs the server until the response is complete, stopAt ends an open stream early
+	Response request(const char* method, const char* path, const std::string& body = "", const char* stopAt = nullptr)
+	{
+		std::string request = std::string(method) + " " + path + " HTTP/1.1\r\nHost: localhost\r\nConnection: keep-alive\r\n";
+		if (strcmp(method, "POST") == 0)
+			request += "Content-Type: application/json\r\nContent-Length: " + std::to_string(body.size()) + "\r\n";
+		request += "\r\n" + body;
+
+		Response response;
+		std::string received;
+		for (int pass = 0; pass < 100000; pass++)
+		{
+			ConfigManager::getInstance().loop();
+
+			if (!request.empty())
+			{
+				const ssize_t sent = send(socket, request.data(), request.size(), MSG_NOSIGNAL);
+				if (sent > 0)
+					request.erase(0, sent);
+			}
+
+			char buffer[4096];
+			const ssize_t read = recv(socket, buffer, sizeof(buffer), 0);
+			if (read == 0)
+				break;
+			if (read > 0)
+				received.append(buffer, read);
+
+			const size_t end = received.find("\r\n\r\n");
+			if (end == std::string::npos)
+				continue;
+
+			response.header = received.substr(0, end + 4);
+			response.body = received.substr(end + 4);
+			const size_t length = response.header.find("Content-Length: ");
+			if (length != std::string::npos)
+				response.contentLength = atoi(response.header.c_str() + length + 16);
+			if ((response.contentLength >= 0 && (int)response.body.size() >= response.contentLength) ||
+				(stopAt && response.body.find(stopAt) != std::string::npos))
+				break;
+		}
+
+		sscanf(received.c_str(), "HTTP/%*s %d", &response.status);
+		if (response.header.empty())
+			response.body = received;
+		return response;
+	}
+
+private:
+	int socket;
+};
+
+static bool parse_json(const std::string& body, DynamicJsonDocument& doc)
+{
+	JsonStreamParser parser;
+	parser.reset(&doc);
+	return parser.parse(body.data(), body.size()) && parser.finish();
+}
+
+static const char* const getters[] = {
+	"getDisplayOptions", "getGamepadOptions", "getLedOptions", "getCustomTheme", "getPinMappings",
+	"getKeyMappings", "getAddonsOptions", "getSplashImage", "getFirmwareVersion", "getMemoryReport",
+	"getUsbReportStats", "getWiiExtensionStats", "getInputTraceStats", "getUsedPins", "getAnalogRaw",
+};
+
+// A getter's answer posted to its setter has to come back unchanged
+static const char* const roundTrips[][2] = {
+	{ "getDisplayOptions", "setDisplayOptions" },
+	{ "getGamepadOptions", "setGamepadOptions" },
+	{ "getLedOptions", "setLedOptions" },
+	{ "getCustomTheme", "setCustomTheme" },
+	{ "getPinMappings", "setPinMappings" },
+	{ "getKeyMappings", "setKeyMappings" },
+	{ "getAddonsOptions", "setAddonsOptions" },
+};
+
+static bool is_volatile(const char* getter)
+{
+	// Counters and clocks that move between two requests
+	return strcmp(getter, "getMemoryReport") == 0 || strcmp(getter, "getUsbReportStats") == 0;
+}
+
+static void checkGetters()
+{
+	Client client;
+	for (const char* getter : getters)
+	{
+		const std::string path = std::string("/api/") + getter;
+		const Response response = client.request("GET", path.c_str());
+		CHECK(response.status == 200);
+		CHECK(response.contentLength == (int)response.body.size());
+		CHECK(response.header.find("Connection: keep-alive") != std::string::npos);
+
+		DynamicJsonDocument doc(4 * response.body.size() + 1024);
+		if (!parse_json(response.body, doc))
+			printf("%s: not valid JSON\n", getter);
+		CHECK(parse_json(response.body, doc));
+
+		// Split into small and odd chunks, the serializer has to carry on where every read stopped
+		if (!is_volatile(getter))
+		{
+			for (int chunk : { 1, 7, 97 })
+			{
+				readChunk = chunk;
+				const Response split = client.request("GET", path.c_str());
+				if (split.body != response.body)
+					printf("%s: differs when read in %d byte chunks\n", getter, chunk);
+				CHECK(split.body == response.body);
+			}
+			readChunk = HTTP_SEND_BUFFER;
+		}
+	}
+}
+
+static void checkRoundTrips()
+{
+	Client client;
+	for (const auto& pair : roundTrips)
+	{
+		const std::string getPath = std::string("/api/") + pair[0];
+		const std::string setPath = std::string("/api/") + pair[1];
+		const Response before = client.request("GET", getPath.c_str());
+		const Response set = client.request("POST", setPath.c_str(), before.body);
+		CHECK(set.status == 200);
+		const Response after = client.request("GET", getPath.c_str());
+		if (after.body != before.body)
+			printf("%s: %s\n%s: %s\n", pair[0], before.body.c_str(), pair[1], after.body.c_str());
+		CHECK(after.body == before.body);
+	}
+}
+
+static void checkErrors()
+{
+	// A 404 closes the connection, every request gets its own
+	CHECK(Client().request("GET", "/api/getNothing").status == 404);
+	CHECK(Client().request("GET", "/api/setGamepadOptions").status == 404);
+	CHECK(Client().request("POST", "/api/setGamepadOptions", "{\"dpadMode\":").status == 404);
+	CHECK(Client().request("GET", "/").status == 200);
+	CHECK(Client().request("GET", "/settings").status == 200);
+}
+
+static void checkBinary()
+{
+	Client client;
+	const Response snapshot = client.request("GET", "/api/exportSettingsSnapshot");
+	CHECK(snapshot.status == 200);
+	CHECK(snapshot.contentLength > 0 && snapshot.contentLength == (int)snapshot.body.size());
+
+	const Response stream = Client().request("GET", "/api/streamGamepadState", "", "\n\n");
+	CHECK(stream.status == 200);
+	CHECK(stream.body.compare(0, 6, "data: ") == 0);
+}
+
+static void checkHandlerStats()
+{
+	Client client;
+	const Response response = client.request("GET", "/api/getHandlerStats");
+	DynamicJsonDocument doc(4 * response.body.size() + 1024);
+	CHECK(parse_json(response.body, doc));
+
+	printf("%-24s %6s %9s %9s\n", "handler", "calls", "max us", "max heap");
+	for (JsonPairConst handler : doc["handlers"].as<JsonObjectConst>())
+	{
+		JsonObjectConst stats = handler.value().as<JsonObjectConst>();
+		printf("%-24s %6u %9u %9u\n", handler.key().c_str(), stats["calls"].as<unsigned>(),
+			stats["maxUs"].as<unsigned>(), stats["maxHeap"].as<unsigned>());
+		if (stats["overflows"].as<unsigned>() != 0)
+			printf("%s: response overflowed its document\n", handler.key().c_str());
+		CHECK(stats["overflows"].as<unsigned>() == 0);
+		CHECK(stats["maxHeap"].as<unsigned>() > 0);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	bool check = false;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--check") == 0)
+			check = true;
+		else if (strcmp(argv[i], "--port") == 0 && i + 1 < argc)
+			listenPort = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--flash") == 0 && i + 1 < argc)
+			host_flash_open(argv[++i]);
+		else
+		{
+			printf("usage: %s [--port 8080] [--flash settings.bin] [--check]\n", argv[0]);
+			return 2;
+		}
+	}
+	if (check)
+		listenPort = 0;
+
+	// Boots into web config like GP2040::setup does
+	Storage::getInstance().SetGamepad(new Gamepad(5));
+	Storage::getInstance().SetProcessedGamepad(new Gamepad(5));
+	Storage::getInstance().GetGamepad()->setup();
+	Storage::getInstance().SetConfigMode(true);
+	ConfigManager::getInstance().setup(CONFIG_TYPE_WEB);
+
+	if (!check)
+	{
+		printf("web config on http://localhost:%d\n", listenPort);
+		fflush(stdout);
+		for (;;)
+			ConfigManager::getInstance().loop();
+	}
+
+	checkGetters();
+	checkRoundTrips();
+	checkErrors();
+	checkBinary();
+	checkHandlerStats();
+
+	if (failures)
+	{
+		printf("%d checks failed\n", failures);
+		return 1;
+	}
+	printf("all checks passed\n");
+	return 0;
+}
@@ -1,38 +1,136 @@
+// Generates lib/httpd/fsdata.c from the React build.
+//
+// Every asset is compressed at the highest zlib level with each deflate strategy and the smallest of
+// those or the uncompressed file is embedded, together with a precomputed HTTP/1.1 header carrying the
+// matching Content-Encoding and Content-Length so the web server can keep connections alive.
 const path = require('path');
 const fs = require('fs');
+const zlib = require('zlib');
 
-const exec = require('child_process').execFile;
-
-const root = path.dirname(require.main.filename).replace(path.normalize("www"), "");
 const rootwww = path.dirname(require.main.filename);
+const root = path.resolve(rootwww, '..');
+const buildDir = path.join(rootwww, 'build');
+const fsdataFile = path.join(root, 'lib', 'httpd', 'fsdata.c');
+
+const contentTypes = {
+    'html': 'text/html',
+    'htm': 'text/html',
+    'css': 'text/css',
+    'js': 'application/javascript',
+    'json': 'application/json',
+    'txt': 'text/plain',
+    'xml': 'text/xml',
+    'svg': 'image/svg+xml',
+    'png': 'image/png',
+    'ico': 'image/x-icon',
+    'jpg': 'image/jpeg',
+    'jpeg': 'image/jpeg',
+    'gif': 'image/gif',
+    'woff': 'font/woff',
+    'woff2': 'font/woff2',
+};
+
+const strategies = [
+    zlib.constants.Z_DEFAULT_STRATEGY,
+    zlib.constants.Z_FILTERED,
+    zlib.constants.Z_RLE,
+];
+
+function listFiles(dir) {
+    return fs.readdirSync(dir, { withFileTypes: true })
+        .sort((a, b) => a.name.localeCompare(b.name))
+        .flatMap((entry) => {
+            const fullPath = path.join(dir, entry.name);
+            return entry.isDirectory() ? listFiles(fullPath) : [fullPath];
+        });
+}
 
-const fsdata_filename = path.normalize("/lib/httpd/fsdata.c");
-
-function correctincludes() {
-    fs.readFile(root + fsdata_filename, "utf8", function (error, data) {
-        if (data) {
-            let result = data.replace("#include \"lwip/apps/fs.h\"\r\n#include \"lwip/def.h\"", '#include "fsdata.h"');
-        
-            fs.writeFile(root + fsdata_filename, result, "utf8", function (error) {
-                if (error) {
-                    console.error(error);
-                }
-            });
-        } else {
-            if (error) {
-                console.error(error);
-            }
+// Returns the smallest representation of the file, deflate is what lwIP's makefsdata has always served
+function encode(data) {
+    let best = { encoding: null, data };
+    for (const strategy of strategies) {
+        const compressed = zlib.deflateSync(data, {
+            level: zlib.constants.Z_BEST_COMPRESSION,
+            memLevel: 9,
+            windowBits: 15,
+            strategy,
+        });
+        if (compressed.length < best.data.length) {
+            best = { encoding: 'deflate', data: compressed };
         }
-    });
+    }
+    return best;
+}
+
+function httpHeader(uri, contentLength, encoding) {
+    const extension = path.extname(uri).substring(1).toLowerCase();
+    const contentType = contentTypes[extension] || 'application/octet-stream';
+    return 'HTTP/1.1 200 OK\r\n' +
+        'Server: GP2040-CE\r\n' +
+        `Content-Length: ${contentLength}\r\n` +
+        `Content-Type: ${contentType}\r\n` +
+        (encoding ? `Content-Encoding: ${encoding}\r\n` : '') +
+        'Connection: keep-alive\r\n' +
+        '\r\n';
+}
+
+function toHex(buffer) {
+    const lines = [];
+    for (let i = 0; i < buffer.length; i += 16) {
+        lines.push(Array.from(buffer.subarray(i, i + 16), (b) => '0x' + b.toString(16).padStart(2, '0')).join(',') + ',');
+    }
+    return lines.join('\n');
+}
+
+function formatSize(size) {
+    return (size / 1024).toFixed(1).padStart(8) + ' KB';
 }
 
 function makefsdata() {
-      exec(path.normalize(process.platform !== "darwin" ? `${root}/tools/makefsdata` : `${root}/tools/makefsdata.darwin`), [path.normalize(`${rootwww}/build`), '-defl:1', '-xc:png,ico,json', `-f:`+ path.normalize(`${root}/lib/httpd/fsdata.c`)], function(error, data) {
-        if (error) {
-            console.error(error);
-        } else {
-            correctincludes();
-        }
-    });  
+    if (!fs.existsSync(buildDir)) {
+        console.error(`${buildDir} does not exist, run the React build first`);
+        process.exit(1);
+    }
+
+    // index.html goes last so it ends up at the head of the file list that httpd searches
+    const files = listFiles(buildDir)
+        .map((fullPath) => '/' + path.relative(buildDir, fullPath).split(path.sep).join('/'))
+        .sort((a, b) => (a === '/index.html') - (b === '/index.html'));
+
+    let output = '#include "fsdata.h"\n\n#define file_NULL (struct fsdata_file *) NULL\n\n';
+    let previous = 'file_NULL';
+    let totalRaw = 0;
+    let totalEmbedded = 0;
+
+    for (const uri of files) {
+        const raw = fs.readFileSync(path.join(buildDir, uri));
+        const { encoding, data } = encode(raw);
+        const name = Buffer.from(uri + '\0');
+        const header = Buffer.from(httpHeader(uri, data.length, encoding));
+        const symbol = uri.replace(/[^A-Za-z0-9]/g, '_');
+
+        output += `static const unsigned char data_${symbol}[] = {\n`;
+        output += `/* ${uri} (${name.length} chars) */\n${toHex(name)}\n`;
+        output += `/* HTTP header (${header.length} bytes) */\n${toHex(header)}\n`;
+        output += `/* ${encoding || 'raw'} file data (${data.length} bytes) */\n${toHex(data)}\n};\n\n`;
+        output += `const struct fsdata_file file_${symbol}[] = { {\n`;
+        output += `${previous},\ndata_${symbol},\ndata_${symbol} + ${name.length},\n`;
+        output += `sizeof(data_${symbol}) - ${name.length},\n`;
+        output += 'FS_FILE_FLAGS_HEADER_INCLUDED | FS_FILE_FLAGS_HEADER_PERSISTENT | FS_FILE_FLAGS_HEADER_HTTPVER_1_1,\n';
+        output += '}};\n\n';
+        previous = `file_${symbol}`;
+
+        totalRaw += raw.length;
+        totalEmbedded += data.length;
+        const saving = raw.length > 0 ? (100 - data.length / raw.length * 100).toFixed(1) : '0.0';
+        console.log(`${formatSize(raw.length)} -> ${formatSize(data.length)} ${saving.padStart(5)}% ${(encoding || 'raw').padEnd(7)} ${uri}`);
+    }
+
+    output += `#define FS_ROOT ${previous}\n#define FS_NUMFILES ${files.length}\n`;
+    fs.writeFileSync(fsdataFile, output, 'utf8');
+
+    const saving = totalRaw > 0 ? (100 - totalEmbedded / totalRaw * 100).toFixed(1) : '0.0';
+    console.log(`${formatSize(totalRaw)} -> ${formatSize(totalEmbedded)} ${saving.padStart(5)}% total for ${files.length} files`);
 }
-makefsdata();
\ No newline at end of file
+
+makefsdata();
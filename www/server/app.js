@@ -23,6 +23,14 @@ app.get("/api/getUsedPins", (req, res) => {
 	return res.send({ usedPins: Object.values(picoController) });
 })
 
+app.get("/api/getAnalogRaw", (req, res) => {
+	const angle = Date.now() / 1000;
+	return res.send({
+		x: Math.round(32768 + Math.cos(angle) * 30000),
+		y: Math.round(32768 + Math.sin(angle) * 30000),
+	});
+})
+
 app.get("/api/resetSettings", (req, res) => {
 	return res.send({ success: true });
 });
@@ -67,8 +75,12 @@ app.get("/api/getDisplayOptions", (req, res) => {
 });
 
 app.get("/api/getSplashImage", (req, res) => {
+	// A single all white key frame, see www/src/Services/SplashCodec.js
+	const frame = [...Array(7).fill([0xff, 0xff]).flat(), 0xf7, 0xff];
 	const data = {
-		splashImage: Array(16 * 64).fill(255),
+		splashImage: Buffer.from([0, frame.length, 0, ...frame]).toString("base64"),
+		frameCount: 1,
+		frameDelay: 0,
 	};
 	console.log("data", data);
 	return res.send(data);
@@ -185,6 +197,7 @@ app.get("/api/getAddonsOptions", (req, res) => {
 		i2cAnalog1219Block: 0,
 		i2cAnalog1219Speed: 400000,
 		i2cAnalog1219Address: 0x40,
+		i2cAnalog1219DRDYPin: -1,
 		onBoardLedMode: 0,
 		dualDirUpPin: -1,
 		dualDirDownPin: -1,
@@ -194,6 +207,15 @@ app.get("/api/getAddonsOptions", (req, res) => {
 		dualDirCombineMode: 0,
 		analogAdcPinX: -1,
 		analogAdcPinY: -1,
+		analogDeadzoneMode: 1,
+		analogDeadzone: 10,
+		analogCurve: 0,
+		analogCalibrationXMin: 0,
+		analogCalibrationXCenter: 32768,
+		analogCalibrationXMax: 65535,
+		analogCalibrationYMin: 0,
+		analogCalibrationYCenter: 32768,
+		analogCalibrationYMax: 65535,
 		bootselButtonMap: 0,
 		buzzerPin: -1,
 		buzzerVolume: 100,
@@ -276,9 +298,144 @@ app.get("/api/getMemoryReport", (req, res) => {
 		staticAllocs: 200,
 		totalHeap: 2048,
 		usedHeap: 1048,
+		freeHeap: 1000,
+		largestFreeHeap: 900,
+		peakHeap: 1200,
+		stacks: [
+			{ size: 2048, highWater: 1320, bootHighWater: 912, bootUsedHeap: 980 },
+			{ size: 2048, highWater: 640, bootHighWater: 512, bootUsedHeap: 1010 },
+		],
+		allocations: {
+			json: { count: 12, current: 3072, peak: 9216 },
+			leds: { count: 1, current: 1496, peak: 1496 },
+			addons: { count: 6, current: 4120, peak: 4120 },
+		},
+	});
+});
+
+app.get("/api/getUsbReportStats", (req, res) => {
+	return res.send({
+		available: true,
+		inputMode: 0,
+		generated: 60000,
+		sent: 12000,
+		deduplicated: 47900,
+		busy: 100,
+		completed: 12000,
+		pollInterval: 1000,
+		pollIntervalMin: 998,
+		inputEdges: 2400,
+		inputLatency: 180,
+		inputLatencyMax: 1150,
+	});
+});
+
+app.get("/api/getWiiExtensionStats", (req, res) => {
+	return res.send({
+		available: true,
+		extensionType: 1,
+		polls: 42000,
+		timeouts: 3,
+		reconnects: 1,
+	});
+});
+
+app.get("/api/getHandlerStats", (req, res) => {
+	return res.send({
+		usedHeap: 24576,
+		peakHeap: 61440,
+		handlers: {
+			getGamepadOptions: { calls: 3, lastUs: 210, maxUs: 480, maxHeap: 28672, overflows: 0 },
+			getAddonsOptions: { calls: 2, lastUs: 950, maxUs: 1020, maxHeap: 32768, overflows: 0 },
+		},
+	});
+});
+
+// Streams a slowly cycling button press in the same format as the firmware
+app.post("/api/streamGamepadState", (req, res) => {
+	res.writeHead(200, { "Content-Type": "text/event-stream", "Cache-Control": "no-cache" });
+	const interval = Math.max(req.body?.interval ?? 16, 250);
+	let step = 0;
+	const timer = setInterval(() => {
+		const snapshot = Buffer.alloc(19);
+		snapshot.writeUInt16LE(1 << (step++ % 14), 0);
+		[5, 7, 9, 11].forEach((offset) => snapshot.writeUInt16LE(0x7fff, offset));
+		snapshot.writeUInt32LE((Date.now() * 1000) >>> 0, 15);
+		res.write(`data: ${snapshot.toString("hex")}\n\n`);
+	}, interval);
+	req.on("close", () => clearInterval(timer));
+});
+
+app.post("/api/exportSettingsSnapshot", (req, res) => {
+	// An empty snapshot with a zero CRC, the mock has no storage sections to export
+	const snapshot = Buffer.alloc(12);
+	snapshot.writeUInt32LE(0x53535047, 0);
+	snapshot.writeUInt16LE(1, 4);
+	snapshot.writeUInt16LE(0, 6);
+	snapshot.writeUInt32LE(0, 8);
+	res.type("application/octet-stream");
+	return res.send(snapshot);
+});
+
+app.post("/api/importSettingsSnapshot", express.raw({ type: "application/octet-stream", limit: "16kb" }), (req, res) => {
+	console.log(`Received ${req.body.length} byte settings snapshot`);
+	return res.send({ success: req.body.length >= 12 && req.body.readUInt32LE(0) === 0x53535047 });
+});
+
+app.get("/api/getInputTraceStats", (req, res) => {
+	return res.send({
+		entries: 24,
+		dropped: 0,
+		replay: {
+			frames: 24,
+			mismatches: 1,
+			pipelineTime: 1150,
+			pipelineMax: 92,
+			firstMismatch: { index: 7, expectedButtons: 1, actualButtons: 0, expectedDpad: 0, actualDpad: 0, expectedAux: 0, actualAux: 0 },
+		},
 	});
 });
 
+// A trace of B1 through A2 pressed and released in turn, 50 ms apart
+app.get("/api/exportInputTrace", (req, res) => {
+	const count = 28;
+	const trace = Buffer.alloc(16 + count * 28);
+	trace.writeUInt32LE(0x52545047, 0);
+	trace.writeUInt16LE(1, 4);
+	trace.writeUInt16LE(28, 6);
+	trace.writeUInt32LE(count, 8);
+	for (let i = 0; i < count; i++) {
+		const entry = 16 + i * 28;
+		const buttons = i % 2 === 0 ? 1 << (i / 2) : 0;
+		trace.writeUInt32LE(1000000 + i * 50000, entry);
+		trace.writeUInt32LE(buttons << 6, entry + 4);
+		trace.writeUInt32LE(buttons << 6, entry + 8);
+		trace.writeUInt16LE(buttons, entry + 12);
+		[20, 22, 24, 26].forEach((offset) => trace.writeUInt16LE(0x7fff, entry + offset));
+	}
+	res.type("application/octet-stream");
+	return res.send(trace);
+});
+
+app.post("/api/replayInputTrace", express.raw({ type: "application/octet-stream", limit: "16kb" }), (req, res) => {
+	console.log(`Received ${req.body.length} byte input trace`);
+	return res.send({ success: req.body.length >= 16 && req.body.readUInt32LE(0) === 0x52545047 });
+});
+
+app.post("/api/batch", async (req, res) => {
+	const results = {};
+	for (const [name, payload] of Object.entries(req.body)) {
+		const response = await fetch(`http://localhost:${port}/api/${name}`, payload === null ? {} : {
+			method: "POST",
+			headers: { "Content-Type": "application/json" },
+			body: JSON.stringify(payload),
+		});
+		const data = await response.json();
+		results[name] = payload === null ? data : { success: data.success ?? true };
+	}
+	return res.send(results);
+});
+
 app.post("/api/*", (req, res) => {
 	console.log(req.body);
 	return res.send(req.body);
@@ -0,0 +1,65 @@
+/**
+ * GP2040 Configurator API Benchmark
+ *
+ * Calls every getter of a controller in web config mode and reports the round trip time next to
+ * the time and heap use the firmware measured for each handler.
+ *
+ * Usage: npm run benchmark -- [baseUrl] [iterations]
+ *
+ * Without a controller point it at the host build of the firmware handlers in tests/webconfig:
+ *   webconfig_server --port 8080 --flash settings.bin
+ *   npm run benchmark -- http://localhost:8080
+ */
+
+const baseUrl = process.argv[2] || "http://192.168.7.1";
+const iterations = parseInt(process.argv[3] || "10");
+
+const getters = [
+	"getDisplayOptions",
+	"getGamepadOptions",
+	"getLedOptions",
+	"getCustomTheme",
+	"getPinMappings",
+	"getKeyMappings",
+	"getAddonsOptions",
+	"getSplashImage",
+	"getFirmwareVersion",
+	"getMemoryReport",
+	"getUsbReportStats",
+	"getInputTraceStats",
+	"getUsedPins",
+];
+
+const pad = (value, width) => String(value).padStart(width);
+
+async function run() {
+	const roundTrips = {};
+	for (const name of getters) {
+		roundTrips[name] = [];
+		for (let i = 0; i < iterations; i++) {
+			const start = performance.now();
+			const response = await fetch(`${baseUrl}/api/${name}`);
+			await response.arrayBuffer();
+			roundTrips[name].push(performance.now() - start);
+		}
+	}
+
+	const stats = await (await fetch(`${baseUrl}/api/getHandlerStats`)).json();
+
+	console.log(`${"handler".padEnd(20)} ${pad("rtt avg", 9)} ${pad("rtt max", 9)} ${pad("fw max", 9)} ${pad("max heap", 9)}`);
+	for (const name of getters) {
+		const times = roundTrips[name];
+		const average = times.reduce((a, b) => a + b, 0) / times.length;
+		const handler = stats.handlers?.[name] ?? {};
+		console.log(
+			`${name.padEnd(20)} ${pad(average.toFixed(1) + "ms", 9)} ${pad(Math.max(...times).toFixed(1) + "ms", 9)}` +
+			` ${pad(handler.maxUs !== undefined ? (handler.maxUs / 1000).toFixed(1) + "ms" : "-", 9)} ${pad(handler.maxHeap ?? "-", 9)}`
+		);
+	}
+	console.log(`heap in use ${stats.usedHeap} bytes, peak ${stats.peakHeap} bytes`);
+}
+
+run().catch((err) => {
+	console.error(`Benchmark against ${baseUrl} failed: ${err.message}`);
+	process.exit(1);
+});
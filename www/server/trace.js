@@ -0,0 +1,134 @@
+/**
+ * GP2040 Input Trace Tool
+ *
+ * Downloads the input trace of the last gamepad session, prints a trace file, or replays a trace on a
+ * controller in web config mode and reports where its outputs differ from the recording.
+ *
+ * Usage: npm run trace -- download <file> [baseUrl]
+ *        npm run trace -- show <file>
+ *        npm run trace -- replay <file> [baseUrl]
+ */
+
+const fs = require("fs");
+
+const [command, file] = process.argv.slice(2, 4);
+const baseUrl = process.argv[4] || "http://192.168.7.1";
+
+// Layout of InputTraceHeader and InputTraceEntry in the firmware (little endian)
+const TRACE_MAGIC = 0x52545047;
+const HEADER_SIZE = 16;
+const ENTRY_SIZE = 28;
+const BUTTON_NAMES = ["B1", "B2", "B3", "B4", "L1", "R1", "L2", "R2", "S1", "S2", "L3", "R3", "A1", "A2"];
+const DPAD_NAMES = ["Up", "Down", "Left", "Right"];
+
+const REPLAY_START_DELAY_MS = 2000;
+const REPLAY_TIMEOUT_MS = 30000;
+
+const hex = (value) => "0x" + value.toString(16).padStart(8, "0");
+const names = (mask, list) => list.filter((name, bit) => mask & (1 << bit)).join("+") || "-";
+const sleep = (ms) => new Promise((resolve) => setTimeout(resolve, ms));
+
+function parseTrace(buffer) {
+	if (buffer.length < HEADER_SIZE || buffer.readUInt32LE(0) !== TRACE_MAGIC)
+		throw new Error("not an input trace");
+	if (buffer.readUInt16LE(6) !== ENTRY_SIZE)
+		throw new Error(`unsupported trace version ${buffer.readUInt16LE(4)}`);
+
+	const count = buffer.readUInt32LE(8);
+	const entries = [];
+	for (let i = 0; i < count; i++) {
+		const offset = HEADER_SIZE + i * ENTRY_SIZE;
+		entries.push({
+			time: buffer.readUInt32LE(offset),
+			pressed: buffer.readUInt32LE(offset + 4),
+			keys: buffer.readUInt32LE(offset + 8),
+			buttons: buffer.readUInt16LE(offset + 12),
+			aux: buffer.readUInt16LE(offset + 14),
+			dpad: buffer.readUInt8(offset + 16),
+		});
+	}
+	return { dropped: buffer.readUInt32LE(12), entries };
+}
+
+function printEntry(entry, index, start) {
+	const time = (((entry.time - start) >>> 0) / 1000).toFixed(3);
+	console.log(
+		`${String(index).padStart(5)} ${time.padStart(12)}ms  pins ${hex(entry.pressed)}  ` +
+		`${names(entry.dpad, DPAD_NAMES)} ${names(entry.buttons, BUTTON_NAMES)}`
+	);
+}
+
+async function download() {
+	const response = await fetch(`${baseUrl}/api/exportInputTrace`);
+	if (!response.ok)
+		throw new Error("no input trace recorded");
+
+	const buffer = Buffer.from(await response.arrayBuffer());
+	const trace = parseTrace(buffer);
+	fs.writeFileSync(file, buffer);
+	console.log(`Saved ${trace.entries.length} changes to ${file}`);
+}
+
+function show() {
+	const trace = parseTrace(fs.readFileSync(file));
+	if (trace.dropped > 0)
+		console.log(`${trace.dropped} older changes were overwritten before the first one`);
+	trace.entries.forEach((entry, index) => printEntry(entry, index, trace.entries[0].time));
+}
+
+async function replay() {
+	const buffer = fs.readFileSync(file);
+	const trace = parseTrace(buffer);
+	const upload = await fetch(`${baseUrl}/api/replayInputTrace`, {
+		method: "POST",
+		headers: { "Content-Type": "application/octet-stream" },
+		body: buffer,
+	});
+	if (!(await upload.json()).success)
+		throw new Error("the controller rejected the trace");
+
+	// The controller reboots into gamepad mode, replays and reboots back into web config mode
+	await sleep(REPLAY_START_DELAY_MS);
+	const deadline = Date.now() + REPLAY_TIMEOUT_MS;
+	let stats = null;
+	while (stats === null) {
+		if (Date.now() > deadline)
+			throw new Error("the controller did not come back from the replay");
+		try {
+			stats = await (await fetch(`${baseUrl}/api/getInputTraceStats`)).json();
+		} catch {
+			await sleep(500);
+		}
+	}
+
+	const result = stats.replay;
+	if (!result)
+		throw new Error("the controller did not replay the trace");
+
+	console.log(
+		`Replayed ${result.frames} of ${trace.entries.length} changes, ${result.mismatches} mismatches, ` +
+		`${(result.pipelineTime / Math.max(result.frames, 1)).toFixed(1)} us per frame (max ${result.pipelineMax} us)`
+	);
+	if (result.firstMismatch) {
+		const mismatch = result.firstMismatch;
+		console.log(`First mismatch at change ${mismatch.index}:`);
+		console.log(`  expected ${names(mismatch.expectedDpad, DPAD_NAMES)} ${names(mismatch.expectedButtons, BUTTON_NAMES)} aux ${mismatch.expectedAux}`);
+		console.log(`  actual   ${names(mismatch.actualDpad, DPAD_NAMES)} ${names(mismatch.actualButtons, BUTTON_NAMES)} aux ${mismatch.actualAux}`);
+		const first = Math.max(mismatch.index - 3, 0);
+		trace.entries.slice(first, mismatch.index + 4)
+			.forEach((entry, offset) => printEntry(entry, first + offset, trace.entries[0].time));
+	}
+	process.exitCode = result.mismatches > 0 ? 2 : 0;
+}
+
+const commands = { download, show, replay };
+
+if (!commands[command] || !file) {
+	console.error("Usage: npm run trace -- download|show|replay <file> [baseUrl]");
+	process.exit(1);
+}
+
+Promise.resolve(commands[command]()).catch((err) => {
+	console.error(`Trace ${command} failed: ${err.message}`);
+	process.exit(1);
+});
@@ -37,6 +37,41 @@ const DUAL_COMBINE_MODES = [
 	{ label: 'None', value: 3 }
 ];
 
+// Values match AnalogDeadzoneMode and AnalogCurve in enums.h
+const ANALOG_DEADZONE_MODES = [
+	{ label: 'None', value: 0 },
+	{ label: 'Axial', value: 1 },
+	{ label: 'Radial', value: 2 },
+	{ label: 'Scaled Radial', value: 3 },
+];
+
+const ANALOG_CURVES = [
+	{ label: 'Linear', value: 0 },
+	{ label: 'Quadratic', value: 1 },
+	{ label: 'Cubic', value: 2 },
+	{ label: 'Square Root', value: 3 },
+];
+
+const ANALOG_CALIBRATION_FIELDS = [
+	{ name: 'analogCalibrationXMin', label: 'X Min' },
+	{ name: 'analogCalibrationXCenter', label: 'X Center' },
+	{ name: 'analogCalibrationXMax', label: 'X Max' },
+	{ name: 'analogCalibrationYMin', label: 'Y Min' },
+	{ name: 'analogCalibrationYCenter', label: 'Y Center' },
+	{ name: 'analogCalibrationYMax', label: 'Y Max' },
+];
+
+const ANALOG_CALIBRATION_DEFAULTS = {
+	analogCalibrationXMin: 0,
+	analogCalibrationXCenter: 0x8000,
+	analogCalibrationXMax: 0xFFFF,
+	analogCalibrationYMin: 0,
+	analogCalibrationYCenter: 0x8000,
+	analogCalibrationYMax: 0xFFFF,
+};
+
+const ANALOG_CALIBRATION_POLL_MS = 50;
+
 const SHMUP_MIXED_MODES = [
 	{ label: 'Turbo Priority', value: 0 },
 	{ label: 'Charge Priority', value: 1}
@@ -259,10 +294,16 @@ const schema = yup.object().shape({
 	i2cAnalog1219Block:          yup.number().label('I2C Analog1219 Block').validateSelectionWhenValue('I2CAnalog1219InputEnabled', I2C_BLOCKS),
 	i2cAnalog1219Speed:          yup.number().label('I2C Analog1219 Speed').validateNumberWhenValue('I2CAnalog1219InputEnabled'),
 	i2cAnalog1219Address:        yup.number().label('I2C Analog1219 Address').validateNumberWhenValue('I2CAnalog1219InputEnabled'),
+	i2cAnalog1219DRDYPin:        yup.number().label('I2C Analog1219 DRDY Pin').validatePinWhenValue('I2CAnalog1219InputEnabled'),
 
 	AnalogInputEnabled:          yup.number().required().label('Analog Input Enabled'),
 	analogAdcPinX:               yup.number().label('Analog Stick Pin X').validatePinWhenValue('AnalogInputEnabled'),
  	analogAdcPinY:               yup.number().label('Analog Stick Pin Y').validatePinWhenValue('AnalogInputEnabled'),
+	analogDeadzoneMode:          yup.number().label('Analog Deadzone Mode').validateSelectionWhenValue('AnalogInputEnabled', ANALOG_DEADZONE_MODES),
+	analogDeadzone:              yup.number().label('Analog Deadzone').validateRangeWhenValue('AnalogInputEnabled', 0, 99),
+	analogCurve:                 yup.number().label('Analog Response Curve').validateSelectionWhenValue('AnalogInputEnabled', ANALOG_CURVES),
+	...Object.fromEntries(ANALOG_CALIBRATION_FIELDS.map(({ name, label }) =>
+		[name, yup.number().label(`Analog Calibration ${label}`).validateRangeWhenValue('AnalogInputEnabled', 0, 65535)])),
 
 	BoardLedAddonEnabled:        yup.number().required().label('Board LED Add-On Enabled'),
 	onBoardLedMode:              yup.number().label('On-Board LED Mode').validateSelectionWhenValue('BoardLedAddonEnabled', ON_BOARD_LED_MODES),
@@ -348,6 +389,7 @@ const defaultValues = {
 	i2cAnalog1219Block: 0,
 	i2cAnalog1219Speed: 400000,
 	i2cAnalog1219Address: 0x40,
+	i2cAnalog1219DRDYPin: -1,
 	onBoardLedMode: 0,
 	dualUpPin: -1,
 	dualDownPin: -1,
@@ -357,6 +399,10 @@ const defaultValues = {
 	dualDirCombineMode: 0,
 	analogAdcPinX : -1,
  	analogAdcPinY : -1,
+	analogDeadzoneMode: 1,
+	analogDeadzone: 10,
+	analogCurve: 0,
+	...ANALOG_CALIBRATION_DEFAULTS,
 	bootselButtonMap: 0,
 	buzzerPin: -1,
 	buzzerVolume: 100,
@@ -421,6 +467,79 @@ const FormContext = ({setStoredData}) => {
 	return null;
 };
 
+// Captures the calibration of the analog add-on stick from its raw readings
+const AnalogCalibration = () => {
+	const { values, errors, handleChange, setValues } = useFormikContext();
+	const [capturing, setCapturing] = useState(false);
+	const [reading, setReading] = useState(null);
+
+	useEffect(() => {
+		if (!capturing)
+			return;
+
+		// Sweep the stick around its full range while capturing
+		let range = null;
+		const timer = setInterval(async () => {
+			const raw = await WebApi.getAnalogRaw();
+			if (!raw)
+				return;
+
+			setReading(raw);
+			range = range ? {
+				xMin: Math.min(range.xMin, raw.x), xMax: Math.max(range.xMax, raw.x),
+				yMin: Math.min(range.yMin, raw.y), yMax: Math.max(range.yMax, raw.y),
+			} : { xMin: raw.x, xMax: raw.x, yMin: raw.y, yMax: raw.y };
+			setValues((current) => ({
+				...current,
+				analogCalibrationXMin: range.xMin,
+				analogCalibrationXMax: range.xMax,
+				analogCalibrationYMin: range.yMin,
+				analogCalibrationYMax: range.yMax,
+			}));
+		}, ANALOG_CALIBRATION_POLL_MS);
+
+		return () => clearInterval(timer);
+	}, [capturing, setValues]);
+
+	const captureCenter = async () => {
+		const raw = await WebApi.getAnalogRaw();
+		if (!raw)
+			return;
+
+		setReading(raw);
+		setValues({ ...values, analogCalibrationXCenter: raw.x, analogCalibrationYCenter: raw.y });
+	};
+
+	return (
+		<div className="mb-3">
+			<p>Leave the stick at rest and capture its center, then capture the range while moving the stick around its full travel. Limits not on either side of the center fall back to the full range.</p>
+			<Row className="mb-3">
+				{ANALOG_CALIBRATION_FIELDS.map(({ name, label }) =>
+					<FormControl type="number"
+						key={`analog-calibration-${name}`}
+						label={label}
+						name={name}
+						className="form-control-sm"
+						groupClassName="col-sm-2 mb-3"
+						value={values[name]}
+						error={errors[name]}
+						isInvalid={errors[name]}
+						onChange={handleChange}
+						min={0}
+						max={65535}
+					/>
+				)}
+			</Row>
+			<Button className="me-2" size="sm" variant="secondary" disabled={capturing} onClick={captureCenter}>Capture Center</Button>
+			<Button className="me-2" size="sm" variant={capturing ? 'danger' : 'secondary'} onClick={() => setCapturing(!capturing)}>
+				{capturing ? 'Stop Capturing Range' : 'Capture Range'}
+			</Button>
+			<Button className="me-2" size="sm" variant="secondary" disabled={capturing} onClick={() => setValues({ ...values, ...ANALOG_CALIBRATION_DEFAULTS })}>Reset</Button>
+			{reading && <span>Raw X: {reading.x}, Y: {reading.y}</span>}
+		</div>
+	);
+};
+
 const sanitizeData = (values) => {
 	if (!!values.turboPin)
 			values.turboPin = parseInt(values.turboPin);
@@ -458,6 +577,8 @@ const sanitizeData = (values) => {
 			values.i2cAnalog1219Speed = parseInt(values.i2cAnalog1219Speed);
 		if (!!values.i2cAnalog1219Address)
 			values.i2cAnalog1219Address = parseInt(values.i2cAnalog1219Address);
+		if (!!values.i2cAnalog1219DRDYPin)
+			values.i2cAnalog1219DRDYPin = parseInt(values.i2cAnalog1219DRDYPin);
 		if (!!values.onBoardLedMode)
 			values.onBoardLedMode = parseInt(values.onBoardLedMode);
 		if (!!values.dualDownPin)
@@ -474,6 +595,16 @@ const sanitizeData = (values) => {
 			values.analogAdcPinX = parseInt(values.analogAdcPinX);
 		if (!!values.analogAdcPinY)
 			values.analogAdcPinY = parseInt(values.analogAdcPinY);
+		if (!!values.analogDeadzoneMode)
+			values.analogDeadzoneMode = parseInt(values.analogDeadzoneMode);
+		if (!!values.analogDeadzone)
+			values.analogDeadzone = parseInt(values.analogDeadzone);
+		if (!!values.analogCurve)
+			values.analogCurve = parseInt(values.analogCurve);
+		ANALOG_CALIBRATION_FIELDS.forEach(({ name }) => {
+			if (!!values[name])
+				values[name] = parseInt(values[name]);
+		});
 		if (!!values.bootselButtonMap)
 			values.bootselButtonMap = parseInt(values.bootselButtonMap);
 		if (!!values.buzzerPin)
@@ -707,6 +838,7 @@ export default function AddonsConfigPage() {
 								{ANALOG_PIN_OPTIONS}
 							</FormSelect>
 						</Row>
+						<AnalogCalibration />
 						</div>
 						<FormCheck
 							label="Enabled"
@@ -718,6 +850,47 @@ export default function AddonsConfigPage() {
 							onChange={(e) => {handleCheckbox("AnalogInputEnabled", values); handleChange(e);}}
 						/>
 					</Section>
+					<Section title="Analog Stick Conditioning">
+						<p>Deadzone and response curve for the sticks of the Analog, I2C Analog ADS1219 and Wii Extension add-ons.</p>
+						<Row className="mb-3">
+							<FormSelect
+								label="Deadzone Mode"
+								name="analogDeadzoneMode"
+								className="form-select-sm"
+								groupClassName="col-sm-3 mb-3"
+								value={values.analogDeadzoneMode}
+								error={errors.analogDeadzoneMode}
+								isInvalid={errors.analogDeadzoneMode}
+								onChange={handleChange}
+							>
+								{ANALOG_DEADZONE_MODES.map((o, i) => <option key={`analogDeadzoneMode-option-${i}`} value={o.value}>{o.label}</option>)}
+							</FormSelect>
+							<FormControl type="number"
+								label="Deadzone (% of radius)"
+								name="analogDeadzone"
+								className="form-control-sm"
+								groupClassName="col-sm-3 mb-3"
+								value={values.analogDeadzone}
+								error={errors.analogDeadzone}
+								isInvalid={errors.analogDeadzone}
+								onChange={handleChange}
+								min={0}
+								max={99}
+							/>
+							<FormSelect
+								label="Response Curve"
+								name="analogCurve"
+								className="form-select-sm"
+								groupClassName="col-sm-3 mb-3"
+								value={values.analogCurve}
+								error={errors.analogCurve}
+								isInvalid={errors.analogCurve}
+								onChange={handleChange}
+							>
+								{ANALOG_CURVES.map((o, i) => <option key={`analogCurve-option-${i}`} value={o.value}>{o.label}</option>)}
+							</FormSelect>
+						</Row>
+					</Section>
 					<Section title="Turbo">
 						<div
 							id="TurboInputOptions"
@@ -1155,6 +1328,18 @@ export default function AddonsConfigPage() {
 								onChange={handleChange}
 								maxLength={4}
 							/>
+							<FormControl type="number"
+								label="I2C Analog ADS1219 DRDY Pin"
+								name="i2cAnalog1219DRDYPin"
+								className="form-control-sm"
+								groupClassName="col-sm-3 mb-3"
+								value={values.i2cAnalog1219DRDYPin}
+								error={errors.i2cAnalog1219DRDYPin}
+								isInvalid={errors.i2cAnalog1219DRDYPin}
+								onChange={handleChange}
+								min={-1}
+								max={29}
+							/>
 						</Row>
 						</div>
 						<FormCheck
@@ -5,6 +5,10 @@ import WebApi from '../Services/WebApi';
 
 const FILE_EXTENSION = ".gp2040"
 const FILENAME = "gp2040ce_backup_{DATE}" + FILE_EXTENSION;
+const SNAPSHOT_FILE_EXTENSION = ".gp2040snap";
+const SNAPSHOT_FILENAME = "gp2040ce_snapshot_{DATE}" + SNAPSHOT_FILE_EXTENSION;
+const TRACE_FILE_EXTENSION = ".gp2040trace";
+const TRACE_FILENAME = "gp2040ce_trace_{DATE}" + TRACE_FILE_EXTENSION;
 
 const API_BINDING = {
 	"display":     {label: "Display",      get: WebApi.getDisplayOptions, set: WebApi.setDisplayOptions},
@@ -19,6 +23,8 @@ const API_BINDING = {
 
 export default function BackupPage() {
 	const inputFileSelect = useRef();
+	const inputSnapshotSelect = useRef();
+	const inputTraceSelect = useRef();
 
 	const [optionState, setOptionStateData] = useState({});
 	const [checkValues, setCheckValues] = useState({});	// lazy approach
@@ -26,17 +32,23 @@ export default function BackupPage() {
 	const [noticeMessage, setNoticeMessage] = useState('');
 	const [saveMessage, setSaveMessage] = useState('');
 	const [loadMessage, setLoadMessage] = useState('');
+	const [includePS4, setIncludePS4] = useState(false);
+	const [snapshotMessage, setSnapshotMessage] = useState('');
+	const [traceStats, setTraceStats] = useState(null);
+	const [traceMessage, setTraceMessage] = useState('');
 
 	useEffect(() => {
 		async function fetchData() {
+			const entries = Object.entries(API_BINDING);
+			const results = await Promise.all(entries.map(([key, func]) => func.get()));
 			let exportData = {};
-			for (const [key, func] of Object.entries(API_BINDING)) {
-				exportData[key] = await func.get();
-			}
+			entries.forEach(([key], index) => exportData[key] = results[index]);
 			setOptionStateData(exportData);
 		}
 		fetchData();
 
+		WebApi.getInputTraceStats().then(setTraceStats);
+
 		// setup defaults
 		function getDefaultValues() {
 			let defaults = {};
@@ -87,6 +99,84 @@ export default function BackupPage() {
 		setCheckValues(checkValues => ({...checkValues, ...nextCheckValue}));
 	}
 
+	const downloadFile = (file, name) => {
+		let a = document.createElement('a');
+		a.href = URL.createObjectURL(file);
+		a.download = name;
+
+		let container = document.getElementById("root");
+		container.appendChild(a);
+
+		a.click();
+		a.remove();
+	};
+
+	const showSnapshotMessage = (message) => {
+		setSnapshotMessage(message);
+		setTimeout(() => {
+			setSnapshotMessage('');
+		}, 5000);
+	};
+
+	const handleSnapshotExport = async () => {
+		const snapshot = await WebApi.exportSettingsSnapshot(includePS4);
+		if (!snapshot) {
+			showSnapshotMessage('Failed to export the settings snapshot!');
+			return;
+		}
+
+		const fileDate = new Date().toISOString().replace(/[^0-9]/g, '');
+		const name = SNAPSHOT_FILENAME.replace("{DATE}", fileDate);
+		downloadFile(new Blob([snapshot], { type: 'application/octet-stream' }), name);
+		showSnapshotMessage(`Saved as: ${name}`);
+	};
+
+	const handleSnapshotSelect = async (ev) => {
+		const input = ev.target;
+		if (!input || input.files.length === 0)
+			return;
+
+		const file = input.files[0];
+		input.value = '';
+		const success = await WebApi.importSettingsSnapshot(await file.arrayBuffer());
+		showSnapshotMessage(success
+			? `Restored ${file.name}, the controller is rebooting`
+			: `${file.name} is not a valid snapshot for this firmware version!`);
+	};
+
+	const showTraceMessage = (message) => {
+		setTraceMessage(message);
+		setTimeout(() => {
+			setTraceMessage('');
+		}, 5000);
+	};
+
+	const handleTraceExport = async () => {
+		const trace = await WebApi.exportInputTrace();
+		if (!trace) {
+			showTraceMessage('No input trace recorded!');
+			return;
+		}
+
+		const fileDate = new Date().toISOString().replace(/[^0-9]/g, '');
+		const name = TRACE_FILENAME.replace("{DATE}", fileDate);
+		downloadFile(new Blob([trace], { type: 'application/octet-stream' }), name);
+		showTraceMessage(`Saved as: ${name}`);
+	};
+
+	const handleTraceSelect = async (ev) => {
+		const input = ev.target;
+		if (!input || input.files.length === 0)
+			return;
+
+		const file = input.files[0];
+		input.value = '';
+		const success = await WebApi.replayInputTrace(await file.arrayBuffer());
+		showTraceMessage(success
+			? `Replaying ${file.name}, the controller reboots twice and shows the result here`
+			: `${file.name} is not a valid input trace!`);
+	};
+
 	const handleSave = async (values) => {
 		let exportData = {};
 		for (const [key, value] of Object.entries(checkValues)) {
@@ -101,18 +191,7 @@ export default function BackupPage() {
 		const fileDate = new Date().toISOString().replace(/[^0-9]/g, '');
 		const name = FILENAME.replace("{DATE}", fileDate);
 		const json = JSON.stringify(exportData);
-		const file = new Blob([json], { type: 'text/json;charset=utf-8' });
-
-		let a = document.createElement('a');
-		a.href = URL.createObjectURL(file);
-		a.download = name;
-		a.innerHTML = "Save Backup";
-
-		let container = document.getElementById("root");
-		container.appendChild(a);
-
-		a.click();
-		a.remove();
+		downloadFile(new Blob([json], { type: 'text/json;charset=utf-8' }), name);
 
 		setSaveMessage(`Saved as: ${name}`);
 
@@ -287,6 +366,119 @@ export default function BackupPage() {
 					</div>
 				</Col>
 			</Section>
+			<Section title={"Settings Snapshot"}>
+				<Col>
+					<p>
+						{"A snapshot holds every setting of this controller and restores them all at once, which makes it the quickest way to set up several controllers the same way. "}
+						{"Snapshots only load on the GP2040-CE version they were saved with."}
+					</p>
+					<Form.Group className={"row mb-3"}>
+						<div className={"col-sm-4"}>
+							<Form.Check
+								id={"snapshot_ps4"}
+								label={"Include PS4 Keys"}
+								type={"checkbox"}
+								checked={includePS4}
+								onChange={() => setIncludePS4(!includePS4)}
+							/>
+						</div>
+					</Form.Group>
+					<input
+						ref={inputSnapshotSelect}
+						type={"file"}
+						accept={SNAPSHOT_FILE_EXTENSION}
+						style={{display: "none"}}
+						onChange={handleSnapshotSelect}
+					/>
+					<div
+						style={{
+							display: "flex",
+							flexDirection: "row"
+						}}
+					>
+						<Button onClick={handleSnapshotExport}>
+							{"Export"}
+						</Button>
+						<Button
+							className={"ms-2"}
+							onClick={() => {
+								inputSnapshotSelect.current.click();
+							}}
+						>
+							{"Import"}
+						</Button>
+						<div
+							style={{
+								height: "100%",
+								paddingLeft: 24,
+								fontWeight: 600,
+								color: "darkcyan",
+								alignSelf: "center"
+							}}
+						>
+							{snapshotMessage ? snapshotMessage : null}
+						</div>
+					</div>
+				</Col>
+			</Section>
+			<Section title={"Input Trace"}>
+				<Col>
+					<p>
+						{"The controller records every change of its inputs during a gamepad session, the last session can be downloaded here. "}
+						{"Replaying a trace feeds its inputs through the current settings and add-ons and compares the buttons against the recording."}
+					</p>
+					{traceStats &&
+						<div className="mb-3">
+							<div>Recorded Changes: {traceStats.entries}{traceStats.dropped > 0 && ` (${traceStats.dropped} older ones overwritten)`}</div>
+							{traceStats.replay &&
+								<div className={traceStats.replay.mismatches > 0 ? 'text-danger' : ''}>
+									Last Replay: {traceStats.replay.frames} frames, {traceStats.replay.mismatches} mismatches,
+									{` ${(traceStats.replay.pipelineTime / Math.max(traceStats.replay.frames, 1)).toFixed(1)} µs per frame (max ${traceStats.replay.pipelineMax} µs)`}
+									{traceStats.replay.firstMismatch &&
+										` - first at change ${traceStats.replay.firstMismatch.index}`
+									}
+								</div>
+							}
+						</div>
+					}
+					<input
+						ref={inputTraceSelect}
+						type={"file"}
+						accept={TRACE_FILE_EXTENSION}
+						style={{display: "none"}}
+						onChange={handleTraceSelect}
+					/>
+					<div
+						style={{
+							display: "flex",
+							flexDirection: "row"
+						}}
+					>
+						<Button onClick={handleTraceExport}>
+							{"Download"}
+						</Button>
+						<Button
+							className={"ms-2"}
+							onClick={() => {
+								inputTraceSelect.current.click();
+							}}
+						>
+							{"Replay"}
+						</Button>
+						<div
+							style={{
+								height: "100%",
+								paddingLeft: 24,
+								fontWeight: 600,
+								color: "darkcyan",
+								alignSelf: "center"
+							}}
+						>
+							{traceMessage ? traceMessage : null}
+						</div>
+					</div>
+				</Col>
+			</Section>
 		</>
 	);
 }
@@ -1,4 +1,4 @@
-import React, { useContext, useEffect, useState, useRef } from 'react';
+import React, { useContext, useEffect, useMemo, useState, useRef } from 'react';
 import { Button, Form, Row, Col, FormLabel } from 'react-bootstrap';
 import { Formik, useFormikContext, Field } from 'formik';
 import chunk from 'lodash/chunk';
@@ -9,6 +9,7 @@ import FormControl from '../Components/FormControl';
 import FormSelect from '../Components/FormSelect';
 import Section from '../Components/Section';
 import WebApi from '../Services/WebApi';
+import { encodeFrames, MAX_ENCODED_SIZE } from '../Services/SplashCodec';
 
 const ON_OFF_OPTIONS = [
 	{ label: 'Disabled', value: 0 },
@@ -101,6 +102,8 @@ const defaultValues = {
 	splashDuration: 0,
 	splashMode: 3,
 	splashImage: Array(16*64).fill(0), // 128 columns represented by bytes so 16 and 64 rows
+	splashFrames: [], // Animation frames shown after splashImage
+	frameDelay: 100,
 	invertSplash: false,
 	buttonLayoutCustomOptions: {
 		params: {
@@ -153,6 +156,7 @@ const schema = yup.object().shape({
 		})
 	}),
 	splashDuration: yup.number().required().min(0).label('Splash Duration'),
+	frameDelay: yup.number().required().min(10).max(2550).label('Frame Delay'),
 	displaySaverTimeout: yup.number().required().min(0).label('Display Saver'),
 });
 
@@ -161,9 +165,13 @@ const FormContext = () => {
 
 	useEffect(() => {
 		async function fetchData() {
-			const data = await WebApi.getDisplayOptions();
-			const splashImageResponse = await WebApi.getSplashImage();
+			const [data, splashImageResponse] = await Promise.all([
+				WebApi.getDisplayOptions(),
+				WebApi.getSplashImage(),
+			]);
 			data.splashImage = splashImageResponse.splashImage;
+			data.splashFrames = splashImageResponse.splashFrames;
+			data.frameDelay = splashImageResponse.frameDelay;
 			setValues(data);
 		}
 		fetchData();
@@ -231,13 +239,14 @@ export default function DisplayConfigPage() {
 	const [saveMessage, setSaveMessage] = useState('');
 
 	const onSuccess = async (values) => {
-		const success = await WebApi.setDisplayOptions(values, false)
-			.then(() => WebApi.setSplashImage(values));
+		const saved = await WebApi.setDisplayOptions(values, false);
+		const splashResult = saved ? await WebApi.setSplashImage(values) : null;
+		const success = saved && splashResult?.success;
 
 		if (success)
 			await updateUsedPins();
 
-		setSaveMessage(success ? 'Saved! Please Restart Your Device' : 'Unable to Save');
+		setSaveMessage(success ? 'Saved! Please Restart Your Device' : (splashResult?.error || 'Unable to Save'));
 
 	};
 
@@ -568,6 +577,30 @@ export default function DisplayConfigPage() {
 								)}
 							</Field>
 						</Row>
+						<Field name="splashFrames">
+							{({ field, form }) => (
+								<AnimationFrames
+									firstFrame={values.splashImage}
+									frames={field.value || []}
+									onChange={frames => form.setFieldValue(field.name, frames)}
+								/>
+							)}
+						</Field>
+						{values.splashFrames?.length > 0 && <Row className="mb-3">
+							<FormControl type="number"
+								label="Frame Delay (ms)"
+								name="frameDelay"
+								className="form-control-sm"
+								groupClassName="col-sm-3 mb-3"
+								value={values.frameDelay}
+								error={errors.frameDelay}
+								isInvalid={errors.frameDelay}
+								onChange={handleChange}
+								min={10}
+								max={2550}
+								step={10}
+							/>
+						</Row>}
 						<div className="mt-3">
 							<Button type="submit">Save</Button>
 							{saveMessage ? <span className="alert">{saveMessage}</span> : null}
@@ -580,6 +613,81 @@ export default function DisplayConfigPage() {
 	);
 }
 
+const loadImage = (file) => new Promise((resolve) => {
+	const fr = new FileReader();
+	fr.onload = () => {
+		const img = new Image();
+		img.onload = () => resolve(img);
+		img.src = fr.result;
+	};
+	fr.readAsDataURL(file);
+});
+
+// Scales an image into a 128x64 canvas and thresholds it to a row-major monochrome bitmap
+const imageToBitmap = (image, canvasContext) => {
+	const ctxWidth = canvasContext.canvas.width,
+		ctxHeight = canvasContext.canvas.height;
+	const imgWidth = image.width,
+		imgHeight = image.height;
+	const ratioWidth = imgWidth / ctxWidth,
+		ratioHeight = imgHeight / ctxHeight,
+		ratioAspect = ratioWidth > 1 ? ratioWidth : ratioHeight > 1 ? ratioHeight : 1;
+	const newWidth = imgWidth / ratioAspect,
+		newHeight = imgHeight / ratioAspect;
+	const offsetX = (ctxWidth / 2) - (newWidth / 2),
+		offsetY = (ctxHeight / 2) - (newHeight / 2);
+	canvasContext.clearRect(0, 0, ctxWidth, ctxHeight);
+	canvasContext.drawImage(image, offsetX, offsetY, newWidth, newHeight);
+
+	var imgPixels = canvasContext.getImageData(0, 0, canvasContext.canvas.width, canvasContext.canvas.height);
+
+	// Convert to monochrome
+	for (var i = 0; i < imgPixels.data.length; i = i + 4) {
+		var avg = (imgPixels.data[i] + imgPixels.data[i + 1] + imgPixels.data[i + 2]) / 3;
+		if (avg > 123) avg = 255
+		else avg = 0;
+		imgPixels.data[i] = avg;
+		imgPixels.data[i + 1] = avg;
+		imgPixels.data[i + 2] = avg;
+	}
+
+	// Pick only first channel because all of them are same
+	const bitsArray = chunk([...(new Uint8Array(imgPixels.data))]
+		.filter((x, y) => (y % 4) === 0), 8)
+		.map(chunks => chunks.reduce((acc, curr, i) => {
+			return acc + ((curr === 255 ? 1 : 0) << (7 - i))
+		}, 0));
+
+	return bitsArray;
+};
+
+const drawBitmap = (canvasContext, bitsArray) => {
+	const w = canvasContext.canvas.width;
+	const h = canvasContext.canvas.height;
+	const rgbToRgba = [];
+
+	// expand bytes to individual binary bits and then bits to 255 or 0, because monochrome
+	const bitsArrayArray = bitsArray.flatMap((a) => {
+		const bits = a.toString(2).split('').map(Number);
+		const full = Array(8 - bits.length).fill(0).concat(bits);
+		return full.map(a => a === 1 ? 255 : 0)
+	})
+
+	// fill up the new array as RGBA
+	bitsArrayArray.forEach((x) => {
+		rgbToRgba.push(x);
+		rgbToRgba.push(x);
+		rgbToRgba.push(x);
+		rgbToRgba.push(255);
+	})
+	const imageDataCopy = new ImageData(
+		new Uint8ClampedArray(rgbToRgba),
+		w,
+		h
+	)
+	canvasContext.putImageData(imageDataCopy, 0, 0, 0, 0, w, h);
+};
+
 const Canvas = ({value: bitsArray, onChange}) => {
 	const [image, setImage] = useState(null);
 	const [canvasContext, setCanvasContext] = useState(null);
@@ -594,39 +702,7 @@ const Canvas = ({value: bitsArray, onChange}) => {
 	useEffect(() => {
 		if (canvasContext == null || image == null) return
 
-		const ctxWidth = canvasContext.canvas.width,
-			ctxHeight = canvasContext.canvas.height;
-		const imgWidth = image.width,
-			imgHeight = image.height;
-		const ratioWidth = imgWidth / ctxWidth,
-			ratioHeight = imgHeight / ctxHeight,
-			ratioAspect = ratioWidth > 1 ? ratioWidth : ratioHeight > 1 ? ratioHeight : 1;
-		const newWidth = imgWidth / ratioAspect,
-			newHeight = imgHeight / ratioAspect;
-		const offsetX = (ctxWidth / 2) - (newWidth / 2),
-			offsetY = (ctxHeight / 2) - (newHeight / 2);
-		canvasContext.clearRect(0, 0, canvasRef.current.width, canvasRef.current.height);
-		canvasContext.drawImage(image, offsetX, offsetY, newWidth, newHeight);
-
-		var imgPixels = canvasContext.getImageData(0, 0, canvasContext.canvas.width, canvasContext.canvas.height);
-
-		// Convert to monochrome
-		for (var i = 0; i < imgPixels.data.length; i = i + 4) {
-			var avg = (imgPixels.data[i] + imgPixels.data[i + 1] + imgPixels.data[i + 2]) / 3;
-			if (avg > 123) avg = 255
-			else avg = 0;
-			imgPixels.data[i] = avg;
-			imgPixels.data[i + 1] = avg;
-			imgPixels.data[i + 2] = avg;
-		}
-
-		// Pick only first channel because all of them are same
-		const bitsArray = chunk([...(new Uint8Array(imgPixels.data))]
-			.filter((x, y) => (y % 4) === 0), 8)
-			.map(chunks => chunks.reduce((acc, curr, i) => {
-				return acc + ((curr === 255 ? 1 : 0) << (7 - i))
-			}, 0));
-
+		const bitsArray = imageToBitmap(image, canvasContext);
 		onChange(bitsArray.map(a => inverted ? 255 - a : a));
 
 	}, [image, canvasContext]);
@@ -635,43 +711,11 @@ const Canvas = ({value: bitsArray, onChange}) => {
 	useEffect(() => {
 		if (canvasContext == null) return;
 
-		const w = canvasContext.canvas.width;
-		const h = canvasContext.canvas.height;
-		const rgbToRgba = [];
-
-		// expand bytes to individual binary bits and then bits to 255 or 0, because monochrome
-		const bitsArrayArray = bitsArray.flatMap((a) => {
-			const bits = a.toString(2).split('').map(Number);
-			const full = Array(8 - bits.length).fill(0).concat(bits);
-			return full.map(a => a === 1 ? 255 : 0)
-		})
-
-		// fill up the new array as RGBA
-		bitsArrayArray.forEach((x) => {
-			rgbToRgba.push(x);
-			rgbToRgba.push(x);
-			rgbToRgba.push(x);
-			rgbToRgba.push(255);
-		})
-		const imageDataCopy = new ImageData(
-			new Uint8ClampedArray(rgbToRgba),
-			w,
-			h
-		)
-		canvasContext.putImageData(imageDataCopy, 0, 0, 0, 0, w, h);
+		drawBitmap(canvasContext, bitsArray);
 	}, [bitsArray, canvasContext])
 
 	const onImageAdd = (ev) => {
-		var file = ev.target.files[0];
-		var fr = new FileReader();
-		fr.onload = () => {
-			const img = new Image();
-			img.onload = () => {
-				setImage(img);
-			};
-			img.src = fr.result;
-		};
-		fr.readAsDataURL(file);
+		loadImage(ev.target.files[0]).then(setImage);
 	}
 
 	const toggleInverted = () => {
@@ -689,3 +733,59 @@ const Canvas = ({value: bitsArray, onChange}) => {
 		</div>
 	</div>)
 }
+
+const FramePreview = ({ bitmap }) => {
+	const canvasRef = useRef();
+
+	useEffect(() => {
+		drawBitmap(canvasRef.current.getContext('2d'), bitmap);
+	}, [bitmap]);
+
+	return <canvas ref={canvasRef} width="128" height="64" style={{ background: 'black' }} />;
+};
+
+const AnimationFrames = ({ firstFrame, frames, onChange }) => {
+	const encodedSize = useMemo(() => encodeFrames([firstFrame, ...frames]).length, [firstFrame, frames]);
+
+	const onFrameAdd = (ev) => {
+		const file = ev.target.files[0];
+		ev.target.value = '';
+		if (!file)
+			return;
+
+		loadImage(file).then((image) => {
+			const canvas = document.createElement('canvas');
+			canvas.width = 128;
+			canvas.height = 64;
+			onChange([...frames, imageToBitmap(image, canvas.getContext('2d'))]);
+		});
+	};
+
+	const onFrameRemove = (index) => onChange(frames.filter((frame, i) => i !== index));
+
+	return (
+		<Row className="mt-3 mb-3">
+			<FormLabel>Animation Frames</FormLabel>
+			<p>
+				Frames added here play after the image above, then the animation starts over. Frames that only change
+				part of the screen take the least space.
+			</p>
+			<div style={{ display: "flex", flexWrap: "wrap", gap: "11px" }}>
+				{frames.map((frame, index) => (
+					<div key={`splash-frame-${index}`}>
+						<FramePreview bitmap={frame} />
+						<br />
+						<Button size="sm" variant="secondary" onClick={() => onFrameRemove(index)}>Remove</Button>
+					</div>
+				))}
+			</div>
+			<div className="mt-2">
+				<input type="file" accept="image/jpeg, image/png, image/jpg" onChange={onFrameAdd} />
+			</div>
+			<div className={`mt-2 ${encodedSize > MAX_ENCODED_SIZE ? 'text-danger' : 'text-muted'}`}>
+				Stored size: {encodedSize} of {MAX_ENCODED_SIZE} bytes
+				{encodedSize > MAX_ENCODED_SIZE ? ', remove frames or simplify the images to save' : ''}
+			</div>
+		</Row>
+	);
+};
@@ -8,12 +8,19 @@ import WebApi from '../Services/WebApi';
 
 const percentage = (x, y) => (x / y * 100).toFixed(2)
 const toKB = (x) => parseFloat((x / 1024).toFixed(2))
+const toMs = (x) => parseFloat((x / 1000).toFixed(1))
+
+const INPUT_MODE_NAMES = ['XInput', 'Nintendo Switch', 'PS3/DirectInput', 'Keyboard', 'PS4'];
+const ALLOCATION_NAMES = { json: 'JSON Documents', leds: 'LEDs', addons: 'Add-ons' };
+const WII_EXTENSION_NAMES = { [-1]: 'None', 0: 'Nunchuck', 1: 'Classic Controller', 2: 'Classic Controller Pro', 4: 'Guitar', 5: 'Drums', 7: 'Taiko Drum' };
 
 export default function HomePage() {
 	const [latestVersion, setLatestVersion] = useState('');
 	const [latestTag, setLatestTag] = useState('');
 	const [currentVersion, setCurrentVersion] = useState(process.env.REACT_APP_CURRENT_VERSION);
 	const [memoryReport, setMemoryReport] = useState(null);
+	const [usbReportStats, setUsbReportStats] = useState(null);
+	const [wiiExtensionStats, setWiiExtensionStats] = useState(null);
 
 	useEffect(() => {
 		WebApi.getFirmwareVersion().then(response => {
@@ -23,19 +30,35 @@ export default function HomePage() {
 
 		WebApi.getMemoryReport().then(response => {
 			const unit = 1024;
-			const {totalFlash, usedFlash, staticAllocs, totalHeap, usedHeap} = response;
+			const {totalFlash, usedFlash, staticAllocs, totalHeap, usedHeap, largestFreeHeap, peakHeap, stacks, allocations} = response;
 			setMemoryReport({
 				totalFlash: toKB(totalFlash),
 				usedFlash: toKB(usedFlash),
 				staticAllocs: toKB(staticAllocs),
 				totalHeap: toKB(totalHeap),
 				usedHeap: toKB(usedHeap),
+				largestFreeHeap: toKB(largestFreeHeap),
+				peakHeap: toKB(peakHeap),
 				percentageFlash: percentage(usedFlash, totalFlash),
-				percentageHeap: percentage(usedHeap, totalHeap)
+				percentageHeap: percentage(usedHeap, totalHeap),
+				stacks: stacks ?? [],
+				allocations: allocations ?? {},
 			});
 		})
 		.catch(console.error);
 
+		WebApi.getUsbReportStats().then(response => {
+			if (response?.available)
+				setUsbReportStats(response);
+		})
+		.catch(console.error);
+
+		WebApi.getWiiExtensionStats().then(response => {
+			if (response?.available)
+				setWiiExtensionStats(response);
+		})
+		.catch(console.error);
+
 		axios.get('https://api.github.com/repos/OpenStickCommunity/GP2040-CE/releases')
 			.then((response) => {
 				const sortedData = orderBy(response.data, 'published_at', 'desc');
@@ -69,7 +92,40 @@ export default function HomePage() {
 							<strong>Memory (KB)</strong>
 							<div>Flash: {memoryReport.usedFlash} / {memoryReport.totalFlash} ({memoryReport.percentageFlash}%)</div>
 							<div>Heap: {memoryReport.usedHeap} / {memoryReport.totalHeap} ({memoryReport.percentageHeap}%)</div>
+							<div>Heap Peak: {memoryReport.peakHeap} / Largest Free Block: {memoryReport.largestFreeHeap}</div>
 							<div>Static Allocations: {memoryReport.staticAllocs}</div>
+							{memoryReport.stacks.map((stack, core) =>
+								<div key={`stack-${core}`} className={stack.highWater >= stack.size ? 'text-danger' : ''}>
+									Core {core} Stack: {toKB(stack.highWater)} / {toKB(stack.size)} deepest ({toKB(stack.bootHighWater)} at boot)
+									{stack.highWater >= stack.size && ' - possible overflow'}
+								</div>
+							)}
+							{Object.entries(memoryReport.allocations).map(([name, counter]) =>
+								<div key={`allocations-${name}`}>
+									{ALLOCATION_NAMES[name] ?? name}: {toKB(counter.current)} in use, {toKB(counter.peak)} peak ({counter.count} allocations)
+								</div>
+							)}
+						</div>
+					}
+					{usbReportStats &&
+						<div className="mt-3">
+							<strong>USB Reports (last gamepad session)</strong>
+							<div>Input Mode: {INPUT_MODE_NAMES[usbReportStats.inputMode] ?? usbReportStats.inputMode}</div>
+							<div>Generated: {usbReportStats.generated}</div>
+							<div>Sent: {usbReportStats.sent} / Unchanged: {usbReportStats.deduplicated} / Busy: {usbReportStats.busy}</div>
+							<div>Completed: {usbReportStats.completed}</div>
+							<div>Polling Interval: {usbReportStats.pollInterval ? `${usbReportStats.pollInterval} µs (min ${usbReportStats.pollIntervalMin} µs)` : 'not measured'}</div>
+							<div>Input to Report: {usbReportStats.inputEdges ? `${usbReportStats.inputLatency} µs (max ${usbReportStats.inputLatencyMax} µs) over ${usbReportStats.inputEdges} input changes` : 'not measured'}</div>
+							{usbReportStats.ps4Signing &&
+								<div>PS4 Signing: {usbReportStats.ps4Signing.count} signed, last took {toMs(usbReportStats.ps4Signing.lastTime)} ms ({toMs(usbReportStats.ps4Signing.lastCpuTime)} ms busy), longest stall {toMs(usbReportStats.ps4Signing.maxStall)} ms</div>
+							}
+						</div>
+					}
+					{wiiExtensionStats &&
+						<div className="mt-3">
+							<strong>Wii Extension</strong>
+							<div>Connected: {WII_EXTENSION_NAMES[wiiExtensionStats.extensionType] ?? wiiExtensionStats.extensionType}</div>
+							<div>Polls: {wiiExtensionStats.polls} / Timeouts: {wiiExtensionStats.timeouts} / Reconnects: {wiiExtensionStats.reconnects}</div>
 						</div>
 					}
 				</div>
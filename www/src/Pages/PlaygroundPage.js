@@ -1,5 +1,97 @@
-import React from 'react';
+import React, { useContext, useEffect, useState } from 'react';
+import { Form } from 'react-bootstrap';
+import { AppContext } from '../Contexts/AppContext';
+import Section from '../Components/Section';
+import WebApi from '../Services/WebApi';
+import { BUTTONS } from '../Data/Buttons';
+
+// Bit order matches GAMEPAD_MASK_* in GamepadState.h
+const DPAD_BUTTONS = ['Up', 'Down', 'Left', 'Right'];
+const BUTTON_ORDER = ['B1', 'B2', 'B3', 'B4', 'L1', 'R1', 'L2', 'R2', 'S1', 'S2', 'L3', 'R3', 'A1', 'A2'];
+const ANALOG_AXES = ['lx', 'ly', 'rx', 'ry'];
+const INTERVALS = [1, 4, 8, 16, 33, 100];
+const HISTORY_SIZE = 100;
 
 export default function PlaygroundPage() {
-	return <></>;
+	const { buttonLabels } = useContext(AppContext);
+	const [updateInterval, setUpdateInterval] = useState(16);
+	const [gamepadState, setGamepadState] = useState(null);
+	const [timing, setTiming] = useState(null);
+
+	useEffect(() => {
+		const history = [];
+		let last = null;
+		const stop = WebApi.streamGamepadState(updateInterval, (state, receivedAt) => {
+			setGamepadState(state);
+
+			// Jitter between the time the firmware sampled a change and the time it arrived here
+			if (last) {
+				const deviceDelta = ((state.timestamp - last.state.timestamp) >>> 0) / 1000;
+				const browserDelta = receivedAt - last.receivedAt;
+				history.push(browserDelta - deviceDelta);
+				if (history.length > HISTORY_SIZE)
+					history.shift();
+
+				setTiming({
+					events: history.length,
+					average: history.reduce((a, b) => a + b, 0) / history.length,
+					max: Math.max(...history.map(Math.abs)),
+				});
+			}
+			last = { state, receivedAt };
+		});
+
+		return stop;
+	}, [updateInterval]);
+
+	const isPressed = (button) => {
+		if (!gamepadState)
+			return false;
+
+		const dpadIndex = DPAD_BUTTONS.indexOf(button);
+		if (dpadIndex >= 0)
+			return (gamepadState.dpad & (1 << dpadIndex)) !== 0;
+
+		return (gamepadState.buttons & (1 << BUTTON_ORDER.indexOf(button))) !== 0;
+	};
+
+	return (
+		<Section title="Input Playground">
+			<p>Shows the live state of the controller inputs while in web config mode.</p>
+			<Form.Group className="row mb-3">
+				<Form.Label className="col-sm-3">Update Interval</Form.Label>
+				<div className="col-sm-3">
+					<Form.Select value={updateInterval} onChange={(e) => setUpdateInterval(parseInt(e.target.value))}>
+						{INTERVALS.map((value) => <option key={`interval-${value}`} value={value}>{value} ms</option>)}
+					</Form.Select>
+				</div>
+			</Form.Group>
+			<div className="d-flex flex-wrap mb-3">
+				{[...DPAD_BUTTONS, ...BUTTON_ORDER].map((button) =>
+					<span
+						key={`button-${button}`}
+						className={`badge me-2 mb-2 ${isPressed(button) ? 'bg-success' : 'bg-secondary'}`}
+					>
+						{BUTTONS[buttonLabels][button]}
+					</span>
+				)}
+			</div>
+			{gamepadState &&
+				<div className="mb-3">
+					{ANALOG_AXES.map((axis) =>
+						<div key={`axis-${axis}`}>{axis.toUpperCase()}: {gamepadState[axis]}</div>
+					)}
+					<div>LT: {gamepadState.lt}</div>
+					<div>RT: {gamepadState.rt}</div>
+				</div>
+			}
+			{timing &&
+				<div>
+					<div><strong>Delivery jitter</strong> (last {timing.events} changes)</div>
+					<div>Average: {timing.average.toFixed(1)} ms</div>
+					<div>Max: {timing.max.toFixed(1)} ms</div>
+				</div>
+			}
+		</Section>
+	);
 }
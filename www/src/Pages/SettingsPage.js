@@ -51,6 +51,7 @@ const HOTKEY_ACTIONS = [
 	{ label: 'SOCD Cleaning Off', value: 12 },
 	{ label: 'Invert X Axis', value: 9 },
 	{ label: 'Invert Y Axis', value: 10 },
+	{ label: 'Next Remap Layer', value: 13 },
 ];
 
 const schema = yup.object().shape({
@@ -0,0 +1,134 @@
+// Mirrors headers/splashcodec.h: frames are RLE compressed in OLED page order, key frames replace
+// the screen and delta frames are XORed onto the previous frame. Raw frames are uncompressed key frames.
+
+const FRAME_WIDTH = 128;
+const FRAME_PAGES = 8;
+const FRAME_SIZE = FRAME_WIDTH * FRAME_PAGES;
+const FRAME_KEY = 0;
+const FRAME_DELTA = 1;
+const FRAME_RAW = 2;
+const MAX_LITERAL = 128;
+const MAX_REPEAT = 129;
+const MIN_REPEAT = 3;
+
+export const MAX_ENCODED_SIZE = 1028; // SPLASH_IMAGE_DATA_SIZE
+
+// Row-major 128x64 bitmap (16 bytes per row, MSB is the left-most pixel) to page order
+const toPages = (bitmap) => {
+	const pages = new Uint8Array(FRAME_SIZE);
+	for (let pos = 0; pos < FRAME_SIZE; pos++) {
+		const page = Math.floor(pos / FRAME_WIDTH);
+		const column = pos % FRAME_WIDTH;
+		const mask = 0x80 >> (column & 7);
+		let value = 0;
+		for (let bit = 0; bit < 8; bit++) {
+			if (bitmap[(page * 8 + bit) * (FRAME_WIDTH / 8) + (column >> 3)] & mask)
+				value |= (1 << bit);
+		}
+		pages[pos] = value;
+	}
+	return pages;
+};
+
+const fromPages = (pages) => {
+	const bitmap = Array(FRAME_SIZE).fill(0);
+	for (let pos = 0; pos < FRAME_SIZE; pos++) {
+		const page = Math.floor(pos / FRAME_WIDTH);
+		const column = pos % FRAME_WIDTH;
+		for (let bit = 0; bit < 8; bit++) {
+			if (pages[pos] & (1 << bit))
+				bitmap[(page * 8 + bit) * (FRAME_WIDTH / 8) + (column >> 3)] |= 0x80 >> (column & 7);
+		}
+	}
+	return bitmap;
+};
+
+const compress = (pages) => {
+	const out = [];
+	let literal = [];
+	const flushLiteral = () => {
+		if (literal.length > 0)
+			out.push(literal.length - 1, ...literal);
+		literal = [];
+	};
+
+	let pos = 0;
+	while (pos < FRAME_SIZE) {
+		const value = pages[pos];
+		let run = 1;
+		while (pos + run < FRAME_SIZE && run < MAX_REPEAT && pages[pos + run] === value)
+			run++;
+
+		if (run >= MIN_REPEAT) {
+			flushLiteral();
+			out.push(0x80 | (run - 2), value);
+			pos += run;
+		} else {
+			for (let i = 0; i < run; i++, pos++) {
+				literal.push(pages[pos]);
+				if (literal.length === MAX_LITERAL)
+					flushLiteral();
+			}
+		}
+	}
+	flushLiteral();
+	return out;
+};
+
+// Encodes a list of row-major bitmaps, picking whichever of key or delta is smaller for each frame
+export const encodeFrames = (bitmaps) => {
+	const out = [];
+	let previous = null;
+	bitmaps.forEach((bitmap, index) => {
+		const pages = toPages(bitmap);
+		let type = FRAME_KEY;
+		let data = compress(pages);
+		if (data.length >= FRAME_SIZE) {
+			type = FRAME_RAW;
+			data = [...pages];
+		}
+		if (index > 0) {
+			const delta = compress(pages.map((value, i) => value ^ previous[i]));
+			if (delta.length < data.length) {
+				type = FRAME_DELTA;
+				data = delta;
+			}
+		}
+		out.push(type, data.length & 0xFF, data.length >> 8, ...data);
+		previous = pages;
+	});
+	return new Uint8Array(out);
+};
+
+export const decodeFrames = (data, frameCount) => {
+	const frames = [];
+	const pages = new Uint8Array(FRAME_SIZE);
+	let offset = 0;
+	for (let frame = 0; frame < frameCount && offset + 3 <= data.length; frame++) {
+		const delta = data[offset] === FRAME_DELTA;
+		const end = offset + 3 + (data[offset + 1] | (data[offset + 2] << 8));
+		let src = offset + 3;
+		let pos = 0;
+		if (data[offset] === FRAME_RAW) {
+			pages.set(data.subarray(src, end));
+		} else {
+			while (src < end && pos < FRAME_SIZE) {
+				const token = data[src++];
+				const repeat = token & 0x80;
+				const count = repeat ? (token & 0x7F) + 2 : token + 1;
+				for (let i = 0; i < count && pos < FRAME_SIZE; i++, pos++) {
+					const value = repeat ? data[src] : data[src + i];
+					pages[pos] = delta ? pages[pos] ^ value : value;
+				}
+				src += repeat ? 1 : count;
+			}
+		}
+		frames.push(fromPages(pages));
+		offset = end;
+	}
+	return frames;
+};
+
+export const toBase64 = (data) => btoa(String.fromCharCode.apply(null, data));
+
+export const fromBase64 = (data) => Uint8Array.from(atob(data), c => c.charCodeAt(0));
@@ -1,5 +1,6 @@
 import axios from 'axios';
 import { intToHex, hexToInt, rgbIntToHex } from './Utilities';
+import { encodeFrames, decodeFrames, toBase64, fromBase64, MAX_ENCODED_SIZE } from './SplashCodec';
 
 const baseUrl = process.env.NODE_ENV === 'production' ? '' : 'http://localhost:8080';
 
@@ -24,6 +25,29 @@ export const baseButtonMappings = {
 	A2:    { pin: -1, key: 0, error: null },
 };
 
+// GET requests made in the same tick are coalesced into a single /api/batch POST, which saves a
+// TCP connection per call on page load. Getters the batch could not fit are fetched on their own.
+let pendingBatch = null;
+
+function batchGet(name) {
+	if (!pendingBatch) {
+		const batch = { requests: {} };
+		batch.response = new Promise((resolve) => setTimeout(resolve, 0))
+			.then(() => {
+				pendingBatch = null;
+				return axios.post(`${baseUrl}/api/batch`, batch.requests);
+			})
+			.catch(() => ({ data: {} }));
+		pendingBatch = batch;
+	}
+
+	pendingBatch.requests[name] = null;
+	return pendingBatch.response
+		.then((response) => response.data[name] !== undefined
+			? { data: response.data[name] }
+			: axios.get(`${baseUrl}/api/${name}`));
+}
+
 async function resetSettings() {
 	return axios.get(`${baseUrl}/api/resetSettings`)
 		.then((response) => response.data)
@@ -31,7 +55,7 @@ async function resetSettings() {
 }
 
 async function getDisplayOptions() {
-	return axios.get(`${baseUrl}/api/getDisplayOptions`)
+	return batchGet('getDisplayOptions')
 		.then((response) => {
 			if (response.data.i2cAddress)
 				response.data.i2cAddress = '0x' + response.data.i2cAddress.toString(16);
@@ -59,6 +83,8 @@ async function setDisplayOptions(options, isPreview) {
 	}
 
 	delete newOptions.splashImage;
+	delete newOptions.splashFrames;
+	delete newOptions.frameDelay;
 	const url = !isPreview ? `${baseUrl}/api/setDisplayOptions` : `${baseUrl}/api/setPreviewDisplayOptions`;
 	return axios.post(url, newOptions)
 		.then((response) => {
@@ -72,22 +98,33 @@ async function setDisplayOptions(options, isPreview) {
 }
 
 async function getSplashImage() {
-	return axios.get(`${baseUrl}/api/getSplashImage`)
+	return batchGet('getSplashImage')
 		.then((response) => {
-			return response.data;
+			// The first frame is edited on its own, splashFrames holds the animation frames after it
+			const { splashImage, frameCount, frameDelay } = response.data;
+			const frames = decodeFrames(fromBase64(splashImage), frameCount || 1);
+			return { splashImage: frames[0], splashFrames: frames.slice(1), frameDelay: (frameDelay || 10) * 10 };
 		}).catch(console.error);
 }
 
-async function setSplashImage({splashImage}) {
+async function setSplashImage({splashImage, splashFrames = [], frameDelay}) {
+	const frames = [splashImage, ...splashFrames];
+	const encoded = encodeFrames(frames);
+	if (encoded.length > MAX_ENCODED_SIZE)
+		return { success: false, error: `Splash image is too large (${encoded.length} of ${MAX_ENCODED_SIZE} bytes)` };
+
+	// The device counts the frame delay in 10ms steps
 	return axios.post(`${baseUrl}/api/setSplashImage`, {
-		splashImage: btoa(String.fromCharCode.apply(null, new Uint8Array(splashImage)))
+		splashImage: toBase64(encoded),
+		frameCount: frames.length,
+		frameDelay: frames.length > 1 ? Math.min(Math.round((frameDelay || 0) / 10), 255) : 0,
 	}).then((response) => {
 		return response.data;
 	}).catch(console.error);
 }
 
 async function getGamepadOptions() {
-	return axios.get(`${baseUrl}/api/getGamepadOptions`)
+	return batchGet('getGamepadOptions')
 		.then((response) => response.data)
 		.catch(console.error);
 }
@@ -105,7 +142,7 @@ async function setGamepadOptions(options) {
 }
 
 async function getLedOptions() {
-	return axios.get(`${baseUrl}/api/getLedOptions`)
+	return batchGet('getLedOptions')
 		.then((response) => {
 			console.log(response.data);
 
@@ -138,7 +175,7 @@ async function setLedOptions(options) {
 }
 
 async function getCustomTheme() {
-	return axios.get(`${baseUrl}/api/getCustomTheme`)
+	return batchGet('getCustomTheme')
 		.then((response) => {
 			let data = { hasCustomTheme: response.data.enabled, customTheme: { } };
 
@@ -182,7 +219,7 @@ async function setCustomTheme(customThemeOptions) {
 }
 
 async function getPinMappings() {
-	return axios.get(`${baseUrl}/api/getPinMappings`)
+	return batchGet('getPinMappings')
 		.then((response) => {
 			let mappings = { ...baseButtonMappings };
 			for (let prop of Object.keys(response.data))
@@ -209,7 +246,7 @@ async function setPinMappings(mappings) {
 }
 
 async function getKeyMappings() {
-	return axios.get(`${baseUrl}/api/getKeyMappings`)
+	return batchGet('getKeyMappings')
 		.then((response) => {
 			let mappings = { ...baseButtonMappings };
 			for (let prop of Object.keys(response.data))
@@ -235,7 +272,7 @@ async function setKeyMappings(mappings) {
 		});
 }
 async function getAddonsOptions() {
-	return axios.get(`${baseUrl}/api/getAddonsOptions`)
+	return batchGet('getAddonsOptions')
 		.then((response) => response.data)
 		.catch(console.error);
 }
@@ -265,29 +302,144 @@ async function setPS4Options(options) {
 }
 
 async function getFirmwareVersion() {
-	return axios.get(`${baseUrl}/api/getFirmwareVersion`)
+	return batchGet('getFirmwareVersion')
 		.then((response) => response.data)
 		.catch(console.error);
 }
 
 async function getMemoryReport() {
-	return axios.get(`${baseUrl}/api/getMemoryReport`)
+	return batchGet('getMemoryReport')
+		.then((response) => response.data)
+		.catch(console.error);
+}
+
+async function getUsbReportStats() {
+	return batchGet('getUsbReportStats')
+		.then((response) => response.data)
+		.catch(console.error);
+}
+
+async function getWiiExtensionStats() {
+	return batchGet('getWiiExtensionStats')
+		.then((response) => response.data)
+		.catch(console.error);
+}
+
+// Size of the recorded input trace and the result of the latest replay
+async function getInputTraceStats() {
+	return batchGet('getInputTraceStats')
 		.then((response) => response.data)
 		.catch(console.error);
 }
 
 async function getUsedPins() {
-	return axios.get(`${baseUrl}/api/getUsedPins`)
+	return batchGet('getUsedPins')
 	.then((response) => response.data)
 	.catch(console.error);
 }
 
+// Uncalibrated readings of the analog add-on stick, -1 for an axis without a pin
+async function getAnalogRaw() {
+	return batchGet('getAnalogRaw')
+		.then((response) => response.data)
+		.catch(console.error);
+}
+
+// Binary image of all settings, see Storage::exportSnapshot in the firmware
+async function exportSettingsSnapshot(includePS4) {
+	return axios.post(`${baseUrl}/api/exportSettingsSnapshot`, { includePS4 }, { responseType: 'arraybuffer' })
+		.then((response) => response.data)
+		.catch(console.error);
+}
+
+// Restores a snapshot with a single flash write, the controller reboots into web config mode afterwards
+async function importSettingsSnapshot(snapshot) {
+	return axios.post(`${baseUrl}/api/importSettingsSnapshot`, snapshot, {
+		headers: { 'Content-Type': 'application/octet-stream' },
+	})
+		.then((response) => response.data.success)
+		.catch((err) => {
+			console.error(err);
+			return false;
+		});
+}
+
+// Binary trace of the last gamepad session, see InputTraceHeader in the firmware
+async function exportInputTrace() {
+	return axios.get(`${baseUrl}/api/exportInputTrace`, { responseType: 'arraybuffer' })
+		.then((response) => response.data)
+		.catch(console.error);
+}
+
+// The controller replays the trace in gamepad mode and comes back to web config mode with the result
+async function replayInputTrace(trace) {
+	return axios.post(`${baseUrl}/api/replayInputTrace`, trace, {
+		headers: { 'Content-Type': 'application/octet-stream' },
+	})
+		.then((response) => response.data.success)
+		.catch((err) => {
+			console.error(err);
+			return false;
+		});
+}
+
 async function reboot(bootMode) {
 	return axios.post(`${baseUrl}/api/reboot`, { bootMode })
 		.then((response) => response.data)
 		.catch(console.error);
 }
 
+// Snapshot layout mirrors GamepadStateStream in webconfig.cpp (little endian)
+const parseGamepadState = (hex) => {
+	const bytes = Uint8Array.from(hex.match(/../g), (h) => parseInt(h, 16));
+	const view = new DataView(bytes.buffer);
+	return {
+		buttons: view.getUint16(0, true),
+		dpad: view.getUint8(2),
+		aux: view.getUint16(3, true),
+		lx: view.getUint16(5, true),
+		ly: view.getUint16(7, true),
+		rx: view.getUint16(9, true),
+		ry: view.getUint16(11, true),
+		lt: view.getUint8(13),
+		rt: view.getUint8(14),
+		timestamp: view.getUint32(15, true),
+	};
+};
+
+// Streams gamepad state changes to onState until the returned function is called
+function streamGamepadState(interval, onState) {
+	const controller = new AbortController();
+	fetch(`${baseUrl}/api/streamGamepadState`, {
+		method: 'POST',
+		body: JSON.stringify({ interval }),
+		signal: controller.signal,
+	})
+		.then(async (response) => {
+			const reader = response.body.getReader();
+			const decoder = new TextDecoder();
+			let pending = '';
+			for (;;) {
+				const { value, done } = await reader.read();
+				if (done)
+					break;
+
+				pending += decoder.decode(value, { stream: true });
+				const events = pending.split('\n\n');
+				pending = events.pop();
+				events
+					.filter((event) => event.startsWith('data: '))
+					.forEach((event) => onState(parseGamepadState(event.substring(6)), performance.now()));
+			}
+		})
+		.catch((err) => {
+			if (err.name !== 'AbortError')
+				console.error(err);
+		});
+
+	return () => controller.abort();
+}
+
 function sanitizeRequest(request) {
 	const newRequest = {...request};
 	delete newRequest.pledIndex1;
@@ -319,7 +471,16 @@ const WebApi = {
 	setSplashImage,
 	getFirmwareVersion,
 	getMemoryReport,
+	getUsbReportStats,
+	getWiiExtensionStats,
+	getInputTraceStats,
 	getUsedPins,
+	getAnalogRaw,
+	streamGamepadState,
+	exportSettingsSnapshot,
+	importSettingsSnapshot,
+	exportInputTrace,
+	replayInputTrace,
 	reboot
 };
 